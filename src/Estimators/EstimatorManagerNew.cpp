@@ -121,7 +121,7 @@ EstimatorManagerNew::EstimatorManagerNew(Communicate* c,
   makeConfigReport(app_log());
 }
 
-EstimatorManagerNew::~EstimatorManagerNew() {}
+EstimatorManagerNew::~EstimatorManagerNew() { flushAsyncReduction(); }
 
 /** reset names of the properties
  *
@@ -228,9 +228,15 @@ void EstimatorManagerNew::startDriverRun()
     for (auto& uope : operator_ests_)
       uope->registerOperatorEstimator(h_file->getFileID());
   }
+  if (async_reduction_)
+    startAsyncReduction();
 }
 
-void EstimatorManagerNew::stopDriverRun() { h_file.reset(); }
+void EstimatorManagerNew::stopDriverRun()
+{
+  flushAsyncReduction();
+  h_file.reset();
+}
 
 void EstimatorManagerNew::startBlock(int steps) { block_timer_.restart(); }
 
@@ -243,11 +249,25 @@ void EstimatorManagerNew::stopBlock(unsigned long accept, unsigned long reject,
   //take block averages and update properties per block
   PropertyCache[weightInd] = block_weight;
   makeBlockAverages(accept, reject);
-  reduceOperatorEstimators();
-  writeOperatorEstimators();
-  zeroOperatorEstimators();
-  // intentionally put after all the estimator I/O
-  PropertyCache[cpuInd] = block_timer_.elapsed();
+  if (async_reduction_)
+  {
+    // the reductions of the previous block had the whole block to progress
+    completeOperatorReductions();
+    BlockBuffer& buffer = acquireBlockBuffer();
+    postOperatorReduction(buffer);
+    PropertyCache[cpuInd] = block_timer_.elapsed();
+    // h5 records of the scalars are written by the I/O thread along with the operator estimators
+    buffer.averages.assign(AverageCache.begin(), AverageCache.end());
+    reducing_buffers_.push_back(&buffer);
+  }
+  else
+  {
+    reduceOperatorEstimators();
+    writeOperatorEstimators();
+    zeroOperatorEstimators();
+    // intentionally put after all the estimator I/O
+    PropertyCache[cpuInd] = block_timer_.elapsed();
+  }
   writeScalarH5();
   RecordCount++;
 }
@@ -343,11 +363,9 @@ void EstimatorManagerNew::makeBlockAverages(unsigned long accepts, unsigned long
 void EstimatorManagerNew::writeScalarH5()
 {
   //Do not assume h_file is valid
-  if (h_file)
+  if (h_file && !async_reduction_)
   {
-    for (int o = 0; o < h5desc.size(); ++o)
-      // cheating here, remove SquaredAverageCache from API
-      h5desc[o].write(AverageCache.data(), AverageCache.data());
+    writeScalarRecords(AverageCache.data());
     H5Fflush(h_file->getFileID(), H5F_SCOPE_LOCAL);
   }
 
@@ -363,6 +381,13 @@ void EstimatorManagerNew::writeScalarH5()
   }
 }
 
+void EstimatorManagerNew::writeScalarRecords(const RealType* averages)
+{
+  for (int o = 0; o < h5desc.size(); ++o)
+    // cheating here, remove SquaredAverageCache from API
+    h5desc[o].write(averages, averages);
+}
+
 void EstimatorManagerNew::reduceOperatorEstimators()
 {
   if (operator_ests_.size() > 0)
@@ -425,6 +450,140 @@ void EstimatorManagerNew::zeroOperatorEstimators()
     op_est->zero();
 }
 
+void EstimatorManagerNew::startAsyncReduction()
+{
+  assert(reducing_buffers_.empty() && !block_writer_.joinable());
+  free_buffers_.clear();
+  write_queue_.clear();
+  for (auto& buffer : block_buffers_)
+    free_buffers_.push_back(&buffer);
+  stop_writer_ = false;
+#if defined(H5_HAVE_THREADSAFE)
+  if (h_file)
+    block_writer_ = std::thread(&EstimatorManagerNew::runBlockWriter, this);
+#endif
+}
+
+void EstimatorManagerNew::postOperatorReduction(BlockBuffer& buffer)
+{
+  const size_t num_ops = operator_ests_.size();
+  buffer.send.resize(num_ops);
+  buffer.recv.resize(num_ops);
+  buffer.requests.resize(num_ops);
+  for (int iop = 0; iop < num_ops; ++iop)
+  {
+    auto& estimator = *operator_ests_[iop];
+    auto& data      = estimator.get_data();
+    auto& send      = buffer.send[iop];
+    auto& recv      = buffer.recv[iop];
+    // 1 larger to carry the weight, same layout as reduceOperatorEstimators.
+    send.resize(data.size() + 1);
+    recv.resize(data.size() + 1);
+    std::copy_n(data.begin(), data.size(), send.begin());
+    send[data.size()] = estimator.get_walkers_weight();
+#if defined(HAVE_MPI)
+    MPI_Ireduce(send.data(), recv.data(), send.size(), mpi::get_mpi_datatype(send[0]), MPI_SUM, 0,
+                my_comm_->getMPI(), &buffer.requests[iop]);
+#else
+    recv = send;
+#endif
+  }
+  zeroOperatorEstimators();
+}
+
+void EstimatorManagerNew::completeOperatorReductions()
+{
+  while (!reducing_buffers_.empty())
+  {
+    BlockBuffer& buffer = *reducing_buffers_.front();
+    reducing_buffers_.pop_front();
+#if defined(HAVE_MPI)
+    MPI_Waitall(buffer.requests.size(), buffer.requests.data(), MPI_STATUSES_IGNORE);
+#endif
+    if (block_writer_.joinable())
+    {
+      {
+        std::lock_guard<std::mutex> lock(block_buffer_mutex_);
+        write_queue_.push_back(&buffer);
+      }
+      block_buffer_cv_.notify_all();
+    }
+    else
+    {
+      if (my_comm_->rank() == 0)
+        writeBlockBuffer(buffer);
+      std::lock_guard<std::mutex> lock(block_buffer_mutex_);
+      free_buffers_.push_back(&buffer);
+    }
+  }
+}
+
+EstimatorManagerNew::BlockBuffer& EstimatorManagerNew::acquireBlockBuffer()
+{
+  std::unique_lock<std::mutex> lock(block_buffer_mutex_);
+  block_buffer_cv_.wait(lock, [this] { return !free_buffers_.empty(); });
+  BlockBuffer* buffer = free_buffers_.front();
+  free_buffers_.pop_front();
+  return *buffer;
+}
+
+void EstimatorManagerNew::writeBlockBuffer(BlockBuffer& buffer)
+{
+  for (int iop = 0; iop < buffer.recv.size(); ++iop)
+  {
+    auto& recv             = buffer.recv[iop];
+    const size_t data_size = recv.size() - 1;
+    // same normalization as OperatorEstBase::normalize in reduceOperatorEstimators
+    size_t reduced_walker_weights = recv[data_size];
+    RealType invTotWgt            = 1.0 / static_cast<QMCT::RealType>(reduced_walker_weights);
+    for (size_t i = 0; i < data_size; ++i)
+      recv[i] *= invTotWgt;
+  }
+  //Do not assume h_file is valid
+  if (!h_file)
+    return;
+  for (int iop = 0; iop < buffer.recv.size(); ++iop)
+    operator_ests_[iop]->write(buffer.recv[iop].data());
+  writeScalarRecords(buffer.averages.data());
+  H5Fflush(h_file->getFileID(), H5F_SCOPE_LOCAL);
+}
+
+void EstimatorManagerNew::runBlockWriter()
+{
+  while (true)
+  {
+    BlockBuffer* buffer;
+    {
+      std::unique_lock<std::mutex> lock(block_buffer_mutex_);
+      block_buffer_cv_.wait(lock, [this] { return !write_queue_.empty() || stop_writer_; });
+      if (write_queue_.empty())
+        return;
+      buffer = write_queue_.front();
+      write_queue_.pop_front();
+    }
+    writeBlockBuffer(*buffer);
+    {
+      std::lock_guard<std::mutex> lock(block_buffer_mutex_);
+      free_buffers_.push_back(buffer);
+    }
+    block_buffer_cv_.notify_all();
+  }
+}
+
+void EstimatorManagerNew::flushAsyncReduction()
+{
+  completeOperatorReductions();
+  if (block_writer_.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(block_buffer_mutex_);
+      stop_writer_ = true;
+    }
+    block_buffer_cv_.notify_all();
+    block_writer_.join();
+  }
+}
+
 void EstimatorManagerNew::getApproximateEnergyVariance(RealType& e, RealType& var)
 {
   RealType tmp[3];
@@ -13,6 +13,10 @@
 #define QMCPLUSPLUS_ESTIMATORMANAGERNEW_H
 
 #include <memory>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 
 #include "Configuration.h"
 #include "Utilities/Timer.h"
@@ -25,6 +29,8 @@
 #include "OhmmsData/HDFAttribIO.h"
 #include "type_traits/template_types.hpp"
 #include "EstimatorManagerInput.h"
+#include "mpi/mpi_datatype.h"
+#include <array>
 #include <bitset>
 
 namespace qmcplusplus
@@ -96,9 +102,21 @@ public:
 
   /** Stop the manager at the end of a driver run().
    * Flush/close files.
+   * Completes the reductions and writes still in flight if the asynchronous reduction is on.
    */
   void stopDriverRun();
 
+  /** Turn on/off the asynchronous reduction of the operator estimators
+   *
+   *  When on, stopBlock copies the block data of the operator estimators into a free buffer,
+   *  posts non-blocking reductions and returns. The reductions are completed at the next stopBlock
+   *  and the reduced block is normalized and written by a dedicated I/O thread on rank 0 while
+   *  the following block runs. At most two blocks are in flight.
+   *  The I/O thread requires a thread-safe HDF5 library, otherwise the writes stay on the calling thread.
+   *  Must be called before startDriverRun.
+   */
+  void setAsyncReduction(bool async) { async_reduction_ = async; }
+
   /** start  a block
    * @param steps number of steps in a block
    */
@@ -207,6 +225,38 @@ private:
    */
   void zeroOperatorEstimators();
 
+  /// write h5 records of the scalar estimators from averages laid out like AverageCache
+  void writeScalarRecords(const RealType* averages);
+
+  /// one block of estimator data for the asynchronous reduction and write
+  struct BlockBuffer
+  {
+    /// operator estimator data with the walker weight appended, one per operator estimator
+    std::vector<std::vector<RealType>> send;
+    /// reduction result on rank 0
+    std::vector<std::vector<RealType>> recv;
+    /// block averages of the scalar estimators, written along with the operator estimators
+    std::vector<RealType> averages;
+    std::vector<mpi::request> requests;
+  };
+
+  /** copy the operator estimator data into the buffer, post the non-blocking reductions and zero the estimators
+   */
+  void postOperatorReduction(BlockBuffer& buffer);
+  /** wait for the reductions in flight and pass the blocks to the writer
+   */
+  void completeOperatorReductions();
+  /// get a free buffer, waits for the I/O thread if all the buffers are in flight
+  BlockBuffer& acquireBlockBuffer();
+  /// normalize and write a reduced block, rank 0 only
+  void writeBlockBuffer(BlockBuffer& buffer);
+  /// I/O thread main loop
+  void runBlockWriter();
+  /// reset the buffers and start the I/O thread
+  void startAsyncReduction();
+  /// complete all the reductions and writes in flight and stop the I/O thread
+  void flushAsyncReduction();
+
   ///number of records in a block
   int RecordCount;
   ///index for the block weight PropertyCache(weightInd)
@@ -259,6 +309,24 @@ private:
   ///block timer
   Timer block_timer_;
 
+  /// if true, operator estimators are reduced asynchronously
+  bool async_reduction_ = false;
+  /// double buffer of the blocks in flight
+  std::array<BlockBuffer, 2> block_buffers_;
+  /// buffers ready to be filled
+  std::deque<BlockBuffer*> free_buffers_;
+  /// buffers with reductions in flight, in block order. Only touched by the calling thread
+  std::deque<BlockBuffer*> reducing_buffers_;
+  /// reduced buffers waiting for the I/O thread, in block order
+  std::deque<BlockBuffer*> write_queue_;
+  /// if true, the I/O thread exits once write_queue_ is drained
+  bool stop_writer_ = false;
+  /// protect free_buffers_, write_queue_ and stop_writer_
+  std::mutex block_buffer_mutex_;
+  std::condition_variable block_buffer_cv_;
+  /// I/O thread writing the reduced blocks
+  std::thread block_writer_;
+
   ///number of maximum data for a scalar.dat
   int max4ascii;
 
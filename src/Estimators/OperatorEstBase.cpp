@@ -52,14 +52,18 @@ void OperatorEstBase::write()
   assert(data_.size() > 0);
   // auto total = std::accumulate(data_->begin(), data_->end(), 0.0);
   // std::cout << "data size: " << data_->size() << " : " << total << '\n';
-  for (auto& h5d : h5desc_)
-    h5d->write(expanded_data.data(), nullptr);
+  write(expanded_data.data());
 #else
-  for (auto& h5d : h5desc_)
-    h5d->write(data_.data(), nullptr);
+  write(data_.data());
 #endif
 }
 
+void OperatorEstBase::write(const QMCT::FullPrecRealType* data)
+{
+  for (auto& h5d : h5desc_)
+    h5d->write(data, nullptr);
+}
+
 void OperatorEstBase::zero()
 {
   if (data_locality_ == DataLocality::rank || data_locality_ == DataLocality::crowd)
@@ -120,6 +120,12 @@ public:
    */
   void write();
 
+  /** Write data laid out like get_data() to previously registered observable_helper hdf5 wrapper.
+   *
+   *  Used to write a block which has already been swapped out of this estimator.
+   */
+  void write(const QMCT::FullPrecRealType* data);
+
   /** zero data appropriately for the DataLocality
    */
   void zero();
@@ -151,5 +151,17 @@ void EstimatorManagerNewTest::collectMainEstimators()
   
 void EstimatorManagerNewTest::testReduceOperatorEstimators() { em.reduceOperatorEstimators(); }
 
+std::vector<QMCTraits::RealType> EstimatorManagerNewTest::testAsyncReduceOperatorEstimators()
+{
+  em.setAsyncReduction(true);
+  em.startAsyncReduction();
+  auto& buffer = em.acquireBlockBuffer();
+  em.postOperatorReduction(buffer);
+  em.reducing_buffers_.push_back(&buffer);
+  em.completeOperatorReductions();
+  auto& reduced = buffer.recv[0];
+  return std::vector<QMCT::RealType>(reduced.begin(), reduced.end() - 1);
+}
+
 } // namespace testing
 } // namespace qmcplusplus
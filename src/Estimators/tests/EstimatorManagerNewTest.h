@@ -55,6 +55,10 @@ public:
   
   bool testMakeBlockAverages();
   void testReduceOperatorEstimators();
+  /** post and complete the asynchronous reduction of the operator estimators
+   *  \return normalized reduced data of the first operator estimator, only valid on rank 0
+   */
+  std::vector<QMCT::RealType> testAsyncReduceOperatorEstimators();
 
   std::vector<QMCT::RealType>& get_operator_data() { return em.operator_ests_[0]->get_data(); }
   
@@ -117,4 +117,29 @@ TEST_CASE("EstimatorManagerNew::reduceOperatorestimators()", "[estimators]")
   }
 }
 
+TEST_CASE("EstimatorManagerNew::asyncReduceOperatorEstimators", "[estimators]")
+{
+  Communicate* c = OHMMS::Controller;
+  int num_ranks  = c->size();
+  QMCHamiltonian ham;
+  testing::EstimatorManagerNewTest embt(ham, c, num_ranks);
+
+  embt.fakeSomeOperatorEstimatorSamples(c->rank());
+  std::vector<QMCTraits::RealType> good_data = embt.generateGoodOperatorData(num_ranks);
+
+  std::vector<QMCTraits::RealType> test_data = embt.testAsyncReduceOperatorEstimators();
+
+  // the estimator is ready for the next block as soon as the reduction is posted
+  for (auto value : embt.get_operator_data())
+    CHECK(value == 0.0);
+
+  if (c->rank() == 0)
+  {
+    REQUIRE(test_data.size() == good_data.size());
+    QMCTraits::RealType norm = 1.0 / static_cast<QMCTraits::RealType>(num_ranks);
+    for (size_t i = 0; i < test_data.size(); ++i)
+      CHECK(test_data[i] == Approx(good_data[i] * norm));
+  }
+}
+
 } // namespace qmcplusplus
@@ -111,6 +111,12 @@ void Communicate::initializeAsNodeComm(const Communicate& parent)
   myMPI       = comm.get();
   d_mycontext = comm.rank();
   d_ncontexts = comm.size();
+  // create a communicator among node leaders.
+  mpi3::communicator leader_comm = parent.comm.split(isGroupLeader() ? 0 : MPI_UNDEFINED, parent.rank());
+  if (isGroupLeader())
+    GroupLeaderComm = std::make_unique<Communicate>(leader_comm);
+  else
+    GroupLeaderComm.reset();
 }
 
 void Communicate::finalize()
@@ -132,7 +138,7 @@ void Communicate::barrier() const { comm.barrier(); }
 
 void Communicate::initialize(int argc, char** argv) { std::string when = "qmc." + getDateAndTime("%Y%m%d_%H%M"); }
 
-void Communicate::initializeAsNodeComm(const Communicate& parent) {}
+void Communicate::initializeAsNodeComm(const Communicate& parent) { GroupLeaderComm = std::make_unique<Communicate>(); }
 
 void Communicate::finalize() {}
 
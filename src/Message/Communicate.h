@@ -96,7 +96,7 @@ public:
 #ifdef HAVE_MPI
   void initialize(const mpi3::environment& env);
 #endif
-  /// initialize this as a node/shared-memory communicator
+  /// initialize this as a node/shared-memory communicator. The node leaders are connected by getGroupLeaderComm()
   void initializeAsNodeComm(const Communicate& parent);
   void finalize();
   void barrier() const;
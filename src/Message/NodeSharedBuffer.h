@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_NODESHAREDBUFFER_H
+#define QMCPLUSPLUS_NODESHAREDBUFFER_H
+
+#include <memory>
+#include <stdexcept>
+#include "Message/Communicate.h"
+#include "CPU/SIMD/aligned_allocator.hpp"
+
+namespace qmcplusplus
+{
+/** An array shared by all the ranks of a node communicator.
+ *
+ * With MPI, the node leader allocates the memory of an MPI-3 shared memory window and all the ranks on the node
+ * map it. Without MPI, it falls back to private memory. Ranks on the node may write disjoint parts of the array
+ * and must call fence() collectively before reading what the other ranks wrote.
+ * The destructor frees the window and is collective over the node communicator as well.
+ * @tparam T element type
+ * @tparam ALIGN alignment of the first element in bytes
+ */
+template<typename T, size_t ALIGN = QMC_SIMD_ALIGNMENT>
+class NodeSharedBuffer
+{
+public:
+  /** allocate the array. collective over node_comm
+   * @param node_comm communicator of the ranks sharing the array, created by Communicate::initializeAsNodeComm
+   * @param n number of elements
+   */
+  NodeSharedBuffer(Communicate& node_comm, size_t n) : size_(n), data_(nullptr)
+  {
+#ifdef HAVE_MPI
+    const MPI_Aint bytes = node_comm.isGroupLeader() ? n * sizeof(T) + ALIGN : 0;
+    void* base           = nullptr;
+    if (MPI_Win_allocate_shared(bytes, 1, MPI_INFO_NULL, node_comm.getMPI(), &base, &win_) != MPI_SUCCESS)
+      throw std::runtime_error("NodeSharedBuffer failed to allocate the node shared memory window!");
+    MPI_Aint leader_bytes;
+    int disp_unit;
+    MPI_Win_shared_query(win_, 0, &leader_bytes, &disp_unit, &base);
+    // the window is mapped with page granularity so the offset to alignment is the same on all the ranks
+    size_t space = leader_bytes;
+    if (std::align(ALIGN, n * sizeof(T), base, space) == nullptr)
+      throw std::runtime_error("NodeSharedBuffer failed to align the node shared memory!");
+    data_ = static_cast<T*>(base);
+    MPI_Win_fence(0, win_);
+#else
+    data_ = allocator_.allocate(n);
+#endif
+  }
+
+  NodeSharedBuffer(const NodeSharedBuffer&) = delete;
+  NodeSharedBuffer& operator=(const NodeSharedBuffer&) = delete;
+
+  ~NodeSharedBuffer()
+  {
+#ifdef HAVE_MPI
+    MPI_Win_free(&win_);
+#else
+    allocator_.deallocate(data_, size_);
+#endif
+  }
+
+  T* data() { return data_; }
+  size_t size() const { return size_; }
+
+  /// make the writes of every rank on the node visible to all of them. collective over the node communicator
+  void fence()
+  {
+#ifdef HAVE_MPI
+    MPI_Win_fence(0, win_);
+#endif
+  }
+
+private:
+  size_t size_;
+  T* data_;
+#ifdef HAVE_MPI
+  MPI_Win win_;
+#else
+  aligned_allocator<T, ALIGN> allocator_;
+#endif
+};
+
+} // namespace qmcplusplus
+#endif
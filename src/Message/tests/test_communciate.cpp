@@ -12,6 +12,7 @@
 
 #include "catch.hpp"
 #include "Message/Communicate.h"
+#include "Message/NodeSharedBuffer.h"
 
 namespace qmcplusplus
 {
@@ -117,4 +118,36 @@ TEST_CASE("test_communicate_split_four", "[message]")
   }
 }
 
+TEST_CASE("test_communicate_node_shared_buffer", "[message]")
+{
+  Communicate* c = OHMMS::Controller;
+
+  Communicate node_comm;
+  node_comm.initializeAsNodeComm(*c);
+  REQUIRE(node_comm.size() <= c->size());
+
+  if (node_comm.isGroupLeader())
+  {
+    auto leader_comm = node_comm.getGroupLeaderComm();
+    REQUIRE(leader_comm != nullptr);
+    REQUIRE(leader_comm->size() <= c->size());
+    if (c->rank() == 0)
+      REQUIRE(leader_comm->rank() == 0);
+  }
+  else
+    REQUIRE(node_comm.getGroupLeaderComm() == nullptr);
+
+  const size_t n = 37;
+  NodeSharedBuffer<double> buffer(node_comm, n);
+  REQUIRE(buffer.size() == n);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(buffer.data()) % QMC_SIMD_ALIGNMENT == 0);
+
+  // every rank writes its own slots and reads those written by the others
+  for (size_t i = node_comm.rank(); i < n; i += node_comm.size())
+    buffer.data()[i] = i * 0.5;
+  buffer.fence();
+  for (size_t i = 0; i < n; i++)
+    CHECK(buffer.data()[i] == Approx(i * 0.5));
+}
+
 } // namespace qmcplusplus
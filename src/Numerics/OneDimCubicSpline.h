@@ -222,6 +222,19 @@ public:
     return eval.cubicInterpolate(m_Y[Loc], m_Y[Loc + 1], m_Y2[Loc], m_Y2[Loc + 1]);
   }
 
+  /** Interpolation to evaluate the function at n points
+   *@param n the number of points
+   *@param r the radial distances
+   *@param vals return the values of the function
+   *
+   *The loop calls the non-virtual splint, a sweep over many points sharing this spline avoids the per point dispatch.
+   */
+  inline void splint(size_t n, const point_type* restrict r, value_type* restrict vals) const
+  {
+    for (size_t i = 0; i < n; i++)
+      vals[i] = OneDimCubicSpline::splint(r[i]);
+  }
+
   /** Interpolation to evaluate the function and itsderivatives.
    *@param r the radial distance
    *@param du return the derivative
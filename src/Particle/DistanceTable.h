@@ -253,6 +253,27 @@ protected:
   /// old displacements
   DisplRow old_dr_;
 
+  /// cutoff of the neighbor lists of a move. 0 if move() sets up the dense temp_r_, temp_dr_, old_r_ and old_dr_
+  RealType neighbor_cutoff_ = 0;
+
+  /// ids of the particles within neighbor_cutoff_ of the proposed position
+  std::vector<int> temp_nb_ids_;
+
+  /// distances to the particles of temp_nb_ids_
+  DistRow temp_nb_r_;
+
+  /// displacements to the particles of temp_nb_ids_
+  DisplRow temp_nb_dr_;
+
+  /// ids of the particles within neighbor_cutoff_ of the current position of the moved particle
+  std::vector<int> old_nb_ids_;
+
+  /// distances to the particles of old_nb_ids_
+  DistRow old_nb_r_;
+
+  /// displacements to the particles of old_nb_ids_
+  DisplRow old_nb_dr_;
+
 public:
   ///constructor using source and target ParticleSet
   DistanceTableAA(const ParticleSet& target, DTModes modes) : DistanceTable(target, target, modes) {}
@@ -289,6 +310,33 @@ public:
    */
   const DisplRow& getOldDispls() const { return old_dr_; }
 
+  /** return the cutoff of the neighbor lists set up by move().
+   *  If positive, move() only sets up the neighbor lists and the temp and old rows are not valid.
+   */
+  RealType getNeighborCutoff() const { return neighbor_cutoff_; }
+
+  /** return the ids of the particles within the neighbor cutoff of the proposed position.
+   *  It may include the moved particle at its current position, as the temp row does.
+   */
+  const std::vector<int>& getTempNeighbors() const { return temp_nb_ids_; }
+
+  /// return the distances to the particles of getTempNeighbors()
+  const DistRow& getTempNeighborDists() const { return temp_nb_r_; }
+
+  /// return the displacements to the particles of getTempNeighbors()
+  const DisplRow& getTempNeighborDispls() const { return temp_nb_dr_; }
+
+  /** return the ids of the particles within the neighbor cutoff of the current position of the moved particle.
+   *  Set up by move() with prepare_old = true.
+   */
+  const std::vector<int>& getOldNeighbors() const { return old_nb_ids_; }
+
+  /// return the distances to the particles of getOldNeighbors()
+  const DistRow& getOldNeighborDists() const { return old_nb_r_; }
+
+  /// return the displacements to the particles of getOldNeighbors()
+  const DisplRow& getOldNeighborDispls() const { return old_nb_dr_; }
+
   virtual size_t get_num_particls_stored() const { return 0; }
 
   /// return multi walker temporary pair distance table data pointer
@@ -18,7 +18,6 @@
  * @brief definition  of HDFWalkerOuput  and other support class and functions
  */
 #include "HDFWalkerOutput.h"
-#include "Utilities/IteratorUtility.h"
 #include "OhmmsData/FileUtility.h"
 #include "hdf/HDFVersion.h"
 #include <numeric>
@@ -27,6 +26,7 @@
 #include "Message/Communicate.h"
 #include "mpi/collectives.h"
 #include "hdf/hdf_hyperslab.h"
+#include <cstdio>
 
 namespace qmcplusplus
 {
@@ -56,13 +56,12 @@ HDFWalkerOutput::HDFWalkerOutput(size_t num_ptcls, const std::string& aroot, Com
       number_of_particles_(num_ptcls),
       myComm(c),
       currentConfigNumber(0),
-      RootName(aroot)
+      RootName(aroot),
+      block(-1),
+      single_precision_(false),
+      async_(false)
 //       , fw_out(myComm)
 {
-  RemoteData.reserve(4);
-  RemoteData.push_back(new BufferType);
-  RemoteData.push_back(new BufferType);
-  block = -1;
   //     //FileName=myComm->getName()+hdf::config_ext;
   //     //ConfigFileName=myComm->getName()+".storeConfig.h5";
   //     std::string ConfigFileName=myComm->getName()+".storeConfig.h5";
@@ -74,11 +73,34 @@ HDFWalkerOutput::HDFWalkerOutput(size_t num_ptcls, const std::string& aroot, Com
   //     fw_out.write(dim,"DIM");
 }
 
-/** Destructor writes the state of random numbers and close the file */
+/** Destructor waits for the write in flight */
 HDFWalkerOutput::~HDFWalkerOutput()
 {
   //     fw_out.close();
-  delete_iter(RemoteData.begin(), RemoteData.end());
+  wait();
+}
+
+void HDFWalkerOutput::setWriteMode(bool single_precision, bool async)
+{
+  single_precision_ = single_precision;
+  async_            = async;
+#if !defined(H5_HAVE_THREADSAFE)
+  if (async_)
+  {
+    app_warning() << "Writing walker configurations on a background thread requires a thread-safe HDF5 library. "
+                  << "Writing synchronously." << std::endl;
+    async_ = false;
+  }
+#endif
+}
+
+void HDFWalkerOutput::wait()
+{
+  if (writer_.joinable())
+    writer_.join();
+#if defined(HAVE_MPI)
+  send_requests_.clear(); // mpi3::request waits on destruction
+#endif
 }
 
 /** Write the set of walker configurations to the HDF5 file.
@@ -94,6 +116,9 @@ HDFWalkerOutput::~HDFWalkerOutput()
  */
 bool HDFWalkerOutput::dump(const WalkerConfigurations& W, int nblock)
 {
+  // the buffers of the previous dump are reused
+  wait();
+
   std::string FileName = myComm->getName() + hdf::config_ext;
   //rotate files
   //if(!myComm->rank() && currentConfigNumber)
@@ -105,82 +130,179 @@ bool HDFWalkerOutput::dump(const WalkerConfigurations& W, int nblock)
 
   //try to use collective
   hdf_archive dump_file(myComm, true);
-  dump_file.create(FileName);
-  HDFVersion cur_version;
-  dump_file.write(cur_version.version, hdf::version);
-  dump_file.push(hdf::main_state);
-  dump_file.write(nblock, "block");
+  if (async_ && !dump_file.is_parallel())
+  {
+    // collect everything on the master and hand the file over to a background thread.
+    snapshot(W, nblock);
+    number_of_walkers_                    = W.WalkerOffsets[myComm->size()];
+    const std::vector<int> walker_offsets = W.WalkerOffsets;
+    if (single_precision_)
+      gather_walkers(walker_offsets, RemoteDataSP[0], RemoteDataSP[1]);
+    else
+      gather_walkers(walker_offsets, RemoteData[0], RemoteData[1]);
+    if (!myComm->rank())
+      writer_ = std::thread([this, FileName, nblock, walker_offsets]() {
+        // write to a temporary file so that a complete checkpoint is always on disk
+        const std::string tmp_name = FileName + ".tmp";
+        hdf_archive hout;
+        hout.create(tmp_name);
+        HDFVersion cur_version;
+        hout.write(cur_version.version, hdf::version);
+        hout.push(hdf::main_state);
+        int block_copy = nblock;
+        hout.write(block_copy, "block");
+        hout.write(number_of_walkers_, hdf::num_walkers);
+        std::vector<int> offsets_copy(walker_offsets);
+        hout.write(offsets_copy, "walker_partition");
+        std::array<size_t, 3> gcounts{number_of_walkers_, number_of_particles_, OHMMS_DIM};
+        if (single_precision_)
+          hout.writeSlabReshaped(RemoteDataSP[1], gcounts, hdf::walkers);
+        else
+          hout.writeSlabReshaped(RemoteData[1], gcounts, hdf::walkers);
+        hout.close();
+        std::rename(tmp_name.c_str(), FileName.c_str());
+      });
+  }
+  else
+  {
+    dump_file.create(FileName);
+    HDFVersion cur_version;
+    dump_file.write(cur_version.version, hdf::version);
+    dump_file.push(hdf::main_state);
+    dump_file.write(nblock, "block");
 
-  write_configuration(W, dump_file, nblock);
-  dump_file.close();
+    write_configuration(W, dump_file, nblock);
+    dump_file.close();
+  }
 
   currentConfigNumber++;
   prevFile = FileName;
   return true;
 }
 
-void HDFWalkerOutput::write_configuration(const WalkerConfigurations& W, hdf_archive& hout, int nblock)
+void HDFWalkerOutput::snapshot(const WalkerConfigurations& W, int nblock)
 {
   const int wb = OHMMS_DIM * number_of_particles_;
   if (nblock > block)
   {
-    RemoteData[0]->resize(wb * W.getActiveWalkers());
-    W.putConfigurations(RemoteData[0]->data());
+    RemoteData[0].resize(wb * W.getActiveWalkers());
+    W.putConfigurations(RemoteData[0].data());
+    if (single_precision_)
+    {
+      RemoteDataSP[0].resize(RemoteData[0].size());
+      std::copy(RemoteData[0].begin(), RemoteData[0].end(), RemoteDataSP[0].begin());
+    }
     block = nblock;
   }
+}
+
+void HDFWalkerOutput::write_configuration(const WalkerConfigurations& W, hdf_archive& hout, int nblock)
+{
+  snapshot(W, nblock);
 
   number_of_walkers_ = W.WalkerOffsets[myComm->size()];
   hout.write(number_of_walkers_, hdf::num_walkers);
 
-  std::array<size_t, 3> gcounts{number_of_walkers_, number_of_particles_, OHMMS_DIM};
-
   if (hout.is_parallel())
-  {
-    { // write walker offset.
-      // Though it is a small array, it needs to be written collectively in large scale runs.
-      std::array<size_t, 1> gcounts{static_cast<size_t>(myComm->size()) + 1};
-      std::array<size_t, 1> counts{0};
-      std::array<size_t, 1> offsets{static_cast<size_t>(myComm->rank())};
-      std::vector<int> myWalkerOffset;
-      if (myComm->size() - 1 == myComm->rank())
-      {
-        counts[0] = 2;
-        myWalkerOffset.push_back(W.WalkerOffsets[myComm->rank()]);
-        myWalkerOffset.push_back(W.WalkerOffsets[myComm->size()]);
-      }
-      else
-      {
-        counts[0] = 1;
-        myWalkerOffset.push_back(W.WalkerOffsets[myComm->rank()]);
-      }
-      hyperslab_proxy<std::vector<int>, 1> slab(myWalkerOffset, gcounts, counts, offsets);
-      hout.write(slab, "walker_partition");
+  { // write walker offset.
+    // Though it is a small array, it needs to be written collectively in large scale runs.
+    std::array<size_t, 1> gcounts{static_cast<size_t>(myComm->size()) + 1};
+    std::array<size_t, 1> counts{0};
+    std::array<size_t, 1> offsets{static_cast<size_t>(myComm->rank())};
+    std::vector<int> myWalkerOffset;
+    if (myComm->size() - 1 == myComm->rank())
+    {
+      counts[0] = 2;
+      myWalkerOffset.push_back(W.WalkerOffsets[myComm->rank()]);
+      myWalkerOffset.push_back(W.WalkerOffsets[myComm->size()]);
     }
-    { // write walker configuration
-      std::array<size_t, 3> counts{W.getActiveWalkers(), number_of_particles_, OHMMS_DIM};
-      std::array<size_t, 3> offsets{static_cast<size_t>(W.WalkerOffsets[myComm->rank()]), 0, 0};
-      hyperslab_proxy<BufferType, 3> slab(*RemoteData[0], gcounts, counts, offsets);
-      hout.write(slab, hdf::walkers);
+    else
+    {
+      counts[0] = 1;
+      myWalkerOffset.push_back(W.WalkerOffsets[myComm->rank()]);
     }
+    hyperslab_proxy<std::vector<int>, 1> slab(myWalkerOffset, gcounts, counts, offsets);
+    hout.write(slab, "walker_partition");
   }
   else
-  { //gaterv to the master and master writes it, could use isend/irecv
     hout.write(W.WalkerOffsets, "walker_partition");
-    if (myComm->size() > 1)
+
+  if (single_precision_)
+    write_walkers(hout, W.WalkerOffsets, RemoteDataSP[0], &RemoteDataSP[1]);
+  else
+    write_walkers(hout, W.WalkerOffsets, RemoteData[0], &RemoteData[1]);
+}
+
+template<typename BT>
+void HDFWalkerOutput::write_walkers(hdf_archive& hout, const std::vector<int>& walker_offsets, BT& local, BT* remote)
+{
+  const size_t wb = OHMMS_DIM * number_of_particles_;
+  std::array<size_t, 3> gcounts{number_of_walkers_, number_of_particles_, OHMMS_DIM};
+
+  auto write_slab = [&](BT& data, int rank) {
+    std::array<size_t, 3> counts{static_cast<size_t>(walker_offsets[rank + 1] - walker_offsets[rank]),
+                                 number_of_particles_, OHMMS_DIM};
+    std::array<size_t, 3> offsets{static_cast<size_t>(walker_offsets[rank]), 0, 0};
+    hyperslab_proxy<BT, 3> slab(data, gcounts, counts, offsets);
+    hout.write(slab, hdf::walkers);
+  };
+
+  if (hout.is_parallel())
+    write_slab(local, myComm->rank());
+  else if (myComm->size() == 1)
+    hout.writeSlabReshaped(local, gcounts, hdf::walkers);
+  else
+  { // stream the walkers of each rank to the master, no rank holds more than its own share of walkers
+#if defined(HAVE_MPI)
+    if (!myComm->rank())
     {
-      std::vector<int> displ(myComm->size()), counts(myComm->size());
-      for (int i = 0; i < myComm->size(); ++i)
+      auto post_recv = [&](int rank, BT& buf) {
+        buf.resize(wb * (walker_offsets[rank + 1] - walker_offsets[rank]));
+        return myComm->comm.ireceive_n(buf.data(), buf.size(), rank);
+      };
+      // write the master's walkers while receiving from rank 1
+      mpi3::request next = post_recv(1, remote[0]);
+      if (walker_offsets[1] > walker_offsets[0])
+        write_slab(local, 0);
+      for (int rank = 1; rank < myComm->size(); rank++)
       {
-        counts[i] = wb * (W.WalkerOffsets[i + 1] - W.WalkerOffsets[i]);
-        displ[i]  = wb * W.WalkerOffsets[i];
+        next.wait();
+        BT& current = remote[(rank - 1) % 2];
+        if (rank + 1 < myComm->size())
+          next = post_recv(rank + 1, remote[rank % 2]);
+        if (walker_offsets[rank + 1] > walker_offsets[rank])
+          write_slab(current, rank);
       }
-      if (!myComm->rank())
-        RemoteData[1]->resize(wb * W.WalkerOffsets[myComm->size()]);
-      mpi::gatherv(*myComm, *RemoteData[0], *RemoteData[1], counts, displ);
     }
-    int buffer_id = (myComm->size() > 1) ? 1 : 0;
-    hout.writeSlabReshaped(*RemoteData[buffer_id], gcounts, hdf::walkers);
+    else
+      send_requests_.push_back(myComm->comm.isend_n(local.data(), local.size(), 0));
+#endif
+  }
+}
+
+template<typename BT>
+BT& HDFWalkerOutput::gather_walkers(const std::vector<int>& walker_offsets, BT& local, BT& all)
+{
+  if (myComm->size() == 1)
+  {
+    all = local;
+    return all;
   }
+#if defined(HAVE_MPI)
+  const size_t wb = OHMMS_DIM * number_of_particles_;
+  if (!myComm->rank())
+  {
+    all.resize(wb * walker_offsets[myComm->size()]);
+    std::copy(local.begin(), local.end(), all.begin());
+    std::vector<mpi3::request> requests;
+    for (int rank = 1; rank < myComm->size(); rank++)
+      requests.push_back(myComm->comm.ireceive_n(all.data() + wb * walker_offsets[rank],
+                                                 wb * (walker_offsets[rank + 1] - walker_offsets[rank]), rank));
+  }
+  else
+    send_requests_.push_back(myComm->comm.isend_n(local.data(), local.size(), 0));
+#endif
+  return all;
 }
 
 /*
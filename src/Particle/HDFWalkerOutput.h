@@ -17,6 +17,8 @@
 #define QMCPLUSPLUS_WALKER_OUTPUT_H
 
 #include "Particle/WalkerConfigurations.h"
+#include <array>
+#include <thread>
 #include <utility>
 #include "hdf/hdf_archive.h"
 
@@ -57,12 +59,41 @@ public:
   bool dump(const WalkerConfigurations& w, int block);
   //     bool dump(ForwardWalkingHistoryObject& FWO);
 
+  /** set how walker configurations are written
+   * @param single_precision if true, walker positions are stored in single precision
+   * @param async if true, the master writes the file on a background thread and dump returns once the data is collected
+   *
+   * Single precision files are read back by the same reader, HDF5 converts the datatype.
+   * The background write requires a thread-safe HDF5 library and serial HDF5 I/O, otherwise dump stays synchronous.
+   */
+  void setWriteMode(bool single_precision, bool async);
+
+  /// wait for the background write and the pending sends of a previous dump
+  void wait();
+
 private:
   ///PooledData<T> is used to define the shape of multi-dimensional array
   using BufferType = PooledData<OHMMS_PRECISION>;
+  using SPBufferType = PooledData<float>;
   std::vector<Communicate::request> myRequest;
-  std::vector<BufferType*> RemoteData;
+  /** walker positions, [0] local walkers, [1,2] receive buffers of the master
+   *
+   * [1] holds all the walkers when the master writes on a background thread
+   */
+  std::array<BufferType, 3> RemoteData;
+  ///single precision copy of RemoteData
+  std::array<SPBufferType, 3> RemoteDataSP;
   int block;
+  ///store positions in single precision
+  bool single_precision_;
+  ///write on a background thread
+  bool async_;
+  ///background writer of the master
+  std::thread writer_;
+#if defined(HAVE_MPI)
+  ///sends of the local walkers to the master
+  std::vector<mpi3::request> send_requests_;
+#endif
 
   //     //define some types for the FW collection
   //     using FWBufferType = std::vector<ForwardWalkingData>;
@@ -70,6 +101,26 @@ private:
   //     std::vector<std::vector<int> > FWCountData;
 
   void write_configuration(const WalkerConfigurations& W, hdf_archive& hout, int block);
+
+  /** write the walker positions
+   * @param walker_offsets walker offsets of all the ranks
+   * @param local positions of the local walkers
+   * @param remote receive buffers of the master
+   *
+   * With serial I/O, the master receives the walkers of one rank while writing the previous one as a hyperslab.
+   * The other ranks post non-blocking sends and return.
+   */
+  template<typename BT>
+  void write_walkers(hdf_archive& hout, const std::vector<int>& walker_offsets, BT& local, BT* remote);
+
+  /** collect all the walker positions on the master
+   * @return the buffer holding all the walkers on the master
+   */
+  template<typename BT>
+  BT& gather_walkers(const std::vector<int>& walker_offsets, BT& local, BT& all);
+
+  /// copy the walker positions of the current block, in single precision if requested
+  void snapshot(const WalkerConfigurations& W, int block);
 };
 
 } // namespace qmcplusplus
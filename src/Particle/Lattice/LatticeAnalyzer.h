@@ -15,6 +15,8 @@
 
 #ifndef QMCPLUSPLUS_LATTICE_ANALYZER_H
 #define QMCPLUSPLUS_LATTICE_ANALYZER_H
+#include <cmath>
+#include <vector>
 #include "OhmmsPETE/TinyVector.h"
 namespace qmcplusplus
 {
@@ -264,5 +266,188 @@ inline void find_reduced_basis(TinyVector<TinyVector<T, 3>, 3>& rb)
                            "Check unit cell or contact a developer.");
 }
 
+/** find the vertices of the convex polytope {x | dot(normals[k], x) <= offsets[k]}
+ * @param normals unit normals of the planes
+ * @param offsets distances of the planes from the origin
+ * @param tol tolerance in length
+ *
+ * The vertices are the intersections of triples of planes satisfying all the constraints.
+ * Vertices shared by more than three planes appear multiple times.
+ */
+inline std::vector<TinyVector<double, 3>> find_polytope_vertices(const std::vector<TinyVector<double, 3>>& normals,
+                                                                 const std::vector<double>& offsets,
+                                                                 double tol)
+{
+  std::vector<TinyVector<double, 3>> vertices;
+  const int n = normals.size();
+  for (int a = 0; a < n; ++a)
+    for (int b = a + 1; b < n; ++b)
+    {
+      const TinyVector<double, 3> nab = cross(normals[a], normals[b]);
+      for (int c = b + 1; c < n; ++c)
+      {
+        const double det = dot(nab, normals[c]);
+        if (std::abs(det) < 1e-10)
+          continue;
+        const TinyVector<double, 3> x =
+            (offsets[a] * cross(normals[b], normals[c]) + offsets[b] * cross(normals[c], normals[a]) + offsets[c] * nab) /
+            det;
+        bool inside = true;
+        for (int k = 0; k < n && inside; ++k)
+          inside = dot(normals[k], x) <= offsets[k] + tol;
+        if (inside)
+          vertices.push_back(x);
+      }
+    }
+  return vertices;
+}
+
+/** return true if the convex polytope {x | dot(normals[k], x) <= offsets[k]} has a finite volume
+ *
+ * The mean of the vertices is strictly inside a polytope with a volume and on a plane otherwise.
+ */
+inline bool polytope_has_volume(const std::vector<TinyVector<double, 3>>& normals,
+                                const std::vector<double>& offsets,
+                                double tol)
+{
+  const auto vertices = find_polytope_vertices(normals, offsets, tol);
+  if (vertices.empty())
+    return false;
+  TinyVector<double, 3> center;
+  for (const auto& x : vertices)
+    center += x;
+  center /= vertices.size();
+  for (int k = 0; k < normals.size(); ++k)
+    if (dot(normals[k], center) > offsets[k] - tol)
+      return false;
+  return true;
+}
+
+/** find the lattice vectors whose Wigner-Seitz cells overlap a parallelepiped spanned by a reduced basis
+ * @param rb reduced basis
+ * @param shift the parallelepiped is {u_0 rb[0] + u_1 rb[1] + u_2 rb[2] | -shift <= u_i < 1 - shift}
+ * @param images lattice vectors t other than 0 such that x - t is the minimum image of x for some x in the parallelepiped
+ * @return false if the faces of the Wigner-Seitz cell are not found among the first neighbors of the basis
+ *
+ * The minimum image of a displacement reduced into the parallelepiped is found by checking only these images.
+ * The faces of the Wigner-Seitz cell are the planes bisecting the Voronoi relevant vectors,
+ * searched among the 26 vectors with the coefficients -1, 0, 1 in the reduced basis.
+ */
+template<typename T>
+bool find_wigner_seitz_images(const TinyVector<TinyVector<T, 3>, 3>& rb,
+                              T shift,
+                              std::vector<TinyVector<T, 3>>& images)
+{
+  using Vec = TinyVector<double, 3>;
+  TinyVector<Vec, 3> a;
+  double length = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    a[i] = rb[i];
+    length += std::sqrt(dot(a[i], a[i]));
+  }
+  const double tol = 1e-8 * length;
+  // reciprocal vectors, dot(a[i], g[j]) = delta_ij
+  const double volume = dot(a[0], cross(a[1], a[2]));
+  TinyVector<Vec, 3> g;
+  for (int j = 0; j < 3; ++j)
+    g[j] = cross(a[(j + 1) % 3], a[(j + 2) % 3]) / volume;
+  auto lattice_vector = [&a](int n0, int n1, int n2) -> Vec {
+    return static_cast<double>(n0) * a[0] + static_cast<double>(n1) * a[1] + static_cast<double>(n2) * a[2];
+  };
+  // the half space of the points closer to the origin than to t
+  auto add_bisector = [](const Vec& t, const Vec& origin, std::vector<Vec>& normals, std::vector<double>& offsets) {
+    const double tnorm = std::sqrt(dot(t, t));
+    normals.push_back(t / tnorm);
+    offsets.push_back(0.5 * tnorm + dot(origin, t) / tnorm);
+  };
+
+  // faces of the Wigner-Seitz cell
+  std::vector<Vec> neighbors;
+  for (int i = -1; i <= 1; ++i)
+    for (int j = -1; j <= 1; ++j)
+      for (int k = -1; k <= 1; ++k)
+        if (i != 0 || j != 0 || k != 0)
+          neighbors.push_back(lattice_vector(i, j, k));
+  std::vector<Vec> faces;
+  for (int iv = 0; iv < neighbors.size(); ++iv)
+  {
+    // a relevant vector removes a part of the cell bounded by the other ones
+    std::vector<Vec> normals;
+    std::vector<double> offsets;
+    for (int jv = 0; jv < neighbors.size(); ++jv)
+      if (jv != iv)
+        add_bisector(neighbors[jv], Vec(), normals, offsets);
+    add_bisector(neighbors[iv], Vec(), normals, offsets);
+    normals.back() *= -1.0;
+    offsets.back() *= -1.0;
+    if (polytope_has_volume(normals, offsets, tol))
+      faces.push_back(neighbors[iv]);
+  }
+
+  // the vertices of the cell must not be closer to the second neighbors
+  std::vector<Vec> ws_normals;
+  std::vector<double> ws_offsets;
+  for (const auto& v : faces)
+    add_bisector(v, Vec(), ws_normals, ws_offsets);
+  const auto ws_vertices = find_polytope_vertices(ws_normals, ws_offsets, tol);
+  double ws_radius = 0;
+  for (const auto& x : ws_vertices)
+  {
+    ws_radius = std::max(ws_radius, std::sqrt(dot(x, x)));
+    for (int i = -2; i <= 2; ++i)
+      for (int j = -2; j <= 2; ++j)
+        for (int k = -2; k <= 2; ++k)
+        {
+          const Vec t = lattice_vector(i, j, k);
+          if ((i != 0 || j != 0 || k != 0) && 2.0 * dot(x, t) > dot(t, t) + tol * length)
+            return false;
+        }
+  }
+
+  // the parallelepiped
+  std::vector<Vec> box_normals;
+  std::vector<double> box_offsets;
+  double box_radius = 0;
+  for (int j = 0; j < 3; ++j)
+  {
+    const double gnorm = std::sqrt(dot(g[j], g[j]));
+    box_normals.push_back(g[j] / gnorm);
+    box_offsets.push_back((1.0 - shift) / gnorm);
+    box_normals.push_back(g[j] / (-gnorm));
+    box_offsets.push_back(shift / gnorm);
+  }
+  for (int i = 0; i < 2; ++i)
+    for (int j = 0; j < 2; ++j)
+      for (int k = 0; k < 2; ++k)
+      {
+        const Vec corner = (i - static_cast<double>(shift)) * a[0] + (j - static_cast<double>(shift)) * a[1] +
+            (k - static_cast<double>(shift)) * a[2];
+        box_radius       = std::max(box_radius, std::sqrt(dot(corner, corner)));
+      }
+
+  // the Wigner-Seitz cell centered at t overlaps the parallelepiped only if |t| <= box_radius + ws_radius
+  const double tmax = box_radius + ws_radius;
+  TinyVector<int, 3> nmax;
+  for (int j = 0; j < 3; ++j)
+    nmax[j] = static_cast<int>(std::ceil(tmax * std::sqrt(dot(g[j], g[j]))));
+  images.clear();
+  for (int i = -nmax[0]; i <= nmax[0]; ++i)
+    for (int j = -nmax[1]; j <= nmax[1]; ++j)
+      for (int k = -nmax[2]; k <= nmax[2]; ++k)
+      {
+        const Vec t = lattice_vector(i, j, k);
+        if ((i == 0 && j == 0 && k == 0) || dot(t, t) > tmax * tmax)
+          continue;
+        std::vector<Vec> normals(box_normals);
+        std::vector<double> offsets(box_offsets);
+        for (const auto& v : faces)
+          add_bisector(v, t, normals, offsets);
+        if (polytope_has_volume(normals, offsets, tol))
+          images.push_back(TinyVector<T, 3>(t[0], t[1], t[2]));
+      }
+  return true;
+}
+
 } // namespace qmcplusplus
 #endif
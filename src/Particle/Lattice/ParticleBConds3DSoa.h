@@ -15,8 +15,10 @@
 
 #include <config.h>
 #include <algorithm>
+#include <vector>
 #include "CrystalLattice.h"
 #include "ParticleBConds.h"
+#include "Message/AppAbort.h"
 
 namespace qmcplusplus
 {
@@ -323,13 +325,26 @@ struct DTD_BConds<T, 3, PPPS + SOA_OFFSET>
  *
  * Wigner-Seitz cell radius > simulation cell radius
  * Need to check image cells
+ *
+ * A displacement is reduced into a parallelepiped of the reduced basis, either centered at the origin or
+ * cornered at the origin. Only the images whose Wigner-Seitz cells overlap the parallelepiped are checked,
+ * see find_wigner_seitz_images. The choice with fewer images is made at construction.
+ * The cornered parallelepiped needs the 7 other corners while the centered one needs 4 images for
+ * hexagonal and monoclinic cells.
 */
 template<class T>
 struct DTD_BConds<T, 3, PPPG + SOA_OFFSET>
 {
+  /// maximal number of images including the origin
+  static constexpr int MaxImages = 16;
   T g00, g10, g20, g01, g11, g21, g02, g12, g22;
   T r00, r10, r20, r01, r11, r21, r02, r12, r22;
-  TinyVector<TinyVector<T, 8>, 3> corners;
+  /// 0.5 for the centered parallelepiped, 0 for the cornered one
+  T shift;
+  /// number of images to check including the origin
+  int num_images;
+  /// lattice vectors of the images, the first is the origin
+  TinyVector<TinyVector<T, MaxImages>, 3> images;
 
   DTD_BConds(const CrystalLattice<T, 3>& lat)
   {
@@ -365,21 +380,24 @@ struct DTD_BConds<T, 3, PPPG + SOA_OFFSET>
     g12 = g(5);
     g22 = g(8);
 
-    constexpr T minusone(-1);
-    constexpr T zero(0);
+    std::vector<TinyVector<T, 3>> centered, cornered;
+    if (find_wigner_seitz_images(rb, T(0.5), centered) && find_wigner_seitz_images(rb, T(0), cornered) &&
+        std::min(centered.size(), cornered.size()) < MaxImages)
+      shift = centered.size() < cornered.size() ? T(0.5) : T(0);
+    else
+    {
+      // the corners of the parallelepiped
+      shift    = T(0);
+      cornered = {rb[0], rb[1], rb[2], rb[0] + rb[1], rb[0] + rb[2], rb[1] + rb[2], rb[0] + rb[1] + rb[2]};
+    }
+    const auto& selected = shift > T(0) ? centered : cornered;
 
+    num_images = selected.size() + 1;
     for (int idim = 0; idim < 3; idim++)
     {
-      auto& corners_dim = corners[idim];
-
-      corners_dim[0] = zero;
-      corners_dim[1] = minusone * (rb[0][idim]);
-      corners_dim[2] = minusone * (rb[1][idim]);
-      corners_dim[3] = minusone * (rb[2][idim]);
-      corners_dim[4] = minusone * (rb[0][idim] + rb[1][idim]);
-      corners_dim[5] = minusone * (rb[0][idim] + rb[2][idim]);
-      corners_dim[6] = minusone * (rb[1][idim] + rb[2][idim]);
-      corners_dim[7] = minusone * (rb[0][idim] + rb[1][idim] + rb[2][idim]);
+      images[idim][0] = T(0);
+      for (int c = 1; c < num_images; c++)
+        images[idim][c] = selected[c - 1][idim];
     }
   }
 
@@ -404,9 +422,9 @@ struct DTD_BConds<T, 3, PPPG + SOA_OFFSET>
     T* restrict dy = temp_dr.data(1);
     T* restrict dz = temp_dr.data(2);
 
-    const auto& cellx = corners[0];
-    const auto& celly = corners[1];
-    const auto& cellz = corners[2];
+    const auto& cellx = images[0];
+    const auto& celly = images[1];
+    const auto& cellz = images[2];
 
     constexpr T minusone(-1);
     constexpr T one(1);
@@ -418,9 +436,9 @@ struct DTD_BConds<T, 3, PPPG + SOA_OFFSET>
       const T displ_1 = (py[iat] - y0) * flip;
       const T displ_2 = (pz[iat] - z0) * flip;
 
-      const T ar_0 = -std::floor(displ_0 * g00 + displ_1 * g10 + displ_2 * g20);
-      const T ar_1 = -std::floor(displ_0 * g01 + displ_1 * g11 + displ_2 * g21);
-      const T ar_2 = -std::floor(displ_0 * g02 + displ_1 * g12 + displ_2 * g22);
+      const T ar_0 = -std::floor(displ_0 * g00 + displ_1 * g10 + displ_2 * g20 + shift);
+      const T ar_1 = -std::floor(displ_0 * g01 + displ_1 * g11 + displ_2 * g21 + shift);
+      const T ar_2 = -std::floor(displ_0 * g02 + displ_1 * g12 + displ_2 * g22 + shift);
 
       const T delx = displ_0 + ar_0 * r00 + ar_1 * r10 + ar_2 * r20;
       const T dely = displ_1 + ar_0 * r01 + ar_1 * r11 + ar_2 * r21;
@@ -428,21 +446,20 @@ struct DTD_BConds<T, 3, PPPG + SOA_OFFSET>
 
       T rmin = delx * delx + dely * dely + delz * delz;
       int ic = 0;
-#pragma unroll(7)
-      for (int c = 1; c < 8; ++c)
+      for (int c = 1; c < num_images; ++c)
       {
-        const T x  = delx + cellx[c];
-        const T y  = dely + celly[c];
-        const T z  = delz + cellz[c];
+        const T x  = delx - cellx[c];
+        const T y  = dely - celly[c];
+        const T z  = delz - cellz[c];
         const T r2 = x * x + y * y + z * z;
         ic         = (r2 < rmin) ? c : ic;
         rmin       = (r2 < rmin) ? r2 : rmin;
       }
 
       temp_r[iat] = std::sqrt(rmin);
-      dx[iat]     = flip * (delx + cellx[ic]);
-      dy[iat]     = flip * (dely + celly[ic]);
-      dz[iat]     = flip * (delz + cellz[ic]);
+      dx[iat]     = flip * (delx - cellx[ic]);
+      dy[iat]     = flip * (dely - celly[ic]);
+      dz[iat]     = flip * (delz - cellz[ic]);
     }
   }
 
@@ -467,9 +484,9 @@ struct DTD_BConds<T, 3, PPPG + SOA_OFFSET>
     T* restrict dy = temp_dr + padded_size;
     T* restrict dz = temp_dr + padded_size * 2;
 
-    const auto& cellx = corners[0];
-    const auto& celly = corners[1];
-    const auto& cellz = corners[2];
+    const auto& cellx = images[0];
+    const auto& celly = images[1];
+    const auto& cellz = images[2];
 
     constexpr T minusone(-1);
     constexpr T one(1);
@@ -479,9 +496,9 @@ struct DTD_BConds<T, 3, PPPG + SOA_OFFSET>
     const T displ_1 = (py[iat] - y0) * flip;
     const T displ_2 = (pz[iat] - z0) * flip;
 
-    const T ar_0 = -std::floor(displ_0 * g00 + displ_1 * g10 + displ_2 * g20);
-    const T ar_1 = -std::floor(displ_0 * g01 + displ_1 * g11 + displ_2 * g21);
-    const T ar_2 = -std::floor(displ_0 * g02 + displ_1 * g12 + displ_2 * g22);
+    const T ar_0 = -std::floor(displ_0 * g00 + displ_1 * g10 + displ_2 * g20 + shift);
+    const T ar_1 = -std::floor(displ_0 * g01 + displ_1 * g11 + displ_2 * g21 + shift);
+    const T ar_2 = -std::floor(displ_0 * g02 + displ_1 * g12 + displ_2 * g22 + shift);
 
     const T delx = displ_0 + ar_0 * r00 + ar_1 * r10 + ar_2 * r20;
     const T dely = displ_1 + ar_0 * r01 + ar_1 * r11 + ar_2 * r21;
@@ -489,44 +506,42 @@ struct DTD_BConds<T, 3, PPPG + SOA_OFFSET>
 
     T rmin = delx * delx + dely * dely + delz * delz;
     int ic = 0;
-#pragma unroll(7)
-    for (int c = 1; c < 8; ++c)
+    for (int c = 1; c < num_images; ++c)
     {
-      const T x  = delx + cellx[c];
-      const T y  = dely + celly[c];
-      const T z  = delz + cellz[c];
+      const T x  = delx - cellx[c];
+      const T y  = dely - celly[c];
+      const T z  = delz - cellz[c];
       const T r2 = x * x + y * y + z * z;
       ic         = (r2 < rmin) ? c : ic;
       rmin       = (r2 < rmin) ? r2 : rmin;
     }
 
     temp_r[iat] = std::sqrt(rmin);
-    dx[iat]     = flip * (delx + cellx[ic]);
-    dy[iat]     = flip * (dely + celly[ic]);
-    dz[iat]     = flip * (delz + cellz[ic]);
+    dx[iat]     = flip * (delx - cellx[ic]);
+    dy[iat]     = flip * (dely - celly[ic]);
+    dz[iat]     = flip * (delz - cellz[ic]);
   }
 
   T computeDist(T dx, T dy, T dz) const
   {
-    const auto& cellx = corners[0];
-    const auto& celly = corners[1];
-    const auto& cellz = corners[2];
+    const auto& cellx = images[0];
+    const auto& celly = images[1];
+    const auto& cellz = images[2];
 
-    const T ar_0 = -std::floor(dx * g00 + dy * g10 + dz * g20);
-    const T ar_1 = -std::floor(dx * g01 + dy * g11 + dz * g21);
-    const T ar_2 = -std::floor(dx * g02 + dy * g12 + dz * g22);
+    const T ar_0 = -std::floor(dx * g00 + dy * g10 + dz * g20 + shift);
+    const T ar_1 = -std::floor(dx * g01 + dy * g11 + dz * g21 + shift);
+    const T ar_2 = -std::floor(dx * g02 + dy * g12 + dz * g22 + shift);
 
     const T delx = dx + ar_0 * r00 + ar_1 * r10 + ar_2 * r20;
     const T dely = dy + ar_0 * r01 + ar_1 * r11 + ar_2 * r21;
     const T delz = dz + ar_0 * r02 + ar_1 * r12 + ar_2 * r22;
 
     T rmin = delx * delx + dely * dely + delz * delz;
-#pragma unroll(7)
-    for (int c = 1; c < 8; ++c)
+    for (int c = 1; c < num_images; ++c)
     {
-      const T x  = delx + cellx[c];
-      const T y  = dely + celly[c];
-      const T z  = delz + cellz[c];
+      const T x  = delx - cellx[c];
+      const T y  = dely - celly[c];
+      const T z  = delz - cellz[c];
       const T r2 = x * x + y * y + z * z;
       rmin       = (r2 < rmin) ? r2 : rmin;
     }
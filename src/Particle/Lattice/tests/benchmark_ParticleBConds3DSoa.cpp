@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** \file
+ *  This implements micro benchmarking of the minimum image distance kernels of periodic 3D cells.
+ *  Each lattice uses the DTD_BConds specialization selected by createDistanceTableAA/AB.
+ */
+
+#include "catch.hpp"
+
+#include <random>
+#include <sstream>
+#include "OhmmsSoA/VectorSoaContainer.h"
+#include "Lattice/CrystalLattice.h"
+#include "Lattice/ParticleBConds3DSoa.h"
+#include "Configuration.h"
+
+namespace qmcplusplus
+{
+using RealType = OHMMS_PRECISION;
+using vec_t    = TinyVector<RealType, 3>;
+
+template<int SC>
+void benchmarkDistances(const std::string& name, const CrystalLattice<RealType, 3>& lattice, int num_ptcls)
+{
+  const DTD_BConds<RealType, 3, SC + SOA_OFFSET> bconds(lattice);
+
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<RealType> unit(0.0, 1.0);
+  VectorSoaContainer<RealType, 3> R0(num_ptcls), temp_dr(num_ptcls);
+  for (int iat = 0; iat < num_ptcls; iat++)
+    R0(iat) = lattice.toCart(vec_t(unit(rng), unit(rng), unit(rng)));
+  aligned_vector<RealType> temp_r(num_ptcls);
+
+  std::ostringstream label;
+  label << name << " particles=" << num_ptcls;
+  BENCHMARK_ADVANCED(label.str())(Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&] {
+      // a row of the A-A table per particle
+      for (int iat = 0; iat < num_ptcls; iat++)
+        bconds.computeDistances(R0[iat], R0, temp_r.data(), temp_dr, 0, num_ptcls, iat);
+    });
+  };
+}
+
+CrystalLattice<RealType, 3> makeBenchmarkLattice(const vec_t& a0, const vec_t& a1, const vec_t& a2)
+{
+  CrystalLattice<RealType, 3> lattice;
+  lattice.BoxBConds = true; // periodic
+  for (int idim = 0; idim < 3; idim++)
+  {
+    lattice.R(0, idim) = a0[idim];
+    lattice.R(1, idim) = a1[idim];
+    lattice.R(2, idim) = a2[idim];
+  }
+  lattice.reset();
+  return lattice;
+}
+
+void benchmarkLatticeTypes(int num_ptcls)
+{
+  const auto orthorhombic = makeBenchmarkLattice(vec_t(10, 0, 0), vec_t(0, 11, 0), vec_t(0, 0, 12));
+  const auto hexagonal    = makeBenchmarkLattice(vec_t(10, 0, 0), vec_t(-5, 8.660254, 0), vec_t(0, 0, 16));
+  const auto monoclinic   = makeBenchmarkLattice(vec_t(10, 0, 0), vec_t(0, 12, 0), vec_t(-4, 0, 14));
+  const auto bcc          = makeBenchmarkLattice(vec_t(-5, 5, 5), vec_t(5, -5, 5), vec_t(5, 5, -5));
+  const auto triclinic    = makeBenchmarkLattice(vec_t(10, 0, 0), vec_t(1, 9, 0), vec_t(0.5, -0.5, 11));
+  REQUIRE(orthorhombic.DiagonalOnly);
+
+  benchmarkDistances<PPPO>("orthorhombic PPPO", orthorhombic, num_ptcls);
+  for (const auto& [name, lattice] :
+       {std::make_pair("hexagonal", hexagonal), std::make_pair("monoclinic", monoclinic), std::make_pair("bcc", bcc),
+        std::make_pair("triclinic", triclinic)})
+  {
+    REQUIRE(lattice.WignerSeitzRadius > lattice.SimulationCellRadius);
+    const DTD_BConds<RealType, 3, PPPG + SOA_OFFSET> bconds(lattice);
+    benchmarkDistances<PPPG>(std::string(name) + " PPPG images=" + std::to_string(bconds.num_images), lattice,
+                             num_ptcls);
+  }
+}
+
+/** This test will run by default.
+ */
+TEST_CASE("DTD_BConds distance benchmark small", "[lattice][benchmark]") { benchmarkLatticeTypes(64); }
+
+/** This and other [.benchmark] benchmarks only run if "[benchmark]" is explicitly passed as tag to test.
+ */
+TEST_CASE("DTD_BConds distance benchmark large", "[lattice][.benchmark]") { benchmarkLatticeTypes(1024); }
+
+} // namespace qmcplusplus
@@ -0,0 +1,157 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <random>
+#include "OhmmsSoA/VectorSoaContainer.h"
+#include "Lattice/CrystalLattice.h"
+#include "Lattice/ParticleBConds3DSoa.h"
+#include "Configuration.h"
+
+namespace qmcplusplus
+{
+using RealType = OHMMS_PRECISION;
+using vec_t    = TinyVector<RealType, 3>;
+
+CrystalLattice<RealType, 3> makePeriodicLattice(const vec_t& a0, const vec_t& a1, const vec_t& a2)
+{
+  CrystalLattice<RealType, 3> lattice;
+  lattice.BoxBConds = true; // periodic
+  for (int idim = 0; idim < 3; idim++)
+  {
+    lattice.R(0, idim) = a0[idim];
+    lattice.R(1, idim) = a1[idim];
+    lattice.R(2, idim) = a2[idim];
+  }
+  lattice.reset();
+  return lattice;
+}
+
+/// minimum image distance by searching the images of the neighboring cells of the input lattice vectors
+RealType bruteForceDistance(const CrystalLattice<RealType, 3>& lattice, const vec_t& displ)
+{
+  vec_t u = lattice.toUnit(displ);
+  for (int idim = 0; idim < 3; idim++)
+    u[idim] -= std::round(u[idim]);
+  const vec_t d = lattice.toCart(u);
+  RealType rmin = std::sqrt(dot(d, d));
+  for (int i = -3; i <= 3; i++)
+    for (int j = -3; j <= 3; j++)
+      for (int k = -3; k <= 3; k++)
+      {
+        const vec_t x = d + RealType(i) * lattice.a(0) + RealType(j) * lattice.a(1) + RealType(k) * lattice.a(2);
+        rmin          = std::min(rmin, std::sqrt(dot(x, x)));
+      }
+  return rmin;
+}
+
+/// check all the distance kernels of the general cell against the brute force search
+void checkGeneralCellDistances(const CrystalLattice<RealType, 3>& lattice)
+{
+  const DTD_BConds<RealType, 3, PPPG + SOA_OFFSET> bconds(lattice);
+
+  const int num_ptcls = 300;
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<RealType> unit(-2.0, 2.0);
+  VectorSoaContainer<RealType, 3> R0(num_ptcls), temp_dr(num_ptcls);
+  for (int iat = 0; iat < num_ptcls; iat++)
+    R0(iat) = lattice.toCart(vec_t(unit(rng), unit(rng), unit(rng)));
+  const vec_t pos = lattice.toCart(vec_t(unit(rng), unit(rng), unit(rng)));
+
+  std::vector<RealType> temp_r(num_ptcls), temp_r_offload(num_ptcls);
+  std::vector<RealType> temp_dr_offload(3 * num_ptcls);
+  const int flip_ind = num_ptcls / 2;
+  bconds.computeDistances(pos, R0, temp_r.data(), temp_dr, 0, num_ptcls, flip_ind);
+  for (int iat = 0; iat < num_ptcls; iat++)
+    bconds.computeDistancesOffload(pos.data(), R0.data(), R0.capacity(), temp_r_offload.data(), temp_dr_offload.data(),
+                                   num_ptcls, iat, flip_ind);
+
+  for (int iat = 0; iat < num_ptcls; iat++)
+  {
+    const vec_t displ = R0[iat] - pos;
+    const RealType r  = bruteForceDistance(lattice, displ);
+    CHECK(temp_r[iat] == Approx(r));
+    CHECK(temp_r_offload[iat] == Approx(r));
+    CHECK(bconds.computeDist(displ[0], displ[1], displ[2]) == Approx(r));
+
+    // the displacement is an image of R0[iat] - pos
+    const vec_t dr = temp_dr[iat];
+    CHECK(std::sqrt(dot(dr, dr)) == Approx(r));
+    const vec_t u = lattice.toUnit(dr - displ);
+    for (int idim = 0; idim < 3; idim++)
+    {
+      CHECK(u[idim] == Approx(std::round(u[idim])).margin(1e-4));
+      CHECK(temp_dr_offload[idim * num_ptcls + iat] == Approx(dr[idim]).margin(1e-5));
+    }
+  }
+}
+
+TEST_CASE("DTD_BConds PPPG hexagonal", "[lattice]")
+{
+  const RealType a = 3.2;
+  const auto lattice =
+      makePeriodicLattice(vec_t(a, 0, 0), vec_t(-0.5 * a, 0.5 * std::sqrt(3.0) * a, 0), vec_t(0, 0, 1.6 * a));
+  REQUIRE(lattice.WignerSeitzRadius > lattice.SimulationCellRadius);
+  // the centered cell only needs the images along the two shortest in-plane vectors
+  const DTD_BConds<RealType, 3, PPPG + SOA_OFFSET> bconds(lattice);
+  CHECK(bconds.shift == Approx(0.5));
+  CHECK(bconds.num_images == 5);
+  checkGeneralCellDistances(lattice);
+}
+
+TEST_CASE("DTD_BConds PPPG monoclinic", "[lattice]")
+{
+  const auto lattice = makePeriodicLattice(vec_t(5, 0, 0), vec_t(0, 6, 0), vec_t(-2, 0, 7));
+  const DTD_BConds<RealType, 3, PPPG + SOA_OFFSET> bconds(lattice);
+  CHECK(bconds.num_images == 5);
+  checkGeneralCellDistances(lattice);
+}
+
+TEST_CASE("DTD_BConds PPPG fcc and bcc", "[lattice]")
+{
+  const auto fcc = makePeriodicLattice(vec_t(0, 2, 2), vec_t(2, 0, 2), vec_t(2, 2, 0));
+  CHECK(DTD_BConds<RealType, 3, PPPG + SOA_OFFSET>(fcc).num_images == 7);
+  checkGeneralCellDistances(fcc);
+
+  // the corners of the cell are fewer than the images of the centered cell
+  const auto bcc = makePeriodicLattice(vec_t(-2, 2, 2), vec_t(2, -2, 2), vec_t(2, 2, -2));
+  const DTD_BConds<RealType, 3, PPPG + SOA_OFFSET> bconds(bcc);
+  CHECK(bconds.shift == Approx(0.0));
+  CHECK(bconds.num_images == 8);
+  checkGeneralCellDistances(bcc);
+}
+
+TEST_CASE("DTD_BConds PPPG triclinic", "[lattice]")
+{
+  checkGeneralCellDistances(makePeriodicLattice(vec_t(10, 0, 0), vec_t(1, 9, 0), vec_t(0.5, -0.5, 11)));
+  // a strongly skewed input basis, reduced internally
+  checkGeneralCellDistances(makePeriodicLattice(vec_t(4, 0, 0), vec_t(3.6, 1.2, 0), vec_t(0.8, 1.2, 3.2)));
+}
+
+TEST_CASE("find_wigner_seitz_images", "[lattice]")
+{
+  // a simple cubic lattice has no image overlapping the centered cell
+  TinyVector<TinyVector<double, 3>, 3> rb;
+  rb[0] = TinyVector<double, 3>(2, 0, 0);
+  rb[1] = TinyVector<double, 3>(0, 2, 0);
+  rb[2] = TinyVector<double, 3>(0, 0, 2);
+  std::vector<TinyVector<double, 3>> images;
+  REQUIRE(find_wigner_seitz_images(rb, 0.5, images));
+  CHECK(images.size() == 0);
+  // the cornered cell needs all its corners
+  REQUIRE(find_wigner_seitz_images(rb, 0.0, images));
+  CHECK(images.size() == 7);
+}
+
+} // namespace qmcplusplus
@@ -14,6 +14,7 @@
 
 
 #include "StructFact.h"
+#include <cassert>
 #include "CPU/math.hpp"
 #include "CPU/e2iphi.h"
 #include "CPU/SIMD/vmath.hpp"
@@ -29,6 +30,7 @@ StructFact::StructFact(const ParticleLayout& lattice, const KContainer& k_lists)
     : SuperCellEnum(SUPERCELL_BULK),
       k_lists_(k_lists),
       StorePerParticle(false),
+      num_incremental_updates_(0),
       update_all_timer_(*timer_manager.createTimer("StructFact::update_all_part", timer_level_fine))
 {
   if (lattice.SuperCellEnum == SUPERCELL_SLAB)
@@ -56,7 +58,109 @@ void StructFact::resize(int nkpts, int num_species, int num_ptcls)
 void StructFact::updateAllPart(const ParticleSet& P)
 {
   ScopedTimer local(update_all_timer_);
-  computeRhok(P);
+  updateRhok(P);
+}
+
+void StructFact::acceptMove(int iat, int gid, const PosType& newpos)
+{
+  // rhok has not been computed yet. updateAllPart will do it.
+  if (rhok_pos_.empty())
+    return;
+
+  const PosType oldpos         = rhok_pos_[iat];
+  const size_t nk              = k_lists_.numk;
+  const size_t num_kblocks     = (nk + kblock_size - 1) / kblock_size;
+  auto* restrict rhok_r_ptr    = rhok_r[gid];
+  auto* restrict rhok_i_ptr    = rhok_i[gid];
+  RealType old_r[kblock_size], old_i[kblock_size], new_r[kblock_size], new_i[kblock_size];
+
+  for (int ib = 0; ib < num_kblocks; ib++)
+  {
+    const size_t offset          = ib * kblock_size;
+    const size_t this_block_size = std::min(kblock_size, nk - offset);
+    RealType* restrict eikr_old_r = old_r;
+    RealType* restrict eikr_old_i = old_i;
+    RealType* restrict eikr_new_r = new_r;
+    RealType* restrict eikr_new_i = new_i;
+    if (StorePerParticle)
+    {
+      eikr_old_r = eikr_r[iat] + offset;
+      eikr_old_i = eikr_i[iat] + offset;
+    }
+    else
+      evalPhases(oldpos, offset, this_block_size, eikr_old_r, eikr_old_i);
+    evalPhases(newpos, offset, this_block_size, eikr_new_r, eikr_new_i);
+
+#pragma omp simd
+    for (int ki = 0; ki < this_block_size; ki++)
+    {
+      rhok_r_ptr[ki + offset] += eikr_new_r[ki] - eikr_old_r[ki];
+      rhok_i_ptr[ki + offset] += eikr_new_i[ki] - eikr_old_i[ki];
+    }
+
+    if (StorePerParticle)
+    {
+      std::copy_n(eikr_new_r, this_block_size, eikr_old_r);
+      std::copy_n(eikr_new_i, this_block_size, eikr_old_i);
+    }
+  }
+
+  rhok_pos_[iat] = newpos;
+  num_incremental_updates_++;
+}
+
+void StructFact::updateRhok(const ParticleSet& P)
+{
+  const size_t num_ptcls = P.getTotalNum();
+  if (rhok_pos_.size() != num_ptcls || rhok_r.rows() != P.groups())
+  {
+    computeRhok(P);
+    return;
+  }
+
+  std::vector<int> moved;
+  for (int iat = 0; iat < num_ptcls; iat++)
+    if (rhok_pos_[iat] != P.R[iat])
+      moved.push_back(iat);
+
+  // an incremental update evaluates the old and new phases of a moved particle, unless old ones are stored,
+  // while computing from the start evaluates the phases of every particle once.
+  const size_t incremental_cost = StorePerParticle ? moved.size() : 2 * moved.size();
+  if (incremental_cost >= num_ptcls || num_incremental_updates_ + moved.size() > max_incremental_sweeps * num_ptcls)
+    computeRhok(P);
+  else
+    for (const int iat : moved)
+      acceptMove(iat, P.getGroupID(iat), P.R[iat]);
+}
+
+void StructFact::evalPhases(const PosType& pos,
+                            size_t offset,
+                            size_t block_size,
+                            RealType* restrict phase_r,
+                            RealType* restrict phase_i) const
+{
+  assert(block_size <= kblock_size);
+  const auto& kpts_cart = k_lists_.get_kpts_cart_soa();
+#if defined(__INTEL_COMPILER) || defined(__INTEL_LLVM_COMPILER)
+  const RealType* restrict kx = kpts_cart.data(0) + offset;
+  const RealType* restrict ky = kpts_cart.data(1) + offset;
+  const RealType* restrict kz = kpts_cart.data(2) + offset;
+#pragma omp simd
+  for (int ki = 0; ki < block_size; ki++)
+    qmcplusplus::sincos(kx[ki] * pos[0] + ky[ki] * pos[1] + kz[ki] * pos[2], &phase_i[ki], &phase_r[ki]);
+#else
+  RealType phiV[kblock_size];
+  std::fill_n(phiV, block_size, RealType(0));
+  for (int idim = 0; idim < DIM; idim++)
+  {
+    const RealType* restrict k_ptr = kpts_cart.data(idim) + offset;
+    const RealType r               = pos[idim];
+#pragma omp simd
+    for (int ki = 0; ki < block_size; ki++)
+      phiV[ki] += k_ptr[ki] * r;
+  }
+  eval_e2iphi(block_size, phiV, phase_r, phase_i);
+#endif
 }
 
 void StructFact::mw_updateAllPart(const RefVectorWithLeader<StructFact>& sk_list,
@@ -67,8 +171,11 @@ void StructFact::mw_updateAllPart(const RefVectorWithLeader<StructFact>& sk_list
   auto& p_leader  = p_list.getLeader();
   ScopedTimer local(sk_leader.update_all_timer_);
   if (p_leader.getCoordinates().getKind() != DynamicCoordinateKind::DC_POS_OFFLOAD || sk_leader.StorePerParticle)
+  {
+#pragma omp parallel for
     for (int iw = 0; iw < sk_list.size(); iw++)
-      sk_list[iw].computeRhok(p_list[iw]);
+      sk_list[iw].updateRhok(p_list[iw]);
+  }
   else
   {
     const size_t nw          = p_list.size();
@@ -128,6 +235,12 @@ void StructFact::mw_updateAllPart(const RefVectorWithLeader<StructFact>& sk_list
         std::copy_n(mw_mem.nw_rhok[(iw * num_species + is) * cplx_stride], nk, sk_list[iw].rhok_r[is]);
         std::copy_n(mw_mem.nw_rhok[(iw * num_species + is) * cplx_stride + 1], nk, sk_list[iw].rhok_i[is]);
       }
+
+    for (int iw = 0; iw < nw; iw++)
+    {
+      sk_list[iw].rhok_pos_.assign(p_list[iw].R.begin(), p_list[iw].R.end());
+      sk_list[iw].num_incremental_updates_ = 0;
+    }
   }
 }
 
@@ -143,64 +256,33 @@ void StructFact::computeRhok(const ParticleSet& P)
 
   rhok_r = 0.0;
   rhok_i = 0.0;
-  if (StorePerParticle)
+  // make the compute over nk by blocks
+  const size_t num_kblocks = (nk + kblock_size - 1) / kblock_size;
+  RealType eikr_r_temp[kblock_size], eikr_i_temp[kblock_size];
+  for (int i = 0; i < num_ptcls; ++i)
   {
-    // save per particle and species value
-    for (int i = 0; i < num_ptcls; ++i)
+    const auto& pos           = P.R[i];
+    auto* restrict rhok_r_ptr = rhok_r[P.getGroupID(i)];
+    auto* restrict rhok_i_ptr = rhok_i[P.getGroupID(i)];
+    for (int ib = 0; ib < num_kblocks; ib++)
     {
-      const auto& pos           = P.R[i];
-      auto* restrict eikr_r_ptr = eikr_r[i];
-      auto* restrict eikr_i_ptr = eikr_i[i];
-      auto* restrict rhok_r_ptr = rhok_r[P.getGroupID(i)];
-      auto* restrict rhok_i_ptr = rhok_i[P.getGroupID(i)];
+      const size_t offset          = ib * kblock_size;
+      const size_t this_block_size = std::min(kblock_size, nk - offset);
+      // save per particle and species value or only per species value
+      auto* restrict eikr_r_ptr = StorePerParticle ? eikr_r[i] + offset : eikr_r_temp;
+      auto* restrict eikr_i_ptr = StorePerParticle ? eikr_i[i] + offset : eikr_i_temp;
+      evalPhases(pos, offset, this_block_size, eikr_r_ptr, eikr_i_ptr);
 #pragma omp simd
-      for (int ki = 0; ki < nk; ki++)
+      for (int ki = 0; ki < this_block_size; ki++)
       {
-        qmcplusplus::sincos(dot(k_lists_.kpts_cart[ki], pos), &eikr_i_ptr[ki], &eikr_r_ptr[ki]);
-        rhok_r_ptr[ki] += eikr_r_ptr[ki];
-        rhok_i_ptr[ki] += eikr_i_ptr[ki];
+        rhok_r_ptr[ki + offset] += eikr_r_ptr[ki];
+        rhok_i_ptr[ki + offset] += eikr_i_ptr[ki];
       }
     }
   }
-  else
-  {
-    // save per species value
-    for (int i = 0; i < num_ptcls; ++i)
-    {
-      const auto& pos           = P.R[i];
-      auto* restrict rhok_r_ptr = rhok_r[P.getGroupID(i)];
-      auto* restrict rhok_i_ptr = rhok_i[P.getGroupID(i)];
-#if defined(__INTEL_COMPILER) || defined(__INTEL_LLVM_COMPILER)
-#pragma omp simd
-      for (int ki = 0; ki < nk; ki++)
-      {
-        RealType s, c;
-        qmcplusplus::sincos(dot(k_lists_.kpts_cart[ki], pos), &s, &c);
-        rhok_r_ptr[ki] += c;
-        rhok_i_ptr[ki] += s;
-      }
-#else
-      // make the compute over nk by blocks
-      constexpr size_t kblock_size = 512;
-      const size_t num_kblocks     = (nk + kblock_size) / kblock_size;
-      RealType phiV[kblock_size], eikr_r_temp[kblock_size], eikr_i_temp[kblock_size];
 
-      for (int ib = 0; ib < num_kblocks; ib++)
-      {
-        const size_t offset          = ib * kblock_size;
-        const size_t this_block_size = std::min(kblock_size, nk - offset);
-        for (int ki = 0; ki < this_block_size; ki++)
-          phiV[ki] = dot(k_lists_.kpts_cart[ki + offset], pos);
-        eval_e2iphi(this_block_size, phiV, eikr_r_temp, eikr_i_temp);
-        for (int ki = 0; ki < this_block_size; ki++)
-        {
-          rhok_r_ptr[ki + offset] += eikr_r_temp[ki];
-          rhok_i_ptr[ki + offset] += eikr_i_temp[ki];
-        }
-      }
-#endif
-    }
-  }
+  rhok_pos_.assign(P.R.begin(), P.R.end());
+  num_incremental_updates_ = 0;
 }
 
 void StructFact::turnOnStorePerParticle(const ParticleSet& P)
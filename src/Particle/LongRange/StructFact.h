@@ -55,9 +55,20 @@ public:
   ~StructFact();
 
   /**  Update Rhok if all particles moved
+   *
+   * Only the particles which moved since the last update are accounted for incrementally
+   * when it is cheaper than recomputing all the particles from scratch.
    */
   void updateAllPart(const ParticleSet& P);
 
+  /** Update Rhok and eikr after the move of particle iat is accepted.
+   * Both the old and new phases of iat are evaluated unless eikr is stored per particle.
+   * @param iat the moved particle
+   * @param gid the group of iat
+   * @param newpos the new position of iat
+   */
+  void acceptMove(int iat, int gid, const PosType& newpos);
+
   static void mw_updateAllPart(const RefVectorWithLeader<StructFact>& sk_list,
                                const RefVectorWithLeader<ParticleSet>& p_list,
                                SKMultiWalkerMem& mw_mem);
@@ -71,9 +82,23 @@ public:
   /// accessor of StorePerParticle
   bool isStorePerParticle() const { return StorePerParticle; }
 
+  /// k-vectors are processed by blocks of this size
+  static constexpr size_t kblock_size = 512;
+  /// incremental updates of rhok are allowed up to this many sweeps before rhok is computed from the start
+  static constexpr size_t max_incremental_sweeps = 32;
+
 private:
   /// Compute all rhok elements from the start
   void computeRhok(const ParticleSet& P);
+  /// Bring rhok up to date with P either incrementally or from the start whichever is cheaper
+  void updateRhok(const ParticleSet& P);
+  /** evaluate e^{i k.r} for a block of k-vectors using the SoA layout of the k-vectors
+   * @param pos position r
+   * @param offset the first k-vector of the block
+   * @param block_size number of k-vectors in the block, no larger than kblock_size
+   */
+  void evalPhases(const PosType& pos, size_t offset, size_t block_size, RealType* restrict phase_r, RealType* restrict phase_i)
+      const;
   /** resize the internal data
    * @param nkpts
    * @param num_species number of species
@@ -88,6 +113,10 @@ private:
    * storing data per particle specie is more cost-effective
    */
   bool StorePerParticle;
+  /// particle positions currently accounted for in rhok and eikr
+  std::vector<PosType> rhok_pos_;
+  /// number of particle updates done incrementally since rhok was computed from the start
+  size_t num_incremental_updates_;
   /// timer for updateAllPart
   NewTimer& update_all_timer_;
 };
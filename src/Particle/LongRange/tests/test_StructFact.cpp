@@ -70,4 +70,66 @@ TEST_CASE("StructFact", "[lrhandler]")
   }
 }
 
+/** rhok kept up to date by incremental updates must agree with the one computed from scratch
+ */
+TEST_CASE("StructFact incremental update", "[lrhandler]")
+{
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> Lattice;
+  Lattice.BoxBConds     = true;
+  Lattice.LR_dim_cutoff = 15.;
+  Lattice.R.diagonal(5.0);
+  Lattice.reset();
+
+  const SimulationCell simulation_cell(Lattice);
+  const auto& klists = simulation_cell.getKLists();
+  REQUIRE(klists.numk > 0);
+
+  for (const bool per_particle : {false, true})
+  {
+    ParticleSet elec(simulation_cell);
+    SpeciesSet& tspecies = elec.getSpeciesSet();
+    tspecies.addSpecies("u");
+    tspecies.addSpecies("d");
+    elec.create({4, 4});
+    for (int iat = 0; iat < elec.getTotalNum(); iat++)
+      elec.R[iat] = {0.3 * iat, 4.9 - 0.6 * iat, 0.7 * iat * iat};
+    elec.createSK();
+    if (per_particle)
+      elec.turnOnPerParticleSK();
+    elec.update();
+
+    // accept a few single particle moves. rhok is updated on the fly only if eikr is stored per particle.
+    // otherwise, few enough particles moved for donePbyP to update rhok incrementally.
+    for (int iat = 0; iat < elec.getTotalNum(); iat++)
+    {
+      elec.makeMove(iat, {0.1 * iat, -0.2, 0.05 * iat});
+      if (iat % 3 == 1)
+        elec.acceptMove(iat);
+      else
+        elec.rejectMove(iat);
+    }
+    elec.donePbyP();
+
+    StructFact sk_ref(elec.getLRBox(), klists);
+    if (per_particle)
+      sk_ref.turnOnStorePerParticle(elec);
+    sk_ref.updateAllPart(elec);
+
+    const StructFact& sk = elec.getSK();
+    for (int is = 0; is < elec.groups(); is++)
+      for (int ik = 0; ik < klists.numk; ik++)
+      {
+        CHECK(sk.rhok_r[is][ik] == Approx(sk_ref.rhok_r[is][ik]).margin(1e-5));
+        CHECK(sk.rhok_i[is][ik] == Approx(sk_ref.rhok_i[is][ik]).margin(1e-5));
+      }
+    if (per_particle)
+      for (int iat = 0; iat < elec.getTotalNum(); iat++)
+        for (int ik = 0; ik < klists.numk; ik++)
+        {
+          CHECK(sk.eikr_r[iat][ik] == Approx(sk_ref.eikr_r[iat][ik]).margin(1e-5));
+          CHECK(sk.eikr_i[iat][ik] == Approx(sk_ref.eikr_i[iat][ik]).margin(1e-5));
+        }
+  }
+}
+
 } // namespace qmcplusplus
@@ -68,6 +68,7 @@ ParticleSet::ParticleSet(const SimulationCell& simulation_cell, const DynamicCoo
       simulation_cell_(simulation_cell),
       same_mass_(true),
       is_spinor_(false),
+      neighbor_cutoff_(0),
       active_ptcl_(-1),
       active_spin_val_(0.0),
       myTwist(0.0),
@@ -85,6 +86,7 @@ ParticleSet::ParticleSet(const ParticleSet& p)
       simulation_cell_(p.simulation_cell_),
       same_mass_(true),
       is_spinor_(false),
+      neighbor_cutoff_(0),
       active_ptcl_(-1),
       active_spin_val_(0.0),
       my_species_(p.getSpeciesSet()),
@@ -96,11 +98,12 @@ ParticleSet::ParticleSet(const ParticleSet& p)
   setQuantumDomain(p.quantum_domain);
 
   resize(p.getTotalNum());
-  R.InUnit   = p.R.InUnit;
-  R          = p.R;
-  spins      = p.spins;
-  GroupID    = p.GroupID;
-  is_spinor_ = p.is_spinor_;
+  R.InUnit         = p.R.InUnit;
+  R                = p.R;
+  spins            = p.spins;
+  GroupID          = p.GroupID;
+  is_spinor_       = p.is_spinor_;
+  neighbor_cutoff_ = p.neighbor_cutoff_;
 
   //need explicit copy:
   Mass = p.Mass;
@@ -663,6 +666,8 @@ void ParticleSet::acceptMove(Index_t iat)
   coordinates_->setOneParticlePos(active_pos_, iat);
   for (int i = 0; i < DistTables.size(); i++)
     DistTables[i]->update(iat);
+  if (structure_factor_ && structure_factor_->isStorePerParticle())
+    structure_factor_->acceptMove(iat, GroupID[iat], active_pos_);
 
   R[iat]       = active_pos_;
   spins[iat]   = active_spin_val_;
@@ -677,6 +682,8 @@ void ParticleSet::acceptMoveForwardMode(Index_t iat)
   coordinates_->setOneParticlePos(active_pos_, iat);
   for (int i = 0; i < DistTables.size(); i++)
     DistTables[i]->updatePartial(iat, true);
+  if (structure_factor_ && structure_factor_->isStorePerParticle())
+    structure_factor_->acceptMove(iat, GroupID[iat], active_pos_);
 
   R[iat]       = active_pos_;
   spins[iat]   = active_spin_val_;
@@ -750,6 +757,14 @@ void ParticleSet::mw_accept_rejectMove(const RefVectorWithLeader<ParticleSet>& p
       dts[i]->mw_updatePartial(dt_list, iat, isAccepted);
     }
 
+    if (p_leader.structure_factor_ && p_leader.structure_factor_->isStorePerParticle())
+    {
+#pragma omp parallel for
+      for (int iw = 0; iw < p_list.size(); iw++)
+        if (isAccepted[iw])
+          p_list[iw].structure_factor_->acceptMove(iat, p_list[iw].GroupID[iat], p_list[iw].active_pos_);
+    }
+
     for (int iw = 0; iw < p_list.size(); iw++)
     {
       assert(iat == p_list[iw].active_ptcl_);
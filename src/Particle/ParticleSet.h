@@ -250,6 +250,12 @@ public:
   inline bool isSameMass() const { return same_mass_; }
   inline bool isSpinor() const { return is_spinor_; }
   inline void setSpinor(bool is_spinor) { is_spinor_ = is_spinor; }
+  /// return the cutoff of the neighbor lists of the A-A distance table, 0 for the dense table
+  inline RealType getNeighborCutoff() const { return neighbor_cutoff_; }
+  /** request a cell-list A-A distance table keeping only the pairs within cutoff during single particle moves.
+   *  Must be set before the A-A distance table is added.
+   */
+  inline void setNeighborCutoff(RealType cutoff) { neighbor_cutoff_ = cutoff; }
 
   /// return active particle id
   inline Index_t getActivePtcl() const { return active_ptcl_; }
@@ -585,6 +591,8 @@ protected:
   bool same_mass_;
   ///true is a dynamic spin calculation
   bool is_spinor_;
+  ///cutoff of the neighbor lists of the A-A distance table, 0 for the dense table
+  RealType neighbor_cutoff_;
   /** the index of the active particle during particle-by-particle moves
    *
    * when a single particle move is proposed, the particle id is assigned to active_ptcl_
@@ -117,6 +117,7 @@ bool ParticleSetPool::put(xmlNodePtr cur)
   std::string randomsrc;
   std::string useGPU;
   std::string spinor;
+  ParticleSet::RealType neighbor_cutoff(0);
   OhmmsAttributeSet pAttrib;
   pAttrib.add(id, "id");
   pAttrib.add(id, "name");
@@ -125,6 +126,7 @@ bool ParticleSetPool::put(xmlNodePtr cur)
   pAttrib.add(randomsrc, "randomsrc");
   pAttrib.add(randomsrc, "random_source");
   pAttrib.add(spinor, "spinor", {"no", "yes"});
+  pAttrib.add(neighbor_cutoff, "neighbor_cutoff");
   pAttrib.add(useGPU, "gpu", CPUOMPTargetSelector::candidate_values);
   pAttrib.put(cur);
   //backward compatibility
@@ -168,6 +170,7 @@ bool ParticleSetPool::put(xmlNodePtr cur)
     }
     pTemp->setName(id);
     pTemp->setSpinor(spinor == "yes");
+    pTemp->setNeighborCutoff(neighbor_cutoff);
     app_summary() << "  Particle set size: " << pTemp->getTotalNum() << "   Groups : " << pTemp->groups() << std::endl;
     app_summary() << std::endl;
     return true;
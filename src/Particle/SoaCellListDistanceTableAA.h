@@ -0,0 +1,279 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_DTDIMPL_AA_CELLLIST_H
+#define QMCPLUSPLUS_DTDIMPL_AA_CELLLIST_H
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "SoaDistanceTableAA.h"
+#include "OhmmsPETE/OhmmsMatrix.h"
+
+namespace qmcplusplus
+{
+/**@ingroup nnlist
+ * @brief A-A distance table with a linked-cell spatial index for short ranged consumers in large periodic cells
+ *
+ * The simulation cell is divided along each lattice vector into cells not thinner than the neighbor cutoff
+ * so that all the pairs within the cutoff of a particle are found in the surrounding 3^D cells.
+ * During particle-by-particle moves, move() only computes the distances to the particles of those cells and
+ * keeps the pairs within the cutoff in the neighbor lists of DistanceTableAA. The cost of a move scales with the
+ * number of neighbors instead of the number of particles. The temp and old rows are not set up and
+ * update() only moves the particle to its new cell.
+ * The full table is recomputed by evaluate() and at finalizePbyP, so the consumers of the full table after
+ * donePbyP, e.g. Coulomb potentials, are unaffected. If DTModes::NEED_FULL_TABLE_ANYTIME is requested, the dense
+ * rows are kept up to date as well and only the saving of the move is lost.
+ */
+template<typename T, unsigned D, int SC>
+struct SoaCellListDistanceTableAA : public SoaDistanceTableAA<T, D, SC>
+{
+  using Base = SoaDistanceTableAA<T, D, SC>;
+  using typename Base::DisplRow;
+  using typename Base::DistRow;
+  using typename Base::IndexType;
+  using typename Base::PosType;
+  using typename Base::RealType;
+
+  SoaCellListDistanceTableAA(ParticleSet& target) : Base(target), lattice_(target.getLattice())
+  {
+    const RealType cutoff = target.getNeighborCutoff();
+    if (cutoff <= 0 || cutoff > lattice_.SimulationCellRadius)
+      throw std::runtime_error("SoaCellListDistanceTableAA the neighbor cutoff " + std::to_string(cutoff) +
+                               " must be positive and not larger than the simulation cell radius " +
+                               std::to_string(lattice_.SimulationCellRadius));
+    this->neighbor_cutoff_ = cutoff;
+
+    // the width of the cell along lattice vector d is 1/|b_d|
+    int num_cells = 1;
+    for (int d = 0; d < D; ++d)
+    {
+      num_cells_[d] = std::max(1, static_cast<int>(std::floor(1.0 / (std::sqrt(dot(lattice_.Gv[d], lattice_.Gv[d])) *
+                                                                     cutoff))));
+      num_cells *= num_cells_[d];
+    }
+    buildStencils(num_cells);
+
+    const int N = this->num_targets_;
+    cell_head_.resize(num_cells, -1);
+    next_in_cell_.resize(N, -1);
+    cell_of_.resize(N, -1);
+    cand_ids_.resize(N);
+    cand_pos_.resize(N);
+    cand_r_.resize(N);
+    cand_dr_.resize(N);
+    this->temp_nb_ids_.reserve(N);
+    this->temp_nb_r_.resize(N);
+    this->temp_nb_dr_.resize(N);
+    this->old_nb_ids_.reserve(N);
+    this->old_nb_r_.resize(N);
+    this->old_nb_dr_.resize(N);
+  }
+
+  inline void evaluate(ParticleSet& P) override { rebuild(P); }
+
+  /// refresh the full table and the cells after particle-by-particle moves
+  void finalizePbyP(const ParticleSet& P) override { rebuild(P); }
+
+  ///evaluate the pairs within the cutoff of the proposed position
+  inline void move(const ParticleSet& P, const PosType& rnew, const IndexType iat, bool prepare_old) override
+  {
+    if (this->modes_ & DTModes::NEED_FULL_TABLE_ANYTIME)
+      Base::move(P, rnew, iat, prepare_old);
+
+    ScopedTimer local_timer(this->move_timer_);
+    temp_cell_ = findCell(rnew);
+    // like the temp row, the current position of iat is a candidate
+    collectNeighbors(P, rnew, temp_cell_, -1, this->temp_nb_ids_, this->temp_nb_r_, this->temp_nb_dr_);
+    if (prepare_old)
+      collectNeighbors(P, P.R[iat], cell_of_[iat], iat, this->old_nb_ids_, this->old_nb_r_, this->old_nb_dr_);
+  }
+
+  int get_first_neighbor(IndexType iat, RealType& r, PosType& dr, bool newpos) const override
+  {
+    if (!newpos)
+      return Base::get_first_neighbor(iat, r, dr, newpos);
+
+    RealType min_dist = std::numeric_limits<RealType>::max();
+    int index         = -1;
+    for (int k = 0; k < this->temp_nb_ids_.size(); ++k)
+      if (this->temp_nb_r_[k] < min_dist && this->temp_nb_ids_[k] != iat)
+      {
+        min_dist = this->temp_nb_r_[k];
+        index    = k;
+      }
+    if (index < 0)
+      return -1;
+    r  = min_dist;
+    dr = this->temp_nb_dr_[index];
+    return this->temp_nb_ids_[index];
+  }
+
+  inline void update(IndexType iat) override
+  {
+    if (this->modes_ & DTModes::NEED_FULL_TABLE_ANYTIME)
+      Base::update(iat);
+    ScopedTimer local_timer(this->update_timer_);
+    moveToCell(iat, temp_cell_);
+  }
+
+  void updatePartial(IndexType jat, bool from_temp) override
+  {
+    if (this->modes_ & DTModes::NEED_FULL_TABLE_ANYTIME)
+      Base::updatePartial(jat, from_temp);
+    if (from_temp)
+    {
+      ScopedTimer local_timer(this->update_timer_);
+      moveToCell(jat, temp_cell_);
+    }
+  }
+
+private:
+  /// lattice of the simulation cell
+  const typename ParticleSet::ParticleLayout& lattice_;
+  /// number of cells along each lattice vector
+  TinyVector<int, D> num_cells_;
+  /// cell_stencil_(c, :) are the distinct cells surrounding cell c, c included
+  Matrix<int> cell_stencil_;
+  /// first particle of each cell, -1 for an empty cell
+  std::vector<int> cell_head_;
+  /// next particle in the same cell, -1 for the last one
+  std::vector<int> next_in_cell_;
+  /// cell of each particle
+  std::vector<int> cell_of_;
+  /// cell of the proposed position of the last move
+  int temp_cell_ = -1;
+  /// ids, positions, distances and displacements of the particles in the stencil of a move
+  std::vector<int> cand_ids_;
+  VectorSoaContainer<RealType, D> cand_pos_;
+  DistRow cand_r_;
+  DisplRow cand_dr_;
+
+  /// compute the full table and sort the particles into cells
+  void rebuild(const ParticleSet& P)
+  {
+    {
+      ScopedTimer local_timer(this->evaluate_timer_);
+      for (int iat = 1; iat < this->num_targets_; ++iat)
+        DTD_BConds<T, D, SC>::computeDistances(P.R[iat], P.getCoordinates().getAllParticlePos(),
+                                               this->distances_[iat].data(), this->displacements_[iat], 0, iat, iat);
+    }
+    std::fill(cell_head_.begin(), cell_head_.end(), -1);
+    for (int iat = this->num_targets_ - 1; iat >= 0; --iat)
+    {
+      const int cell     = findCell(P.R[iat]);
+      cell_of_[iat]      = cell;
+      next_in_cell_[iat] = cell_head_[cell];
+      cell_head_[cell]   = iat;
+    }
+  }
+
+  /// cell index of a position, the position is wrapped into the cell
+  int findCell(const PosType& pos) const
+  {
+    const PosType u = lattice_.toUnit(pos);
+    int cell        = 0;
+    for (int d = 0; d < D; ++d)
+    {
+      const int ic = static_cast<int>(std::floor((u[d] - std::floor(u[d])) * num_cells_[d]));
+      // guard u[d] - floor(u[d]) rounding to 1
+      cell = cell * num_cells_[d] + std::min(std::max(ic, 0), num_cells_[d] - 1);
+    }
+    return cell;
+  }
+
+  /// compute the surrounding cells of all the cells, periodic images of the same cell are counted once
+  void buildStencils(int num_cells)
+  {
+    std::vector<std::vector<int>> stencils(num_cells);
+    for (int cell = 0; cell < num_cells; ++cell)
+    {
+      std::vector<int>& stencil = stencils[cell];
+      stencil.assign(1, 0);
+      for (int d = 0, stride = num_cells; d < D; ++d)
+      {
+        stride /= num_cells_[d];
+        const int ic = (cell / stride) % num_cells_[d];
+        std::vector<int> nb_d;
+        for (int offset = -1; offset <= 1; ++offset)
+        {
+          const int jc = (ic + offset + num_cells_[d]) % num_cells_[d];
+          if (std::find(nb_d.begin(), nb_d.end(), jc) == nb_d.end())
+            nb_d.push_back(jc);
+        }
+        std::vector<int> expanded;
+        for (const int partial : stencil)
+          for (const int jc : nb_d)
+            expanded.push_back(partial * num_cells_[d] + jc);
+        stencil.swap(expanded);
+      }
+    }
+    cell_stencil_.resize(num_cells, stencils[0].size());
+    for (int cell = 0; cell < num_cells; ++cell)
+      std::copy(stencils[cell].begin(), stencils[cell].end(), cell_stencil_[cell]);
+  }
+
+  /// move a particle from its cell to a new one
+  void moveToCell(int iat, int new_cell)
+  {
+    const int old_cell = cell_of_[iat];
+    if (old_cell == new_cell)
+      return;
+    int* link = &cell_head_[old_cell];
+    while (*link != iat)
+      link = &next_in_cell_[*link];
+    *link                = next_in_cell_[iat];
+    next_in_cell_[iat]   = cell_head_[new_cell];
+    cell_head_[new_cell] = iat;
+    cell_of_[iat]        = new_cell;
+  }
+
+  /** gather the particles around a position and keep those within the cutoff
+   * @param skip particle excluded from the candidates, -1 for none
+   */
+  void collectNeighbors(const ParticleSet& P,
+                        const PosType& pos,
+                        int cell,
+                        int skip,
+                        std::vector<int>& nb_ids,
+                        DistRow& nb_r,
+                        DisplRow& nb_dr)
+  {
+    const auto& R = P.getCoordinates().getAllParticlePos();
+    int num_cand  = 0;
+    for (int s = 0; s < cell_stencil_.cols(); ++s)
+      for (int jat = cell_head_[cell_stencil_(cell, s)]; jat >= 0; jat = next_in_cell_[jat])
+        if (jat != skip)
+        {
+          cand_ids_[num_cand] = jat;
+          for (int idim = 0; idim < D; ++idim)
+            cand_pos_.data(idim)[num_cand] = R.data(idim)[jat];
+          num_cand++;
+        }
+
+    DTD_BConds<T, D, SC>::computeDistances(pos, cand_pos_, cand_r_.data(), cand_dr_, 0, num_cand);
+
+    const RealType cutoff = this->neighbor_cutoff_;
+    nb_ids.clear();
+    for (int k = 0; k < num_cand; ++k)
+      if (cand_r_[k] < cutoff)
+      {
+        const int n = nb_ids.size();
+        nb_r[n]     = cand_r_[k];
+        for (int idim = 0; idim < D; ++idim)
+          nb_dr.data(idim)[n] = cand_dr_.data(idim)[k];
+        nb_ids.push_back(cand_ids_[k]);
+      }
+  }
+};
+} // namespace qmcplusplus
+#endif
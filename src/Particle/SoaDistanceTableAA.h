@@ -192,7 +192,7 @@ struct SoaDistanceTableAA : public DTD_BConds<T, D, SC>, public DistanceTableAA
     }
   }
 
-private:
+protected:
   ///number of targets with padding
   const size_t num_targets_padded_;
 #if !defined(NDEBUG)
@@ -445,6 +445,7 @@ public:
     DataSet.add(Age);
     DataSet.add(ReleasedNodeAge);
     DataSet.add(ReleasedNodeWeight);
+    DataSet.add(Weight);
     // vectors
     assert(R.size() != 0);
     DataSet.add(R.first_address(), R.last_address());
@@ -485,7 +486,7 @@ public:
   {
     assert(DataSet.size() != 0);
     DataSet.rewind();
-    DataSet >> ID >> ParentID >> Generation >> Age >> ReleasedNodeAge >> ReleasedNodeWeight;
+    DataSet >> ID >> ParentID >> Generation >> Age >> ReleasedNodeAge >> ReleasedNodeWeight >> Weight;
     // vectors
     assert(R.size() != 0);
     DataSet.get(R.first_address(), R.last_address());
@@ -539,7 +540,7 @@ public:
   void updateBuffer()
   {
     DataSet.rewind();
-    DataSet << ID << ParentID << Generation << Age << ReleasedNodeAge << ReleasedNodeWeight;
+    DataSet << ID << ParentID << Generation << Age << ReleasedNodeAge << ReleasedNodeWeight << Weight;
     // vectors
     DataSet.put(R.first_address(), R.last_address());
     DataSet.put(spins.first_address(), spins.last_address());
@@ -579,6 +580,54 @@ public:
     assert(scalar_end == DataSet.current_scalar());
   }
 
+  /** register the minimal walker state to a message buffer
+   *
+   * G and L are left out. They are restored by recomputing the wavefunction after the walker is loaded.
+   */
+  void registerMinimalData(WFBuffer_t& buf)
+  {
+    assert(buf.size() == 0);
+    buf.add(ID);
+    buf.add(ParentID);
+    buf.add(Generation);
+    buf.add(Age);
+    buf.add(ReleasedNodeAge);
+    buf.add(ReleasedNodeWeight);
+    buf.add(Weight);
+    buf.add(R.first_address(), R.last_address());
+    buf.add(spins.first_address(), spins.last_address());
+    buf.add(Properties.data(), Properties.data() + Properties.capacity());
+    for (int iat = 0; iat < PropertyHistory.size(); iat++)
+      buf.add(PropertyHistory[iat].data(), PropertyHistory[iat].data() + PropertyHistory[iat].size());
+    buf.add(PHindex.data(), PHindex.data() + PHindex.size());
+  }
+
+  /// pack the minimal walker state registered by registerMinimalData
+  void updateMinimalBuffer(WFBuffer_t& buf)
+  {
+    buf.rewind();
+    buf << ID << ParentID << Generation << Age << ReleasedNodeAge << ReleasedNodeWeight << Weight;
+    buf.put(R.first_address(), R.last_address());
+    buf.put(spins.first_address(), spins.last_address());
+    buf.put(Properties.data(), Properties.data() + Properties.capacity());
+    for (int iat = 0; iat < PropertyHistory.size(); iat++)
+      buf.put(PropertyHistory[iat].data(), PropertyHistory[iat].data() + PropertyHistory[iat].size());
+    buf.put(PHindex.data(), PHindex.data() + PHindex.size());
+  }
+
+  /// unpack the minimal walker state registered by registerMinimalData
+  void copyFromMinimalBuffer(WFBuffer_t& buf)
+  {
+    buf.rewind();
+    buf >> ID >> ParentID >> Generation >> Age >> ReleasedNodeAge >> ReleasedNodeWeight >> Weight;
+    buf.get(R.first_address(), R.last_address());
+    buf.get(spins.first_address(), spins.last_address());
+    buf.get(Properties.data(), Properties.data() + Properties.capacity());
+    for (int iat = 0; iat < PropertyHistory.size(); iat++)
+      buf.get(PropertyHistory[iat].data(), PropertyHistory[iat].data() + PropertyHistory[iat].size());
+    buf.get(PHindex.data(), PHindex.data() + PHindex.size());
+  }
+
   template<class Msg>
   inline Msg& putMessage(Msg& m)
   {
@@ -17,9 +17,20 @@
 #include "Particle/createDistanceTable.h"
 #include "Particle/DistanceTable.h"
 #include "Particle/SoaDistanceTableAA.h"
+#include "Particle/SoaCellListDistanceTableAA.h"
 
 namespace qmcplusplus
 {
+/// the dense table of a 3D periodic cell or the cell-list table if a neighbor cutoff is requested
+template<int SC>
+std::unique_ptr<DistanceTable> createBulkDistanceTableAA(ParticleSet& s)
+{
+  if (s.getNeighborCutoff() > 0)
+    return std::make_unique<SoaCellListDistanceTableAA<OHMMS_PRECISION, OHMMS_DIM, SC>>(s);
+  else
+    return std::make_unique<SoaDistanceTableAA<OHMMS_PRECISION, OHMMS_DIM, SC>>(s);
+}
+
 /** Adding SymmetricDTD to the list, e.g., el-el distance table
  *\param s source/target particle set
  *\return index of the distance table with the name
@@ -38,24 +49,30 @@ std::unique_ptr<DistanceTable> createDistanceTableAA(ParticleSet& s, std::ostrea
   o << "    source/target: " << s.getName() << std::endl;
   o << "    Using structure-of-arrays (SoA) data layout" << std::endl;
 
+  if (s.getNeighborCutoff() > 0 && sc != SUPERCELL_BULK)
+    app_warning() << "Neighbor cutoff of particleset " << s.getName()
+                  << " ignored. Cell lists are only supported in 3D periodic cells." << std::endl;
+
   if (sc == SUPERCELL_BULK)
   {
+    if (s.getNeighborCutoff() > 0)
+      o << "    Single particle moves use cell lists with neighbor cutoff " << s.getNeighborCutoff() << std::endl;
     if (s.getLattice().DiagonalOnly)
     {
       o << "    Distance computations use orthorhombic periodic cell in 3D." << std::endl;
-      dt = std::make_unique<SoaDistanceTableAA<RealType, DIM, PPPO + SOA_OFFSET>>(s);
+      dt = createBulkDistanceTableAA<PPPO + SOA_OFFSET>(s);
     }
     else
     {
       if (s.getLattice().WignerSeitzRadius > s.getLattice().SimulationCellRadius)
       {
-        o << "    Distance computations use general periodic cell in 3D with corner image checks." << std::endl;
-        dt = std::make_unique<SoaDistanceTableAA<RealType, DIM, PPPG + SOA_OFFSET>>(s);
+        o << "    Distance computations use general periodic cell in 3D with Wigner-Seitz image checks." << std::endl;
+        dt = createBulkDistanceTableAA<PPPG + SOA_OFFSET>(s);
       }
       else
       {
         o << "    Distance computations use general periodic cell in 3D without corner image checks." << std::endl;
-        dt = std::make_unique<SoaDistanceTableAA<RealType, DIM, PPPS + SOA_OFFSET>>(s);
+        dt = createBulkDistanceTableAA<PPPS + SOA_OFFSET>(s);
       }
     }
   }
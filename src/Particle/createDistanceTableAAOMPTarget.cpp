@@ -37,6 +37,9 @@ std::unique_ptr<DistanceTable> createDistanceTableAAOMPTarget(ParticleSet& s, st
   o << "  Distance table for similar particles (A-A):" << std::endl;
   o << "    source/target: " << s.getName() << std::endl;
   o << "    Using structure-of-arrays (SoA) data layout and OpenMP offload" << std::endl;
+  if (s.getNeighborCutoff() > 0)
+    app_warning() << "Neighbor cutoff of particleset " << s.getName()
+                  << " ignored. Cell lists are not supported with OpenMP offload." << std::endl;
 
   if (sc == SUPERCELL_BULK)
   {
@@ -49,7 +52,7 @@ std::unique_ptr<DistanceTable> createDistanceTableAAOMPTarget(ParticleSet& s, st
     {
       if (s.getLattice().WignerSeitzRadius > s.getLattice().SimulationCellRadius)
       {
-        o << "    Distance computations use general periodic cell in 3D with corner image checks." << std::endl;
+        o << "    Distance computations use general periodic cell in 3D with Wigner-Seitz image checks." << std::endl;
         dt = std::make_unique<SoaDistanceTableAAOMPTarget<RealType, DIM, PPPG + SOA_OFFSET>>(s);
       }
       else
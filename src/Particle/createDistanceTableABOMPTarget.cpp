@@ -52,7 +52,7 @@ std::unique_ptr<DistanceTable> createDistanceTableABOMPTarget(const ParticleSet&
     {
       if (s.getLattice().WignerSeitzRadius > s.getLattice().SimulationCellRadius)
       {
-        o << "    Distance computations use general periodic cell in 3D with corner image checks." << std::endl;
+        o << "    Distance computations use general periodic cell in 3D with Wigner-Seitz image checks." << std::endl;
         dt = std::make_unique<SoaDistanceTableABOMPTarget<RealType, DIM, PPPG + SOA_OFFSET>>(s, t);
       }
       else
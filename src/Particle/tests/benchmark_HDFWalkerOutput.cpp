@@ -0,0 +1,74 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** \file
+ *  This implements micro benchmarking of the walker configuration checkpoint.
+ *  The time measured is the time the driver is blocked by HDFWalkerOutput::dump.
+ */
+
+#include "catch.hpp"
+
+#include <sstream>
+#include "Configuration.h"
+#include "Particle/WalkerConfigurations.h"
+#include "Particle/HDFWalkerOutput.h"
+
+namespace qmcplusplus
+{
+/** checkpoint num_walkers walkers per rank of num_ptcls particles
+ */
+void benchmarkCheckpoint(int num_walkers, int num_ptcls)
+{
+  Communicate* c = OHMMS::Controller;
+
+  WalkerConfigurations walkers;
+  walkers.createWalkers(num_walkers, num_ptcls);
+  for (int iw = 0; iw < num_walkers; iw++)
+    for (int iat = 0; iat < num_ptcls; iat++)
+      walkers[iw]->R[iat] = 0.01 * iw + 0.1 * iat;
+
+  std::vector<int> walker_offset(c->size() + 1);
+  for (int i = 0; i <= c->size(); i++)
+    walker_offset[i] = num_walkers * i;
+  walkers.setWalkerOffsets(walker_offset);
+
+  c->setName("benchmark_checkpoint");
+  for (const bool single_precision : {false, true})
+    for (const bool async : {false, true})
+    {
+      HDFWalkerOutput hout(num_ptcls, "", c);
+      hout.setWriteMode(single_precision, async);
+      std::ostringstream name;
+      name << "checkpoint walkers=" << num_walkers << " particles=" << num_ptcls
+           << (single_precision ? " single" : " double") << (async ? " async" : "");
+      int block = 0;
+      BENCHMARK_ADVANCED(name.str())(Catch::Benchmark::Chronometer meter)
+      {
+        // the wait for the previous background write is part of the next dump
+        meter.measure([&] { hout.dump(walkers, block++); });
+      };
+    }
+}
+
+/** This test will run by default.
+ */
+TEST_CASE("HDFWalkerOutput checkpoint benchmark small", "[particle][benchmark]") { benchmarkCheckpoint(16, 8); }
+
+/** This and other [.benchmark] benchmarks only run if "[benchmark]" is explicitly passed as tag to test.
+ */
+TEST_CASE("HDFWalkerOutput checkpoint benchmark scaling", "[particle][.benchmark]")
+{
+  for (const int num_walkers : {256, 1024, 4096})
+    benchmarkCheckpoint(num_walkers, 512);
+}
+
+} // namespace qmcplusplus
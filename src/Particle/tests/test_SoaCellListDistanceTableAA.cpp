@@ -0,0 +1,145 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <random>
+#include "OhmmsData/Libxml2Doc.h"
+#include "Particle/ParticleSet.h"
+#include "ParticleIO/LatticeIO.h"
+#include "Particle/DistanceTable.h"
+
+namespace qmcplusplus
+{
+using RealType = QMCTraits::RealType;
+using PosType  = QMCTraits::PosType;
+using DistRow  = DistanceTable::DistRow;
+using DisplRow = DistanceTable::DisplRow;
+
+/// the neighbor list must hold the pairs of the dense row within the cutoff, particle skip excluded
+void checkNeighbors(const std::vector<int>& ids,
+                    const DistRow& dist,
+                    const DisplRow& displ,
+                    const DistRow& dist_ref,
+                    const DisplRow& displ_ref,
+                    int skip,
+                    RealType cutoff)
+{
+  std::vector<int> expected;
+  for (int jat = 0; jat < dist_ref.size(); jat++)
+    if (jat != skip && dist_ref[jat] < cutoff)
+      expected.push_back(jat);
+  std::vector<int> sorted(ids);
+  std::sort(sorted.begin(), sorted.end());
+  CHECK(sorted == expected);
+
+  for (int k = 0; k < ids.size(); k++)
+  {
+    CHECK(dist[k] == Approx(dist_ref[ids[k]]));
+    for (int idim = 0; idim < OHMMS_DIM; idim++)
+      CHECK(displ[k][idim] == Approx(displ_ref[ids[k]][idim]));
+  }
+}
+
+void testCellListAgainstDense(const char* lattice_xml, RealType cutoff)
+{
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(lattice_xml));
+  ParticleSet::ParticleLayout lattice;
+  LatticeParser lp(lattice);
+  lp.put(doc.getRoot());
+  const SimulationCell simulation_cell(lattice);
+
+  ParticleSet elec(simulation_cell);
+  elec.setName("e");
+  elec.create({50, 50});
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<RealType> unit(0.0, 1.0), step(-1.5, 1.5);
+  // a few particles start outside of the cell
+  for (int iat = 0; iat < elec.getTotalNum(); iat++)
+    elec.R[iat] = lattice.toCart(PosType(unit(rng), unit(rng), unit(rng) + (iat % 7 == 0 ? 1 : 0)));
+
+  ParticleSet elec_ref(elec);
+  elec.setNeighborCutoff(cutoff);
+  const int ee_id  = elec.addTable(elec);
+  const int ref_id = elec_ref.addTable(elec_ref);
+  const auto& dt   = elec.getDistTableAA(ee_id);
+  const auto& dref = elec_ref.getDistTableAA(ref_id);
+  REQUIRE(dt.getNeighborCutoff() == Approx(cutoff));
+  REQUIRE(dref.getNeighborCutoff() == 0);
+  elec.update();
+  elec_ref.update();
+
+  const int num_ptcls = elec.getTotalNum();
+  std::uniform_int_distribution<int> pick(0, num_ptcls - 1);
+  auto check_move = [&](int iat, bool accept, bool forward_mode) {
+    const PosType displ(step(rng), step(rng), step(rng));
+    elec.makeMove(iat, displ);
+    elec_ref.makeMove(iat, displ);
+    checkNeighbors(dt.getTempNeighbors(), dt.getTempNeighborDists(), dt.getTempNeighborDispls(), dref.getTempDists(),
+                   dref.getTempDispls(), -1, cutoff);
+    checkNeighbors(dt.getOldNeighbors(), dt.getOldNeighborDists(), dt.getOldNeighborDispls(), dref.getOldDists(),
+                   dref.getOldDispls(), iat, cutoff);
+    elec.accept_rejectMove(iat, accept, forward_mode);
+    elec_ref.accept_rejectMove(iat, accept, forward_mode);
+  };
+
+  // random particles in the regular mode, then a sweep in the forward mode
+  for (int imove = 0; imove < 200; imove++)
+    check_move(pick(rng), imove % 3 != 0, false);
+  for (int iat = 0; iat < num_ptcls; iat++)
+    check_move(iat, iat % 4 != 0, true);
+  elec.donePbyP();
+  elec_ref.donePbyP();
+
+  // the full table is up to date after donePbyP
+  for (int iat = 1; iat < num_ptcls; iat++)
+    for (int jat = 0; jat < iat; jat++)
+    {
+      CHECK(dt.getDistRow(iat)[jat] == Approx(dref.getDistRow(iat)[jat]));
+      for (int idim = 0; idim < OHMMS_DIM; idim++)
+        CHECK(dt.getDisplRow(iat)[jat][idim] == Approx(dref.getDisplRow(iat)[jat][idim]));
+    }
+
+  // a move after donePbyP sees the cells rebuilt from the accepted positions
+  check_move(pick(rng), true, false);
+}
+
+TEST_CASE("SoaCellListDistanceTableAA general cell", "[distance_table]")
+{
+  const char* lattice_xml = "<simulationcell> \
+     <parameter name=\"lattice\" units=\"bohr\"> \
+              10.0000000        0.00000000        0.00000000 \
+              1.00000000        9.00000000        0.00000000 \
+              0.50000000       -0.50000000        11.0000000 \
+     </parameter> \
+     <parameter name=\"bconds\"> p p p </parameter> \
+  </simulationcell>";
+  testCellListAgainstDense(lattice_xml, 2.5);
+}
+
+TEST_CASE("SoaCellListDistanceTableAA two cells per direction", "[distance_table]")
+{
+  // periodic images of a neighboring cell are counted once
+  const char* lattice_xml = "<simulationcell> \
+     <parameter name=\"lattice\" units=\"bohr\"> \
+              6.00000000        0.00000000        0.00000000 \
+              0.00000000        6.00000000        0.00000000 \
+              0.00000000        0.00000000        6.00000000 \
+     </parameter> \
+     <parameter name=\"bconds\"> p p p </parameter> \
+  </simulationcell>";
+  testCellListAgainstDense(lattice_xml, 2.9);
+}
+
+} // namespace qmcplusplus
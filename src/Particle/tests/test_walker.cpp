@@ -104,6 +104,49 @@ TEST_CASE("walker HDF read and write", "[particle]")
   }
 }
 
+TEST_CASE("walker HDF single precision and background write", "[particle]")
+{
+  Communicate* c = OHMMS::Controller;
+
+  const size_t num_ptcls = 2;
+  WalkerConfigurations wc_list;
+  wc_list.createWalkers(3, num_ptcls);
+  for (int iw = 0; iw < 3; iw++)
+    for (int iat = 0; iat < num_ptcls; iat++)
+      wc_list[iw]->R[iat] = 0.1 * iw + 0.3 * iat + 1.0 / 3.0;
+
+  std::vector<int> walker_offset(c->size() + 1);
+  for (int i = 0; i <= c->size(); i++)
+    walker_offset[i] = 3 * i;
+  wc_list.setWalkerOffsets(walker_offset);
+
+  c->setName("walker_test_sp");
+  {
+    HDFWalkerOutput hout(num_ptcls, "", c);
+    hout.setWriteMode(true, true);
+    hout.dump(wc_list, 0);
+    // the second dump waits for the first one
+    hout.dump(wc_list, 1);
+    hout.wait();
+  }
+
+  c->barrier();
+
+  WalkerConfigurations wc_list2;
+  HDFVersion version(0, 4);
+  HDFWalkerInput_0_4 hinp(wc_list2, num_ptcls, c, version);
+  REQUIRE(hinp.read_hdf5("walker_test_sp"));
+
+  REQUIRE(wc_list2.getActiveWalkers() == 3);
+  for (int iw = 0; iw < 3; iw++)
+    for (int i = 0; i < 3; i++)
+    {
+      CHECK(wc_list2[iw]->R[1][i] == Approx(wc_list[iw]->R[1][i]).epsilon(1e-6));
+      // positions went through single precision
+      CHECK(wc_list2[iw]->R[1][i] == static_cast<float>(wc_list[iw]->R[1][i]));
+    }
+}
+
 TEST_CASE("walker buffer add, update, restore", "[particle]")
 {
   int num_particles = 4;
@@ -120,12 +163,40 @@ TEST_CASE("walker buffer add, update, restore", "[particle]")
   walkers[0]->Properties(WP::SIGN)           = 1.3;
   walkers[0]->Properties(WP::UMBRELLAWEIGHT) = 1.4;
   walkers[0]->Properties(WP::LOCALPOTENTIAL) = 1.6;
+  walkers[0]->Weight                         = 0.7;
   walkers[0]->updateBuffer();
 
   std::memcpy(walkers[1]->DataSet.data(), walkers[0]->DataSet.data(), walkers[0]->DataSet.size());
   walkers[1]->copyFromBuffer();
   CHECK(walkers[1]->Properties(WP::LOGPSI) == Approx(1.2));
   CHECK(walkers[1]->Properties(WP::LOCALPOTENTIAL) == Approx(1.6));
+  CHECK(walkers[1]->Weight == Approx(0.7));
+}
+
+TEST_CASE("walker minimal buffer update, restore", "[particle]")
+{
+  int num_particles = 4;
+
+  MCPWalker w1(num_particles), w2(num_particles);
+  w1.registerData();
+  w1.DataSet.allocate();
+
+  MCPWalker::WFBuffer_t minimal;
+  w1.registerMinimalData(minimal);
+  minimal.allocate();
+  // G and L are left out
+  CHECK(minimal.byteSize() < w1.byteSize());
+
+  w1.Age                         = 3;
+  w1.Weight                      = 0.7;
+  w1.R[2][1]                     = 0.2;
+  w1.Properties(WP::LOCALENERGY) = -1.5;
+  w1.updateMinimalBuffer(minimal);
+  w2.copyFromMinimalBuffer(minimal);
+  CHECK(w2.Age == 3);
+  CHECK(w2.Weight == Approx(0.7));
+  CHECK(w2.R[2][1] == Approx(0.2));
+  CHECK(w2.Properties(WP::LOCALENERGY) == Approx(-1.5));
 }
 
 } // namespace qmcplusplus
@@ -7,6 +7,7 @@
 // File developed by: Peter Doak, doakpw@ornl.gov, Oak Ridge National Laboratory
 //////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include "Crowd.h"
 #include "QMCHamiltonians/QMCHamiltonian.h"
 
@@ -27,6 +28,10 @@ void Crowd::clearWalkers()
   walker_elecs_.clear();
   walker_twfs_.clear();
   walker_hamiltonians_.clear();
+  crowd_walkers_.clear();
+  slot_elecs_.clear();
+  slot_twfs_.clear();
+  slot_hamiltonians_.clear();
 }
 
 void Crowd::reserve(int crowd_size)
@@ -46,9 +51,72 @@ void Crowd::addWalker(MCPWalker& walker, ParticleSet& elecs, TrialWaveFunction&
   walker_hamiltonians_.push_back(hamiltonian);
 };
 
+void Crowd::addWalker(MCPWalker& walker) { crowd_walkers_.push_back(walker); }
+
+void Crowd::addWalkerSlot(ParticleSet& elecs, TrialWaveFunction& twf, QMCHamiltonian& hamiltonian)
+{
+  slot_elecs_.push_back(elecs);
+  slot_twfs_.push_back(twf);
+  slot_hamiltonians_.push_back(hamiltonian);
+}
+
+int Crowd::getNumWalkerBatches() const
+{
+  if (!hasWalkerSlots())
+    return 1;
+  const int num_slots = slot_elecs_.size();
+  return (crowd_walkers_.size() + num_slots - 1) / num_slots;
+}
+
+void Crowd::loadWalkerBatch(int batch)
+{
+  if (!hasWalkerSlots())
+    return;
+  const int num_slots   = slot_elecs_.size();
+  const int batch_first = batch * num_slots;
+  const int batch_end   = std::min(batch_first + num_slots, static_cast<int>(crowd_walkers_.size()));
+
+  mcp_walkers_.clear();
+  walker_elecs_.clear();
+  walker_twfs_.clear();
+  walker_hamiltonians_.clear();
+  for (int iw = batch_first; iw < batch_end; ++iw)
+  {
+    const int islot        = iw - batch_first;
+    MCPWalker& walker      = crowd_walkers_[iw];
+    ParticleSet& elecs     = slot_elecs_[islot];
+    TrialWaveFunction& twf = slot_twfs_[islot];
+    elecs.loadWalker(walker, false);
+    elecs.update();
+    // some components attach their per walker state to the walker buffer here
+    twf.copyFromBuffer(elecs, walker.DataSet);
+    // G and L are not in the buffer but were saved to the walker
+    twf.G = elecs.G;
+    twf.L = elecs.L;
+
+    mcp_walkers_.push_back(walker);
+    walker_elecs_.push_back(elecs);
+    walker_twfs_.push_back(twf);
+    walker_hamiltonians_.push_back(slot_hamiltonians_[islot]);
+  }
+}
+
+void Crowd::storeWalkerBatch()
+{
+  if (!hasWalkerSlots())
+    return;
+  for (int iw = 0; iw < mcp_walkers_.size(); ++iw)
+  {
+    MCPWalker& walker  = mcp_walkers_[iw];
+    ParticleSet& elecs = walker_elecs_[iw];
+    walker_twfs_[iw].get().updateBuffer(elecs, walker.DataSet, false);
+    elecs.saveWalker(walker);
+  }
+}
+
 void Crowd::setRNGForHamiltonian(RandomGenerator& rng)
 {
-  for (QMCHamiltonian& ham : walker_hamiltonians_)
+  for (QMCHamiltonian& ham : hasWalkerSlots() ? slot_hamiltonians_ : walker_hamiltonians_)
     ham.setRandomGenerator(&rng);
 }
 
@@ -13,6 +13,7 @@
 #include <vector>
 #include "QMCDrivers/MCPopulation.h"
 #include "RandomGenerator.h"
+#include "Utilities/NewTimer.h"
 #include "MultiWalkerDispatchers.h"
 #include "DriverWalkerTypes.h"
 #include "Estimators/EstimatorManagerCrowd.h"
@@ -58,6 +59,43 @@ public:
   EstimatorManagerCrowd& get_estimator_manager_crowd() { return estimator_manager_crowd_; }
   void addWalker(MCPWalker& walker, ParticleSet& elecs, TrialWaveFunction& twf, QMCHamiltonian& hamiltonian);
 
+  /** @name Walker Slots
+   *
+   *  With slots, the crowd owns a fixed set of ParticleSet/TrialWaveFunction/QMCHamiltonian
+   *  and its walkers only carry R, spins, properties and the wavefunction state in their DataSet.
+   *  A step goes over the walkers in batches of at most the number of slots.
+   *  Between loadWalkerBatch and storeWalkerBatch the walker vectors refer to the batch.
+   *  Without slots there is a single batch of all the walkers and both calls are no-op.
+   *  @{
+   */
+  void addWalker(MCPWalker& walker);
+  void addWalkerSlot(ParticleSet& elecs, TrialWaveFunction& twf, QMCHamiltonian& hamiltonian);
+  bool hasWalkerSlots() const { return !slot_elecs_.empty(); }
+  int getNumWalkerBatches() const;
+  /// load the walkers of a batch into the slots, the wavefunction state is restored from the walker DataSet
+  void loadWalkerBatch(int batch);
+  /// save the loaded batch back to its walkers
+  void storeWalkerBatch();
+  /** run op on each batch of walkers between loadWalkerBatch and storeWalkerBatch
+   *  @param buffer_timer timer of the batch loads and stores
+   *  @param op operation on the loaded walkers
+   */
+  template<typename OP>
+  void forEachWalkerBatch(NewTimer& buffer_timer, OP&& op)
+  {
+    for (int batch = 0; batch < getNumWalkerBatches(); ++batch)
+    {
+      {
+        ScopedTimer buffer_scope(buffer_timer);
+        loadWalkerBatch(batch);
+      }
+      op();
+      ScopedTimer buffer_scope(buffer_timer);
+      storeWalkerBatch();
+    }
+  }
+  /** @} */
+
   /** Clears all walker vectors
    *
    *  Unless you are _redistributing_ walkers to crowds don't
@@ -69,7 +107,7 @@ public:
 
   void accumulate(RandomGenerator& rng)
   {
-    if (this->size() == 0)
+    if (mcp_walkers_.empty())
       return;
     estimator_manager_crowd_.accumulate(mcp_walkers_, walker_elecs_, walker_twfs_, rng);
   }
@@ -92,7 +130,8 @@ public:
 
   DriverWalkerResourceCollection& getSharedResource() { return driverwalker_resource_collection_; }
 
-  int size() const { return mcp_walkers_.size(); }
+  /// number of walkers in the crowd, with slots get_walkers() only holds the loaded batch
+  int size() const { return hasWalkerSlots() ? crowd_walkers_.size() : mcp_walkers_.size(); }
 
   void incReject() { ++n_reject_; }
   void incAccept() { ++n_accept_; }
@@ -116,6 +155,13 @@ private:
   RefVector<QMCHamiltonian> walker_hamiltonians_;
   /** }@ */
 
+  /// all the walkers of the crowd when it uses slots
+  RefVector<MCPWalker> crowd_walkers_;
+  /// the slots, shared by the walkers of the crowd
+  RefVector<ParticleSet> slot_elecs_;
+  RefVector<TrialWaveFunction> slot_twfs_;
+  RefVector<QMCHamiltonian> slot_hamiltonians_;
+
   // provides multi walker resource
   DriverWalkerResourceCollection driverwalker_resource_collection_;
   /// per crowd estimator manager
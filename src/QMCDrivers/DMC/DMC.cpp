@@ -32,6 +32,7 @@
 #include "Utilities/ProgressReportEngine.h"
 #include "Utilities/qmc_common.h"
 #include "Utilities/FairDivide.h"
+#include "QMCWaveFunctions/Fermion/DelayRankTuner.h"
 #if !defined(REMOVE_TRACEMANAGER)
 #include "Estimators/TraceManager.h"
 #else
@@ -279,7 +280,11 @@ bool DMC::run()
       //           W.resetWalkerParents();
       //         }
       if (variablePop)
+      {
         FairDivideLow(W.getActiveWalkers(), NumThreads, wPerRank);
+        // the best delay rank depends on the number of walkers sharing the caches
+        DelayRankTuner::notifyPopulation(W.getActiveWalkers());
+      }
       sample++;
     }
     //       branchEngine->debugFWconfig();
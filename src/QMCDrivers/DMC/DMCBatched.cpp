@@ -104,7 +104,7 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
     twf_dispatcher.flex_recompute(walker_twfs, walker_elecs, recompute_mask);
   }
 
-  const int num_walkers   = crowd.size();
+  const int num_walkers   = walkers.size();
   auto& pset_leader       = walker_elecs.getLeader();
   const int num_particles = pset_leader.getTotalNum();
 
@@ -359,12 +359,14 @@ void DMCBatched::runDMCStep(int crowd_id,
   const bool recompute_this_step  = (sft.is_recomputing_block && (step + 1) == max_steps);
   const bool accumulate_this_step = true;
   const bool spin_move            = sft.population.get_golden_electrons()->isSpinor();
-  if (spin_move)
-    advanceWalkers<CoordsType::POS_SPIN>(sft, crowd, timers, dmc_timers, *context_for_steps[crowd_id],
-                                         recompute_this_step, accumulate_this_step);
-  else
-    advanceWalkers<CoordsType::POS>(sft, crowd, timers, dmc_timers, *context_for_steps[crowd_id], recompute_this_step,
-                                    accumulate_this_step);
+  crowd.forEachWalkerBatch(timers.buffer_timer, [&] {
+    if (spin_move)
+      advanceWalkers<CoordsType::POS_SPIN>(sft, crowd, timers, dmc_timers, *context_for_steps[crowd_id],
+                                           recompute_this_step, accumulate_this_step);
+    else
+      advanceWalkers<CoordsType::POS>(sft, crowd, timers, dmc_timers, *context_for_steps[crowd_id],
+                                      recompute_this_step, accumulate_this_step);
+  });
 }
 
 void DMCBatched::process(xmlNodePtr node)
@@ -429,7 +431,8 @@ bool DMCBatched::run()
   { // walker initialization
     ScopedTimer local_timer(timers_.init_walkers_timer);
     ParallelExecutor<> section_start_task;
-    section_start_task(crowds_.size(), initialLogEvaluation, std::ref(crowds_), std::ref(step_contexts_));
+    section_start_task(crowds_.size(), initialLogEvaluation, std::ref(crowds_), std::ref(step_contexts_),
+                       std::ref(timers_.buffer_timer));
 
     FullPrecRealType energy, variance;
     population_.measureGlobalEnergyVariance(*myComm, energy, variance);
@@ -471,11 +474,18 @@ bool DMCBatched::run()
                  std::ref(crowds_));
 
       {
-        int iter                 = block * qmcdriver_input_.get_max_steps() + step;
-        const int population_now = walker_controller_->branch(iter, population_, iter == 0);
-        branch_engine_->updateParamAfterPopControl(population_now, walker_controller_->get_ensemble_property(),
-                                                   population_.get_golden_electrons()->getTotalNum());
-        walker_controller_->setTrialEnergy(branch_engine_->getEtrial());
+        int iter = block * qmcdriver_input_.get_max_steps() + step;
+        // with async_branch, the population control reduction of this step is completed during the next step
+        // and population_now is the global population of the previous step.
+        const int population_now = walker_controller_->isAsyncBranch()
+            ? walker_controller_->branchAsync(iter, population_, iter == 0)
+            : walker_controller_->branch(iter, population_, iter == 0);
+        if (population_now > 0)
+        {
+          branch_engine_->updateParamAfterPopControl(population_now, walker_controller_->get_ensemble_property(),
+                                                     population_.get_golden_electrons()->getTotalNum());
+          walker_controller_->setTrialEnergy(branch_engine_->getEtrial());
+        }
       }
 
       population_.redistributeWalkers(crowds_);
@@ -501,6 +511,14 @@ bool DMCBatched::run()
     }
   }
 
+  if (const int population_now = walker_controller_->flushAsyncBranch(population_); population_now > 0)
+  {
+    branch_engine_->updateParamAfterPopControl(population_now, walker_controller_->get_ensemble_property(),
+                                               population_.get_golden_electrons()->getTotalNum());
+    walker_controller_->setTrialEnergy(branch_engine_->getEtrial());
+    population_.redistributeWalkers(crowds_);
+  }
+
   branch_engine_->printStatus();
 
   print_mem("DMCBatched ends", app_log());
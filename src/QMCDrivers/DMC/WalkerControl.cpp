@@ -41,6 +41,13 @@ enum WC_Timers
   WC_loadbalance,
   WC_send,
   WC_recv,
+  WC_async_post,
+  WC_async_wait,
+  WC_pack,
+  WC_unpack,
+  WC_recycle,
+  WC_allocate,
+  WC_kill,
 };
 
 TimerNameList_t<WC_Timers> WalkerControlTimerNames = {{WC_branch, "WalkerControl::branch"},
@@ -51,7 +58,14 @@ TimerNameList_t<WC_Timers> WalkerControlTimerNames = {{WC_branch, "WalkerControl
                                                       {WC_allreduce, "WalkerControl::allreduce"},
                                                       {WC_loadbalance, "WalkerControl::loadbalance"},
                                                       {WC_send, "WalkerControl::send"},
-                                                      {WC_recv, "WalkerControl::recv"}};
+                                                      {WC_recv, "WalkerControl::recv"},
+                                                      {WC_async_post, "WalkerControl::async_allreduce_post"},
+                                                      {WC_async_wait, "WalkerControl::async_allreduce_wait"},
+                                                      {WC_pack, "WalkerControl::pack"},
+                                                      {WC_unpack, "WalkerControl::unpack"},
+                                                      {WC_recycle, "WalkerControl::recycleWalker"},
+                                                      {WC_allocate, "WalkerControl::allocateWalker"},
+                                                      {WC_kill, "WalkerControl::killWalkers"}};
 
 WalkerControl::WalkerControl(Communicate* c, RandomGenerator& rng, bool use_fixed_pop)
     : MPIObjectBase(c),
@@ -64,7 +78,14 @@ WalkerControl::WalkerControl(Communicate* c, RandomGenerator& rng, bool use_fixe
       num_ranks_(c->size()),
       SwapMode(0),
       use_nonblocking_(true),
+      walker_message_(WalkerMessage::AUTO),
+      walker_message_reported_(false),
       debug_disable_branching_(false),
+      use_async_branch_(false),
+      async_pending_(false),
+      async_iter_(0),
+      async_step_time_(0.0),
+      async_wait_time_(0.0),
       saved_num_walkers_sent_(0)
 {
   num_per_rank_.resize(num_ranks_);
@@ -158,8 +179,8 @@ int WalkerControl::branch(int iter, MCPopulation& pop, bool do_not_branch)
 
   {
     ScopedTimer prebalance_timer(my_timers_[WC_prebalance]);
-    ///any temporary data includes many ridiculous conversions of integral types to and from fp
-    std::vector<FullPrecRealType> curData(LE_MAX + num_ranks_, 0.0);
+    // reuse the storage of the previous steps
+    curData.resize(LE_MAX + num_ranks_);
 
     if (use_fixed_pop_)
     {
@@ -206,20 +227,7 @@ int WalkerControl::branch(int iter, MCPopulation& pop, bool do_not_branch)
   // ranks sending walkers from other ranks have the lowest walker count now.
   untouched_walkers = std::min(untouched_walkers, walkers.size());
 
-  { // copy good walkers
-    ScopedTimer copywalkers_timer(my_timers_[WC_copyWalkers]);
-    const size_t good_walkers = walkers.size();
-    for (size_t iw = 0; iw < good_walkers; iw++)
-    {
-      size_t num_copies = static_cast<int>(walkers[iw]->Multiplicity);
-      while (num_copies > 1)
-      {
-        auto walker_elements   = pop.spawnWalker();
-        walker_elements.walker = *walkers[iw];
-        num_copies--;
-      }
-    }
-  }
+  copyWalkersOnRank(pop);
 
   const int current_num_global_walkers = std::accumulate(num_per_rank_.begin(), num_per_rank_.end(), 0);
   pop.set_num_global_walkers(current_num_global_walkers);
@@ -246,7 +254,138 @@ int WalkerControl::branch(int iter, MCPopulation& pop, bool do_not_branch)
   return pop.get_num_global_walkers();
 }
 
-void WalkerControl::computeCurData(const UPtrVector<MCPWalker>& walkers, std::vector<FullPrecRealType>& curData)
+int WalkerControl::branchAsync(int iter, MCPopulation& pop, bool do_not_branch)
+{
+  if (debug_disable_branching_)
+    do_not_branch = true;
+
+  ScopedTimer branch_timer(my_timers_[WC_branch]);
+  // the walker counts of the pending reduction are still valid because no walker has been created or killed since.
+  const int population_now = async_pending_ ? completeAsyncBranch(pop) : 0;
+
+  auto& walkers = pop.get_walkers();
+  // walkers received by completeAsyncBranch carry the weights of the current step and are branched here as well.
+  {
+    ScopedTimer prebalance_timer(my_timers_[WC_prebalance]);
+    if (do_not_branch)
+      for (auto& walker : walkers)
+        walker->Multiplicity = 1.0;
+    else
+      for (auto& walker : walkers)
+        walker->Multiplicity = static_cast<int>(walker->Weight + rng_());
+    async_curData_.resize(LE_MAX + num_ranks_);
+    computeLocalCurData(walkers, async_curData_);
+  }
+
+  {
+    ScopedTimer post_timer(my_timers_[WC_async_post]);
+#if defined(HAVE_MPI)
+    MPI_Iallreduce(MPI_IN_PLACE, async_curData_.data(), async_curData_.size(),
+                   mpi::get_mpi_datatype(async_curData_[0]), MPI_SUM, myComm->getMPI(), &async_request_);
+#endif
+    async_pending_ = true;
+    async_iter_    = iter;
+    async_clock_.restart();
+  }
+
+  // branching within the rank doesn't need any global information.
+  killDeadWalkersOnRank(pop);
+  const auto untouched_walkers = walkers.size();
+  copyWalkersOnRank(pop);
+
+  if (!do_not_branch)
+    for (UPtr<MCPWalker>& walker : walkers)
+    {
+      walker->Weight       = 1.0;
+      walker->Multiplicity = 1.0;
+    }
+
+  // walkers received by completeAsyncBranch have been marked already.
+  for (int iw = untouched_walkers; iw < walkers.size(); iw++)
+    walkers[iw]->wasTouched = true;
+
+  return population_now;
+}
+
+int WalkerControl::flushAsyncBranch(MCPopulation& pop)
+{
+  if (!async_pending_)
+    return 0;
+  ScopedTimer branch_timer(my_timers_[WC_branch]);
+  const int population_now = completeAsyncBranch(pop);
+  // only the wait is measured, the reduction may have completed anywhere within the steps
+  app_log() << "  WalkerControl asynchronous branching: " << async_wait_time_
+            << " secs waiting for the population control reductions overlapped with " << async_step_time_
+            << " secs of steps." << std::endl;
+  return population_now;
+}
+
+int WalkerControl::completeAsyncBranch(MCPopulation& pop)
+{
+  assert(async_pending_);
+  async_step_time_ += async_clock_.elapsed();
+  {
+    ScopedTimer wait_timer(my_timers_[WC_async_wait]);
+    Timer wait_clock;
+#if defined(HAVE_MPI)
+    MPI_Wait(&async_request_, MPI_STATUS_IGNORE);
+#endif
+    async_wait_time_ += wait_clock.elapsed();
+  }
+  async_pending_ = false;
+
+  for (int i = 0, j = LE_MAX; i < num_ranks_; i++, j++)
+    num_per_rank_[i] = static_cast<int>(async_curData_[j]);
+  writeDMCdat(async_iter_, async_curData_);
+  pop.set_ensemble_property(ensemble_property_);
+
+  auto& walkers                = pop.get_walkers();
+  const auto untouched_walkers = walkers.size();
+#if defined(HAVE_MPI)
+  {
+    ScopedTimer loadbalance_timer(my_timers_[WC_loadbalance]);
+    // every walker has been copied out to its multiplicity already.
+    for (auto& walker : walkers)
+      walker->Multiplicity = 1.0;
+    swapWalkersSimple(pop);
+    killDeadWalkersOnRank(pop);
+  }
+#endif
+
+  const int current_num_global_walkers = std::accumulate(num_per_rank_.begin(), num_per_rank_.end(), 0);
+  pop.set_num_global_walkers(current_num_global_walkers);
+#ifndef NDEBUG
+  pop.checkIntegrity();
+  pop.syncWalkersPerRank(myComm);
+  if (current_num_global_walkers != pop.get_num_global_walkers())
+    throw std::runtime_error("Potential bug! Population num_global_walkers mismatched!");
+#endif
+
+  for (int iw = std::min(untouched_walkers, walkers.size()); iw < walkers.size(); iw++)
+    walkers[iw]->wasTouched = true;
+
+  return current_num_global_walkers;
+}
+
+void WalkerControl::copyWalkersOnRank(MCPopulation& pop)
+{
+  ScopedTimer copywalkers_timer(my_timers_[WC_copyWalkers]);
+  auto& walkers             = pop.get_walkers();
+  const size_t good_walkers = walkers.size();
+  for (size_t iw = 0; iw < good_walkers; iw++)
+  {
+    size_t num_copies = static_cast<int>(walkers[iw]->Multiplicity);
+    while (num_copies > 1)
+    {
+      // the copy reuses the buffers of the spawned walker in place
+      auto walker_elements   = spawnWalker(pop);
+      walker_elements.walker = *walkers[iw];
+      num_copies--;
+    }
+  }
+}
+
+void WalkerControl::computeLocalCurData(const UPtrVector<MCPWalker>& walkers, std::vector<FullPrecRealType>& curData)
 {
   FullPrecRealType esum = 0.0, e2sum = 0.0, wsum = 0.0;
   FullPrecRealType r2_accepted = 0.0, r2_proposed = 0.0;
@@ -279,7 +418,11 @@ void WalkerControl::computeCurData(const UPtrVector<MCPWalker>& walkers, std::ve
     curData[LE_MAX + rank_num_] = wsum; // node sum of walker weights
   else
     curData[LE_MAX + rank_num_] = num_total_copies; // node num of walkers after local branching
+}
 
+void WalkerControl::computeCurData(const UPtrVector<MCPWalker>& walkers, std::vector<FullPrecRealType>& curData)
+{
+  computeLocalCurData(walkers, curData);
   {
     ScopedTimer allreduce_timer(my_timers_[WC_allreduce]);
     myComm->allreduce(curData);
@@ -405,7 +548,7 @@ void WalkerControl::swapWalkersSimple(MCPopulation& pop)
 
     if (minus[ic] == rank_num_)
     {
-      newW.push_back(pop.spawnWalker());
+      newW.push_back(spawnWalker(pop));
 
       // recv the number of copies from the target
       myComm->comm.receive_n(&nsentcopy, 1, plus[ic]);
@@ -424,28 +567,69 @@ void WalkerControl::swapWalkersSimple(MCPopulation& pop)
     ic += nsentcopy;
   }
 
+  // every rank makes the same choice because all the walkers have the same layout
+  const bool minimal_message = !job_list.empty() &&
+      useMinimalMessage(nsend > 0 ? *good_walkers[job_list[0].walkerID] : newW[job_list[0].walkerID].walker);
+  // one message buffer per job. A walker sent to several targets is packed once.
+  std::vector<Walker_t::WFBuffer_t*> messages(job_list.size());
+  if (minimal_message)
+  {
+    if (message_buffers_.size() < job_list.size())
+      message_buffers_.resize(job_list.size());
+    for (int ij = 0; ij < job_list.size(); ij++)
+    {
+      Walker_t::WFBuffer_t& buf = message_buffers_[ij];
+      if (buf.size() == 0)
+      {
+        auto& awalker = nsend > 0 ? *good_walkers[job_list[ij].walkerID] : newW[job_list[ij].walkerID].walker;
+        awalker.registerMinimalData(buf);
+        buf.allocate();
+      }
+      messages[ij] = &buf;
+    }
+  }
+
   if (nsend > 0)
   {
     std::vector<mpi3::request> requests;
     // mark all walkers not in send
     for (auto jobit = job_list.begin(); jobit != job_list.end(); jobit++)
       good_walkers[jobit->walkerID]->SendInProgress = false;
-    for (auto jobit = job_list.begin(); jobit != job_list.end(); jobit++)
     {
-      // pack data and send
-      auto& awalker   = good_walkers[jobit->walkerID];
-      size_t byteSize = awalker->byteSize();
-      if (!awalker->SendInProgress)
+      ScopedTimer pack_timer(my_timers_[WC_pack]);
+      std::vector<int> packed_job(good_walkers.size(), -1);
+      for (int ij = 0; ij < job_list.size(); ij++)
       {
-        awalker->updateBuffer();
-        awalker->SendInProgress = true;
+        auto& awalker = good_walkers[job_list[ij].walkerID];
+        if (!minimal_message)
+        {
+          // byteSize registers DataSet if needed
+          awalker->byteSize();
+          messages[ij] = &awalker->DataSet;
+        }
+        if (!awalker->SendInProgress)
+        {
+          if (minimal_message)
+            awalker->updateMinimalBuffer(*messages[ij]);
+          else
+            awalker->updateBuffer();
+          awalker->SendInProgress           = true;
+          packed_job[job_list[ij].walkerID] = ij;
+        }
+        else
+          messages[ij] = messages[packed_job[job_list[ij].walkerID]];
       }
+    }
+    for (int ij = 0; ij < job_list.size(); ij++)
+    {
+      // send packed data
+      auto& message = *messages[ij];
       if (use_nonblocking_)
-        requests.push_back(myComm->comm.isend_n(awalker->DataSet.data(), byteSize, jobit->target));
+        requests.push_back(myComm->comm.isend_n(message.data(), message.byteSize(), job_list[ij].target));
       else
       {
         ScopedTimer local_timer(my_timers_[WC_send]);
-        myComm->comm.send_n(awalker->DataSet.data(), byteSize, jobit->target);
+        myComm->comm.send_n(message.data(), message.byteSize(), job_list[ij].target);
       }
     }
     if (use_nonblocking_)
@@ -462,19 +646,33 @@ void WalkerControl::swapWalkersSimple(MCPopulation& pop)
   else
   {
     std::vector<mpi3::request> requests;
-    for (auto jobit = job_list.begin(); jobit != job_list.end(); jobit++)
+    auto unpack = [&](int ij) {
+      ScopedTimer unpack_timer(my_timers_[WC_unpack]);
+      auto& awalker = newW[job_list[ij].walkerID].walker;
+      if (minimal_message)
+        awalker.copyFromMinimalBuffer(*messages[ij]);
+      else
+        awalker.copyFromBuffer();
+    };
+    for (int ij = 0; ij < job_list.size(); ij++)
     {
       // recv and unpack data
-      auto& walker_elements = newW[jobit->walkerID];
-      auto& awalker         = walker_elements.walker;
-      size_t byteSize       = awalker.byteSize();
+      auto& awalker = newW[job_list[ij].walkerID].walker;
+      if (!minimal_message)
+      {
+        awalker.byteSize();
+        messages[ij] = &awalker.DataSet;
+      }
+      auto& message = *messages[ij];
       if (use_nonblocking_)
-        requests.push_back(myComm->comm.ireceive_n(awalker.DataSet.data(), byteSize, jobit->target));
+        requests.push_back(myComm->comm.ireceive_n(message.data(), message.byteSize(), job_list[ij].target));
       else
       {
-        ScopedTimer local_timer(my_timers_[WC_recv]);
-        myComm->comm.receive_n(awalker.DataSet.data(), byteSize, jobit->target);
-        awalker.copyFromBuffer();
+        {
+          ScopedTimer local_timer(my_timers_[WC_recv]);
+          myComm->comm.receive_n(message.data(), message.byteSize(), job_list[ij].target);
+        }
+        unpack(ij);
       }
     }
     if (use_nonblocking_)
@@ -489,8 +687,7 @@ void WalkerControl::swapWalkersSimple(MCPopulation& pop)
           {
             if (requests[im].completed())
             {
-              auto& walker_elements = newW[job_list[im].walkerID];
-              walker_elements.walker.copyFromBuffer();
+              unpack(im);
               not_completed[im] = false;
             }
             else
@@ -521,22 +718,47 @@ void WalkerControl::swapWalkersSimple(MCPopulation& pop)
 }
 #endif
 
+bool WalkerControl::useMinimalMessage(MCPWalker& walker)
+{
+  if (walker_message_ == WalkerMessage::FULL)
+    return false;
+  if (walker_message_ == WalkerMessage::MINIMAL)
+    return true;
+
+  // cost of a message ~ latency + bytes / network bandwidth. The minimal message is packed into a staging buffer
+  // and pays an extra copy at memory bandwidth, roughly an order of magnitude faster than the network.
+  constexpr double staging_cost_ratio = 0.1;
+  const size_t full_bytes             = walker.byteSize();
+  Walker_t::WFBuffer_t minimal;
+  walker.registerMinimalData(minimal);
+  const size_t minimal_bytes = minimal.current() + minimal.current_scalar() * sizeof(FullPrecRealType);
+  const bool use_minimal     = minimal_bytes * (1.0 + staging_cost_ratio) < full_bytes;
+  if (!walker_message_reported_)
+  {
+    app_log() << "  WalkerControl walker message " << full_bytes << " bytes full, " << minimal_bytes
+              << " bytes minimal. Sending " << (use_minimal ? "minimal" : "full") << " messages." << std::endl;
+    walker_message_reported_ = true;
+  }
+  return use_minimal;
+}
+
 void WalkerControl::killDeadWalkersOnRank(MCPopulation& pop)
 {
+  ScopedTimer kill_timer(my_timers_[WC_kill]);
   // kill walkers, actually put them in deadlist
-  RefVector<MCPWalker> bad_walkers;
-  auto& walkers = pop.get_walkers();
-  bad_walkers.reserve(walkers.size());
-  for (auto& walker : walkers)
-    if (static_cast<int>(walker->Multiplicity) == 0)
-      bad_walkers.push_back(*walker);
-  for (MCPWalker& bad_walker : bad_walkers)
-    pop.killWalker(bad_walker);
+  pop.killDeadWalkers();
 #ifndef NDEBUG
   pop.checkIntegrity();
 #endif
 }
 
+WalkerElementsRef WalkerControl::spawnWalker(MCPopulation& pop)
+{
+  // the call counts are the walkers recycled from the dead walkers and allocated outside of the reserve
+  ScopedTimer spawn_timer(my_timers_[pop.get_dead_walkers().empty() ? WC_allocate : WC_recycle]);
+  return pop.spawnWalker();
+}
+
 std::vector<WalkerControl::IndexType> WalkerControl::syncFutureWalkersPerRank(Communicate* comm, IndexType n_walkers)
 {
   int ncontexts = comm->size();
@@ -551,12 +773,16 @@ bool WalkerControl::put(xmlNodePtr cur)
   int nw_target = 0, nw_max = 0;
   std::string nonblocking;
   std::string debug_disable_branching;
+  std::string async_branch;
+  std::string walker_message;
   ParameterSet params;
   params.add(max_copy_, "maxCopy");
   params.add(nw_target, "targetwalkers");
   params.add(nw_max, "max_walkers");
   params.add(nonblocking, "use_nonblocking", {"yes", "no"});
   params.add(debug_disable_branching, "debug_disable_branching", {"no", "yes"});
+  params.add(async_branch, "async_branch", {"no", "yes"});
+  params.add(walker_message, "walker_message", {"auto", "full", "minimal"});
 
   try
   {
@@ -569,6 +795,18 @@ bool WalkerControl::put(xmlNodePtr cur)
 
   use_nonblocking_         = nonblocking == "yes";
   debug_disable_branching_ = debug_disable_branching == "yes";
+  use_async_branch_        = async_branch == "yes";
+  if (walker_message == "full")
+    walker_message_ = WalkerMessage::FULL;
+  else if (walker_message == "minimal")
+    walker_message_ = WalkerMessage::MINIMAL;
+  else
+    walker_message_ = WalkerMessage::AUTO;
+  if (use_async_branch_ && use_fixed_pop_)
+  {
+    app_warning() << "async_branch is not supported with reconfiguration. Using synchronous branching." << std::endl;
+    use_async_branch_ = false;
+  }
 
   setMinMax(nw_target, nw_max);
 
@@ -579,6 +817,9 @@ bool WalkerControl::put(xmlNodePtr cur)
   app_log() << "    Max Walkers per MPI rank " << n_max_ << std::endl;
   app_log() << "    Min Walkers per MPI rank " << n_min_ << std::endl;
   app_log() << "    Using " << (use_nonblocking_ ? "non-" : "") << "blocking send/recv" << std::endl;
+  app_log() << "    Walker message " << walker_message << std::endl;
+  if (use_async_branch_)
+    app_log() << "    Population control reduction overlapped with the next step" << std::endl;
   if (debug_disable_branching_)
     app_log() << "    Disable branching for debugging as the user input request." << std::endl;
   return true;
@@ -24,6 +24,8 @@
 #include "Message/MPIObjectBase.h"
 #include "Message/CommOperators.h"
 #include "Utilities/RandomGenerator.h"
+#include "Utilities/Timer.h"
+#include "mpi/mpi_datatype.h"
 
 namespace qmcplusplus
 {
@@ -72,6 +74,25 @@ public:
    */
   int branch(int iter, MCPopulation& pop, bool do_not_branch);
 
+  /** unified: perform branch with the global reduction overlapped with the next step
+   *
+   *  Walkers are branched locally right away and the allreduce of the ensemble data is posted without waiting.
+   *  The reduction posted at the previous call is completed first and the walkers are load balanced with it.
+   *  Moving walkers across ranks has no effect on the statistics; the ensemble data and the trial energy lag one step.
+   *  Only available with fluctuating population.
+   *  \return global population from the reduction completed in this call, 0 if nothing was pending
+   */
+  int branchAsync(int iter, MCPopulation& pop, bool do_not_branch);
+
+  /** complete the reduction left in flight by branchAsync and balance the walkers
+   *
+   *  \return global population, 0 if nothing was pending
+   */
+  int flushAsyncBranch(MCPopulation& pop);
+
+  /// true if the population control reduction is overlapped with the next step
+  bool isAsyncBranch() const { return use_async_branch_; }
+
   bool put(xmlNodePtr cur);
 
   void setMinMax(int nw_in, int nmax_in);
@@ -87,13 +108,32 @@ public:
 
 private:
   /// kill dead walkers in the population
-  static void killDeadWalkersOnRank(MCPopulation& pop);
+  void killDeadWalkersOnRank(MCPopulation& pop);
+
+  /** spawn a walker, recycling a dead walker if any
+   *
+   *  The call counts of the WalkerControl::recycleWalker and WalkerControl::allocateWalker timers
+   *  tell how many walker allocations the reserve avoided.
+   */
+  WalkerElementsRef spawnWalker(MCPopulation& pop);
 
   static std::vector<IndexType> syncFutureWalkersPerRank(Communicate* comm, IndexType n_walkers);
 
   /// compute curData
   void computeCurData(const UPtrVector<MCPWalker>& walkers, std::vector<FullPrecRealType>& curData);
 
+  /// compute the rank local contribution to curData without reduction
+  void computeLocalCurData(const UPtrVector<MCPWalker>& walkers, std::vector<FullPrecRealType>& curData);
+
+  /// copy walkers with Multiplicity > 1 on this rank
+  void copyWalkersOnRank(MCPopulation& pop);
+
+  /** wait for the reduction posted by branchAsync, write dmc.dat and swap walkers
+   *
+   *  \return global population
+   */
+  int completeAsyncBranch(MCPopulation& pop);
+
   /** creates the distribution plan
    *
    *  populates the minus and plus vectors they contain 1 copy of a partition index 
@@ -123,6 +163,15 @@ private:
   void swapWalkersSimple(MCPopulation& pop);
 #endif
 
+  /** pick the walker message used by swapWalkersSimple
+   *
+   * The minimal message leaves out the data restored by the wavefunction recompute of received walkers.
+   * Since received walkers are always recomputed, the cost model only weighs the bytes saved on the wire
+   * against the extra staging copy of the minimal message.
+   * \return true if the minimal message is used
+   */
+  bool useMinimalMessage(MCPWalker& walker);
+
   /** An enum to access curData for reduction
    *
    * curData is larger than this //LE_MAX + n_node * T
@@ -170,8 +219,37 @@ private:
   std::vector<FullPrecRealType> curData;
   ///Use non-blocking isend/irecv
   bool use_nonblocking_;
+  ///walker message mode
+  enum class WalkerMessage
+  {
+    AUTO,
+    FULL,
+    MINIMAL
+  } walker_message_;
+  ///the walker message choice has been reported
+  bool walker_message_reported_;
+  ///staging buffers of minimal walker messages
+  std::vector<Walker_t::WFBuffer_t> message_buffers_;
   ///disable branching for debugging
   bool debug_disable_branching_;
+  ///overlap the population control reduction with the next step
+  bool use_async_branch_;
+  ///a reduction posted by branchAsync is in flight
+  bool async_pending_;
+  ///iteration of the reduction in flight
+  int async_iter_;
+  ///curData of the reduction in flight
+  std::vector<FullPrecRealType> async_curData_;
+#if defined(HAVE_MPI)
+  ///request of the reduction in flight
+  mpi::request async_request_;
+#endif
+  ///wall clock since the reduction in flight was posted
+  Timer async_clock_;
+  ///accumulated time of the steps between posting and waiting for the reductions
+  double async_step_time_;
+  ///accumulated time spent waiting for the reductions
+  double async_wait_time_;
   ///ensemble properties
   MCDataType<FullPrecRealType> ensemble_property_;
   ///timers
@@ -9,6 +9,7 @@
 // File refactored from: MCWalkerConfiguration.cpp, QMCUpdate.cpp
 //////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <numeric>
 
 #include "MCPopulation.h"
@@ -59,7 +60,7 @@ MCPopulation::~MCPopulation()
     saveWalkerConfigurations();
 }
 
-void MCPopulation::createWalkers(IndexType num_walkers, RealType reserve)
+void MCPopulation::createWalkers(IndexType num_walkers, RealType reserve, IndexType num_slots)
 {
   IndexType num_walkers_plus_reserve = static_cast<IndexType>(num_walkers * reserve);
 
@@ -73,9 +74,18 @@ void MCPopulation::createWalkers(IndexType num_walkers, RealType reserve)
   // This pattern is begging for a micro benchmark, is this really better
   // than the simpler walkers_.pushback;
   walkers_.resize(num_walkers_plus_reserve);
-  walker_elec_particle_sets_.resize(num_walkers_plus_reserve);
-  walker_trial_wavefunctions_.resize(num_walkers_plus_reserve);
-  walker_hamiltonians_.resize(num_walkers_plus_reserve);
+  // walkers move between the living and the dead lists while branching, their capacity covers the reserve.
+  dead_walkers_.reserve(num_walkers_plus_reserve);
+  const bool use_slots = num_slots > 0;
+  if (!use_slots)
+  {
+    walker_elec_particle_sets_.resize(num_walkers_plus_reserve);
+    walker_trial_wavefunctions_.resize(num_walkers_plus_reserve);
+    walker_hamiltonians_.resize(num_walkers_plus_reserve);
+    dead_walker_elec_particle_sets_.reserve(num_walkers_plus_reserve);
+    dead_walker_trial_wavefunctions_.reserve(num_walkers_plus_reserve);
+    dead_walker_hamiltonians_.reserve(num_walkers_plus_reserve);
+  }
 
   outputManager.pause();
 
@@ -93,12 +103,37 @@ void MCPopulation::createWalkers(IndexType num_walkers, RealType reserve)
     if (iw < walker_configs_ref_.WalkerList.size())
       *walkers_[iw] = *walker_configs_ref_[iw];
 
+    if (use_slots)
+      continue;
     walker_elec_particle_sets_[iw]  = std::make_unique<ParticleSet>(*elec_particle_set_);
     walker_trial_wavefunctions_[iw] = trial_wf_->makeClone(*walker_elec_particle_sets_[iw]);
     walker_hamiltonians_[iw] =
         hamiltonian_->makeClone(*walker_elec_particle_sets_[iw], *walker_trial_wavefunctions_[iw]);
   };
 
+  if (use_slots)
+  {
+    slot_elec_particle_sets_.resize(num_slots);
+    slot_trial_wavefunctions_.resize(num_slots);
+    slot_hamiltonians_.resize(num_slots);
+#pragma omp parallel for
+    for (size_t islot = 0; islot < num_slots; islot++)
+    {
+      slot_elec_particle_sets_[islot]  = std::make_unique<ParticleSet>(*elec_particle_set_);
+      slot_trial_wavefunctions_[islot] = trial_wf_->makeClone(*slot_elec_particle_sets_[islot]);
+      slot_hamiltonians_[islot] =
+          hamiltonian_->makeClone(*slot_elec_particle_sets_[islot], *slot_trial_wavefunctions_[islot]);
+      // every slot has to know where the wavefunction state starts in the walker buffers, they all have this layout.
+      MCPWalker layout_walker(elec_particle_set_->getTotalNum());
+      layout_walker.registerData();
+      slot_trial_wavefunctions_[islot]->registerData(*slot_elec_particle_sets_[islot], layout_walker.DataSet);
+    }
+
+    // registering goes through the first slot, not thread safe.
+    for (auto& walker_ptr : walkers_)
+      registerWalkerSlotData(*walker_ptr);
+  }
+
   outputManager.resume();
 
   int num_walkers_created = 0;
@@ -123,8 +158,20 @@ void MCPopulation::createWalkers(IndexType num_walkers, RealType reserve)
     killLastWalker();
 }
 
+void MCPopulation::registerWalkerSlotData(MCPWalker& walker)
+{
+  if (walker.DataSet.size())
+    walker.DataSet.clear();
+  walker.DataSet.rewind();
+  walker.registerData();
+  slot_trial_wavefunctions_[0]->registerData(*slot_elec_particle_sets_[0], walker.DataSet);
+  walker.DataSet.allocate();
+}
+
 WalkerElementsRef MCPopulation::getWalkerElementsRef(const size_t index)
 {
+  if (hasWalkerSlots())
+    return {*walkers_[index], *elec_particle_set_, *trial_wf_};
   return {*walkers_[index], *walker_elec_particle_sets_[index], *walker_trial_wavefunctions_[index]};
 }
 
@@ -132,9 +179,7 @@ std::vector<WalkerElementsRef> MCPopulation::get_walker_elements()
 {
   std::vector<WalkerElementsRef> walker_elements;
   for (int iw = 0; iw < walkers_.size(); ++iw)
-  {
-    walker_elements.emplace_back(*walkers_[iw], *walker_elec_particle_sets_[iw], *walker_trial_wavefunctions_[iw]);
-  }
+    walker_elements.push_back(getWalkerElementsRef(iw));
   return walker_elements;
 }
 
@@ -154,12 +199,15 @@ WalkerElementsRef MCPopulation::spawnWalker()
   {
     walkers_.push_back(std::move(dead_walkers_.back()));
     dead_walkers_.pop_back();
-    walker_elec_particle_sets_.push_back(std::move(dead_walker_elec_particle_sets_.back()));
-    dead_walker_elec_particle_sets_.pop_back();
-    walker_trial_wavefunctions_.push_back(std::move(dead_walker_trial_wavefunctions_.back()));
-    dead_walker_trial_wavefunctions_.pop_back();
-    walker_hamiltonians_.push_back(std::move(dead_walker_hamiltonians_.back()));
-    dead_walker_hamiltonians_.pop_back();
+    if (!hasWalkerSlots())
+    {
+      walker_elec_particle_sets_.push_back(std::move(dead_walker_elec_particle_sets_.back()));
+      dead_walker_elec_particle_sets_.pop_back();
+      walker_trial_wavefunctions_.push_back(std::move(dead_walker_trial_wavefunctions_.back()));
+      dead_walker_trial_wavefunctions_.pop_back();
+      walker_hamiltonians_.push_back(std::move(dead_walker_hamiltonians_.back()));
+      dead_walker_hamiltonians_.pop_back();
+    }
     // Emulating the legacy implementation valid walker elements were created with the initial walker and DataSet
     // registration and allocation were done then so are not necessary when resurrecting walkers and elements
     walkers_.back()->Generation         = 0;
@@ -180,16 +228,20 @@ WalkerElementsRef MCPopulation::spawnWalker()
     // Because the buffer is changed by Hamiltonians and wavefunctions that
     // Add to the dataSet.
 
-    walker_elec_particle_sets_.emplace_back(std::make_unique<ParticleSet>(*elec_particle_set_));
-    walker_trial_wavefunctions_.emplace_back(trial_wf_->makeClone(*walker_elec_particle_sets_.back()));
-    walker_hamiltonians_.emplace_back(
-        hamiltonian_->makeClone(*walker_elec_particle_sets_.back(), *walker_trial_wavefunctions_.back()));
+    // With walker slots, the copied DataSet already has the layout of the slots.
+    if (!hasWalkerSlots())
+    {
+      walker_elec_particle_sets_.emplace_back(std::make_unique<ParticleSet>(*elec_particle_set_));
+      walker_trial_wavefunctions_.emplace_back(trial_wf_->makeClone(*walker_elec_particle_sets_.back()));
+      walker_hamiltonians_.emplace_back(
+          hamiltonian_->makeClone(*walker_elec_particle_sets_.back(), *walker_trial_wavefunctions_.back()));
+    }
     walkers_.back()->Multiplicity = 1.0;
     walkers_.back()->Weight       = 1.0;
   }
 
   outputManager.resume();
-  return {*walkers_.back().get(), *walker_elec_particle_sets_.back().get(), *walker_trial_wavefunctions_.back().get()};
+  return getWalkerElementsRef(walkers_.size() - 1);
 }
 
 /** Kill last walker (just barely)
@@ -202,6 +254,8 @@ void MCPopulation::killLastWalker()
   // kill the walker but just barely we need all its setup and connections to remain
   dead_walkers_.push_back(std::move(walkers_.back()));
   walkers_.pop_back();
+  if (hasWalkerSlots())
+    return;
   dead_walker_elec_particle_sets_.push_back(std::move(walker_elec_particle_sets_.back()));
   walker_elec_particle_sets_.pop_back();
   dead_walker_trial_wavefunctions_.push_back(std::move(walker_trial_wavefunctions_.back()));
@@ -215,6 +269,18 @@ void MCPopulation::killLastWalker()
  */
 void MCPopulation::killWalker(MCPWalker& walker)
 {
+  if (hasWalkerSlots())
+  {
+    auto it_walkers = std::find_if(walkers_.begin(), walkers_.end(),
+                                   [&walker](const UPtr<MCPWalker>& walker_ptr) { return walker_ptr.get() == &walker; });
+    if (it_walkers == walkers_.end())
+      throw std::runtime_error("Attempt to kill nonexistent walker in MCPopulation!");
+    dead_walkers_.push_back(std::move(*it_walkers));
+    walkers_.erase(it_walkers);
+    --num_local_walkers_;
+    return;
+  }
+
   // find the walker and move its pointer to the dead walkers vector
   auto it_walkers = walkers_.begin();
   auto it_psets   = walker_elec_particle_sets_.begin();
@@ -243,6 +309,44 @@ void MCPopulation::killWalker(MCPWalker& walker)
   throw std::runtime_error("Attempt to kill nonexistent walker in MCPopulation!");
 }
 
+void MCPopulation::killDeadWalkers()
+{
+  const bool use_slots = hasWalkerSlots();
+  size_t num_living    = 0;
+  for (size_t iw = 0; iw < walkers_.size(); ++iw)
+    if (static_cast<int>(walkers_[iw]->Multiplicity) == 0)
+    {
+      dead_walkers_.push_back(std::move(walkers_[iw]));
+      if (use_slots)
+        continue;
+      dead_walker_elec_particle_sets_.push_back(std::move(walker_elec_particle_sets_[iw]));
+      dead_walker_trial_wavefunctions_.push_back(std::move(walker_trial_wavefunctions_[iw]));
+      dead_walker_hamiltonians_.push_back(std::move(walker_hamiltonians_[iw]));
+    }
+    else
+    {
+      if (num_living != iw)
+      {
+        walkers_[num_living] = std::move(walkers_[iw]);
+        if (!use_slots)
+        {
+          walker_elec_particle_sets_[num_living]  = std::move(walker_elec_particle_sets_[iw]);
+          walker_trial_wavefunctions_[num_living] = std::move(walker_trial_wavefunctions_[iw]);
+          walker_hamiltonians_[num_living]        = std::move(walker_hamiltonians_[iw]);
+        }
+      }
+      ++num_living;
+    }
+
+  num_local_walkers_ -= walkers_.size() - num_living;
+  walkers_.resize(num_living);
+  if (use_slots)
+    return;
+  walker_elec_particle_sets_.resize(num_living);
+  walker_trial_wavefunctions_.resize(num_living);
+  walker_hamiltonians_.resize(num_living);
+}
+
 void MCPopulation::syncWalkersPerRank(Communicate* comm)
 {
   std::vector<IndexType> num_local_walkers_per_rank(comm->size(), 0);
@@ -257,11 +361,12 @@ void MCPopulation::measureGlobalEnergyVariance(Communicate& comm,
                                                FullPrecRealType& ener,
                                                FullPrecRealType& variance) const
 {
+  using WP = WalkerProperties::Indexes;
   std::vector<FullPrecRealType> weight_energy_variance(3, 0.0);
-  for (int iw = 0; iw < walker_elec_particle_sets_.size(); iw++)
+  for (int iw = 0; iw < walkers_.size(); iw++)
   {
     auto w = walkers_[iw]->Weight;
-    auto e = walker_hamiltonians_[iw]->getLocalEnergy();
+    auto e = walkers_[iw]->Properties(WP::LOCALENERGY);
     weight_energy_variance[0] += w;
     weight_energy_variance[1] += w * e;
     weight_energy_variance[2] += w * e * e;
@@ -278,6 +383,8 @@ void MCPopulation::set_variational_parameters(const opt_variables_type& active)
   {
     (*it_twfs).get()->resetParameters(active);
   }
+  for (auto& slot_twf : slot_trial_wavefunctions_)
+    slot_twf->resetParameters(active);
 }
 
 void MCPopulation::checkIntegrity() const
@@ -286,6 +393,17 @@ void MCPopulation::checkIntegrity() const
   const size_t num_local_walkers_active = num_local_walkers_;
   if (walkers_.size() != num_local_walkers_active)
     throw std::runtime_error("walkers_ has inconsistent size");
+
+  if (hasWalkerSlots())
+  {
+    if (!walker_elec_particle_sets_.empty() || !dead_walker_elec_particle_sets_.empty())
+      throw std::runtime_error("walker_elec_particle_sets_ must be empty with walker slots");
+    if (slot_trial_wavefunctions_.size() != slot_elec_particle_sets_.size() ||
+        slot_hamiltonians_.size() != slot_elec_particle_sets_.size())
+      throw std::runtime_error("walker slots have inconsistent sizes");
+    return;
+  }
+
   if (walker_elec_particle_sets_.size() != num_local_walkers_active)
     throw std::runtime_error("walker_elec_particle_sets_ has inconsistent size");
   if (walker_trial_wavefunctions_.size() != num_local_walkers_active)
@@ -309,9 +427,17 @@ void MCPopulation::checkIntegrity() const
 
 void MCPopulation::saveWalkerConfigurations()
 {
-  walker_configs_ref_.resize(walker_elec_particle_sets_.size(), elec_particle_set_->getTotalNum());
-  for (int iw = 0; iw < walker_elec_particle_sets_.size(); iw++)
-    walker_elec_particle_sets_[iw]->saveWalker(*walker_configs_ref_[iw]);
+  walker_configs_ref_.resize(walkers_.size(), elec_particle_set_->getTotalNum());
+  // with walker slots, the walkers are up to date after each step
+  if (hasWalkerSlots())
+    for (int iw = 0; iw < walkers_.size(); iw++)
+    {
+      walker_configs_ref_[iw]->R     = walkers_[iw]->R;
+      walker_configs_ref_[iw]->spins = walkers_[iw]->spins;
+    }
+  else
+    for (int iw = 0; iw < walker_elec_particle_sets_.size(); iw++)
+      walker_elec_particle_sets_[iw]->saveWalker(*walker_configs_ref_[iw]);
 }
 
 
@@ -83,6 +83,13 @@ private:
   UPtrVector<TrialWaveFunction> dead_walker_trial_wavefunctions_;
   UPtrVector<QMCHamiltonian> dead_walker_hamiltonians_;
 
+  /** With walker slots there is no element per walker, these are shared by the walkers
+   *  of the crowds and the walkers carry the wavefunction state in their DataSet.
+   */
+  UPtrVector<ParticleSet> slot_elec_particle_sets_;
+  UPtrVector<TrialWaveFunction> slot_trial_wavefunctions_;
+  UPtrVector<QMCHamiltonian> slot_hamiltonians_;
+
   // MCPopulation immutables
   // would be nice if they were const but we'd lose the default move assignment
   int num_ranks_;
@@ -116,20 +123,30 @@ public:
   WalkerElementsRef spawnWalker();
   void killWalker(MCPWalker&);
   void killLastWalker();
+  /** Kill all the walkers with zero Multiplicity in a single pass
+   *
+   *  The order of the living walkers is kept and the dead ones are added to the dead walkers in their order,
+   *  the same as calling killWalker on each of them without searching and erasing one at a time.
+   */
+  void killDeadWalkers();
   /** }@ */
 
   /** Creates walkers with a clone of the golden electron particle set and golden trial wavefunction
    *
    *  \param[in] num_walkers number of living walkers in initial population
    *  \param[in] reserve multiple above that to reserve >=1.0
+   *  \param[in] num_slots if > 0, number of element clones shared by all the walkers instead of a clone per walker
    */
-  void createWalkers(IndexType num_walkers, RealType reserve = 1.0);
+  void createWalkers(IndexType num_walkers, RealType reserve = 1.0, IndexType num_slots = 0);
 
   /** distributes walkers and their "cloned" elements to the elements of a vector
    *  of unique_ptr to "walker_consumers". 
    *
    *  a valid "walker_consumer" has a member function of
    *  void addWalker(MCPWalker& walker, ParticleSet& elecs, TrialWaveFunction& twf, QMCHamiltonian& hamiltonian);
+   *  and for walker slots
+   *  void addWalker(MCPWalker& walker);
+   *  void addWalkerSlot(ParticleSet& elecs, TrialWaveFunction& twf, QMCHamiltonian& hamiltonian);
    */
   template<typename WTTV>
   void redistributeWalkers(WTTV& walker_consumers)
@@ -137,17 +154,35 @@ public:
     // The type returned here is dependent on the integral type that the walker_consumers
     // use to return there size.
     auto walkers_per_crowd = fairDivide(walkers_.size(), walker_consumers.size());
+    // the slots of a consumer don't change, only its walkers do.
+    auto slots_per_crowd = fairDivide(slot_elec_particle_sets_.size(), walker_consumers.size());
 
     auto walker_index = 0;
+    auto slot_index   = 0;
     for (int i = 0; i < walker_consumers.size(); ++i)
     {
       walker_consumers[i]->clearWalkers();
-      for (int j = 0; j < walkers_per_crowd[i]; ++j)
+      if (hasWalkerSlots())
       {
-        walker_consumers[i]->addWalker(*walkers_[walker_index], *walker_elec_particle_sets_[walker_index],
-                                       *walker_trial_wavefunctions_[walker_index], *walker_hamiltonians_[walker_index]);
-        ++walker_index;
+        if (walkers_per_crowd[i] > 0 && slots_per_crowd[i] == 0)
+          throw std::runtime_error("MCPopulation::redistributeWalkers walkers assigned to a consumer without slots!");
+        for (int j = 0; j < slots_per_crowd[i]; ++j)
+        {
+          walker_consumers[i]->addWalkerSlot(*slot_elec_particle_sets_[slot_index],
+                                             *slot_trial_wavefunctions_[slot_index], *slot_hamiltonians_[slot_index]);
+          ++slot_index;
+        }
+        for (int j = 0; j < walkers_per_crowd[i]; ++j)
+          walker_consumers[i]->addWalker(*walkers_[walker_index++]);
       }
+      else
+        for (int j = 0; j < walkers_per_crowd[i]; ++j)
+        {
+          walker_consumers[i]->addWalker(*walkers_[walker_index], *walker_elec_particle_sets_[walker_index],
+                                         *walker_trial_wavefunctions_[walker_index],
+                                         *walker_hamiltonians_[walker_index]);
+          ++walker_index;
+        }
     }
   }
 
@@ -207,7 +242,13 @@ public:
   UPtrVector<QMCHamiltonian>& get_hamiltonians() { return walker_hamiltonians_; }
   UPtrVector<QMCHamiltonian>& get_dead_hamiltonians() { return dead_walker_hamiltonians_; }
 
+  /// true if the walkers share slots instead of having their own elements, the per walker element vectors are empty.
+  bool hasWalkerSlots() const { return !slot_elec_particle_sets_.empty(); }
+  UPtrVector<QMCHamiltonian>& get_slot_hamiltonians() { return slot_hamiltonians_; }
+
   /** Non threadsafe access to walkers and their elements
+   *
+   *  With walker slots, the golden elements are returned along with the walker.
    *  
    *  Prefer to distribute the walker elements and access
    *  through a crowd to support the concurrency design.
@@ -231,7 +272,7 @@ public:
   /** }@ */
 
 
-  /// Set variational parameters for the per-walker copies of the wavefunction.
+  /// Set variational parameters for the per-walker or per-slot copies of the wavefunction.
   void set_variational_parameters(const opt_variables_type& active);
 
   /// check if all the internal vector contain consistent sizes;
@@ -241,6 +282,10 @@ public:
 
   // save walker configurations to walker_configs_ref_
   void saveWalkerConfigurations();
+
+private:
+  /// register the walker data and the wavefunction state of a slot in the walker DataSet and allocate it.
+  void registerWalkerSlotData(MCPWalker& walker);
 };
 
 } // namespace qmcplusplus
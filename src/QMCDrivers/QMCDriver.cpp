@@ -67,8 +67,10 @@ QMCDriver::QMCDriver(MCWalkerConfiguration& w,
   //<parameter name=" "> value </parameter>
   //accept multiple names for the same value
   //recommend using all lower cases for a new parameter
-  Period4CheckPoint = -1;
-  storeConfigs      = 0;
+  Period4CheckPoint         = -1;
+  CheckPointSinglePrecision = false;
+  CheckPointAsync           = false;
+  storeConfigs              = 0;
   //m_param.add(storeConfigs,"storeConfigs");
   m_param.add(storeConfigs, "storeconfigs");
   m_param.add(storeConfigs, "store_configs");
@@ -227,6 +229,7 @@ void QMCDriver::process(xmlNodePtr cur)
   Estimators->put(H, cur);
   if (!wOut)
     wOut = std::make_unique<HDFWalkerOutput>(W.getTotalNum(), RootName, myComm);
+  wOut->setWriteMode(CheckPointSinglePrecision, CheckPointAsync);
   branchEngine->start(RootName);
   branchEngine->write(RootName);
   //use new random seeds
@@ -427,7 +430,9 @@ bool QMCDriver::putQMCInfo(xmlNodePtr cur)
   //int oldSteps=nSteps;
 
   //set the default walker to the number of threads times 10
-  Period4CheckPoint = -1;
+  Period4CheckPoint         = -1;
+  CheckPointSinglePrecision = false;
+  CheckPointAsync           = false;
   // set default for delayed update streak k to zero, meaning use the original Sherman-Morrison rank-1 update
   // if kdelay is set to k (k>1), then the new rank-k scheme is used
 #ifdef QMC_CUDA
@@ -462,10 +467,15 @@ bool QMCDriver::putQMCInfo(xmlNodePtr cur)
       }
       else if (cname == "checkpoint")
       {
+        std::string precision("double"), async("no");
         OhmmsAttributeSet rAttrib;
         rAttrib.add(Period4CheckPoint, "stride");
         rAttrib.add(Period4CheckPoint, "period");
+        rAttrib.add(precision, "precision", {"double", "single"});
+        rAttrib.add(async, "async", {"no", "yes"});
         rAttrib.put(tcur);
+        CheckPointSinglePrecision = precision == "single";
+        CheckPointAsync           = async == "yes";
         //DumpConfig=(Period4CheckPoint>0);
       }
       else if (cname == "dumpconfig")
@@ -227,6 +227,10 @@ protected:
    * The unit is a block.
    */
   int Period4CheckPoint;
+  ///checkpoint walker positions in single precision
+  bool CheckPointSinglePrecision;
+  ///write checkpoint walker configurations on a background thread
+  bool CheckPointAsync;
   /** period of dumping walker positions and IDs for Forward Walking
   *
   * The unit is in steps.
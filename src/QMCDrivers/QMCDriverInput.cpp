@@ -38,6 +38,7 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
   std::string serialize_walkers;
   std::string debug_checks_str;
   std::string measure_imbalance_str;
+  std::string async_estimators_str;
 
   ParameterSet parameter_set;
   parameter_set.add(store_config_period_, "storeconfigs");
@@ -55,6 +56,7 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
   parameter_set.add(warmup_steps_, "warmupsteps");
   parameter_set.add(warmup_steps_, "warmup_steps");
   parameter_set.add(num_crowds_, "crowds");
+  parameter_set.add(walker_slots_, "walker_slots");
   parameter_set.add(serialize_walkers, "crowd_serialize_walkers", {"no", "yes"});
   parameter_set.add(walkers_per_rank_, "walkers_per_rank");
   parameter_set.add(walkers_per_rank_, "walkers", {}, TagStatus::UNSUPPORTED);
@@ -73,6 +75,7 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
   parameter_set.add(debug_checks_str, "debug_checks",
                     {"no", "all", "checkGL_after_load", "checkGL_after_moves", "checkGL_after_tmove"});
   parameter_set.add(measure_imbalance_str, "measure_imbalance", {"no", "yes"});
+  parameter_set.add(async_estimators_str, "async_estimators", {"no", "yes"});
 
   OhmmsAttributeSet aAttrib;
   // first stage in from QMCDriverFactory
@@ -132,6 +135,9 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
     }
   }
 
+  if (walker_slots_ < 0)
+    throw std::runtime_error("walker_slots must be non-negative.");
+
   crowd_serialize_walkers_ = serialize_walkers == "yes";
   if (crowd_serialize_walkers_)
     app_summary() << "  Batched operations are serialized over walkers." << std::endl;
@@ -153,6 +159,9 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
   if (measure_imbalance_str == "yes")
     measure_imbalance_ = true;
 
+  if (async_estimators_str == "yes")
+    async_estimators_ = true;
+
   if (check_point_period_.period < 1)
     check_point_period_.period = max_blocks_;
 }
@@ -47,6 +47,8 @@ protected:
   DriverDebugChecks debug_checks_ = DriverDebugChecks::ALL_OFF;
   /// measure load imbalance (add a barrier) before data aggregation (obvious synchronization)
   bool measure_imbalance_ = false;
+  /// reduce and write the operator estimators in the background while the next block runs
+  bool async_estimators_ = false;
 
   /** @ingroup Input Parameters for QMCDriver base class
    *  @{
@@ -66,6 +68,8 @@ protected:
   input::PeriodStride config_dump_period_;
   IndexType starting_step_ = 0;
   IndexType num_crowds_    = 0;
+  /// number of ParticleSet/TrialWaveFunction/QMCHamiltonian slots per crowd, 0 for a set per walker
+  IndexType walker_slots_ = 0;
   // This is the global walkers it is a hard limit for VMC and the target for DMC
   IndexType total_walkers_     = 0;
   IndexType walkers_per_rank_  = 0;
@@ -114,6 +118,7 @@ public:
   input::PeriodStride get_config_dump_period() const { return config_dump_period_; }
   IndexType get_starting_step() const { return starting_step_; }
   IndexType get_num_crowds() const { return num_crowds_; }
+  IndexType get_walker_slots() const { return walker_slots_; }
   IndexType get_walkers_per_rank() const { return walkers_per_rank_; }
   IndexType get_total_walkers() const { return total_walkers_; }
   IndexType get_requested_samples() const { return requested_samples_; }
@@ -140,6 +145,7 @@ public:
   bool get_scoped_profiling() const { return scoped_profiling_; }
   bool are_walkers_serialized() const { return crowd_serialize_walkers_; }
   bool get_measure_imbalance() const { return measure_imbalance_; }
+  bool get_async_estimators() const { return async_estimators_; }
 
   const std::string get_drift_modifier() const { return drift_modifier_; }
   RealType get_drift_modifier_unr_a() const { return drift_modifier_unr_a_; }
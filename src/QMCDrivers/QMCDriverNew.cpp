@@ -83,6 +83,7 @@ QMCDriverNew::QMCDriverNew(const ProjectData& project_data,
                                                                       qmcdriver_input_.get_estimator_manager_input()),
                                             population_.get_golden_hamiltonian(), *population.get_golden_electrons(),
                                             population.get_golden_twf());
+  estimator_manager_->setAsyncReduction(qmcdriver_input_.get_async_estimators());
 
   drift_modifier_.reset(
       createDriftModifier(qmcdriver_input_.get_drift_modifier(), qmcdriver_input_.get_drift_modifier_unr_a()));
@@ -156,7 +157,11 @@ void QMCDriverNew::startup(xmlNodePtr cur, const QMCDriverNew::AdjustedWalkerCou
   // set num_global_walkers explicitly and then make local walkers.
   population_.set_num_global_walkers(awc.global_walkers);
 
-  makeLocalWalkers(awc.walkers_per_rank[myComm->rank()], awc.reserve_walkers);
+  const IndexType num_slots = awc.walkers_per_crowd.size() * qmcdriver_input_.get_walker_slots();
+  if (num_slots > 0)
+    app_summary() << "  Walkers share " << qmcdriver_input_.get_walker_slots() << " object slots per crowd."
+                  << std::endl;
+  makeLocalWalkers(awc.walkers_per_rank[myComm->rank()], awc.reserve_walkers, num_slots);
 
   if (dispatchers_.are_walkers_batched())
   {
@@ -257,13 +262,13 @@ bool QMCDriverNew::finalize(int block, bool dumpwalkers)
   return true;
 }
 
-void QMCDriverNew::makeLocalWalkers(IndexType nwalkers, RealType reserve)
+void QMCDriverNew::makeLocalWalkers(IndexType nwalkers, RealType reserve, IndexType num_slots)
 {
   ScopedTimer local_timer(timers_.create_walkers_timer);
   // ensure nwalkers local walkers in population_
   if (population_.get_walkers().size() == 0)
   {
-    population_.createWalkers(nwalkers, reserve);
+    population_.createWalkers(nwalkers, reserve, num_slots);
   }
   else if (population_.get_walkers().size() < nwalkers)
   {
@@ -287,6 +292,9 @@ void QMCDriverNew::makeLocalWalkers(IndexType nwalkers, RealType reserve)
   for (UPtr<QMCHamiltonian>& ham : population_.get_dead_hamiltonians())
     setNonLocalMoveHandler_(*ham);
 
+  for (UPtr<QMCHamiltonian>& ham : population_.get_slot_hamiltonians())
+    setNonLocalMoveHandler_(*ham);
+
   // setWalkerOffsets();
   // ////update the global number of walkers
   // ////int nw=W.getActiveWalkers();
@@ -320,13 +328,20 @@ void QMCDriverNew::createRngsStepContexts(int num_crowds)
 
 void QMCDriverNew::initialLogEvaluation(int crowd_id,
                                         UPtrVector<Crowd>& crowds,
-                                        UPtrVector<ContextForSteps>& context_for_steps)
+                                        UPtrVector<ContextForSteps>& context_for_steps,
+                                        NewTimer& buffer_timer)
 {
   Crowd& crowd = *(crowds[crowd_id]);
   if (crowd.size() == 0)
     return;
 
   crowd.setRNGForHamiltonian(context_for_steps[crowd_id]->get_random_gen());
+  // with walker slots, the walkers of the crowd go through the slots one batch at a time.
+  crowd.forEachWalkerBatch(buffer_timer, [&crowd] { initialLogEvaluationLoadedWalkers(crowd); });
+}
+
+void QMCDriverNew::initialLogEvaluationLoadedWalkers(Crowd& crowd)
+{
   auto& ps_dispatcher  = crowd.dispatchers_.ps_dispatcher_;
   auto& twf_dispatcher = crowd.dispatchers_.twf_dispatcher_;
   auto& ham_dispatcher = crowd.dispatchers_.ham_dispatcher_;
@@ -349,7 +364,7 @@ void QMCDriverNew::initialLogEvaluation(int crowd_id,
   // For consistency this should be in ParticleSet as a flex call, but I think its a problem
   // in the algorithm logic and should be removed.
   auto saveElecPosAndGLToWalkers = [](ParticleSet& pset, ParticleSet::Walker_t& walker) { pset.saveWalker(walker); };
-  for (int iw = 0; iw < crowd.size(); ++iw)
+  for (int iw = 0; iw < walkers.size(); ++iw)
     saveElecPosAndGLToWalkers(walker_elecs[iw], walkers[iw]);
 
   std::vector<QMCHamiltonian::FullPrecRealType> local_energies(
@@ -359,19 +374,19 @@ void QMCDriverNew::initialLogEvaluation(int crowd_id,
   auto resetSigNLocalEnergy = [](MCPWalker& walker, TrialWaveFunction& twf, auto local_energy) {
     walker.resetProperty(twf.getLogPsi(), twf.getPhase(), local_energy);
   };
-  for (int iw = 0; iw < crowd.size(); ++iw)
+  for (int iw = 0; iw < walkers.size(); ++iw)
     resetSigNLocalEnergy(walkers[iw], walker_twfs[iw], local_energies[iw]);
 
   auto evaluateNonPhysicalHamiltonianElements = [](QMCHamiltonian& ham, ParticleSet& pset, MCPWalker& walker) {
     ham.auxHevaluate(pset, walker);
   };
-  for (int iw = 0; iw < crowd.size(); ++iw)
+  for (int iw = 0; iw < walkers.size(); ++iw)
     evaluateNonPhysicalHamiltonianElements(walker_hamiltonians[iw], walker_elecs[iw], walkers[iw]);
 
   auto savePropertiesIntoWalker = [](QMCHamiltonian& ham, MCPWalker& walker) {
     ham.saveProperty(walker.getPropertyBase());
   };
-  for (int iw = 0; iw < crowd.size(); ++iw)
+  for (int iw = 0; iw < walkers.size(); ++iw)
     savePropertiesIntoWalker(walker_hamiltonians[iw], walkers[iw]);
 
   auto doesDoinTheseLastMatter = [](MCPWalker& walker) {
@@ -380,7 +395,7 @@ void QMCDriverNew::initialLogEvaluation(int crowd_id,
     walker.Weight             = 1;
     walker.wasTouched         = false;
   };
-  for (int iw = 0; iw < crowd.size(); ++iw)
+  for (int iw = 0; iw < walkers.size(); ++iw)
     doesDoinTheseLastMatter(walkers[iw]);
 }
 
@@ -142,9 +142,10 @@ public:
 
   /** Adjust populations local walkers to this number
   * @param nwalkers number of walkers to add
+  * @param num_slots number of object slots shared by the walkers, 0 for objects per walker
   *
   */
-  void makeLocalWalkers(int nwalkers, RealType reserve);
+  void makeLocalWalkers(int nwalkers, RealType reserve, int num_slots = 0);
 
   DriftModifierBase& get_drift_modifier() const { return *drift_modifier_; }
 
@@ -239,7 +240,12 @@ public:
    */
   void startup(xmlNodePtr cur, const QMCDriverNew::AdjustedWalkerCounts& awc);
 
-  static void initialLogEvaluation(int crowd_id, UPtrVector<Crowd>& crowds, UPtrVector<ContextForSteps>& step_context);
+  static void initialLogEvaluation(int crowd_id,
+                                   UPtrVector<Crowd>& crowds,
+                                   UPtrVector<ContextForSteps>& step_context,
+                                   NewTimer& buffer_timer);
+  /// initial evaluation of the walkers loaded in the crowd
+  static void initialLogEvaluationLoadedWalkers(Crowd& crowd);
 
 
   /** should be set in input don't see a reason to set individually
@@ -39,12 +39,18 @@ VMCBatched::VMCBatched(const ProjectData& project_data,
                    std::move(pop),
                    "VMCBatched::",
                    comm,
-                   "VMCBatched"),
+                   "VMCBatched",
+                   &VMCBatched::setNonLocalMoveHandler),
       vmcdriver_input_(input),
       samples_(samples),
       collect_samples_(false)
 {}
 
+void VMCBatched::setNonLocalMoveHandler(QMCHamiltonian& golden_hamiltonian)
+{
+  golden_hamiltonian.setNonLocalPairSampling(true);
+}
+
 template<CoordsType CT>
 void VMCBatched::advanceWalkers(const StateForThread& sft,
                                 Crowd& crowd,
@@ -73,7 +79,7 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
     checkLogAndGL(crowd, "checkGL_after_load");
 
   timers.movepbyp_timer.start();
-  const int num_walkers   = crowd.size();
+  const int num_walkers   = walkers.size();
   auto& walker_leader     = walker_elecs.getLeader();
   const int num_particles = walker_leader.getTotalNum();
   // Note std::vector<bool> is not like the rest of stl.
@@ -186,7 +192,7 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
   auto resetSigNLocalEnergy = [](MCPWalker& walker, TrialWaveFunction& twf, auto& local_energy) {
     walker.resetProperty(twf.getLogPsi(), twf.getPhase(), local_energy);
   };
-  for (int iw = 0; iw < crowd.size(); ++iw)
+  for (int iw = 0; iw < walkers.size(); ++iw)
     resetSigNLocalEnergy(walkers[iw], walker_twfs[iw], local_energies[iw]);
 
   // moved to be consistent with DMC
@@ -194,13 +200,13 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
   auto evaluateNonPhysicalHamiltonianElements = [](QMCHamiltonian& ham, ParticleSet& pset, MCPWalker& walker) {
     ham.auxHevaluate(pset, walker);
   };
-  for (int iw = 0; iw < crowd.size(); ++iw)
+  for (int iw = 0; iw < walkers.size(); ++iw)
     evaluateNonPhysicalHamiltonianElements(walker_hamiltonians[iw], walker_elecs[iw], walkers[iw]);
 
   auto savePropertiesIntoWalker = [](QMCHamiltonian& ham, MCPWalker& walker) {
     ham.saveProperty(walker.getPropertyBase());
   };
-  for (int iw = 0; iw < crowd.size(); ++iw)
+  for (int iw = 0; iw < walkers.size(); ++iw)
     savePropertiesIntoWalker(walker_hamiltonians[iw], walkers[iw]);
   timers.collectables_timer.stop();
 
@@ -245,12 +251,34 @@ void VMCBatched::runVMCStep(int crowd_id,
   // For VMC we don't call this method for warmup steps.
   const bool accumulate_this_step = true;
   const bool spin_move            = sft.population.get_golden_electrons()->isSpinor();
-  if (spin_move)
-    advanceWalkers<CoordsType::POS_SPIN>(sft, crowd, timers, *context_for_steps[crowd_id], recompute_this_step,
-                                         accumulate_this_step);
-  else
-    advanceWalkers<CoordsType::POS>(sft, crowd, timers, *context_for_steps[crowd_id], recompute_this_step,
-                                    accumulate_this_step);
+  crowd.forEachWalkerBatch(timers.buffer_timer, [&] {
+    if (spin_move)
+      advanceWalkers<CoordsType::POS_SPIN>(sft, crowd, timers, *context_for_steps[crowd_id], recompute_this_step,
+                                           accumulate_this_step);
+    else
+      advanceWalkers<CoordsType::POS>(sft, crowd, timers, *context_for_steps[crowd_id], recompute_this_step,
+                                      accumulate_this_step);
+  });
+}
+
+void VMCBatched::runWarmupStep(int crowd_id,
+                               const StateForThread& sft,
+                               DriverTimers& timers,
+                               std::vector<std::unique_ptr<ContextForSteps>>& context_for_steps,
+                               std::vector<std::unique_ptr<Crowd>>& crowds)
+{
+  Crowd& crowd                    = *(crowds[crowd_id]);
+  const bool recompute            = false;
+  const bool accumulate_this_step = false;
+  const bool spin_move            = sft.population.get_golden_electrons()->isSpinor();
+  crowd.forEachWalkerBatch(timers.buffer_timer, [&] {
+    if (spin_move)
+      advanceWalkers<CoordsType::POS_SPIN>(sft, crowd, timers, *context_for_steps[crowd_id], recompute,
+                                           accumulate_this_step);
+    else
+      advanceWalkers<CoordsType::POS>(sft, crowd, timers, *context_for_steps[crowd_id], recompute,
+                                      accumulate_this_step);
+  });
 }
 
 void VMCBatched::process(xmlNodePtr node)
@@ -306,7 +334,8 @@ bool VMCBatched::run()
   { // walker initialization
     ScopedTimer local_timer(timers_.init_walkers_timer);
     ParallelExecutor<> section_start_task;
-    section_start_task(crowds_.size(), initialLogEvaluation, std::ref(crowds_), std::ref(step_contexts_));
+    section_start_task(crowds_.size(), initialLogEvaluation, std::ref(crowds_), std::ref(step_contexts_),
+                       std::ref(timers_.buffer_timer));
     print_mem("VMCBatched after initialLogEvaluation", app_summary());
     if (qmcdriver_input_.get_measure_imbalance())
       measureImbalance("InitialLogEvaluation");
@@ -318,20 +347,6 @@ bool VMCBatched::run()
   if (qmcdriver_input_.get_warmup_steps() > 0)
   {
     // Run warm-up steps
-    auto runWarmupStep = [](int crowd_id, StateForThread& sft, DriverTimers& timers,
-                            UPtrVector<ContextForSteps>& context_for_steps, UPtrVector<Crowd>& crowds) {
-      Crowd& crowd                    = *(crowds[crowd_id]);
-      const bool recompute            = false;
-      const bool accumulate_this_step = false;
-      const bool spin_move            = sft.population.get_golden_electrons()->isSpinor();
-      if (spin_move)
-        advanceWalkers<CoordsType::POS_SPIN>(sft, crowd, timers, *context_for_steps[crowd_id], recompute,
-                                             accumulate_this_step);
-      else
-        advanceWalkers<CoordsType::POS>(sft, crowd, timers, *context_for_steps[crowd_id], recompute,
-                                        accumulate_this_step);
-    };
-
     for (int step = 0; step < qmcdriver_input_.get_warmup_steps(); ++step)
     {
       ScopedTimer local_timer(timers_.run_steps_timer);
@@ -369,11 +384,13 @@ bool VMCBatched::run()
 
       if (collect_samples_)
       {
-        const auto& elec_psets = population_.get_elec_particle_sets();
-        for (const auto& walker : elec_psets)
-        {
-          samples_.appendSample(MCSample(*walker));
-        }
+        // with walker slots, the walkers hold the configurations
+        if (population_.hasWalkerSlots())
+          for (const auto& walker : population_.get_walkers())
+            samples_.appendSample(MCSample(*walker));
+        else
+          for (const auto& walker : population_.get_elec_particle_sets())
+            samples_.appendSample(MCSample(*walker));
       }
     }
     print_mem("VMCBatched after a block", app_debug_stream());
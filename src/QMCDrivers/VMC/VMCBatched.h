@@ -97,6 +97,13 @@ public:
                          std::vector<std::unique_ptr<ContextForSteps>>& context_for_steps,
                          std::vector<std::unique_ptr<Crowd>>& crowds);
 
+  // task body of a warm-up step, walkers move without accumulating
+  static void runWarmupStep(int crowd_id,
+                            const StateForThread& sft,
+                            DriverTimers& timers,
+                            std::vector<std::unique_ptr<ContextForSteps>>& context_for_steps,
+                            std::vector<std::unique_ptr<Crowd>>& crowds);
+
   /** transitional interface on the way to better walker count adjustment handling.
    *  returns a closure taking walkers per rank and accomplishing what calc_default_local_walkers does.
    */
@@ -110,6 +117,11 @@ public:
    */
   void enable_sample_collection();
 
+  /** VMC has no nonlocal moves, the NLPP may sample the electron-ion pairs
+   *  since the energy enters the VMC estimators linearly.
+   */
+  static void setNonLocalMoveHandler(QMCHamiltonian& golden_hamiltonian);
+
 private:
   int prevSteps;
   int prevStepsBetweenSamples;
@@ -47,6 +47,15 @@ public:
     walker_hamiltonians_.push_back(hamiltonian);
   }
 
+  void addWalker(Walker<QMCTraits, PtclOnLatticeTraits>& walker) { walkers.push_back(walker); }
+
+  void addWalkerSlot(ParticleSet& elecs, TrialWaveFunction& twf, QMCHamiltonian& hamiltonian)
+  {
+    walker_elecs_.push_back(elecs);
+    walker_twfs_.push_back(twf);
+    walker_hamiltonians_.push_back(hamiltonian);
+  }
+
   void clearWalkers()
   {
     // We're clearing the refs to the objects not the referred to objects.
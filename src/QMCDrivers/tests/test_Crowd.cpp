@@ -14,6 +14,7 @@
 #include "Configuration.h"
 #include "Message/Communicate.h"
 #include "QMCDrivers/Crowd.h"
+#include "QMCDrivers/MCPopulation.h"
 #include "type_traits/template_types.hpp"
 #include "Estimators/EstimatorManagerNew.h"
 #include "QMCWaveFunctions/tests/MinimalWaveFunctionPool.h"
@@ -105,4 +106,59 @@ TEST_CASE("Crowd redistribute walkers")
   REQUIRE(crowd.size() == 3);
 }
 
+TEST_CASE("Crowd walker slots", "[drivers]")
+{
+  using namespace testing;
+  using MCPWalker = Walker<QMCTraits, PtclOnLatticeTraits>;
+  SetupPools pools;
+
+  EstimatorManagerNew em(*pools.hamiltonian_pool->getPrimary(), pools.comm);
+  const MultiWalkerDispatchers dispatchers(true);
+  DriverWalkerResourceCollection driverwalker_resource_collection_;
+  UPtrVector<Crowd> crowds;
+  crowds.emplace_back(std::make_unique<Crowd>(em, driverwalker_resource_collection_, dispatchers));
+  Crowd& crowd = *crowds[0];
+
+  WalkerConfigurations walker_confs;
+  MCPopulation population(1, pools.comm->rank(), walker_confs, pools.particle_pool->getParticleSet("e"),
+                          pools.wavefunction_pool->getPrimary(), pools.hamiltonian_pool->getPrimary());
+  population.createWalkers(3, 1.0, 2);
+  auto& walkers = population.get_walkers();
+  for (int iw = 0; iw < walkers.size(); ++iw)
+    walkers[iw]->R[0] = TinyVector<double, 3>(0.1 * iw, 0.2, 0.3);
+  population.redistributeWalkers(crowds);
+
+  REQUIRE(crowd.hasWalkerSlots());
+  CHECK(crowd.size() == 3);
+  REQUIRE(crowd.getNumWalkerBatches() == 2);
+
+  std::vector<double> logs;
+  for (int batch = 0; batch < crowd.getNumWalkerBatches(); ++batch)
+  {
+    crowd.loadWalkerBatch(batch);
+    auto& elecs = crowd.get_walker_elecs();
+    auto& twfs  = crowd.get_walker_twfs();
+    for (int iw = 0; iw < crowd.get_walkers().size(); ++iw)
+      logs.push_back(std::real(twfs[iw].get().evaluateLog(elecs[iw])));
+    crowd.storeWalkerBatch();
+  }
+  REQUIRE(logs.size() == 3);
+  CHECK(logs[0] != Approx(logs[1]));
+
+  // the slots are reused by the second batch, the walkers carry their own state
+  for (int batch = 0; batch < crowd.getNumWalkerBatches(); ++batch)
+  {
+    crowd.loadWalkerBatch(batch);
+    for (int iw = 0; iw < crowd.get_walkers().size(); ++iw)
+    {
+      MCPWalker& walker = crowd.get_walkers()[iw];
+      const int windex  = batch * 2 + iw;
+      CHECK(crowd.get_walker_elecs()[iw].get().R[0][0] == Approx(0.1 * windex));
+      CHECK(std::real(crowd.get_walker_twfs()[iw].get().getLogPsi()) == Approx(logs[windex]));
+      CHECK(&walker == walkers[windex].get());
+    }
+    crowd.storeWalkerBatch();
+  }
+}
+
 } // namespace qmcplusplus
@@ -86,4 +86,96 @@ TEST_CASE("MCPopulation::redistributeWalkers", "[particle][population]")
   REQUIRE((*walker_consumers_incommensurate[2]).walkers.size() == 2);
 }
 
+TEST_CASE("MCPopulation::redistributeWalkers walker slots", "[particle][population]")
+{
+  using namespace testing;
+  Communicate* comm;
+  comm = OHMMS::Controller;
+
+  auto particle_pool     = MinimalParticlePool::make_diamondC_1x1x1(comm);
+  auto wavefunction_pool = MinimalWaveFunctionPool::make_diamondC_1x1x1(comm, particle_pool);
+  auto hamiltonian_pool  = MinimalHamiltonianPool::make_hamWithEE(comm, particle_pool, wavefunction_pool);
+  WalkerConfigurations walker_confs;
+  MCPopulation population(1, comm->rank(), walker_confs, particle_pool.getParticleSet("e"),
+                          wavefunction_pool.getPrimary(), hamiltonian_pool.getPrimary());
+
+  population.createWalkers(8, 2.0, 3);
+  REQUIRE(population.hasWalkerSlots());
+  CHECK(population.get_walkers().size() == 8);
+  CHECK(population.get_dead_walkers().size() == 8);
+  // walkers carry no objects of their own
+  CHECK(population.get_elec_particle_sets().size() == 0);
+  CHECK(population.get_twfs().size() == 0);
+  CHECK(population.get_slot_hamiltonians().size() == 3);
+  // all the walkers share the buffer layout of the slots
+  for (auto& walker : population.get_walkers())
+    CHECK(walker->DataSet.size() == population.get_walkers()[0]->DataSet.size());
+
+  std::vector<std::unique_ptr<WalkerConsumer>> walker_consumers(2);
+  std::for_each(walker_consumers.begin(), walker_consumers.end(),
+                [](std::unique_ptr<WalkerConsumer>& wc) { wc.reset(new WalkerConsumer()); });
+  population.redistributeWalkers(walker_consumers);
+  CHECK(walker_consumers[0]->walkers.size() == 4);
+  CHECK(walker_consumers[0]->walker_elecs_.size() == 2);
+  CHECK(walker_consumers[1]->walkers.size() == 4);
+  CHECK(walker_consumers[1]->walker_twfs_.size() == 1);
+
+  population.killLastWalker();
+  CHECK(population.get_walkers().size() == 7);
+  population.spawnWalker();
+  CHECK(population.get_walkers().size() == 8);
+
+  // more consumers than slots leaves some consumer with walkers but no slot
+  std::vector<std::unique_ptr<WalkerConsumer>> walker_consumers_too_many(4);
+  std::for_each(walker_consumers_too_many.begin(), walker_consumers_too_many.end(),
+                [](std::unique_ptr<WalkerConsumer>& wc) { wc.reset(new WalkerConsumer()); });
+  CHECK_THROWS(population.redistributeWalkers(walker_consumers_too_many));
+}
+
+TEST_CASE("MCPopulation::killDeadWalkers", "[particle][population]")
+{
+  using namespace testing;
+  Communicate* comm;
+  comm = OHMMS::Controller;
+
+  auto particle_pool     = MinimalParticlePool::make_diamondC_1x1x1(comm);
+  auto wavefunction_pool = MinimalWaveFunctionPool::make_diamondC_1x1x1(comm, particle_pool);
+  auto hamiltonian_pool  = MinimalHamiltonianPool::make_hamWithEE(comm, particle_pool, wavefunction_pool);
+  WalkerConfigurations walker_confs;
+  MCPopulation population(1, comm->rank(), walker_confs, particle_pool.getParticleSet("e"),
+                          wavefunction_pool.getPrimary(), hamiltonian_pool.getPrimary());
+
+  population.createWalkers(6, 2.0);
+  auto& walkers = population.get_walkers();
+  std::vector<MCPopulation::MCPWalker*> living;
+  std::vector<ParticleSet*> living_psets;
+  for (int iw = 0; iw < walkers.size(); ++iw)
+  {
+    walkers[iw]->Multiplicity = (iw % 3 == 1) ? 0.0 : 1.0;
+    if (iw % 3 != 1)
+    {
+      living.push_back(walkers[iw].get());
+      living_psets.push_back(population.get_elec_particle_sets()[iw].get());
+    }
+  }
+  MCPopulation::MCPWalker* first_dead = walkers[1].get();
+
+  population.killDeadWalkers();
+  CHECK(population.get_num_local_walkers() == 4);
+  REQUIRE(walkers.size() == 4);
+  CHECK(population.get_dead_walkers().size() == 8);
+  for (int iw = 0; iw < walkers.size(); ++iw)
+  {
+    CHECK(walkers[iw].get() == living[iw]);
+    CHECK(population.get_elec_particle_sets()[iw].get() == living_psets[iw]);
+  }
+  population.checkIntegrity();
+
+  // the last killed walker is the first one recycled
+  population.spawnWalker();
+  population.spawnWalker();
+  CHECK(walkers.back().get() == first_dead);
+  CHECK(population.get_dead_walkers().size() == 6);
+}
+
 } // namespace qmcplusplus
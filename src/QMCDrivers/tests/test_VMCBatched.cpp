@@ -22,6 +22,7 @@
 #include "Concurrency/Info.hpp"
 #include "Concurrency/UtilityFunctions.hpp"
 #include "Particle/SampleStack.h"
+#include "Platforms/Host/OutputManager.h"
 
 namespace qmcplusplus
 {
@@ -52,6 +53,86 @@ public:
     auto hamiltonian_pool  = MinimalHamiltonianPool::make_hamWithEE(comm_, particle_pool, wavefunction_pool);
   }
 
+  /** warm-up with fewer walker slots than walkers must move and store every walker
+   */
+  void testWarmupWithWalkerSlots()
+  {
+    using namespace testing;
+    Concurrency::OverrideMaxCapacity<> override(8);
+    outputManager.pause();
+
+    const char* vmc_input = R"(
+  <qmc method="vmc" move="pbyp">
+    <parameter name="crowds">                 1 </parameter>
+    <estimator name="LocalEnergy" hdf5="no" />
+    <parameter name="walkers_per_rank">       3 </parameter>
+    <parameter name="walker_slots">           1 </parameter>
+    <parameter name="warmupSteps">            2 </parameter>
+    <parameter name="substeps">               1 </parameter>
+    <parameter name="steps">                  1 </parameter>
+    <parameter name="blocks">                 1 </parameter>
+    <parameter name="timestep">             1.0 </parameter>
+    <parameter name="usedrift">              no </parameter>
+  </qmc>
+)";
+    Libxml2Document doc;
+    REQUIRE(doc.parseFromString(vmc_input));
+    xmlNodePtr node = doc.getRoot();
+    QMCDriverInput qmcdriver_input;
+    qmcdriver_input.readXML(node);
+    VMCDriverInput vmcdriver_input;
+    vmcdriver_input.readXML(node);
+
+    auto particle_pool     = MinimalParticlePool::make_diamondC_1x1x1(comm_);
+    auto wavefunction_pool = MinimalWaveFunctionPool::make_diamondC_1x1x1(comm_, particle_pool);
+    auto hamiltonian_pool  = MinimalHamiltonianPool::make_hamWithEE(comm_, particle_pool, wavefunction_pool);
+    SampleStack samples;
+    WalkerConfigurations walker_confs;
+    ProjectData test_project;
+    VMCBatched vmc_batched(test_project, std::move(qmcdriver_input), std::nullopt, std::move(vmcdriver_input),
+                           MCPopulation(comm_->size(), comm_->rank(), walker_confs, particle_pool.getParticleSet("e"),
+                                        wavefunction_pool.getPrimary(), hamiltonian_pool.getPrimary()),
+                           samples, comm_);
+    vmc_batched.setStatus("Test", "", false);
+    outputManager.resume();
+    vmc_batched.process(node);
+
+    auto& population = vmc_batched.population_;
+    auto& crowds     = vmc_batched.crowds_;
+    REQUIRE(population.hasWalkerSlots());
+    REQUIRE(crowds.size() == 1);
+    REQUIRE(crowds[0]->getNumWalkerBatches() == 3);
+    VMCBatched::initialLogEvaluation(0, crowds, vmc_batched.step_contexts_, vmc_batched.timers_.buffer_timer);
+
+    const auto& walkers = population.get_walkers();
+    std::vector<ParticleSet::ParticlePos> initial_R;
+    for (const auto& walker : walkers)
+      initial_R.push_back(walker->R);
+
+    VMCBatched::StateForThread vmc_state(vmc_batched.qmcdriver_input_, vmc_batched.vmcdriver_input_,
+                                         *vmc_batched.drift_modifier_, population);
+    for (int step = 0; step < 2; ++step)
+      VMCBatched::runWarmupStep(0, vmc_state, vmc_batched.timers_, vmc_batched.step_contexts_, crowds);
+
+    // every walker moved and its stored log psi matches a fresh evaluation
+    Crowd& crowd = *crowds[0];
+    for (int iw = 0; iw < walkers.size(); ++iw)
+    {
+      int num_moved = 0;
+      for (int iat = 0; iat < initial_R[iw].size(); ++iat)
+        if (walkers[iw]->R[iat] != initial_R[iw][iat])
+          ++num_moved;
+      CHECK(num_moved > 0);
+
+      crowd.loadWalkerBatch(iw);
+      ParticleSet& elecs     = crowd.get_walker_elecs()[0];
+      TrialWaveFunction& twf = crowd.get_walker_twfs()[0];
+      const auto stored_log  = twf.getLogPsi();
+      CHECK(std::real(twf.evaluateLog(elecs)) == Approx(stored_log));
+      crowd.storeWalkerBatch();
+    }
+  }
+
 private:
   Communicate* comm_;
 };
@@ -64,4 +145,11 @@ TEST_CASE("VMCBatched::calc_default_local_walkers", "[drivers]")
   vbt.testCalcDefaultLocalWalkers();
 }
 
+TEST_CASE("VMCBatched warm-up with walker slots", "[drivers]")
+{
+  using namespace testing;
+  VMCBatchedTest vbt;
+  vbt.testWarmupWithWalkerSlots();
+}
+
 } // namespace qmcplusplus
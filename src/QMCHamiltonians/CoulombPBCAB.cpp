@@ -111,6 +111,34 @@ CoulombPBCAB::Return_t CoulombPBCAB::evaluate(ParticleSet& P)
   return value_;
 }
 
+void CoulombPBCAB::mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                               const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                               const RefVectorWithLeader<ParticleSet>& p_list) const
+{
+  auto& o_leader = o_list.getCastedLeader<CoulombPBCAB>();
+  assert(this == &o_list.getLeader());
+
+#if !defined(REMOVE_TRACEMANAGER)
+  if (o_leader.streaming_particles_)
+  {
+    OperatorBase::mw_evaluate(o_list, wf_list, p_list);
+    return;
+  }
+#endif
+  if (ComputeForces)
+  {
+    OperatorBase::mw_evaluate(o_list, wf_list, p_list);
+    return;
+  }
+
+  const auto short_range_results = mw_evalSR(o_list, p_list);
+  for (int iw = 0; iw < o_list.size(); iw++)
+  {
+    auto& coulomb_ab  = o_list.getCastedElement<CoulombPBCAB>(iw);
+    coulomb_ab.value_ = coulomb_ab.evalLR(p_list[iw]) + short_range_results[iw] + myConst;
+  }
+}
+
 CoulombPBCAB::Return_t CoulombPBCAB::evaluateWithIonDerivs(ParticleSet& P,
                                                            ParticleSet& ions,
                                                            TrialWaveFunction& psi,
@@ -310,6 +338,53 @@ CoulombPBCAB::Return_t CoulombPBCAB::evalSR(ParticleSet& P)
 }
 
 
+std::vector<CoulombPBCAB::Return_t> CoulombPBCAB::mw_evalSR(const RefVectorWithLeader<OperatorBase>& o_list,
+                                                            const RefVectorWithLeader<ParticleSet>& p_list)
+{
+  constexpr mRealType czero(0);
+  auto& cab_leader = o_list.getCastedLeader<CoulombPBCAB>();
+  const size_t nw  = o_list.size();
+  const int nA     = cab_leader.NptclA;
+  const int nB     = cab_leader.NptclB;
+
+  // ions are not necessarily grouped by species
+  std::vector<std::vector<int>> ions_of_species(cab_leader.NumSpeciesA);
+  for (int a = 0; a < nA; a++)
+    ions_of_species[cab_leader.PtclA.GroupID[a]].push_back(a);
+
+  std::vector<mRealType> res(nw, czero);
+  std::vector<RadFunctorType::point_type> dist_species(nA);
+  std::vector<RadFunctorType::value_type> rV_species(nA);
+  for (int spec = 0; spec < cab_leader.NumSpeciesA; spec++)
+  {
+    const auto& ions = ions_of_species[spec];
+    if (ions.empty())
+      continue;
+    // all the ions of a species share one radial functor
+    const RadFunctorType& Vs = *cab_leader.Vat[ions[0]];
+    const size_t nions       = ions.size();
+    for (size_t iw = 0; iw < nw; iw++)
+    {
+      const auto& d_ab(p_list[iw].getDistTableAB(cab_leader.myTableIndex));
+      mRealType wsum = czero;
+      for (size_t b = 0; b < nB; ++b)
+      {
+        const auto& dist = d_ab.getDistRow(b);
+        for (size_t i = 0; i < nions; i++)
+          dist_species[i] = dist[ions[i]];
+        Vs.splint(nions, dist_species.data(), rV_species.data());
+        mRealType esum = czero;
+        for (size_t i = 0; i < nions; i++)
+          esum += rV_species[i] / dist_species[i];
+        wsum += esum * cab_leader.Qat[b];
+      }
+      res[iw] += cab_leader.Zspec[spec] * wsum;
+    }
+  }
+  return {res.begin(), res.end()};
+}
+
+
 CoulombPBCAB::Return_t CoulombPBCAB::evalLR(ParticleSet& P)
 {
   mRealType res = 0.0;
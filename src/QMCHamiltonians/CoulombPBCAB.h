@@ -142,6 +142,11 @@ struct CoulombPBCAB : public OperatorBase, public ForceBase
 
 
   Return_t evaluate(ParticleSet& P) override;
+
+  void mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                   const RefVectorWithLeader<ParticleSet>& p_list) const override;
+
   Return_t evaluateWithIonDerivs(ParticleSet& P,
                                  ParticleSet& ions,
                                  TrialWaveFunction& psi,
@@ -164,6 +169,13 @@ struct CoulombPBCAB : public OperatorBase, public ForceBase
 
   ///Computes the short-range contribution to the coulomb energy.
   Return_t evalSR(ParticleSet& P);
+  /** Computes the short-range contribution to the coulomb energy of a crowd.
+   *
+   *  The e-I distance tables of all the walkers are swept species by species
+   *  with the radial functors of the leader shared by all the walkers.
+   */
+  static std::vector<Return_t> mw_evalSR(const RefVectorWithLeader<OperatorBase>& o_list,
+                                         const RefVectorWithLeader<ParticleSet>& p_list);
   ///Computes the long-range contribution to the coulomb energy.
   Return_t evalLR(ParticleSet& P);
   ///Computes the short-range contribution to the coulomb energy and forces.
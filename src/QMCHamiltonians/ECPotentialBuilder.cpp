@@ -68,6 +68,7 @@ bool ECPotentialBuilder::put(xmlNodePtr cur)
   std::string pbc;
   std::string forces;
   std::string physicalSO;
+  RealType pair_sampling = 1.0;
 
   OhmmsAttributeSet pAttrib;
   pAttrib.add(ecpFormat, "format", {"table", "xml"});
@@ -76,8 +77,12 @@ bool ECPotentialBuilder::put(xmlNodePtr cur)
   pAttrib.add(pbc, "pbc", {"yes", "no"});
   pAttrib.add(forces, "forces", {"no", "yes"});
   pAttrib.add(physicalSO, "physicalSO", {"yes", "no"});
+  pAttrib.add(pair_sampling, "pair_sampling");
   pAttrib.put(cur);
 
+  if (pair_sampling <= 0.0 || pair_sampling > 1.0)
+    myComm->barrier_and_abort("ECPotentialBuilder::put pair_sampling must be in (0, 1].");
+
   bool doForces = (forces == "yes") || (forces == "true");
   if (use_DLA == "yes")
     app_log() << "    Using determinant localization approximation (DLA)" << std::endl;
@@ -150,6 +155,19 @@ bool ECPotentialBuilder::put(xmlNodePtr cur)
               << "    Maximum grid on a sphere for NonLocalECPotential: " << nknot_max << std::endl;
     if (NLPP_algo == "batched")
       app_log() << "    Using batched ratio computing in NonLocalECP" << std::endl;
+    if (pair_sampling < 1.0)
+    {
+#ifdef QMC_CUDA
+      app_warning() << "    pair_sampling is not supported by the CUDA NonLocalECP and is ignored" << std::endl;
+#else
+      app_log() << "    Evaluating a random " << pair_sampling
+                << " fraction of the electron-ion pairs in NonLocalECP with the batched VMC driver. "
+                << "The VMC energy stays unbiased with a larger variance. DMC, forces and T-moves evaluate "
+                << "all the pairs since a noisy local energy in the branching weight biases the DMC energy."
+                << std::endl;
+      apot->setPairSampling(pair_sampling);
+#endif
+    }
 
     targetH.addOperator(std::move(apot), "NonLocalECP");
   }
@@ -105,6 +105,62 @@ LocalECPotential::Return_t LocalECPotential::evaluate(ParticleSet& P)
   return value_;
 }
 
+void LocalECPotential::mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                   const RefVectorWithLeader<ParticleSet>& p_list) const
+{
+  auto& o_leader = o_list.getCastedLeader<LocalECPotential>();
+  assert(this == &o_list.getLeader());
+
+#if !defined(REMOVE_TRACEMANAGER)
+  if (o_leader.streaming_particles_)
+  {
+    OperatorBase::mw_evaluate(o_list, wf_list, p_list);
+    return;
+  }
+#endif
+
+  const size_t nw    = o_list.size();
+  const size_t Nelec = p_list.getLeader().getTotalNum();
+  std::vector<Return_t> values(nw, 0.0);
+  std::vector<RealType> dist_species(NumIons);
+  std::vector<RealType> rV_species(NumIons);
+  std::vector<int> ions;
+  ions.reserve(NumIons);
+  for (int ig = 0; ig < PPset.size(); ++ig)
+  {
+    // clones own copies of the potentials, the leader's are shared by the crowd
+    const RadialPotentialType* ppot = o_leader.PPset[ig].get();
+    if (ppot == nullptr)
+      continue;
+    ions.clear();
+    for (int iat = 0; iat < NumIons; ++iat)
+      if (IonConfig.GroupID[iat] == ig)
+        ions.push_back(iat);
+    const size_t nions = ions.size();
+    for (size_t iw = 0; iw < nw; ++iw)
+    {
+      const auto& d_table(p_list[iw].getDistTableAB(myTableIndex));
+      Return_t wsum(0);
+      for (size_t iel = 0; iel < Nelec; ++iel)
+      {
+        const auto& dist = d_table.getDistRow(iel);
+        for (size_t i = 0; i < nions; ++i)
+          dist_species[i] = dist[ions[i]];
+        ppot->splint(nions, dist_species.data(), rV_species.data());
+        Return_t esum(0);
+        for (size_t i = 0; i < nions; ++i)
+          esum += rV_species[i] / dist_species[i];
+        wsum += esum;
+      }
+      values[iw] -= gZeff[ig] * wsum;
+    }
+  }
+
+  for (size_t iw = 0; iw < nw; ++iw)
+    o_list.getCastedElement<LocalECPotential>(iw).value_ = values[iw];
+}
+
 LocalECPotential::Return_t LocalECPotential::evaluateWithIonDerivs(ParticleSet& P,
                                                                    ParticleSet& ions,
                                                                    TrialWaveFunction& psi,
@@ -74,6 +74,15 @@ struct LocalECPotential : public OperatorBase
 
   Return_t evaluate(ParticleSet& P) override;
 
+  /** Evaluate the local potential of a crowd.
+   *
+   *  The e-I distance tables of all the walkers are swept species by species
+   *  with the radial potentials of the leader shared by all the walkers.
+   */
+  void mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                   const RefVectorWithLeader<ParticleSet>& p_list) const override;
+
   Return_t evaluateWithIonDerivs(ParticleSet& P,
                                  ParticleSet& ions,
                                  TrialWaveFunction& psi,
@@ -50,6 +50,8 @@ NonLocalECPotential::NonLocalECPotential(ParticleSet& ions,
       Psi(psi),
       ComputeForces(computeForces),
       use_DLA(enable_DLA),
+      pair_sampling_(1.0),
+      pair_sampling_enabled_(false),
       Peln(els),
       ElecNeighborIons(els),
       IonNeighborElecs(ions),
@@ -189,6 +191,10 @@ void NonLocalECPotential::evaluateImpl(ParticleSet& P, bool Tmove, bool keepGrid
   }
   else
   {
+    // the neighbor lists are complete even if only a sample of the pairs is evaluated
+    const RealType fraction    = keepGrid ? 1.0 : getPairSampling(Tmove);
+    const bool sampling        = fraction < 1.0;
+    const RealType pair_weight = 1.0 / fraction;
     for (int ig = 0; ig < P.groups(); ++ig) //loop over species
     {
       Psi.prepareGroup(P, ig);
@@ -200,12 +206,14 @@ void NonLocalECPotential::evaluateImpl(ParticleSet& P, bool Tmove, bool keepGrid
         for (int iat = 0; iat < NumIons; iat++)
           if (PP[iat] != nullptr && dist[iat] < PP[iat]->getRmax())
           {
-            RealType pairpot = PP[iat]->evaluateOne(P, iat, Psi, jel, dist[iat], -displ[iat], use_DLA);
+            NeighborIons.push_back(iat);
+            IonNeighborElecs.getNeighborList(iat).push_back(jel);
+            if (sampling && (*myRNG)() >= fraction)
+              continue;
+            RealType pairpot = pair_weight * PP[iat]->evaluateOne(P, iat, Psi, jel, dist[iat], -displ[iat], use_DLA);
             if (Tmove)
               PP[iat]->contributeTxy(jel, tmove_xy_);
             value_ += pairpot;
-            NeighborIons.push_back(iat);
-            IonNeighborElecs.getNeighborList(iat).push_back(jel);
             if (streaming_particles_)
             {
               Ve_samp(jel) += 0.5 * pairpot;
@@ -260,6 +268,8 @@ void NonLocalECPotential::mw_evaluateImpl(const RefVectorWithLeader<OperatorBase
 
     if (Tmove)
       O.tmove_xy_.clear();
+    const RealType fraction = O.getPairSampling(Tmove);
+    const bool sampling     = fraction < 1.0;
 
     for (int ipp = 0; ipp < O.PPset.size(); ipp++)
       if (O.PPset[ipp])
@@ -288,7 +298,8 @@ void NonLocalECPotential::mw_evaluateImpl(const RefVectorWithLeader<OperatorBase
           {
             NeighborIons.push_back(iat);
             O.IonNeighborElecs.getNeighborList(iat).push_back(jel);
-            joblist.emplace_back(iat, jel, P.R[jel], dist[iat], -displ[iat]);
+            if (!sampling || (*O.myRNG)() < fraction)
+              joblist.emplace_back(iat, jel, P.R[jel], dist[iat], -displ[iat]);
           }
       }
     }
@@ -380,9 +391,10 @@ void NonLocalECPotential::mw_evaluateImpl(const RefVectorWithLeader<OperatorBase
             std::cout << "check " << check_value << " wrong " << pairpots[j] << " diff "
                       << std::abs(check_value - pairpots[j]) << std::endl;
         }
-        ecp_potential_list[j].get().value_ += pairpots[j];
+        auto& O = ecp_potential_list[j].get();
+        O.value_ += pairpots[j] / O.getPairSampling(Tmove);
         if (Tmove)
-          ecp_component_list[j].contributeTxy(batch_list[j].get().electron_id, ecp_potential_list[j].get().tmove_xy_);
+          ecp_component_list[j].contributeTxy(batch_list[j].get().electron_id, O.tmove_xy_);
       }
     }
   }
@@ -729,6 +741,8 @@ std::unique_ptr<OperatorBase> NonLocalECPotential::makeClone(ParticleSet& qp, Tr
 {
   std::unique_ptr<NonLocalECPotential> myclone =
       std::make_unique<NonLocalECPotential>(IonConfig, qp, psi, ComputeForces, use_DLA);
+  myclone->pair_sampling_         = pair_sampling_;
+  myclone->pair_sampling_enabled_ = pair_sampling_enabled_;
   for (int ig = 0; ig < PPset.size(); ++ig)
     if (PPset[ig])
       myclone->addComponent(ig, std::unique_ptr<NonLocalECPComponent>(PPset[ig]->makeClone(qp)));
@@ -90,6 +90,18 @@ public:
   {
     UseTMove = nonLocalOps.thingsThatShouldBeInMyConstructor(non_local_move_option, tau, alpha, gamma);
   }
+  /** set the probability to evaluate each electron-ion pair within the cutoff
+   *
+   *  The evaluated pairs are weighted by the inverse of the probability. This keeps the energy unbiased
+   *  only if it enters the estimator linearly as in VMC, so the sampling stays off until enablePairSampling.
+   *  In DMC the noisy local energy in the branching weight would bias the mixed estimator by about -tau*Var.
+   *  All the pairs are evaluated for forces, T-moves and deterministic evaluations.
+   *  @param fraction probability in (0, 1], 1 evaluates every pair
+   */
+  void setPairSampling(RealType fraction) { pair_sampling_ = fraction; }
+  /// turn on or off the pair sampling set by setPairSampling
+  void enablePairSampling(bool enable) { pair_sampling_enabled_ = enable; }
+
   /** make non local moves with particle-by-particle moves
    * @param P particle set
    * @return the number of accepted moves
@@ -159,6 +171,10 @@ protected:
   bool ComputeForces;
   ///true, determinant localization approximation(DLA) is enabled
   bool use_DLA;
+  ///probability to evaluate an electron-ion pair
+  RealType pair_sampling_;
+  ///true if the driver allows sampling the electron-ion pairs
+  bool pair_sampling_enabled_;
 
 private:
   ///number of ions
@@ -198,6 +214,12 @@ private:
    */
   void evaluateImpl(ParticleSet& P, bool Tmove, bool keepGrid = false);
 
+  /** probability to evaluate an electron-ion pair in an evaluation
+   * @param Tmove whether Txy for Tmove is updated
+   * @return pair_sampling_ if the sampling is enabled and T-moves are off, 1 otherwise
+   */
+  RealType getPairSampling(bool Tmove) const { return pair_sampling_enabled_ && !Tmove ? pair_sampling_ : 1.0; }
+
   /** the actual implementation for batched walkers, used by mw_evaluate and mw_evaluateWithToperator
    * @param o_list the list of NonLocalECPotential in a walker batch
    * @param p_list the list of ParticleSet in a walker batch
@@ -960,6 +960,12 @@ void QMCHamiltonian::setNonLocalMoves(const std::string& non_local_move_option,
     nlpp_ptr->setNonLocalMoves(non_local_move_option, tau, alpha, gamma);
 }
 
+void QMCHamiltonian::setNonLocalPairSampling(bool enable)
+{
+  if (nlpp_ptr != nullptr)
+    nlpp_ptr->enablePairSampling(enable);
+}
+
 int QMCHamiltonian::makeNonLocalMoves(ParticleSet& P)
 {
   if (nlpp_ptr == nullptr)
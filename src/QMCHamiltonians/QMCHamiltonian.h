@@ -341,6 +341,11 @@ public:
                         const double alpha,
                         const double gamma);
 
+  /** turn on or off the electron-ion pair sampling of the nonlocal pseudopotential
+   * @param enable only drivers whose energy estimator is linear in the local energy should turn it on
+   */
+  void setNonLocalPairSampling(bool enable);
+
   /** make non local moves
    * @param P particle set
    * @return the number of accepted moves
@@ -0,0 +1,155 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** \file
+ *  This implements micro benchmarking of the batched e-I short-range Coulomb and local pseudopotential
+ *  evaluation against the per walker loop of the single walker API.
+ */
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <sstream>
+#include "Configuration.h"
+#include "Particle/ParticleSet.h"
+#include "QMCHamiltonians/CoulombPBCAB.h"
+#include "QMCHamiltonians/LocalECPotential.h"
+#include "QMCWaveFunctions/TrialWaveFunction.h"
+
+namespace qmcplusplus
+{
+using RealType = QMCTraits::RealType;
+using PosType  = ParticleSet::SingleParticlePos;
+
+/** a cubic supercell of simple cubic carbon with 4 electrons per ion
+ * @param num_ions_per_dim number of ions along each direction
+ * @param num_walkers number of walkers in the crowd
+ */
+void benchmarkLocalPotentials(int num_ions_per_dim, int num_walkers)
+{
+  LRCoulombSingleton::CoulombHandler = 0;
+
+  const double spacing = 3.37;
+  const int num_ions   = num_ions_per_dim * num_ions_per_dim * num_ions_per_dim;
+  const int num_elec   = 4 * num_ions;
+
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> lattice;
+  lattice.BoxBConds = true; // periodic
+  lattice.R.diagonal(spacing * num_ions_per_dim);
+  lattice.reset();
+
+  const SimulationCell simulation_cell(lattice);
+  ParticleSet ions(simulation_cell);
+  ParticleSet elec(simulation_cell);
+
+  ions.setName("ion0");
+  ions.create({num_ions});
+  int count = 0;
+  for (int i = 0; i < num_ions_per_dim; i++)
+    for (int j = 0; j < num_ions_per_dim; j++)
+      for (int k = 0; k < num_ions_per_dim; k++)
+        ions.R[count++] = PosType(i * spacing, j * spacing, k * spacing);
+  SpeciesSet& ion_species       = ions.getSpeciesSet();
+  int cIdx                      = ion_species.addSpecies("C");
+  int pChargeIdx                = ion_species.addAttribute("charge");
+  ion_species(pChargeIdx, cIdx) = 4;
+  ions.createSK();
+  ions.update();
+
+  elec.setName("e");
+  elec.create({num_elec / 2, num_elec / 2});
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  for (int iel = 0; iel < num_elec; iel++)
+    elec.R[iel] = ions.R[iel % num_ions] + PosType(0.9 * std::sin(1.3 * iel), 0.9 * std::cos(0.7 * iel), 0.4);
+  elec.createSK();
+  elec.addTable(ions);
+  elec.update();
+
+  // r*V(r) of a smeared ion, shared by the CoulombPBCAB short-range part and the local pseudopotential
+  LinearGrid<RealType> grid;
+  grid.set(0.0, 10.0, 1001);
+  std::vector<RealType> rV(grid.size());
+  for (int ig = 0; ig < grid.size(); ig++)
+    rV[ig] = -4.0 * std::erf(grid[ig] / 0.6);
+  auto make_ppot = [&] {
+    auto ppot = std::make_unique<LocalECPotential::RadialPotentialType>(grid.makeClone(), rV);
+    ppot->spline(0, -8.0 / (std::sqrt(M_PI) * 0.6), grid.size() - 1, 0.0);
+    return ppot;
+  };
+
+  CoulombPBCAB cab(ions, elec);
+  cab.add(cIdx, make_ppot());
+  LocalECPotential lpp(ions, elec);
+  lpp.add(cIdx, make_ppot(), 4.0);
+
+  std::vector<std::unique_ptr<ParticleSet>> elec_clones;
+  std::vector<std::unique_ptr<OperatorBase>> cab_clones;
+  std::vector<std::unique_ptr<OperatorBase>> lpp_clones;
+  std::vector<std::unique_ptr<TrialWaveFunction>> psi_clones;
+  TrialWaveFunction psi;
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec});
+  RefVectorWithLeader<OperatorBase> cab_list(cab, {cab});
+  RefVectorWithLeader<OperatorBase> lpp_list(lpp, {lpp});
+  RefVectorWithLeader<TrialWaveFunction> psi_list(psi, {psi});
+  for (int iw = 1; iw < num_walkers; iw++)
+  {
+    elec_clones.push_back(std::make_unique<ParticleSet>(elec));
+    for (int iel = 0; iel < num_elec; iel++)
+      elec_clones.back()->R[iel] += PosType(0.05 * iw, -0.03 * iw, 0.02 * iw);
+    elec_clones.back()->update();
+    psi_clones.push_back(std::make_unique<TrialWaveFunction>());
+    cab_clones.push_back(cab.makeClone(*elec_clones.back(), *psi_clones.back()));
+    lpp_clones.push_back(lpp.makeClone(*elec_clones.back(), *psi_clones.back()));
+    p_list.push_back(*elec_clones.back());
+    cab_list.push_back(*cab_clones.back());
+    lpp_list.push_back(*lpp_clones.back());
+    psi_list.push_back(*psi_clones.back());
+  }
+
+  std::ostringstream name;
+  name << "ions=" << num_ions << " walkers=" << num_walkers;
+  BENCHMARK_ADVANCED("CoulombPBCAB " + name.str() + " single walker")(Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&] { cab.OperatorBase::mw_evaluate(cab_list, psi_list, p_list); });
+  };
+  BENCHMARK_ADVANCED("CoulombPBCAB " + name.str() + " batched")(Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&] { cab.mw_evaluate(cab_list, psi_list, p_list); });
+  };
+  BENCHMARK_ADVANCED("LocalECPotential " + name.str() + " single walker")(Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&] { lpp.OperatorBase::mw_evaluate(lpp_list, psi_list, p_list); });
+  };
+  BENCHMARK_ADVANCED("LocalECPotential " + name.str() + " batched")(Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&] { lpp.mw_evaluate(lpp_list, psi_list, p_list); });
+  };
+}
+
+/** This test will run by default.
+ */
+TEST_CASE("Local potentials batched benchmark small", "[hamiltonian][benchmark]") { benchmarkLocalPotentials(2, 4); }
+
+/** This and other [.benchmark] benchmarks only run if "[benchmark]" is explicitly passed as tag to test.
+ */
+TEST_CASE("Local potentials batched benchmark large", "[hamiltonian][.benchmark]")
+{
+  for (const int num_walkers : {8, 16, 32})
+    benchmarkLocalPotentials(4, num_walkers);
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,157 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** \file
+ *  This implements micro benchmarking of the nonlocal pseudopotential evaluation
+ *  with every electron-ion pair against a random sample of the pairs.
+ */
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <sstream>
+#include "Configuration.h"
+#include "OhmmsData/Libxml2Doc.h"
+#include "Particle/ParticleSet.h"
+#include "QMCHamiltonians/ECPComponentBuilder.h"
+#include "QMCHamiltonians/NonLocalECPotential.h"
+#include "QMCWaveFunctions/TrialWaveFunction.h"
+#include "QMCWaveFunctions/Jastrow/RadialJastrowBuilder.h"
+
+namespace qmcplusplus
+{
+using RealType = QMCTraits::RealType;
+using PosType  = ParticleSet::SingleParticlePos;
+
+/** a cubic cluster of Na ions with one electron per ion
+ * @param num_ions_per_dim number of ions along each direction
+ * @param num_walkers number of walkers in the crowd
+ */
+void benchmarkNonLocalECPotential(int num_ions_per_dim, int num_walkers)
+{
+  Communicate* c = OHMMS::Controller;
+
+  const double spacing = 3.5;
+  const int num_ions   = num_ions_per_dim * num_ions_per_dim * num_ions_per_dim;
+  const int num_elec   = 2 * (num_ions / 2);
+
+  const SimulationCell simulation_cell;
+  ParticleSet ions(simulation_cell);
+  ParticleSet elec(simulation_cell);
+
+  ions.setName("ion0");
+  ions.create({num_ions});
+  int count = 0;
+  for (int i = 0; i < num_ions_per_dim; i++)
+    for (int j = 0; j < num_ions_per_dim; j++)
+      for (int k = 0; k < num_ions_per_dim; k++)
+        ions.R[count++] = PosType(i * spacing, j * spacing, k * spacing);
+  SpeciesSet& ion_species       = ions.getSpeciesSet();
+  int pIdx                      = ion_species.addSpecies("Na");
+  int pChargeIdx                = ion_species.addAttribute("charge");
+  int iatnumber                 = ion_species.addAttribute("atomic_number");
+  ion_species(pChargeIdx, pIdx) = 1;
+  ion_species(iatnumber, pIdx)  = 11;
+  ions.resetGroups();
+  ions.update();
+
+  elec.setName("e");
+  elec.create({num_elec / 2, num_elec / 2});
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  for (int iel = 0; iel < num_elec; iel++)
+    elec.R[iel] = ions.R[iel % num_ions] + PosType(0.9 * std::sin(1.3 * iel), 0.9 * std::cos(0.7 * iel), 0.4);
+  elec.resetGroups();
+
+  TrialWaveFunction psi;
+  const char* particles = "<tmp> \
+  <jastrow name=\"J1\" type=\"One-Body\" function=\"Bspline\" source=\"ion0\"> \
+        <correlation elementType=\"Na\" rcut=\"5\" size=\"5\" cusp=\"0\"> \
+          <coefficients id=\"eNa\" type=\"Array\"> 0.5 -0.4 -0.3 -0.2 -0.1</coefficients> \
+        </correlation> \
+      </jastrow> \
+  </tmp> \
+  ";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(particles));
+  RadialJastrowBuilder jastrow1bdy(c, elec, ions);
+  psi.addComponent(jastrow1bdy.buildComponent(xmlFirstElementChild(doc.getRoot())));
+
+  ECPComponentBuilder ecp("benchmark_ecp", c);
+  REQUIRE(ecp.read_pp_file("Na.BFD.xml"));
+  ecp.pp_nonloc->initVirtualParticle(elec);
+  NonLocalECPotential nlpp(ions, elec, psi, false, false);
+  nlpp.addComponent(pIdx, std::move(ecp.pp_nonloc));
+  RandomGenerator rng;
+  nlpp.setRandomGenerator(&rng);
+
+  elec.update();
+  psi.evaluateLog(elec);
+
+  std::vector<std::unique_ptr<ParticleSet>> elec_clones;
+  std::vector<std::unique_ptr<TrialWaveFunction>> psi_clones;
+  std::vector<std::unique_ptr<OperatorBase>> nlpp_clones;
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec});
+  RefVectorWithLeader<OperatorBase> nlpp_list(nlpp, {nlpp});
+  RefVectorWithLeader<TrialWaveFunction> psi_list(psi, {psi});
+  for (int iw = 1; iw < num_walkers; iw++)
+  {
+    elec_clones.push_back(std::make_unique<ParticleSet>(elec));
+    for (int iel = 0; iel < num_elec; iel++)
+      elec_clones.back()->R[iel] += PosType(0.05 * iw, -0.03 * iw, 0.02 * iw);
+    elec_clones.back()->update();
+    psi_clones.push_back(psi.makeClone(*elec_clones.back()));
+    psi_clones.back()->evaluateLog(*elec_clones.back());
+    nlpp_clones.push_back(nlpp.makeClone(*elec_clones.back(), *psi_clones.back()));
+    nlpp_clones.back()->setRandomGenerator(&rng);
+    p_list.push_back(*elec_clones.back());
+    nlpp_list.push_back(*nlpp_clones.back());
+    psi_list.push_back(*psi_clones.back());
+  }
+
+  std::ostringstream name;
+  name << "ions=" << num_ions << " walkers=" << num_walkers;
+  for (const RealType pair_sampling : {1.0, 0.5, 0.25})
+  {
+    for (OperatorBase& op : nlpp_list)
+    {
+      static_cast<NonLocalECPotential&>(op).setPairSampling(pair_sampling);
+      static_cast<NonLocalECPotential&>(op).enablePairSampling(true);
+    }
+    BENCHMARK_ADVANCED("NonLocalECPotential " + name.str() + " pair_sampling=" + std::to_string(pair_sampling))
+    (Catch::Benchmark::Chronometer meter)
+    {
+      meter.measure([&] { nlpp.mw_evaluate(nlpp_list, psi_list, p_list); });
+    };
+  }
+}
+
+/** This test will run by default.
+ */
+TEST_CASE("NonLocalECPotential pair sampling benchmark small", "[hamiltonian][benchmark]")
+{
+  benchmarkNonLocalECPotential(2, 4);
+}
+
+/** This and other [.benchmark] benchmarks only run if "[benchmark]" is explicitly passed as tag to test.
+ */
+TEST_CASE("NonLocalECPotential pair sampling benchmark large", "[hamiltonian][.benchmark]")
+{
+  for (const int num_walkers : {8, 32})
+    benchmarkNonLocalECPotential(4, num_walkers);
+}
+
+} // namespace qmcplusplus
@@ -17,6 +17,7 @@
 #include "Particle/ParticleSet.h"
 #include "QMCHamiltonians/CoulombPBCAB.h"
 #include "QMCHamiltonians/CoulombPBCAA.h"
+#include "QMCWaveFunctions/TrialWaveFunction.h"
 
 
 #include <stdio.h>
@@ -160,4 +161,70 @@ TEST_CASE("Coulomb PBC A-B BCC H", "[hamiltonian]")
                                         // -3.14349127313640
 }
 
+TEST_CASE("Coulomb PBC A-B BCC H batched", "[hamiltonian]")
+{
+  LRCoulombSingleton::CoulombHandler = 0;
+
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> lattice;
+  lattice.BoxBConds = true; // periodic
+  lattice.R.diagonal(3.77945227);
+  lattice.reset();
+
+  const SimulationCell simulation_cell(lattice);
+  ParticleSet ions(simulation_cell);
+  ParticleSet elec(simulation_cell);
+
+  ions.setName("ion");
+  ions.create({2});
+  ions.R[0] = {0.0, 0.0, 0.0};
+  ions.R[1] = {1.88972614, 1.88972614, 1.88972614};
+
+  SpeciesSet& ion_species       = ions.getSpeciesSet();
+  int pIdx                      = ion_species.addSpecies("H");
+  int pChargeIdx                = ion_species.addAttribute("charge");
+  ion_species(pChargeIdx, pIdx) = 1;
+  ions.createSK();
+  ions.update();
+
+  elec.setName("elec");
+  elec.create({2});
+  elec.R[0] = {0.5, 0.0, 0.0};
+  elec.R[1] = {0.0, 0.5, 0.0};
+
+  SpeciesSet& tspecies       = elec.getSpeciesSet();
+  int upIdx                  = tspecies.addSpecies("u");
+  int chargeIdx              = tspecies.addAttribute("charge");
+  int massIdx                = tspecies.addAttribute("mass");
+  tspecies(chargeIdx, upIdx) = -1;
+  tspecies(massIdx, upIdx)   = 1.0;
+
+  elec.resetGroups();
+  elec.createSK();
+  elec.addTable(ions);
+  elec.update();
+
+  CoulombPBCAB cab(ions, elec);
+
+  ParticleSet elec_clone(elec);
+  elec_clone.R[1] = {1.2, 0.3, 2.1};
+  elec_clone.update();
+  CoulombPBCAB cab_clone(cab);
+
+  // per walker references
+  const double ref_value       = cab.evaluate(elec);
+  const double ref_value_clone = cab_clone.evaluate(elec_clone);
+  CHECK(ref_value == Approx(-2.219665062 + 0.0267892759 * 4));
+  CHECK(ref_value != Approx(ref_value_clone));
+
+  RefVectorWithLeader<ParticleSet> p_ref_list(elec, {elec, elec_clone});
+  RefVectorWithLeader<OperatorBase> cab_ref_list(cab, {cab, cab_clone});
+  // dummy psi
+  TrialWaveFunction psi, psi_clone;
+  RefVectorWithLeader<TrialWaveFunction> psi_ref_list(psi, {psi, psi_clone});
+
+  cab.mw_evaluate(cab_ref_list, psi_ref_list, p_ref_list);
+  CHECK(cab.getValue() == Approx(ref_value));
+  CHECK(cab_clone.getValue() == Approx(ref_value_clone));
+}
+
 } // namespace qmcplusplus
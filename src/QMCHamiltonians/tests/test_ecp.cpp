@@ -29,6 +29,8 @@
 #include "QMCWaveFunctions/SpinorSet.h"
 //for nonlocal moves
 #include "QMCHamiltonians/NonLocalTOperator.h"
+#include "QMCHamiltonians/LocalECPotential.h"
+#include "QMCHamiltonians/NonLocalECPotential.h"
 
 
 //for Hamiltonian manipulations.
@@ -564,5 +566,197 @@ TEST_CASE("Evaluate_soecp", "[hamiltonian]")
 }
 #endif
 
+TEST_CASE("LocalECPotential batched", "[hamiltonian]")
+{
+  using RealType            = QMCTraits::RealType;
+  using RadialPotentialType = LocalECPotential::RadialPotentialType;
+
+  const SimulationCell simulation_cell;
+  ParticleSet ions(simulation_cell);
+  ParticleSet elec(simulation_cell);
+
+  // species are not grouped, the batched sweep must not assume it
+  ions.setName("ion0");
+  ions.create({3});
+  ions.R[0] = {0.0, 0.0, 0.0};
+  ions.R[1] = {2.0, 0.0, 0.0};
+  ions.R[2] = {0.0, 2.5, 0.0};
+  SpeciesSet& ion_species = ions.getSpeciesSet();
+  const int aIdx          = ion_species.addSpecies("A");
+  const int bIdx          = ion_species.addSpecies("B");
+  ions.GroupID[0]         = aIdx;
+  ions.GroupID[1]         = bIdx;
+  ions.GroupID[2]         = aIdx;
+  ions.update();
+
+  elec.setName("e");
+  elec.create({2, 1});
+  elec.R[0] = {0.5, 0.1, 0.0};
+  elec.R[1] = {1.5, -0.3, 0.2};
+  elec.R[2] = {0.2, 1.9, -0.4};
+  SpeciesSet& tspecies = elec.getSpeciesSet();
+  tspecies.addSpecies("u");
+  tspecies.addSpecies("d");
+  elec.addTable(ions);
+  elec.update();
+
+  // r*V(r) of a smeared charge, different widths per species
+  auto make_ppot = [](RealType width) {
+    LinearGrid<RealType> grid;
+    grid.set(0.0, 10.0, 1001);
+    std::vector<RealType> rV(grid.size());
+    for (int ig = 0; ig < grid.size(); ig++)
+      rV[ig] = std::erf(grid[ig] / width);
+    auto ppot = std::make_unique<RadialPotentialType>(grid.makeClone(), rV);
+    ppot->spline(0, 2.0 / (std::sqrt(M_PI) * width), grid.size() - 1, 0.0);
+    return ppot;
+  };
+
+  LocalECPotential lpp(ions, elec);
+  lpp.add(aIdx, make_ppot(0.5), 3.0);
+  lpp.add(bIdx, make_ppot(0.8), 5.0);
+
+  ParticleSet elec_clone(elec);
+  elec_clone.R[1] = {-0.7, 0.4, 1.1};
+  elec_clone.update();
+  TrialWaveFunction psi, psi_clone;
+  auto lpp_clone = lpp.makeClone(elec_clone, psi_clone);
+
+  // per walker references
+  const double ref_value       = lpp.evaluate(elec);
+  const double ref_value_clone = lpp_clone->evaluate(elec_clone);
+  CHECK(ref_value != Approx(ref_value_clone));
+
+  RefVectorWithLeader<ParticleSet> p_ref_list(elec, {elec, elec_clone});
+  RefVectorWithLeader<OperatorBase> lpp_ref_list(lpp, {lpp, *lpp_clone});
+  RefVectorWithLeader<TrialWaveFunction> psi_ref_list(psi, {psi, psi_clone});
+
+  lpp.mw_evaluate(lpp_ref_list, psi_ref_list, p_ref_list);
+  CHECK(lpp.getValue() == Approx(ref_value));
+  CHECK(lpp_clone->getValue() == Approx(ref_value_clone));
+}
+
+// the statistical checks need a real random number generator
+#ifndef USE_FAKE_RNG
+TEST_CASE("NonLocalECPotential pair sampling", "[hamiltonian]")
+{
+  using RealType = QMCTraits::RealType;
+
+  Communicate* c = OHMMS::Controller;
+
+  const SimulationCell simulation_cell;
+  ParticleSet ions(simulation_cell);
+  ParticleSet elec(simulation_cell);
+
+  ions.setName("ion0");
+  ions.create({2});
+  ions.R[0]                     = {0.0, 0.0, 0.0};
+  ions.R[1]                     = {2.5, 0.0, 0.0};
+  SpeciesSet& ion_species       = ions.getSpeciesSet();
+  int pIdx                      = ion_species.addSpecies("Na");
+  int pChargeIdx                = ion_species.addAttribute("charge");
+  int iatnumber                 = ion_species.addAttribute("atomic_number");
+  ion_species(pChargeIdx, pIdx) = 1;
+  ion_species(iatnumber, pIdx)  = 11;
+  ions.resetGroups();
+
+  elec.setName("e");
+  elec.create({2, 2});
+  elec.R[0]                    = {0.4, 0.3, 0.0};
+  elec.R[1]                    = {1.3, -0.2, 0.3};
+  elec.R[2]                    = {2.2, 0.5, -0.4};
+  elec.R[3]                    = {-0.3, -0.6, 0.5};
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  int massIdx                  = tspecies.addAttribute("mass");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  tspecies(massIdx, upIdx)     = 1.0;
+  tspecies(massIdx, downIdx)   = 1.0;
+  elec.resetGroups();
+
+  TrialWaveFunction psi;
+  const char* particles = "<tmp> \
+  <jastrow name=\"J1\" type=\"One-Body\" function=\"Bspline\" source=\"ion0\" print=\"yes\"> \
+        <correlation elementType=\"Na\" rcut=\"10\" size=\"10\" cusp=\"0\"> \
+          <coefficients id=\"eNa\" type=\"Array\"> 1.244201343 -1.188935609 -1.840397253 -1.803849126 -1.612058635 -1.35993202 -1.083353212 -0.8066295188 -0.5319252448 -0.3158819772</coefficients> \
+        </correlation> \
+      </jastrow> \
+  </tmp> \
+  ";
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(particles);
+  REQUIRE(okay);
+  RadialJastrowBuilder jastrow1bdy(c, elec, ions);
+  psi.addComponent(jastrow1bdy.buildComponent(xmlFirstElementChild(doc.getRoot())));
+
+  ECPComponentBuilder ecp("test_read_ecp", c);
+  REQUIRE(ecp.read_pp_file("Na.BFD.xml"));
+  ecp.pp_nonloc->initVirtualParticle(elec);
+
+  NonLocalECPotential nlpp(ions, elec, psi, false, false);
+  nlpp.addComponent(pIdx, std::move(ecp.pp_nonloc));
+  RandomGenerator rng;
+  nlpp.setRandomGenerator(&rng);
+
+  ions.update();
+  elec.update();
+  psi.evaluateLog(elec);
+
+  // the quadrature grid is randomly rotated at each evaluation, compare the means of many evaluations
+  const int num_samples = 4000;
+  auto sampleMeanAndError = [num_samples](auto&& evaluate) {
+    double sum = 0.0, sum2 = 0.0;
+    for (int i = 0; i < num_samples; i++)
+    {
+      const double value = evaluate();
+      sum += value;
+      sum2 += value * value;
+    }
+    const double mean = sum / num_samples;
+    return std::make_pair(mean, std::sqrt((sum2 / num_samples - mean * mean) / num_samples));
+  };
+
+  rng.seed(7);
+  const double full_value            = nlpp.evaluate(elec);
+  const auto [full_mean, full_error] = sampleMeanAndError([&]() { return nlpp.evaluate(elec); });
+  CHECK(full_mean != Approx(0.0));
+
+  // the sampling stays off until a driver enables it
+  nlpp.setPairSampling(0.25);
+  rng.seed(7);
+  CHECK(nlpp.evaluate(elec) == Approx(full_value));
+
+  nlpp.enablePairSampling(true);
+  const auto [sampled_mean, sampled_error] = sampleMeanAndError([&]() { return nlpp.evaluate(elec); });
+  CHECK(sampled_error > full_error);
+  CHECK(std::abs(sampled_mean - full_mean) < 4.0 * std::sqrt(full_error * full_error + sampled_error * sampled_error));
+
+  // deterministic evaluations are not sampled
+  const double deterministic_value = nlpp.evaluateDeterministic(elec);
+  CHECK(nlpp.evaluateDeterministic(elec) == Approx(deterministic_value));
+
+  // batched evaluation of two walkers, the clone keeps the sampling
+  ParticleSet elec_clone(elec);
+  auto psi_clone  = psi.makeClone(elec_clone);
+  auto nlpp_clone = nlpp.makeClone(elec_clone, *psi_clone);
+  RandomGenerator rng_clone;
+  nlpp_clone->setRandomGenerator(&rng_clone);
+  elec_clone.update();
+  psi_clone->evaluateLog(elec_clone);
+
+  RefVectorWithLeader<ParticleSet> p_ref_list(elec, {elec, elec_clone});
+  RefVectorWithLeader<OperatorBase> nlpp_ref_list(nlpp, {nlpp, *nlpp_clone});
+  RefVectorWithLeader<TrialWaveFunction> psi_ref_list(psi, {psi, *psi_clone});
+  const auto [mw_sampled_mean, mw_sampled_error] = sampleMeanAndError([&]() {
+    nlpp.mw_evaluate(nlpp_ref_list, psi_ref_list, p_ref_list);
+    return 0.5 * (nlpp.getValue() + nlpp_clone->getValue());
+  });
+  CHECK(std::abs(mw_sampled_mean - full_mean) <
+        4.0 * std::sqrt(full_error * full_error + mw_sampled_error * mw_sampled_error));
+}
+#endif
 
 } // namespace qmcplusplus
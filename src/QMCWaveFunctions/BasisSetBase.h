@@ -21,6 +21,7 @@
 #ifndef QMCPLUSPLUS_BASISSETBASE_H
 #define QMCPLUSPLUS_BASISSETBASE_H
 
+#include <numeric>
 #include "Particle/ParticleSet.h"
 #include "QMCWaveFunctions/OrbitalSetTraits.h"
 
@@ -165,6 +166,22 @@ struct SoaBasisSetBase
                                      int jion,
                                      vghgh_type& vghgh)                            = 0;
   virtual void evaluateV(const ParticleSet& P, int iat, value_type* restrict vals) = 0;
+  //Evaluates value, gradient, and laplacian for electron "iat" only for the basis functions within their screening radius.
+  //    Their indices are returned in "live_aos". Entries of "vgl" not listed in "live_aos" are left untouched.
+  virtual void evaluateVGLScreened(const ParticleSet& P, int iat, vgl_type& vgl, std::vector<int>& live_aos)
+  {
+    evaluateVGL(P, iat, vgl);
+    live_aos.resize(BasisSetSize);
+    std::iota(live_aos.begin(), live_aos.end(), 0);
+  }
+  //Evaluates values for electron "iat" only for the basis functions within their screening radius.
+  //    Their indices are returned in "live_aos". Entries of "vals" not listed in "live_aos" are left untouched.
+  virtual void evaluateVScreened(const ParticleSet& P, int iat, value_type* restrict vals, std::vector<int>& live_aos)
+  {
+    evaluateV(P, iat, vals);
+    live_aos.resize(BasisSetSize);
+    std::iota(live_aos.begin(), live_aos.end(), 0);
+  }
   virtual bool is_S_orbital(int mo_idx, int ao_idx) { return false; }
 
   /// Determine which orbitals are S-type.  Used for cusp correction.
@@ -25,7 +25,14 @@
 namespace qmcplusplus
 {
 BsplineReaderBase::BsplineReaderBase(EinsplineSetBuilder* e)
-    : mybuilder(e), MeshSize(0), checkNorm(true), saveSplineCoefs(false), rotate(true)
+    : mybuilder(e),
+      MeshSize(0),
+      checkNorm(true),
+      saveSplineCoefs(false),
+      nodeSharedTable(false),
+      mmapSplineCoefs(false),
+      int16SplineCoefs(false),
+      rotate(true)
 {
   myComm = mybuilder->getCommunicator();
 }
@@ -85,9 +92,15 @@ void BsplineReaderBase::setCommon(xmlNodePtr cur)
   // check orbital normalization by default
   std::string checkOrbNorm("yes");
   std::string saveCoefs("no");
+  std::string sharedTable("no");
+  std::string mmapCoefs("no");
+  std::string int16Coefs("no");
   OhmmsAttributeSet a;
   a.add(checkOrbNorm, "check_orb_norm");
   a.add(saveCoefs, "save_coefs");
+  a.add(sharedTable, "node_shared_table");
+  a.add(mmapCoefs, "mmap_coefs");
+  a.add(int16Coefs, "int16_coefs");
   a.put(cur);
 
   // allow user to turn off norm check with a warning
@@ -96,7 +109,10 @@ void BsplineReaderBase::setCommon(xmlNodePtr cur)
     app_log() << "WARNING: disable orbital normalization check!" << std::endl;
     checkNorm = false;
   }
-  saveSplineCoefs = saveCoefs == "yes";
+  saveSplineCoefs  = saveCoefs == "yes";
+  nodeSharedTable  = sharedTable == "yes";
+  mmapSplineCoefs  = mmapCoefs == "yes";
+  int16SplineCoefs = int16Coefs == "yes";
 }
 
 std::unique_ptr<SPOSet> BsplineReaderBase::create_spline_set(int spin, xmlNodePtr cur)
@@ -44,6 +44,12 @@ struct BsplineReaderBase
   bool checkNorm;
   ///save spline coefficients to storage
   bool saveSplineCoefs;
+  ///share the spline table among the ranks on a node
+  bool nodeSharedTable;
+  ///map the spline table from a SplineCoefsCache file, write the file if not usable
+  bool mmapSplineCoefs;
+  ///compress the spline table to 16-bit integers after it is built, see MultiBsplineInt16
+  bool int16SplineCoefs;
   ///apply orbital rotations
   bool rotate;
   ///map from spo index to band index
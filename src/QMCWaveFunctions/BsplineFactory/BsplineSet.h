@@ -102,6 +102,11 @@ public:
     return nCB; //return the number of complex bands
   }
 
+  /** replace the spline table by a copy compressed to 16-bit integers, see MultiBsplineInt16
+   * @return false if the derived class doesn't support compressed tables
+   */
+  virtual bool compress_table() { return false; }
+
   // propagate SPOSet virtual functions
   using SPOSet::evaluateDetRatios;
   using SPOSet::evaluateValue;
@@ -151,6 +151,11 @@ public:
 
   HybridRepSetReader(EinsplineSetBuilder* e) : BaseReader(e) {}
 
+  /// the atomic centers are not covered by external tables. Keep the whole SPOSet private to each rank.
+  bool supportExternalTable() const override { return false; }
+  /// create_atomic_centers_Gspace is collective over the band group and processes one band at a time
+  bool supportConcurrentBands() const override { return false; }
+
   /** initialize basic parameters of atomic orbitals */
   void initialize_hybridrep_atomic_centers() override
   {
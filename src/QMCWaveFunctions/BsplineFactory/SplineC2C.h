@@ -22,6 +22,7 @@
 #include "QMCWaveFunctions/BsplineFactory/BsplineSet.h"
 #include "OhmmsSoA/VectorSoaContainer.h"
 #include "spline2/MultiBspline.hpp"
+#include "spline2/MultiBsplineInt16.hpp"
 #include "Utilities/FairDivide.h"
 
 namespace qmcplusplus
@@ -62,6 +63,8 @@ private:
   Tensor<ST, 3> GGt;
   ///multi bspline set
   std::shared_ptr<MultiBspline<ST>> SplineInst;
+  ///multi bspline set compressed to 16-bit integers, replaces SplineInst if not null
+  std::shared_ptr<MultiBsplineInt16<ST>> SplineInst16;
 
   vContainer_type mKK;
   VectorSoaContainer<ST, 3> myKcart;
@@ -125,6 +128,8 @@ public:
 
   inline void flush_zero() { SplineInst->flush_zero(); }
 
+  bool compress_table() override;
+
   /** remap kPoints to pack the double copy */
   inline void resize_kpoints()
   {
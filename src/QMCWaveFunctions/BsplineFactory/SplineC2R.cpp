@@ -33,6 +33,16 @@ inline void SplineC2R<ST>::set_spline(SingleSplineType* spline_r,
   SplineInst->copy_spline(spline_i, 2 * ispline + 1);
 }
 
+template<typename ST>
+bool SplineC2R<ST>::compress_table()
+{
+  SplineInst16 = std::make_shared<MultiBsplineInt16<ST>>(*SplineInst->getSplinePtr());
+  app_log() << "MEMORY " << SplineInst16->sizeInByte() / (1 << 20) << " MB allocated "
+            << "for the 16-bit compressed coefficients in 3D spline orbital representation" << std::endl;
+  SplineInst.reset();
+  return true;
+}
+
 template<typename ST>
 bool SplineC2R<ST>::read_splines(hdf_archive& h5f)
 {
@@ -103,7 +113,10 @@ void SplineC2R<ST>::evaluateValue(const ParticleSet& P, const int iat, ValueVect
     int first, last;
     FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
+    if (SplineInst16)
+      spline2::evaluate3d(SplineInst16->getSplinePtr(), ru, myV, first, last);
+    else
+      spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
     assign_v(r, myV, psi, first / 2, last / 2);
   }
 }
@@ -136,7 +149,10 @@ void SplineC2R<ST>::evaluateDetRatios(const VirtualParticleSet& VP,
       const PointType& r = VP.activeR(iat);
       PointType ru(PrimLattice.toUnit_floor(r));
 
-      spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
+      if (SplineInst16)
+        spline2::evaluate3d(SplineInst16->getSplinePtr(), ru, myV, first, last);
+      else
+        spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
       assign_v(r, myV, psi, first_cplx, last_cplx);
 
       const int first_real     = first_cplx + std::min(nComplexBands, first_cplx);
@@ -430,7 +446,10 @@ void SplineC2R<ST>::evaluateVGL(const ParticleSet& P,
     int first, last;
     FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
+    if (SplineInst16)
+      spline2::evaluate3d_vgh(SplineInst16->getSplinePtr(), ru, myV, myG, myH, first, last);
+    else
+      spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
     assign_vgl(r, psi, dpsi, d2psi, first / 2, last / 2);
   }
 }
@@ -673,7 +692,10 @@ void SplineC2R<ST>::evaluateVGH(const ParticleSet& P,
     int first, last;
     FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
+    if (SplineInst16)
+      spline2::evaluate3d_vgh(SplineInst16->getSplinePtr(), ru, myV, myG, myH, first, last);
+    else
+      spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
     assign_vgh(r, psi, dpsi, grad_grad_psi, first / 2, last / 2);
   }
 }
@@ -1156,6 +1178,8 @@ void SplineC2R<ST>::evaluateVGHGH(const ParticleSet& P,
 {
   const PointType& r = P.activeR(iat);
   PointType ru(PrimLattice.toUnit_floor(r));
+  if (SplineInst16)
+    throw std::runtime_error("SplineC2R::evaluateVGHGH is not supported with a 16-bit compressed spline table!");
 #pragma omp parallel
   {
     int first, last;
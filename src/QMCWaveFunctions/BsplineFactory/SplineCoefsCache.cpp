@@ -0,0 +1,153 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "SplineCoefsCache.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace qmcplusplus
+{
+namespace
+{
+constexpr char cache_magic[8] = {'Q', 'M', 'C', 'S', 'P', 'L', 'N', 'E'};
+
+/// layout of the beginning of the header page
+struct FileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t header_bytes;
+  SplineCoefsCache::Key key;
+  uint64_t checksum;
+};
+static_assert(sizeof(FileHeader) <= SplineCoefsCache::header_bytes, "FileHeader doesn't fit in the header page!");
+
+/// total number of bytes of the coefficient block
+size_t blockBytes(const SplineCoefsCache::Key& key) { return key.coefs_size * key.data_size; }
+} // namespace
+
+bool SplineCoefsCache::Key::operator==(const Key& other) const
+{
+  return hash == other.hash && coefs_size == other.coefs_size && data_size == other.data_size &&
+      grid[0] == other.grid[0] && grid[1] == other.grid[1] && grid[2] == other.grid[2] &&
+      num_splines == other.num_splines && first_band == other.first_band && last_band == other.last_band;
+}
+
+SplineCoefsCache::MappedTable::~MappedTable() { munmap(base_, bytes_); }
+
+std::string SplineCoefsCache::getFileName(const std::string& prefix, const Key& key)
+{
+  std::ostringstream oo;
+  oo << prefix << ".g" << key.grid[0] << "x" << key.grid[1] << "x" << key.grid[2] << ".b" << key.first_band << "-"
+     << key.last_band << "." << std::hex << std::setw(16) << std::setfill('0') << key.hash << ".spline";
+  return oo.str();
+}
+
+std::unique_ptr<SplineCoefsCache::MappedTable> SplineCoefsCache::map(const std::string& filename, const Key& key)
+{
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return nullptr;
+
+  const size_t file_bytes = header_bytes + blockBytes(key);
+  FileHeader header;
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) != file_bytes ||
+      pread(fd, &header, sizeof(FileHeader), 0) != sizeof(FileHeader) ||
+      std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) != 0 || header.version != format_version ||
+      header.header_bytes != header_bytes || !(header.key == key))
+  {
+    close(fd);
+    return nullptr;
+  }
+
+  // private mapping keeps the file intact. Clean pages are shared by all the processes mapping the same file.
+  void* base = mmap(nullptr, file_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+    return nullptr;
+
+  auto table = std::make_unique<MappedTable>(base, file_bytes);
+  if (checksum(table->coefs(), blockBytes(key)) != header.checksum)
+    return nullptr;
+  return table;
+}
+
+bool SplineCoefsCache::write(const std::string& filename, const Key& key, const void* coefs)
+{
+  std::vector<char> header_page(header_bytes, 0);
+  FileHeader header;
+  std::memset(&header, 0, sizeof(FileHeader));
+  std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+  header.version      = format_version;
+  header.header_bytes = header_bytes;
+  header.key          = key;
+  header.checksum     = checksum(coefs, blockBytes(key));
+  std::memcpy(header_page.data(), &header, sizeof(FileHeader));
+
+  const std::string tmp_filename = filename + ".tmp";
+  {
+    std::ofstream fout(tmp_filename, std::ios::binary | std::ios::trunc);
+    fout.write(header_page.data(), header_page.size());
+    fout.write(static_cast<const char*>(coefs), blockBytes(key));
+    if (!fout.good())
+    {
+      fout.close();
+      std::remove(tmp_filename.c_str());
+      return false;
+    }
+  }
+  return std::rename(tmp_filename.c_str(), filename.c_str()) == 0;
+}
+
+uint64_t SplineCoefsCache::checksum(const void* data, size_t bytes)
+{
+  // the chunking doesn't depend on the number of threads, so is the checksum.
+  constexpr size_t chunk_bytes = 1 << 20;
+  const size_t num_chunks      = (bytes + chunk_bytes - 1) / chunk_bytes;
+  std::vector<uint64_t> chunk_sums(num_chunks);
+  const auto* block = static_cast<const unsigned char*>(data);
+
+#pragma omp parallel for
+  for (size_t ic = 0; ic < num_chunks; ic++)
+  {
+    const unsigned char* chunk = block + ic * chunk_bytes;
+    const size_t n             = std::min(chunk_bytes, bytes - ic * chunk_bytes);
+    uint64_t h                 = 14695981039346656037ULL;
+    size_t i                   = 0;
+    for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t))
+    {
+      uint64_t word;
+      std::memcpy(&word, chunk + i, sizeof(uint64_t));
+      h = (h ^ word) * 1099511628211ULL;
+    }
+    for (; i < n; i++)
+      h = (h ^ chunk[i]) * 1099511628211ULL;
+    chunk_sums[ic] = h ^ (h >> 29);
+  }
+
+  KeyHasher hasher;
+  hasher.add(&bytes, 1);
+  hasher.add(chunk_sums.data(), chunk_sums.size());
+  return hasher.value();
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,118 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file SplineCoefsCache.h
+ *
+ * Native file format caching solved B-spline coefficient tables.
+ * A file holds a header padded to a page followed by the raw coefficients in the MultiBspline layout.
+ * The coefficient block is mapped into memory without copies.
+ */
+#ifndef QMCPLUSPLUS_SPLINE_COEFS_CACHE_H
+#define QMCPLUSPLUS_SPLINE_COEFS_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace qmcplusplus
+{
+class SplineCoefsCache
+{
+public:
+  /// size of the padded header. Keeps the coefficient block page aligned
+  static constexpr size_t header_bytes = 4096;
+  static constexpr uint32_t format_version = 1;
+
+  /// identify a table. All the members must match for a cached table to be used.
+  struct Key
+  {
+    /// hash of the spline class, mesh, twists and bands, see KeyHasher
+    uint64_t hash = 0;
+    /// number of elements in the coefficient block
+    uint64_t coefs_size = 0;
+    /// size of the coefficient data type
+    uint32_t data_size = 0;
+    /// number of spline grid points in each direction
+    int32_t grid[3] = {0, 0, 0};
+    /// number of splines, including padding
+    int32_t num_splines = 0;
+    /// band range [first_band, last_band)
+    int32_t first_band = 0;
+    int32_t last_band  = 0;
+
+    bool operator==(const Key& other) const;
+  };
+
+  /// FNV-1a hash accumulating the properties of a table
+  class KeyHasher
+  {
+  public:
+    template<typename T>
+    void add(const T* data, size_t n)
+    {
+      const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+      for (size_t i = 0; i < n * sizeof(T); i++)
+        hash_ = (hash_ ^ bytes[i]) * 1099511628211ULL;
+    }
+    void add(const std::string& s) { add(s.data(), s.size()); }
+    uint64_t value() const { return hash_; }
+
+  private:
+    uint64_t hash_ = 14695981039346656037ULL;
+  };
+
+  /// a table mapped from a cache file. The memory is unmapped upon destruction
+  class MappedTable
+  {
+  public:
+    MappedTable(void* base, size_t bytes) : base_(base), bytes_(bytes) {}
+    MappedTable(const MappedTable&) = delete;
+    MappedTable& operator=(const MappedTable&) = delete;
+    ~MappedTable();
+
+    /// start of the coefficient block. Pages are copy-on-write, the cache file is never modified
+    void* coefs() const { return static_cast<char*>(base_) + header_bytes; }
+
+  private:
+    void* base_;
+    size_t bytes_;
+  };
+
+  /** file name of a table
+   * @param prefix prefix of the file name, usually the name of the band group
+   * @param key table key
+   */
+  static std::string getFileName(const std::string& prefix, const Key& key);
+
+  /** map a cached table
+   * @param filename cache file
+   * @param key expected table key
+   * @return the mapped table or nullptr if the file is missing, is for a different table or fails the checksum
+   */
+  static std::unique_ptr<MappedTable> map(const std::string& filename, const Key& key);
+
+  /** write a table to a cache file
+   * @param filename cache file
+   * @param key table key
+   * @param coefs coefficient block of key.coefs_size * key.data_size bytes
+   * @return true on success
+   *
+   * The file is written under a temporary name and renamed at the end so that readers never see a partial file.
+   */
+  static bool write(const std::string& filename, const Key& key, const void* coefs);
+
+  /// checksum of a memory block, evaluated in parallel with a fixed chunking
+  static uint64_t checksum(const void* data, size_t bytes);
+};
+
+} // namespace qmcplusplus
+#endif
@@ -30,6 +30,16 @@ inline void SplineR2R<ST>::set_spline(SingleSplineType* spline_r,
   SplineInst->copy_spline(spline_r, ispline);
 }
 
+template<typename ST>
+bool SplineR2R<ST>::compress_table()
+{
+  SplineInst16 = std::make_shared<MultiBsplineInt16<ST>>(*SplineInst->getSplinePtr());
+  app_log() << "MEMORY " << SplineInst16->sizeInByte() / (1 << 20) << " MB allocated "
+            << "for the 16-bit compressed coefficients in 3D spline orbital representation" << std::endl;
+  SplineInst.reset();
+  return true;
+}
+
 template<typename ST>
 bool SplineR2R<ST>::read_splines(hdf_archive& h5f)
 {
@@ -73,6 +83,8 @@ bool SplineR2R<ST>::write_splines(hdf_archive& h5f)
 template<typename ST>
 void SplineR2R<ST>::applyRotation(const ValueMatrix& rot_mat, bool use_stored_copy)
 {
+  if (SplineInst16)
+    throw std::runtime_error("SplineR2R::applyRotation is not supported with a 16-bit compressed spline table!");
   // SplineInst is a MultiBspline. See src/spline2/MultiBspline.hpp
   const auto spline_ptr = SplineInst->getSplinePtr();
   assert(spline_ptr != nullptr);
@@ -145,7 +157,10 @@ void SplineR2R<ST>::evaluateValue(const ParticleSet& P, const int iat, ValueVect
     int first, last;
     FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
+    if (SplineInst16)
+      spline2::evaluate3d(SplineInst16->getSplinePtr(), ru, myV, first, last);
+    else
+      spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
     assign_v(bc_sign, myV, psi, first, last);
   }
 }
@@ -178,7 +193,10 @@ void SplineR2R<ST>::evaluateDetRatios(const VirtualParticleSet& VP,
       PointType ru;
       int bc_sign = convertPos(r, ru);
 
-      spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
+      if (SplineInst16)
+        spline2::evaluate3d(SplineInst16->getSplinePtr(), ru, myV, first, last);
+      else
+        spline2::evaluate3d(SplineInst->getSplinePtr(), ru, myV, first, last);
       assign_v(bc_sign, myV, psi, first, last_real);
       ratios_private[iat][tid] = simd::dot(psi.data() + first, psiinv.data() + first, last_real - first);
     }
@@ -270,7 +288,10 @@ void SplineR2R<ST>::evaluateVGL(const ParticleSet& P,
     int first, last;
     FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
+    if (SplineInst16)
+      spline2::evaluate3d_vgh(SplineInst16->getSplinePtr(), ru, myV, myG, myH, first, last);
+    else
+      spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
     assign_vgl(bc_sign, psi, dpsi, d2psi, first, last);
   }
 }
@@ -353,7 +374,10 @@ void SplineR2R<ST>::evaluateVGH(const ParticleSet& P,
     int first, last;
     FairDivideAligned(myV.size(), getAlignment<ST>(), omp_get_num_threads(), omp_get_thread_num(), first, last);
 
-    spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
+    if (SplineInst16)
+      spline2::evaluate3d_vgh(SplineInst16->getSplinePtr(), ru, myV, myG, myH, first, last);
+    else
+      spline2::evaluate3d_vgh(SplineInst->getSplinePtr(), ru, myV, myG, myH, first, last);
     assign_vgh(bc_sign, psi, dpsi, grad_grad_psi, first, last);
   }
 }
@@ -526,6 +550,8 @@ void SplineR2R<ST>::evaluateVGHGH(const ParticleSet& P,
   PointType ru;
   int bc_sign = convertPos(r, ru);
 
+  if (SplineInst16)
+    throw std::runtime_error("SplineR2R::evaluateVGHGH is not supported with a 16-bit compressed spline table!");
 #pragma omp parallel
   {
     int first, last;
@@ -20,6 +20,7 @@
 #include "QMCWaveFunctions/BsplineFactory/BsplineSet.h"
 #include "OhmmsSoA/VectorSoaContainer.h"
 #include "spline2/MultiBspline.hpp"
+#include "spline2/MultiBsplineInt16.hpp"
 #include "Utilities/FairDivide.h"
 
 namespace qmcplusplus
@@ -57,6 +58,8 @@ private:
   Tensor<ST, 3> GGt;
   ///multi bspline set
   std::shared_ptr<MultiBspline<ST>> SplineInst;
+  ///multi bspline set compressed to 16-bit integers, replaces SplineInst if not null
+  std::shared_ptr<MultiBsplineInt16<ST>> SplineInst16;
 
   ///thread private ratios for reduction when using nested threading, numVP x numThread
   Matrix<TT> ratios_private;
@@ -136,6 +139,8 @@ public:
 
   inline void flush_zero() { SplineInst->flush_zero(); }
 
+  bool compress_table() override;
+
   void set_spline(SingleSplineType* spline_r, SingleSplineType* spline_i, int twist, int ispline, int level);
 
   bool read_splines(hdf_archive& h5f);
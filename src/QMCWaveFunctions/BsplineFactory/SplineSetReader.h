@@ -28,6 +28,10 @@
 #include "mpi/collectives.h"
 #include "mpi/point2point.h"
 #include "Utilities/FairDivide.h"
+#include "Message/NodeSharedBuffer.h"
+#include "SplineCoefsCache.h"
+#include "Concurrency/OpenMP.h"
+#include <exception>
 
 namespace qmcplusplus
 {
@@ -40,29 +44,62 @@ struct SplineSetReader : public BsplineReaderBase
   using DataType    = typename splineset_t::DataType;
   using SplineType  = typename splineset_t::SplineType;
 
-  Array<std::complex<double>, 3> FFTbox;
-  Array<double, 3> splineData_r, splineData_i;
+  /** buffers to transform one band from plane waves to B-splines
+   *
+   * Each thread converting bands owns one of them.
+   */
+  struct BandWorkspace
+  {
+    Array<std::complex<double>, 3> FFTbox;
+    Array<double, 3> splineData_r, splineData_i;
+    double rotate_phase_r, rotate_phase_i;
+    UBspline_3d_d* spline_r;
+    UBspline_3d_d* spline_i;
+    fftw_plan FFTplan;
+
+    /// FFTW planning is not thread-safe. Workspaces must be created serially.
+    BandWorkspace(const TinyVector<int, 3>& mesh, const TinyVector<int, 3>& halfG, bool is_complex)
+        : rotate_phase_r(1.0), rotate_phase_i(0.0), spline_r(nullptr), spline_i(nullptr)
+    {
+      FFTbox.resize(mesh[0], mesh[1], mesh[2]);
+      FFTplan = fftw_plan_dft_3d(mesh[0], mesh[1], mesh[2], reinterpret_cast<fftw_complex*>(FFTbox.data()),
+                                 reinterpret_cast<fftw_complex*>(FFTbox.data()), +1, FFTW_ESTIMATE);
+      splineData_r.resize(mesh[0], mesh[1], mesh[2]);
+      if (is_complex)
+        splineData_i.resize(mesh[0], mesh[1], mesh[2]);
+
+      TinyVector<double, 3> start(0.0);
+      TinyVector<double, 3> end(1.0);
+      spline_r = einspline::create(spline_r, start, end, mesh, halfG);
+      if (is_complex)
+        spline_i = einspline::create(spline_i, start, end, mesh, halfG);
+    }
+
+    BandWorkspace(const BandWorkspace&) = delete;
+    BandWorkspace& operator=(const BandWorkspace&) = delete;
+
+    ~BandWorkspace()
+    {
+      einspline::destroy(spline_r);
+      einspline::destroy(spline_i);
+      fftw_destroy_plan(FFTplan);
+    }
+  };
+
   double rotate_phase_r, rotate_phase_i;
-  UBspline_3d_d* spline_r;
-  UBspline_3d_d* spline_i;
   splineset_t* bspline;
-  fftw_plan FFTplan;
+  std::vector<std::unique_ptr<BandWorkspace>> workspaces;
 
-  SplineSetReader(EinsplineSetBuilder* e)
-      : BsplineReaderBase(e), spline_r(nullptr), spline_i(nullptr), bspline(nullptr), FFTplan(nullptr)
-  {}
+  SplineSetReader(EinsplineSetBuilder* e) : BsplineReaderBase(e), bspline(nullptr) {}
 
   ~SplineSetReader() override { clear(); }
 
-  void clear()
-  {
-    einspline::destroy(spline_r);
-    einspline::destroy(spline_i);
-    if (FFTplan != nullptr)
-      fftw_destroy_plan(FFTplan);
-    FFTplan = nullptr;
-  }
+  void clear() { workspaces.clear(); }
 
+  /// true if the spline table can be placed in memory not owned by the spline, see MultiBspline::attachExternalCoefs
+  virtual bool supportExternalTable() const { return !bspline->isOMPoffload(); }
+  /// true if bands can be converted concurrently. create_atomic_centers_Gspace must be called band by band.
+  virtual bool supportConcurrentBands() const { return true; }
   // set info for Hybrid
   virtual void initialize_hybridrep_atomic_centers() {}
   // transform cG to radial functions
@@ -84,6 +121,9 @@ struct SplineSetReader : public BsplineReaderBase
       xyz_bc[i].rCode = xyz_bc_d[i].rCode;
     }
 
+    if (!bspline->SplineInst)
+      throw std::runtime_error("export_MultiSplineComplexDouble failed for a 16-bit compressed spline table.");
+
     const auto* source = (multi_UBspline_3d_d*)bspline->SplineInst->getSplinePtr();
     std::unique_ptr<multi_UBspline_3d_z> target;
     target.reset(einspline::create(target.get(), xyz_grid, xyz_bc, source->num_splines / 2));
@@ -109,6 +149,9 @@ struct SplineSetReader : public BsplineReaderBase
     BCtype_d xyz_bc[3];
     set_grid(bspline->HalfG, xyz_grid, xyz_bc);
 
+    if (!bspline->SplineInst)
+      throw std::runtime_error("export_MultiSplineDouble failed for a 16-bit compressed spline table.");
+
     const auto* source = (multi_UBspline_3d_d*)bspline->SplineInst->getSplinePtr();
     std::unique_ptr<multi_UBspline_3d_d> target;
     target.reset(einspline::create(target.get(), xyz_grid, xyz_bc, source->num_splines));
@@ -156,6 +199,51 @@ struct SplineSetReader : public BsplineReaderBase
 
     const std::string splinefile(oo.str());
     bool root       = (myComm->rank() == 0);
+
+    std::string cachefile;
+    SplineCoefsCache::Key cache_key;
+    if (mmapSplineCoefs)
+    {
+      if (supportExternalTable())
+      {
+        cache_key = make_cache_key(spin, bandgroup);
+        cachefile = SplineCoefsCache::getFileName(bandgroup.myName, cache_key);
+        if (map_cached_table(cachefile, cache_key))
+        {
+          clear();
+          compress_table();
+          return std::unique_ptr<SPOSet>{bspline};
+        }
+      }
+      else
+        app_log() << "  WARNING: mmap_coefs is not supported by " << bspline->getClassName() << "." << std::endl;
+    }
+
+    /* With a node shared table, only the node leaders build the table and the other ranks read it from the shared
+     * memory window. table_comm connects the ranks holding a copy of the table.
+     */
+    Communicate* table_comm = myComm;
+    bool table_owner        = true;
+    std::unique_ptr<Communicate> node_comm;
+    std::shared_ptr<NodeSharedBuffer<DataType>> shared_coefs;
+    if (nodeSharedTable)
+    {
+      if (supportExternalTable())
+      {
+        node_comm = std::make_unique<Communicate>();
+        node_comm->initializeAsNodeComm(*myComm);
+        auto* spline_ptr = bspline->SplineInst->getSplinePtr();
+        shared_coefs     = std::make_shared<NodeSharedBuffer<DataType>>(*node_comm, spline_ptr->coefs_size);
+        bspline->SplineInst->attachExternalCoefs(shared_coefs->data(), shared_coefs);
+        table_comm  = node_comm->getGroupLeaderComm();
+        table_owner = node_comm->isGroupLeader();
+        app_log() << "  Spline table shared by " << node_comm->size() << " ranks on each node" << std::endl;
+      }
+      else
+        app_log() << "  WARNING: node_shared_table is not supported by " << bspline->getClassName()
+                  << ". Each rank holds its own copy of the spline table." << std::endl;
+    }
+
     int foundspline = 0;
     Timer now;
     if (root)
@@ -188,38 +276,20 @@ struct SplineSetReader : public BsplineReaderBase
     if (foundspline)
     {
       now.restart();
-      bspline->bcast_tables(myComm);
+      if (table_owner)
+        bspline->bcast_tables(table_comm);
       app_log() << "  SplineSetReader bcast the full table " << now.elapsed() << " sec." << std::endl;
       app_log().flush();
     }
-    else
+    else if (table_owner)
     {
       bspline->flush_zero();
 
-      int nx = MeshSize[0];
-      int ny = MeshSize[1];
-      int nz = MeshSize[2];
       if (havePsig) //perform FFT using FFTW
       {
-        FFTbox.resize(nx, ny, nz);
-        FFTplan = fftw_plan_dft_3d(nx, ny, nz, reinterpret_cast<fftw_complex*>(FFTbox.data()),
-                                   reinterpret_cast<fftw_complex*>(FFTbox.data()), +1, FFTW_ESTIMATE);
-        splineData_r.resize(nx, ny, nz);
-        if (bspline->is_complex)
-          splineData_i.resize(nx, ny, nz);
-
-        TinyVector<double, 3> start(0.0);
-        TinyVector<double, 3> end(1.0);
-        spline_r = einspline::create(spline_r, start, end, MeshSize, bspline->HalfG);
-        if (bspline->is_complex)
-          spline_i = einspline::create(spline_i, start, end, MeshSize, bspline->HalfG);
-
         now.restart();
-        initialize_spline_pio_gather(spin, bandgroup);
+        initialize_spline_pio_gather(spin, bandgroup, *table_comm);
         app_log() << "  SplineSetReader initialize_spline_pio " << now.elapsed() << " sec" << std::endl;
-
-        fftw_destroy_plan(FFTplan);
-        FFTplan = NULL;
       }
       else //why, don't know
         initialize_spline_psi_r(spin, bandgroup);
@@ -239,94 +309,259 @@ struct SplineSetReader : public BsplineReaderBase
       }
     }
 
+    // make the table written by the node leader visible to all the ranks on the node
+    if (shared_coefs)
+      shared_coefs->fence();
+
+    if (root && !cachefile.empty())
+    {
+      now.restart();
+      if (SplineCoefsCache::write(cachefile, cache_key, bspline->SplineInst->getSplinePtr()->coefs))
+        app_log() << "  Stored spline coefficients in " << cachefile << " for mapping in later runs. The writing time is "
+                  << now.elapsed() << " sec." << std::endl;
+      else
+        app_log() << "  WARNING: failed to store spline coefficients in " << cachefile << std::endl;
+    }
+
     clear();
+    compress_table();
     return std::unique_ptr<SPOSet>{bspline};
   }
 
+  /// compress the finished spline table to 16-bit integers if requested
+  void compress_table()
+  {
+    if (!int16SplineCoefs)
+      return;
+    if (bspline->compress_table())
+      app_log() << "  Spline table compressed to 16-bit integers" << std::endl;
+    else
+      app_log() << "  WARNING: int16_coefs is not supported by " << bspline->getClassName() << "." << std::endl;
+  }
+
+  /** compute the key identifying the table in a SplineCoefsCache file
+   *
+   * Hash the spline class, mesh, twists and bands. The band energies catch regenerated orbitals.
+   */
+  SplineCoefsCache::Key make_cache_key(int spin, const BandInfoGroup& bandgroup)
+  {
+    SplineCoefsCache::KeyHasher hasher;
+    hasher.add(bspline->getClassName());
+    hasher.add(MeshSize.data(), 3);
+    hasher.add(bspline->HalfG.data(), 3);
+    hasher.add(&spin, 1);
+    hasher.add(&rotate, 1);
+    const int Nbands                       = bandgroup.getNumDistinctOrbitals();
+    const std::vector<BandInfo>& cur_bands = bandgroup.myBands;
+    for (int iorb = 0; iorb < Nbands; iorb++)
+    {
+      const BandInfo& band = cur_bands[bspline->BandIndexMap[iorb]];
+      hasher.add(mybuilder->TwistAngles[band.TwistIndex].data(), 3);
+      hasher.add(&band.BandIndex, 1);
+      hasher.add(&band.Energy, 1);
+    }
+
+    const auto* spline_ptr = bspline->SplineInst->getSplinePtr();
+    SplineCoefsCache::Key key;
+    key.hash        = hasher.value();
+    key.coefs_size  = spline_ptr->coefs_size;
+    key.data_size   = sizeof(DataType);
+    key.grid[0]     = spline_ptr->x_grid.num;
+    key.grid[1]     = spline_ptr->y_grid.num;
+    key.grid[2]     = spline_ptr->z_grid.num;
+    key.num_splines = spline_ptr->num_splines;
+    key.first_band  = bandgroup.FirstBand;
+    key.last_band   = bandgroup.FirstBand + Nbands;
+    return key;
+  }
+
+  /** map the table from a SplineCoefsCache file
+   * @return true if all the ranks mapped the table. Otherwise the table is left untouched.
+   */
+  bool map_cached_table(const std::string& cachefile, const SplineCoefsCache::Key& cache_key)
+  {
+    Timer now;
+    std::shared_ptr<SplineCoefsCache::MappedTable> mapped = SplineCoefsCache::map(cachefile, cache_key);
+    // the table must be consistent on all the ranks
+    int num_mapped = mapped ? 1 : 0;
+    myComm->allreduce(num_mapped);
+    if (num_mapped < myComm->size())
+    {
+      app_log() << "  No usable spline cache " << cachefile << " on all the ranks." << std::endl;
+      return false;
+    }
+    bspline->SplineInst->attachExternalCoefs(static_cast<DataType*>(mapped->coefs()), mapped);
+    app_log() << "  Successfully mapped coefficients from " << cachefile << ". The mapping time is " << now.elapsed()
+              << " sec." << std::endl;
+    return true;
+  }
+
   /** fft and spline cG
    * @param cG psi_g to be processed
    * @param ti twist index
-   * @param iorb orbital index
+   * @param ws workspace holding the resulting spline_r and spline_i
    *
    * Perform FFT and spline to spline_r and spline_i
    */
-  inline void fft_spline(Vector<std::complex<double>>& cG, int ti)
+  inline void fft_spline(const Vector<std::complex<double>>& cG, int ti, BandWorkspace& ws)
   {
-    unpack4fftw(cG, mybuilder->Gvecs[0], MeshSize, FFTbox);
-    fftw_execute(FFTplan);
+    unpack4fftw(cG, mybuilder->Gvecs[0], MeshSize, ws.FFTbox);
+    fftw_execute(ws.FFTplan);
     if (bspline->is_complex)
     {
       if (rotate)
-        fix_phase_rotate_c2c(FFTbox, splineData_r, splineData_i, mybuilder->TwistAngles[ti], rotate_phase_r,
-                             rotate_phase_i);
+        fix_phase_rotate_c2c(ws.FFTbox, ws.splineData_r, ws.splineData_i, mybuilder->TwistAngles[ti],
+                             ws.rotate_phase_r, ws.rotate_phase_i);
       else
       {
-        split_real_components_c2c(FFTbox, splineData_r, splineData_i);
-        rotate_phase_r = 1.0;
-        rotate_phase_i = 0.0;
+        split_real_components_c2c(ws.FFTbox, ws.splineData_r, ws.splineData_i);
+        ws.rotate_phase_r = 1.0;
+        ws.rotate_phase_i = 0.0;
       }
-      einspline::set(spline_r, splineData_r.data());
-      einspline::set(spline_i, splineData_i.data());
+      einspline::set(ws.spline_r, ws.splineData_r.data());
+      einspline::set(ws.spline_i, ws.splineData_i.data());
     }
     else
     {
-      fix_phase_rotate_c2r(FFTbox, splineData_r, mybuilder->TwistAngles[ti], rotate_phase_r, rotate_phase_i);
-      einspline::set(spline_r, splineData_r.data());
+      fix_phase_rotate_c2r(ws.FFTbox, ws.splineData_r, mybuilder->TwistAngles[ti], ws.rotate_phase_r,
+                           ws.rotate_phase_i);
+      einspline::set(ws.spline_r, ws.splineData_r.data());
     }
   }
 
+  /** read psi_g of a band and check its norm
+   * @param iorb orbital index
+   * @param cG psi_g read from h5f
+   * @return twist index of the band
+   */
+  int read_band(hdf_archive& h5f, int spin, const BandInfoGroup& bandgroup, int iorb, Vector<std::complex<double>>& cG)
+  {
+    const std::vector<BandInfo>& cur_bands = bandgroup.myBands;
+    int iorb_h5                            = bspline->BandIndexMap[iorb];
+    int ti                                 = cur_bands[iorb_h5].TwistIndex;
+    std::string s                          = psi_g_path(ti, spin, cur_bands[iorb_h5].BandIndex);
+    if (!h5f.readEntry(cG, s))
+    {
+      std::ostringstream msg;
+      msg << "SplineSetReader Failed to read band(s) from h5 file. "
+          << "Attempted dataset " << s << " with " << cG.size() << " complex numbers." << std::endl;
+      throw std::runtime_error(msg.str());
+    }
+    double total_norm = compute_norm(cG);
+    if ((checkNorm) && (std::abs(total_norm - 1.0) > PW_COEFF_NORM_TOLERANCE))
+    {
+      std::ostringstream msg;
+      msg << "SplineSetReader The orbital " << iorb_h5 << " has a wrong norm " << total_norm
+          << ", computed from plane wave coefficients!" << std::endl
+          << "This may indicate a problem with the HDF5 library versions used "
+          << "during wavefunction conversion or read." << std::endl;
+      throw std::runtime_error(msg.str());
+    }
+    return ti;
+  }
+
+  /** convert bands [iorb_first, iorb_last) using all the threads
+   *
+   * One thread reads the bands from h5f in order and spawns a task per band doing FFT and spline,
+   * so the reading overlaps with the conversion of the bands read earlier.
+   * HDF5 calls remain serialized. Each task uses the workspace of the thread running it.
+   */
+  void convert_bands_concurrent(hdf_archive& h5f, int spin, const BandInfoGroup& bandgroup, int iorb_first, int iorb_last)
+  {
+    // bound the number of bands held in memory. Reuse a buffer only after all the tasks spawned before finished.
+    const int num_buffers = std::min(2 * static_cast<int>(workspaces.size()), iorb_last - iorb_first);
+    std::vector<Vector<std::complex<double>>> cG_buffers(num_buffers);
+    for (auto& cG : cG_buffers)
+      cG.resize(mybuilder->Gvecs[0].size());
+
+    std::exception_ptr read_error;
+#pragma omp parallel
+#pragma omp single
+    {
+      for (int iorb = iorb_first; iorb < iorb_last; iorb++)
+      {
+        const int ibuf = (iorb - iorb_first) % num_buffers;
+        if (ibuf == 0 && iorb > iorb_first)
+        {
+#pragma omp taskwait
+        }
+        int ti;
+        try
+        {
+          ti = read_band(h5f, spin, bandgroup, iorb, cG_buffers[ibuf]);
+        }
+        catch (...)
+        {
+          read_error = std::current_exception();
+          break;
+        }
+#pragma omp task firstprivate(iorb, ibuf, ti)
+        {
+          BandWorkspace& ws = *workspaces[omp_get_thread_num()];
+          fft_spline(cG_buffers[ibuf], ti, ws);
+          bspline->set_spline(ws.spline_r, ws.spline_i, ti, iorb, 0);
+        }
+      }
+    }
+    if (read_error)
+      std::rethrow_exception(read_error);
+  }
 
   /** initialize the splines
+   * @param table_comm ranks holding a copy of the table. They share the work and get the full table.
    */
-  void initialize_spline_pio_gather(int spin, const BandInfoGroup& bandgroup)
+  void initialize_spline_pio_gather(int spin, const BandInfoGroup& bandgroup, Communicate& table_comm)
   {
     //distribute bands over processor groups
     int Nbands            = bandgroup.getNumDistinctOrbitals();
-    const int Nprocs      = myComm->size();
+    const int Nprocs      = table_comm.size();
     const int Nbandgroups = std::min(Nbands, Nprocs);
-    Communicate band_group_comm(*myComm, Nbandgroups);
+    Communicate band_group_comm(table_comm, Nbandgroups);
     std::vector<int> band_groups(Nbandgroups + 1, 0);
     FairDivideLow(Nbands, Nbandgroups, band_groups);
     int iorb_first = band_groups[band_group_comm.getGroupID()];
     int iorb_last  = band_groups[band_group_comm.getGroupID() + 1];
 
+    const bool concurrent_bands = supportConcurrentBands() && omp_get_max_threads() > 1 && iorb_last - iorb_first > 1;
+    if (band_group_comm.isGroupLeader())
+    {
+      const int num_workspaces = concurrent_bands ? omp_get_max_threads() : 1;
+      for (int i = 0; i < num_workspaces; i++)
+        workspaces.push_back(std::make_unique<BandWorkspace>(MeshSize, bspline->HalfG, bspline->is_complex));
+    }
+
     app_log() << "Start transforming plane waves to 3D B-Splines." << std::endl;
+    if (concurrent_bands)
+      app_log() << "  Converting bands concurrently on " << omp_get_max_threads() << " threads per band group."
+                << std::endl;
     hdf_archive h5f(&band_group_comm, false);
-    Vector<std::complex<double>> cG(mybuilder->Gvecs[0].size());
-    const std::vector<BandInfo>& cur_bands = bandgroup.myBands;
     if (band_group_comm.isGroupLeader())
       h5f.open(mybuilder->H5FileName, H5F_ACC_RDONLY);
-    for (int iorb = iorb_first; iorb < iorb_last; iorb++)
+    if (concurrent_bands)
     {
       if (band_group_comm.isGroupLeader())
+        convert_bands_concurrent(h5f, spin, bandgroup, iorb_first, iorb_last);
+    }
+    else
+    {
+      Vector<std::complex<double>> cG(mybuilder->Gvecs[0].size());
+      for (int iorb = iorb_first; iorb < iorb_last; iorb++)
       {
-        int iorb_h5   = bspline->BandIndexMap[iorb];
-        int ti        = cur_bands[iorb_h5].TwistIndex;
-        std::string s = psi_g_path(ti, spin, cur_bands[iorb_h5].BandIndex);
-        if (!h5f.readEntry(cG, s))
-        {
-          std::ostringstream msg;
-          msg << "SplineSetReader Failed to read band(s) from h5 file. "
-              << "Attempted dataset " << s << " with " << cG.size() << " complex numbers." << std::endl;
-          throw std::runtime_error(msg.str());
-        }
-        double total_norm = compute_norm(cG);
-        if ((checkNorm) && (std::abs(total_norm - 1.0) > PW_COEFF_NORM_TOLERANCE))
+        if (band_group_comm.isGroupLeader())
         {
-          std::ostringstream msg;
-          msg << "SplineSetReader The orbital " << iorb_h5 << " has a wrong norm " << total_norm
-              << ", computed from plane wave coefficients!" << std::endl
-              << "This may indicate a problem with the HDF5 library versions used "
-              << "during wavefunction conversion or read." << std::endl;
-          throw std::runtime_error(msg.str());
+          BandWorkspace& ws = *workspaces[0];
+          int ti            = read_band(h5f, spin, bandgroup, iorb, cG);
+          fft_spline(cG, ti, ws);
+          bspline->set_spline(ws.spline_r, ws.spline_i, ti, iorb, 0);
+          rotate_phase_r = ws.rotate_phase_r;
+          rotate_phase_i = ws.rotate_phase_i;
         }
-        fft_spline(cG, ti);
-        bspline->set_spline(spline_r, spline_i, cur_bands[iorb_h5].TwistIndex, iorb, 0);
+        this->create_atomic_centers_Gspace(cG, band_group_comm, iorb);
       }
-      this->create_atomic_centers_Gspace(cG, band_group_comm, iorb);
     }
+    workspaces.clear();
 
-    myComm->barrier();
+    table_comm.barrier();
     Timer now;
     if (band_group_comm.isGroupLeader())
     {
@@ -335,7 +570,7 @@ struct SplineSetReader : public BsplineReaderBase
       app_log() << "  Time to gather the table = " << now.elapsed() << std::endl;
     }
     now.restart();
-    bspline->bcast_tables(myComm);
+    bspline->bcast_tables(&table_comm);
     app_log() << "  Time to bcast the table = " << now.elapsed() << std::endl;
   }
 
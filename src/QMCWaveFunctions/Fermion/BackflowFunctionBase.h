@@ -204,6 +204,28 @@ public:
                             GradMatrix& Bmat,
                             HessMatrix& Amat) = 0;
 
+  /** calculate quasi-particle coordinates, and Amat if Amat_list is not empty, after pbyp move of multiple walkers
+   * @param bf_list the list of the same backflow function of a walker batch
+   * @param p_list the list of ParticleSet of a walker batch
+   * @param iat the moved particle
+   * @param newQP_list the quasi-particle coordinates of each walker, updated
+   * @param Amat_list Amat of each walker, updated
+   */
+  virtual void mw_evaluatePbyP(const RefVectorWithLeader<BackflowFunctionBase>& bf_list,
+                               const RefVectorWithLeader<ParticleSet>& p_list,
+                               int iat,
+                               const RefVector<ParticleSet::ParticlePos>& newQP_list,
+                               const RefVector<HessMatrix>& Amat_list) const
+  {
+    assert(this == &bf_list.getLeader());
+#pragma omp parallel for
+    for (int iw = 0; iw < bf_list.size(); iw++)
+      if (Amat_list.empty())
+        bf_list[iw].evaluatePbyP(p_list[iw], iat, newQP_list[iw]);
+      else
+        bf_list[iw].evaluatePbyP(p_list[iw], iat, newQP_list[iw], Amat_list[iw]);
+  }
+
   /** calculate only Bmat
    *  This is used in pbyp moves, in updateBuffer()
    */
@@ -23,10 +23,14 @@ namespace qmcplusplus
 BackflowTransformation::BackflowTransformation(ParticleSet& els)
     : QP(els), cutOff(0.0), myTableIndex_(els.addTable(els))
 {
+  // the quasiparticle update takes the displacement of the moved particle from the temp row of the e-e table
+  if (els.getDistTableAA(myTableIndex_).getNeighborCutoff() > 0)
+    throw std::runtime_error("BackflowTransformation doesn't support the neighbor lists of the e-e distance table!");
   NumTargets = els.getTotalNum();
   Bmat.resize(NumTargets);
   Bmat_full.resize(NumTargets, NumTargets);
   Amat.resize(NumTargets, NumTargets);
+  Amat_temp.resize(NumTargets, NumTargets);
   newQP.resize(NumTargets);
   oldQP.resize(NumTargets);
   indexQP.resize(NumTargets);
@@ -68,6 +72,11 @@ void BackflowTransformation::acceptMove(const ParticleSet& P, int iat)
   // may be faster if I do this one qp at a time, for now do full update
   for (int i = 0; i < NumTargets; i++)
     QP.R[i] = newQP[i];
+  completeAcceptMove(iat);
+}
+
+void BackflowTransformation::completeAcceptMove(int iat)
+{
   QP.update(0);
   indexQP.clear();
   switch (UpdateMode)
@@ -75,15 +84,15 @@ void BackflowTransformation::acceptMove(const ParticleSet& P, int iat)
   case ORB_PBYP_RATIO:
     break;
   case ORB_PBYP_PARTIAL:
-    std::copy(FirstOfA_temp, LastOfA_temp, FirstOfA);
+    std::copy(Amat_temp.begin(), Amat_temp.end(), Amat.begin());
     break;
   case ORB_PBYP_ALL:
-    std::copy(FirstOfA_temp, LastOfA_temp, FirstOfA);
-    std::copy(FirstOfB_temp, LastOfB_temp, FirstOfB);
+    std::copy(Amat_temp.begin(), Amat_temp.end(), Amat.begin());
+    std::copy(Bmat_temp.begin(), Bmat_temp.end(), Bmat_full.begin());
     break;
   default:
-    std::copy(FirstOfA_temp, LastOfA_temp, FirstOfA);
-    std::copy(FirstOfB_temp, LastOfB_temp, FirstOfB);
+    std::copy(Amat_temp.begin(), Amat_temp.end(), Amat.begin());
+    std::copy(Bmat_temp.begin(), Bmat_temp.end(), Bmat_full.begin());
     break;
   }
   for (int i = 0; i < bfFuns.size(); i++)
@@ -266,6 +275,125 @@ void BackflowTransformation::evaluatePbyPWithGrad(const ParticleSet& P, int iat)
   }
 }
 
+void BackflowTransformation::createResource(ResourceCollection& collection) const
+{
+  collection.addResource(std::make_unique<BackflowTransformationMultiWalkerResource>());
+}
+
+void BackflowTransformation::acquireResource(ResourceCollection& collection,
+                                             const RefVectorWithLeader<BackflowTransformation>& bf_list) const
+{
+  auto& bf_leader = bf_list.getLeader();
+  auto res_ptr    = dynamic_cast<BackflowTransformationMultiWalkerResource*>(collection.lendResource().release());
+  if (!res_ptr)
+    throw std::runtime_error("BackflowTransformation::acquireResource dynamic_cast failed");
+  bf_leader.mw_res_.reset(res_ptr);
+}
+
+void BackflowTransformation::releaseResource(ResourceCollection& collection,
+                                             const RefVectorWithLeader<BackflowTransformation>& bf_list) const
+{
+  auto& bf_leader = bf_list.getLeader();
+  collection.takebackResource(std::move(bf_leader.mw_res_));
+}
+
+void BackflowTransformation::mw_evaluatePbyP(const RefVectorWithLeader<BackflowTransformation>& bf_list,
+                                             const RefVectorWithLeader<ParticleSet>& p_list,
+                                             int iat,
+                                             bool with_grad) const
+{
+  auto& bf_leader = bf_list.getLeader();
+  assert(this == &bf_leader);
+  bf_leader.guardMultiWalkerRes();
+  auto& mw_res   = *bf_leader.mw_res_;
+  const int nw   = bf_list.size();
+  const int mode = with_grad ? ORB_PBYP_PARTIAL : ORB_PBYP_RATIO;
+
+#pragma omp parallel for
+  for (int iw = 0; iw < nw; iw++)
+  {
+    BackflowTransformation& bf = bf_list[iw];
+    bf.UpdateMode              = mode;
+    // there should be no need for this, but there is (missing calls in QMCHam...)
+    for (int i = 0; i < bf.bfFuns.size(); i++)
+      bf.bfFuns[i]->restore(iat, mode);
+    bf.activeParticle = iat;
+    for (int i = 0; i < NumTargets; i++)
+      bf.oldQP[i] = bf.newQP[i] = bf.QP.R[i];
+    bf.newQP[iat] -= p_list[iw].getDistTableAA(myTableIndex_).getTempDispls()[iat];
+    bf.indexQP.clear();
+    if (with_grad)
+      std::copy(bf.Amat.begin(), bf.Amat.end(), bf.Amat_temp.begin());
+  }
+
+  RefVector<ParticleSet::ParticlePos> newQP_list;
+  RefVector<HessMatrix> Amat_list;
+  newQP_list.reserve(nw);
+  for (BackflowTransformation& bf : bf_list)
+  {
+    newQP_list.push_back(bf.newQP);
+    if (with_grad)
+      Amat_list.push_back(bf.Amat_temp);
+  }
+  for (int i = 0; i < bfFuns.size(); i++)
+  {
+    RefVectorWithLeader<BackflowFunctionBase> fun_list(*bfFuns[i]);
+    fun_list.reserve(nw);
+    for (BackflowTransformation& bf : bf_list)
+      fun_list.push_back(*bf.bfFuns[i]);
+    bfFuns[i]->mw_evaluatePbyP(fun_list, p_list, iat, newQP_list, Amat_list);
+  }
+
+  // gather the coordinates of all the walkers and find the changed quasi-particles
+  mw_res.new_qp.resize(nw * NumTargets);
+  mw_res.qp_displs.resize(nw * NumTargets);
+#pragma omp parallel for
+  for (int iw = 0; iw < nw; iw++)
+  {
+    BackflowTransformation& bf = bf_list[iw];
+    const int first            = iw * NumTargets;
+    for (int jat = 0; jat < NumTargets; jat++)
+    {
+      mw_res.new_qp(first + jat)    = bf.newQP[jat];
+      mw_res.qp_displs(first + jat) = bf.newQP[jat] - bf.QP.R[jat];
+    }
+    for (int jat = 0; jat < NumTargets; jat++)
+    {
+      RealType dr2 = 0;
+      for (int idim = 0; idim < DIM; idim++)
+        dr2 += mw_res.qp_displs.data(idim)[first + jat] * mw_res.qp_displs.data(idim)[first + jat];
+      if (std::sqrt(dr2) > 1e-10)
+        bf.indexQP.push_back(jat);
+    }
+  }
+}
+
+void BackflowTransformation::mw_accept_rejectMove(const RefVectorWithLeader<BackflowTransformation>& bf_list,
+                                                  const RefVectorWithLeader<ParticleSet>& p_list,
+                                                  int iat,
+                                                  const std::vector<bool>& isAccepted) const
+{
+  auto& bf_leader = bf_list.getLeader();
+  assert(this == &bf_leader);
+  bf_leader.guardMultiWalkerRes();
+  const auto& new_qp = bf_leader.mw_res_->new_qp;
+  assert(new_qp.size() == bf_list.size() * NumTargets);
+
+#pragma omp parallel for
+  for (int iw = 0; iw < bf_list.size(); iw++)
+  {
+    BackflowTransformation& bf = bf_list[iw];
+    if (isAccepted[iw])
+    {
+      for (int i = 0; i < NumTargets; i++)
+        bf.QP.R[i] = new_qp[iw * NumTargets + i];
+      bf.completeAcceptMove(iat);
+    }
+    else
+      bf.restore(iat);
+  }
+}
+
 /** calculate new quasi-particle coordinates after pbyp move
    */
 void BackflowTransformation::evaluatePbyPAll(const ParticleSet& P, int iat)
@@ -24,6 +24,8 @@
 #include "Particle/ParticleBase/ParticleAttribOps.h"
 #include "QMCWaveFunctions/Fermion/BackflowFunctionBase.h"
 #include "OhmmsPETE/OhmmsArray.h"
+#include "OhmmsSoA/VectorSoaContainer.h"
+#include "ResourceCollection.h"
 
 namespace qmcplusplus
 {
@@ -141,6 +143,23 @@ public:
 
   opt_variables_type myVars;
 
+  /** quasi-particle coordinates of all the walkers of a batch in SoA blocks
+   * The block of walker iw is [iw * NumTargets, (iw + 1) * NumTargets).
+   */
+  struct BackflowTransformationMultiWalkerResource : public Resource
+  {
+    BackflowTransformationMultiWalkerResource() : Resource("BackflowTransformation") {}
+    BackflowTransformationMultiWalkerResource(const BackflowTransformationMultiWalkerResource&)
+        : BackflowTransformationMultiWalkerResource()
+    {}
+
+    Resource* makeClone() const override { return new BackflowTransformationMultiWalkerResource(*this); }
+    /// quasi-particle coordinates proposed by the last mw_evaluatePbyP
+    VectorSoaContainer<RealType, DIM> new_qp;
+    /// new_qp minus the current quasi-particle coordinates
+    VectorSoaContainer<RealType, DIM> qp_displs;
+  };
+
   BackflowTransformation(ParticleSet& els);
 
   void copyFrom(const BackflowTransformation& tr, ParticleSet& targetPtcl);
@@ -205,6 +224,58 @@ public:
   void testDeriv(const ParticleSet& P);
 
   void testPbyP(ParticleSet& P);
+
+  void createResource(ResourceCollection& collection) const;
+
+  void acquireResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<BackflowTransformation>& bf_list) const;
+
+  void releaseResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<BackflowTransformation>& bf_list) const;
+
+  /** calculate new quasi-particle coordinates after pbyp move of multiple walkers
+   * @param bf_list the list of BackflowTransformation of a walker batch
+   * @param p_list the list of ParticleSet of a walker batch
+   * @param iat the moved particle
+   * @param with_grad if true, update Amat_temp as evaluatePbyPWithGrad, otherwise as evaluatePbyP
+   *
+   * indexQP and newQP of each walker are set as by the single walker functions and the coordinates are
+   * gathered in the SoA blocks of the multi walker resource of the leader.
+   */
+  void mw_evaluatePbyP(const RefVectorWithLeader<BackflowTransformation>& bf_list,
+                       const RefVectorWithLeader<ParticleSet>& p_list,
+                       int iat,
+                       bool with_grad) const;
+
+  /** accept or reject the move of the iat-th particle of multiple walkers
+   * The quasi-particle coordinates of the accepted walkers are taken from the SoA blocks.
+   */
+  void mw_accept_rejectMove(const RefVectorWithLeader<BackflowTransformation>& bf_list,
+                            const RefVectorWithLeader<ParticleSet>& p_list,
+                            int iat,
+                            const std::vector<bool>& isAccepted) const;
+
+  /// displacement of the quasi-particle jat of the iw-th walker proposed by the last mw_evaluatePbyP
+  PosType getMultiWalkerQPDispl(int iw, int jat) const { return mw_res_->qp_displs[iw * NumTargets + jat]; }
+
+private:
+  /// multi walker resource, only valid in the leader of a batch
+  std::unique_ptr<BackflowTransformationMultiWalkerResource> mw_res_;
+
+  /// update the distance tables, Amat and the functions once QP.R holds the coordinates of an accepted move
+  void completeAcceptMove(int iat);
+
+  /// make this class unit tests friendly without the need of setup resources.
+  void guardMultiWalkerRes()
+  {
+    if (!mw_res_)
+    {
+      std::cerr << "WARNING BackflowTransformation : This message should not be seen in production (performance bug) "
+                   "runs but only unit tests (expected)."
+                << std::endl;
+      mw_res_ = std::make_unique<BackflowTransformationMultiWalkerResource>();
+    }
+  }
 };
 
 } // namespace qmcplusplus
@@ -43,6 +43,8 @@ public:
         myTableIndex_(els.addTable(els, DTModes::NEED_TEMP_DATA_ON_HOST | DTModes::NEED_VP_FULL_TABLE_ON_HOST)),
         first(true)
   {
+    if (els.getDistTableAA(myTableIndex_).getNeighborCutoff() > 0)
+      throw std::runtime_error("Backflow_ee doesn't support the neighbor lists of the e-e distance table!");
     resize(NumTargets, NumTargets);
     NumGroups = els.groups();
     PairID.resize(NumTargets, NumTargets);
@@ -0,0 +1,171 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_DELAY_RANK_TUNER_H
+#define QMCPLUSPLUS_DELAY_RANK_TUNER_H
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include "Utilities/Clock.h"
+#include "Platforms/Host/OutputManager.h"
+#include "Concurrency/OpenMP.h"
+
+namespace qmcplusplus
+{
+/** measures the cost of the delayed update engine and selects the delay rank of the best throughput
+ *
+ * Candidates 1, 2, 4, ... up to the allocated maximum are tried in turn.
+ * Each candidate runs sweeps_per_candidate sweeps of proposed moves while the time spent in
+ * getInvRow, acceptRow and updateInvMat is accumulated. The time per proposed move decides.
+ * The cost is not monotonic in the delay rank, rank-1 Sherman-Morrison often beats small delays,
+ * so all the candidates are measured.
+ * A change of the walker population reported by notifyPopulation restarts the tuning of all the engines.
+ */
+class DelayRankTuner
+{
+public:
+  /// number of sweeps over the orbitals measured per candidate
+  static constexpr int sweeps_per_candidate = 2;
+
+  /// RAII timer accumulating the elapsed time into the tuner while tuning
+  class ScopedMeasure
+  {
+    DelayRankTuner& tuner_;
+    const double start_;
+
+  public:
+    ScopedMeasure(DelayRankTuner& tuner) : tuner_(tuner), start_(tuner.tuning_ ? CPUClock()() : 0.0) {}
+    ~ScopedMeasure()
+    {
+      if (tuner_.tuning_)
+        tuner_.elapsed_ += CPUClock()() - start_;
+    }
+  };
+
+  /** start tuning
+   * @param norb number of electrons/orbitals
+   * @param max_delay the largest candidate delay rank
+   */
+  void reset(int norb, int max_delay)
+  {
+    norb_ = norb;
+    candidates_.clear();
+    for (int delay = 1; delay <= max_delay; delay *= 2)
+      candidates_.push_back(delay);
+    restart();
+  }
+
+  /// restart the tuning with the current candidates
+  void restart()
+  {
+    tuning_ = true;
+    epoch_  = retune_epoch_.load();
+    costs_.clear();
+    current_   = 0;
+    delay_     = candidates_[0];
+    proposals_ = 0;
+    elapsed_   = 0;
+  }
+
+  bool isTuning() const { return tuning_; }
+
+  /// the delay rank to be used by the engine
+  int getDelay() const { return delay_; }
+
+  /// count a proposed move
+  void countProposal() { proposals_++; }
+
+  /** advance the tuning, only call it when the engine has no pending delayed updates
+   * @return true if the delay rank has changed
+   */
+  bool update()
+  {
+    if (!tuning_)
+    {
+      if (epoch_ == retune_epoch_.load())
+        return false;
+      restart();
+      return true;
+    }
+    if (proposals_ < sweeps_per_candidate * norb_)
+      return false;
+
+    costs_.push_back(elapsed_ / proposals_);
+    if (++current_ < candidates_.size())
+    {
+      delay_     = candidates_[current_];
+      proposals_ = 0;
+      elapsed_   = 0;
+    }
+    else
+    {
+      tuning_ = false;
+      delay_  = candidates_[std::min_element(costs_.begin(), costs_.end()) - costs_.begin()];
+      report();
+    }
+    return true;
+  }
+
+  /** report the current walker population, a change by more than 20% since the last change requests re-tuning
+   * @param num_walkers number of walkers of this rank
+   */
+  static void notifyPopulation(size_t num_walkers)
+  {
+    const size_t tuned = tuned_population_.load();
+    if (tuned == 0)
+      tuned_population_ = num_walkers;
+    else if (num_walkers * 5 < tuned * 4 || num_walkers * 4 > tuned * 5)
+    {
+      tuned_population_ = num_walkers;
+      retune_epoch_++;
+    }
+  }
+
+private:
+  /// incremented when all the tuners should start over
+  inline static std::atomic<int> retune_epoch_{0};
+  /// walker population of the last re-tuning request
+  inline static std::atomic<size_t> tuned_population_{0};
+
+  bool tuning_ = false;
+  /// retune_epoch_ value when the tuning started
+  int epoch_ = 0;
+  int norb_  = 0;
+  int delay_ = 1;
+  /// index of the candidate being measured
+  size_t current_ = 0;
+  std::vector<int> candidates_;
+  /// measured time per proposed move of each candidate
+  std::vector<double> costs_;
+  /// proposed moves measured with the current candidate
+  int proposals_ = 0;
+  /// accumulated time with the current candidate
+  double elapsed_ = 0;
+
+  /// the first thread reports the outcome on behalf of all the others
+  void report() const
+  {
+    if (omp_get_thread_num() != 0)
+      return;
+    std::ostringstream msg;
+    msg << "  Delayed update tuning with " << norb_ << " orbitals, time per move (us):";
+    for (int i = 0; i < costs_.size(); i++)
+      msg << " " << candidates_[i] << ":" << std::setprecision(3) << costs_[i] * 1e6;
+    msg << ". Selected delay_rank " << delay_ << std::endl;
+    app_log() << msg.str();
+  }
+};
+} // namespace qmcplusplus
+
+#endif // QMCPLUSPLUS_DELAY_RANK_TUNER_H
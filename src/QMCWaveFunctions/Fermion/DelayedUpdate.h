@@ -17,6 +17,7 @@
 #include "CPU/BLAS.hpp"
 #include "CPU/BlasThreadingEnv.h"
 #include "DiracMatrix.h"
+#include "DelayRankTuner.h"
 #include "Concurrency/OpenMP.h"
 
 namespace qmcplusplus
@@ -44,19 +45,37 @@ class DelayedUpdate
   std::vector<int> delay_list;
   /// current number of delays, increase one for each acceptance, reset to 0 after updating Ainv
   int delay_count;
+  /// delay rank in use, Ainv is updated once delay_count reaches it. Not larger than the allocated delay.
+  int max_delay;
   /// matrix inversion engine
   DiracMatrix<T_FP> detEng;
+  /// selects max_delay if the delay rank is auto-tuned
+  DelayRankTuner tuner;
+  /// true if the delay rank is auto-tuned
+  bool tune_delay;
 
 public:
+  /// the largest delay rank considered by auto-tuning
+  static constexpr int max_tuned_delay = 128;
+
   /// default constructor
-  DelayedUpdate() : delay_count(0) {}
+  DelayedUpdate() : delay_count(0), max_delay(0), tune_delay(false) {}
 
   /** resize the internal storage
    * @param norb number of electrons/orbitals
-   * @param delay, maximum delay 0<delay<=norb
+   * @param delay, maximum delay 0<delay<=norb. delay=0 auto-tunes the delay rank up to max_tuned_delay.
    */
   inline void resize(int norb, int delay)
   {
+    tune_delay = delay == 0;
+    if (tune_delay)
+    {
+      delay = std::min(norb, max_tuned_delay);
+      tuner.reset(norb, delay);
+      max_delay = tuner.getDelay();
+    }
+    else
+      max_delay = delay;
     V.resize(delay, norb);
     U.resize(delay, norb);
     p.resize(delay);
@@ -96,6 +115,9 @@ public:
   template<typename VVT>
   inline void getInvRow(const Matrix<T>& Ainv, int rowchanged, VVT& invRow)
   {
+    DelayRankTuner::ScopedMeasure measure(tuner);
+    if (tune_delay)
+      tuner.countProposal();
     if (delay_count == 0)
     {
       // Ainv is fresh, directly access Ainv
@@ -124,6 +146,33 @@ public:
   template<typename VVT, typename RATIOT>
   inline void acceptRow(Matrix<T>& Ainv, int rowchanged, const VVT& psiV, const RATIOT ratio_new)
   {
+    // the delay rank can only change when no update is pending
+    if (tune_delay && delay_count == 0 && tuner.update())
+      max_delay = tuner.getDelay();
+    acceptRowDelayed(Ainv, rowchanged, psiV, ratio_new);
+    // update Ainv when maximal delay is reached
+    if (delay_count == max_delay)
+      updateInvMat(Ainv);
+  }
+
+  /** update the full Ainv and reset delay_count
+   * @param Ainv inverse matrix
+   */
+  inline void updateInvMat(Matrix<T>& Ainv)
+  {
+    if (delay_count == 0)
+      return;
+    DelayRankTuner::ScopedMeasure measure(tuner);
+    updateInvMatImpl(Ainv);
+    delay_count = 0;
+  }
+
+private:
+  /// acceptRow without the update of Ainv
+  template<typename VVT, typename RATIOT>
+  inline void acceptRowDelayed(Matrix<T>& Ainv, int rowchanged, const VVT& psiV, const RATIOT ratio_new)
+  {
+    DelayRankTuner::ScopedMeasure measure(tuner);
     constexpr T cone(1);
     constexpr T czero(0);
     const int norb     = Ainv.rows();
@@ -146,18 +195,11 @@ public:
     for (int i = 0; i < delay_count; i++)
       Binv[delay_count][i] *= sigma;
     delay_count++;
-    // update Ainv when maximal delay is reached
-    if (delay_count == lda_Binv)
-      updateInvMat(Ainv);
   }
 
-  /** update the full Ainv and reset delay_count
-   * @param Ainv inverse matrix
-   */
-  inline void updateInvMat(Matrix<T>& Ainv)
+  /// apply the delay_count delayed updates to Ainv
+  inline void updateInvMatImpl(Matrix<T>& Ainv)
   {
-    if (delay_count == 0)
-      return;
     // update the inverse matrix
     constexpr T cone(1);
     constexpr T czero(0);
@@ -225,7 +267,6 @@ public:
         }
       }
     }
-    delay_count = 0;
   }
 };
 } // namespace qmcplusplus
@@ -68,6 +68,13 @@ void DiracDeterminantWithBackflow::resize(int nel, int morb)
   psiMinv_temp.resize(NumPtcls, norb);
   psiV.resize(norb);
   psiM_temp.resize(NumPtcls, norb);
+  // for the particle-by-particle moves with gradients
+  dpsiM_temp.resize(NumPtcls, norb);
+  grad_grad_psiM_temp.resize(NumPtcls, norb);
+  dpsiV.resize(norb);
+  d2psiV.resize(norb);
+  grad_gradV.resize(norb);
+  Fmatdiag_temp.resize(norb);
   // For forces
   /*  not used
   grad_source_psiM.resize(nel,norb);
@@ -303,6 +310,136 @@ DiracDeterminantWithBackflow::PsiValueType DiracDeterminantWithBackflow::ratioGr
   return curRatio = LogToValue<PsiValueType>::convert(NewLog - log_value_);
 }
 
+void DiracDeterminantWithBackflow::updateQPColumns(const BackflowTransformation& bf_leader, int iw, bool with_grad)
+{
+  psiM_temp = psiM;
+  if (with_grad)
+  {
+    dpsiM_temp = dpsiM;
+    UpdateMode = ORB_PBYP_PARTIAL;
+  }
+  else
+    UpdateMode = ORB_PBYP_RATIO;
+  for (const int qp : BFTrans_.indexQP)
+  {
+    if (qp < FirstIndex || qp >= LastIndex)
+      continue;
+    const int jat = qp - FirstIndex;
+    BFTrans_.QP.makeMove(qp, bf_leader.getMultiWalkerQPDispl(iw, qp));
+    if (with_grad)
+    {
+      Phi->evaluateVGL(BFTrans_.QP, qp, psiV, dpsiV, d2psiV);
+      std::copy(dpsiV.begin(), dpsiV.end(), dpsiM_temp.begin(jat));
+      std::copy(grad_gradV.begin(), grad_gradV.end(), grad_grad_psiM_temp.begin(jat));
+    }
+    else
+      Phi->evaluateValue(BFTrans_.QP, qp, psiV);
+    for (int orb = 0; orb < psiV.size(); orb++)
+      psiM_temp(orb, jat) = psiV[orb];
+    BFTrans_.QP.rejectMove(qp);
+  }
+}
+
+void DiracDeterminantWithBackflow::mw_ratio_impl(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                                 int iat,
+                                                 bool with_grad,
+                                                 std::vector<PsiValueType>& ratios,
+                                                 std::vector<GradType>* grad_new) const
+{
+  auto& wfc_leader = wfc_list.getCastedLeader<DiracDeterminantWithBackflow>();
+  wfc_leader.guardMultiWalkerRes();
+  auto& mw_res          = *wfc_leader.mw_res_;
+  const int nw          = wfc_list.size();
+  const auto& bf_leader = wfc_leader.BFTrans_;
+
+  {
+    ScopedTimer local_timer(wfc_leader.RatioTimer);
+#pragma omp parallel for
+    for (int iw = 0; iw < nw; iw++)
+      wfc_list.getCastedElement<DiracDeterminantWithBackflow>(iw).updateQPColumns(bf_leader, iw, with_grad);
+  }
+
+  // FIX FIX FIX : code Woodbury formula
+  mw_res.log_values.resize(nw);
+  {
+    ScopedTimer local_timer(wfc_leader.InverseTimer);
+#if defined(QMC_COMPLEX)
+#pragma omp parallel for
+    for (int iw = 0; iw < nw; iw++)
+    {
+      auto& det        = wfc_list.getCastedElement<DiracDeterminantWithBackflow>(iw);
+      det.psiMinv_temp = det.psiM_temp;
+      InvertWithLog(det.psiMinv_temp.data(), det.NumPtcls, det.NumOrbitals, det.WorkSpace.data(), det.Pivot.data(),
+                    mw_res.log_values[iw]);
+    }
+#else
+    RefVector<const ValueMatrix> psiM_temp_list;
+    RefVector<ValueMatrix> psiMinv_temp_list;
+    psiM_temp_list.reserve(nw);
+    psiMinv_temp_list.reserve(nw);
+    for (int iw = 0; iw < nw; iw++)
+    {
+      auto& det = wfc_list.getCastedElement<DiracDeterminantWithBackflow>(iw);
+      psiM_temp_list.push_back(det.psiM_temp);
+      psiMinv_temp_list.push_back(det.psiMinv_temp);
+    }
+    mw_res.inverter.mw_invert(psiM_temp_list, psiMinv_temp_list, mw_res.log_values);
+#endif
+  }
+
+#pragma omp parallel for
+  for (int iw = 0; iw < nw; iw++)
+  {
+    auto& det = wfc_list.getCastedElement<DiracDeterminantWithBackflow>(iw);
+    if (with_grad)
+      for (int j = 0; j < det.NumPtcls; j++)
+      {
+        det.Fmatdiag_temp[j] = simd::dot(det.psiMinv_temp[j], det.dpsiM_temp[j], det.NumOrbitals);
+        (*grad_new)[iw] += dot(det.BFTrans_.Amat_temp(iat, det.FirstIndex + j), det.Fmatdiag_temp[j]);
+      }
+    ratios[iw] = det.curRatio = LogToValue<PsiValueType>::convert(mw_res.log_values[iw] - det.log_value_);
+  }
+}
+
+void DiracDeterminantWithBackflow::mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                                const RefVectorWithLeader<ParticleSet>& p_list,
+                                                int iat,
+                                                std::vector<PsiValueType>& ratios) const
+{
+  mw_ratio_impl(wfc_list, iat, false, ratios, nullptr);
+}
+
+void DiracDeterminantWithBackflow::mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                                const RefVectorWithLeader<ParticleSet>& p_list,
+                                                int iat,
+                                                std::vector<PsiValueType>& ratios,
+                                                std::vector<GradType>& grad_new) const
+{
+  mw_ratio_impl(wfc_list, iat, true, ratios, &grad_new);
+}
+
+void DiracDeterminantWithBackflow::createResource(ResourceCollection& collection) const
+{
+  collection.addResource(std::make_unique<DiracDeterminantWithBackflowMultiWalkerResource>());
+}
+
+void DiracDeterminantWithBackflow::acquireResource(ResourceCollection& collection,
+                                                   const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+{
+  auto& wfc_leader = wfc_list.getCastedLeader<DiracDeterminantWithBackflow>();
+  auto res_ptr = dynamic_cast<DiracDeterminantWithBackflowMultiWalkerResource*>(collection.lendResource().release());
+  if (!res_ptr)
+    throw std::runtime_error("DiracDeterminantWithBackflow::acquireResource dynamic_cast failed");
+  wfc_leader.mw_res_.reset(res_ptr);
+}
+
+void DiracDeterminantWithBackflow::releaseResource(ResourceCollection& collection,
+                                                   const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+{
+  auto& wfc_leader = wfc_list.getCastedLeader<DiracDeterminantWithBackflow>();
+  collection.takebackResource(std::move(wfc_leader.mw_res_));
+}
+
 void DiracDeterminantWithBackflow::testL(ParticleSet& P)
 {
   GradMatrix Fmat_p, Fmat_m;
@@ -22,7 +22,9 @@
 #include "QMCWaveFunctions/SPOSet.h"
 #include "Utilities/TimerManager.h"
 #include "QMCWaveFunctions/Fermion/DiracDeterminantBase.h"
+#include "QMCWaveFunctions/Fermion/DiracMatrixInterleaved.h"
 #include "OhmmsPETE/OhmmsArray.h"
+#include "ResourceCollection.h"
 
 namespace qmcplusplus
 {
@@ -48,6 +50,20 @@ public:
   //using GradArray_t = Array<GradType,3>      ;
   //using PosArray_t = Array<PosType,3>       ;
 
+  struct DiracDeterminantWithBackflowMultiWalkerResource : public Resource
+  {
+    DiracDeterminantWithBackflowMultiWalkerResource() : Resource("DiracDeterminantWithBackflow") {}
+    DiracDeterminantWithBackflowMultiWalkerResource(const DiracDeterminantWithBackflowMultiWalkerResource&)
+        : DiracDeterminantWithBackflowMultiWalkerResource()
+    {}
+
+    Resource* makeClone() const override { return new DiracDeterminantWithBackflowMultiWalkerResource(*this); }
+    /// batched inversion of psiM_temp of all the walkers
+    DiracMatrixInterleaved<ValueType> inverter;
+    /// log values of the inverted matrices
+    std::vector<LogValueType> log_values;
+  };
+
   /** constructor
    *@param spos the single-particle orbital set
    *@param first index of the first particle
@@ -96,7 +112,25 @@ public:
 
   void evaluateRatiosAlltoOne(ParticleSet& P, std::vector<ValueType>& ratios) override;
 
+  /** compute the ratios of multiple walkers
+   * BackflowTransformation::mw_evaluatePbyP must have been called on the walkers.
+   */
+  void mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValueType>& ratios) const override;
+
   PsiValueType ratioGrad(ParticleSet& P, int iat, GradType& grad_iat) override;
+
+  /** compute the ratios and add the gradients of multiple walkers
+   * BackflowTransformation::mw_evaluatePbyP with gradients must have been called on the walkers.
+   */
+  void mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValueType>& ratios,
+                    std::vector<GradType>& grad_new) const override;
+
   GradType evalGrad(ParticleSet& P, int iat) override;
   GradType evalGradSource(ParticleSet& P, ParticleSet& source, int iat) override;
 
@@ -133,6 +167,12 @@ public:
     return nullptr;
   }
 
+  void createResource(ResourceCollection& collection) const override;
+  void acquireResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override;
+  void releaseResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override;
+
   void testDerivFjj(ParticleSet& P, int pa);
   void testGGG(ParticleSet& P);
   void testGG(ParticleSet& P);
@@ -212,6 +252,35 @@ private:
   ParticleSet::ParticleGradient myG, myG_temp;
   ParticleSet::ParticleLaplacian myL, myL_temp;
 
+  /// multi walker resource, only valid in the leader of a batch
+  std::unique_ptr<DiracDeterminantWithBackflowMultiWalkerResource> mw_res_;
+
+  /** update the columns of psiM_temp, and of dpsiM_temp if with_grad, of the quasi-particles moved by the
+   *  last BackflowTransformation::mw_evaluatePbyP
+   * @param bf_leader the leader BackflowTransformation of the batch
+   * @param iw the index of this walker in the batch
+   */
+  void updateQPColumns(const BackflowTransformation& bf_leader, int iw, bool with_grad);
+
+  /// make this class unit tests friendly without the need of setup resources.
+  void guardMultiWalkerRes()
+  {
+    if (!mw_res_)
+    {
+      std::cerr << "WARNING DiracDeterminantWithBackflow : This message should not be seen in production (performance "
+                   "bug) runs but only unit tests (expected)."
+                << std::endl;
+      mw_res_ = std::make_unique<DiracDeterminantWithBackflowMultiWalkerResource>();
+    }
+  }
+
+  /// mw_calcRatio and mw_ratioGrad
+  void mw_ratio_impl(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                     int iat,
+                     bool with_grad,
+                     std::vector<PsiValueType>& ratios,
+                     std::vector<GradType>* grad_new) const;
+
   void dummyEvalLi(ValueType& L1, ValueType& L2, ValueType& L3);
 
   void evaluate_SPO(ValueMatrix& logdet, GradMatrix& dlogdet, HessMatrix& grad_grad_logdet);
@@ -18,6 +18,7 @@
 #include "OMPTarget/OMPallocator.hpp"
 #include "Platforms/PinnedAllocator.h"
 #include "DiracMatrix.h"
+#include "DiracMatrixInterleaved.h"
 #include "type_traits/complex_help.hpp"
 #include "type_traits/template_types.hpp"
 #include "Concurrency/OpenMP.h"
@@ -157,6 +158,8 @@ private:
 
   /// matrix inversion engine
   DiracMatrix<VALUE_FP> detEng_;
+  /// batched matrix inversion engine, only used with real VALUE_FP
+  DiracMatrixInterleaved<VALUE_FP> interleavedEng_;
 
 public:
   DiracMatrixComputeOMPTarget() : Resource("DiracMatrixComputeOMPTarget"), lwork_(0) {}
@@ -216,8 +219,9 @@ public:
   }
 
   /** This covers both mixed and Full precision case.
-   *  
-   *  \todo measure if using the a_mats without a copy to contiguous vector is better.
+   *
+   *  For real VALUE_FP, the batch is inverted by the interleaved engine group by group
+   *  once it fills at least half of a group. Otherwise each matrix is handled by LAPACK.
    */
   template<typename TMAT>
   inline void mw_invertTranspose(HandleResource& resource,
@@ -225,30 +229,21 @@ public:
                                  const RefVector<OffloadPinnedMatrix<TMAT>>& inv_a_mats,
                                  OffloadPinnedVector<LogValue>& log_values)
   {
+    if constexpr (!IsComplex_t<VALUE_FP>::value)
+      if (a_mats.size() * 2 >= DiracMatrixInterleaved<VALUE_FP>::group_size)
+      {
+        interleavedEng_.mw_invert_transpose(a_mats, inv_a_mats, log_values);
+        for (int iw = 0; iw < inv_a_mats.size(); iw++)
+          inv_a_mats[iw].get().updateTo();
+        return;
+      }
+
     for (int iw = 0; iw < a_mats.size(); iw++)
     {
       auto& Ainv = inv_a_mats[iw].get();
       detEng_.invert_transpose(a_mats[iw].get(), Ainv, log_values[iw]);
       Ainv.updateTo();
     }
-
-    /* FIXME
-    const int nw     = a_mats.size();
-    const size_t n   = a_mats[0].get().rows();
-    const size_t lda = a_mats[0].get().cols();
-    const size_t ldb = inv_a_mats[0].get().cols();
-
-    size_t nsqr{n * n};
-    psiM_fp_.resize(n * lda * nw);
-    for (int iw = 0; iw < nw; ++iw)
-      simd::transpose(a_mats[iw].get().data(), n, lda, psiM_fp_.data() + nsqr * iw, n, lda);
-
-    computeInvertAndLog(psiM_fp_, n, lda, log_values);
-    for (int iw = 0; iw < nw; ++iw)
-    {
-      simd::remapCopy(n, n, psiM_fp_.data() + nsqr * iw, lda, inv_a_mats[iw].get().data(), ldb);
-    }
-    */
   }
 };
 } // namespace qmcplusplus
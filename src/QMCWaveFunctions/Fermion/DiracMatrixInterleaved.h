@@ -0,0 +1,355 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_DIRAC_MATRIX_INTERLEAVED_H
+#define QMCPLUSPLUS_DIRAC_MATRIX_INTERLEAVED_H
+
+#include <algorithm>
+#include <complex>
+#include <sstream>
+#include <stdexcept>
+#include "OhmmsPETE/OhmmsMatrix.h"
+#include "CPU/SIMD/aligned_allocator.hpp"
+#include "type_traits/complex_help.hpp"
+#include "type_traits/template_types.hpp"
+#include "DiracMatrix.h"
+
+namespace qmcplusplus
+{
+/** helper class to compute the inverses and the log values of the determinants of a batch of matrices on CPU
+ * @tparam T_FP the datatype used in the actual computation of matrix inversion, only real types are supported
+ *
+ * The matrices of group_size walkers are interleaved element by element, (i, j, iw) at (i * n + j) * group_size + iw,
+ * so every step of the LU factorization and the inversion is a SIMD operation across the walkers of a group.
+ * Both are blocked like LAPACK getrf/getri and the updates are register tiled over rows and columns.
+ * It avoids the per matrix LAPACK overhead and keeps a group of walkers hot in cache, see DiracMatrixComputeOMPTarget.
+ * The last group is padded with identity matrices.
+ */
+template<typename T_FP>
+class DiracMatrixInterleaved
+{
+public:
+  /// number of interleaved walkers, one SIMD register
+  static constexpr int group_size = QMC_SIMD_ALIGNMENT / sizeof(T_FP) > 1 ? QMC_SIMD_ALIGNMENT / sizeof(T_FP) : 1;
+
+  /** compute the inverses of the transposes of matrices A and their determinant values in log
+   * @param a_mats matrices to be inverted
+   * @param inv_a_mats the inverted matrices
+   * @param log_values log of the determinants of a_mats
+   */
+  template<typename TMAT, typename ALLOC1, typename ALLOC2, typename LOGVEC>
+  void mw_invert_transpose(const RefVector<const Matrix<TMAT, ALLOC1>>& a_mats,
+                           const RefVector<Matrix<TMAT, ALLOC2>>& inv_a_mats,
+                           LOGVEC& log_values)
+  {
+    mw_invert_impl<true>(a_mats, inv_a_mats, log_values);
+  }
+
+  /** compute the inverses of matrices A and their determinant values in log
+   * @param a_mats matrices to be inverted
+   * @param inv_a_mats the inverted matrices
+   * @param log_values log of the determinants of a_mats
+   */
+  template<typename TMAT, typename ALLOC1, typename ALLOC2, typename LOGVEC>
+  void mw_invert(const RefVector<const Matrix<TMAT, ALLOC1>>& a_mats,
+                 const RefVector<Matrix<TMAT, ALLOC2>>& inv_a_mats,
+                 LOGVEC& log_values)
+  {
+    mw_invert_impl<false>(a_mats, inv_a_mats, log_values);
+  }
+
+private:
+  static constexpr int W = group_size;
+  /// panel width of the blocked LU factorization
+  static constexpr int panel_size = 16;
+
+  /// interleaved LU factors of a group
+  aligned_vector<T_FP> lu_;
+  /// interleaved inverses of a group
+  aligned_vector<T_FP> inv_;
+  /// pivots of a group, n consecutive 1-based LAPACK style pivots per walker
+  aligned_vector<int> pivots_;
+  /// LU diagonal elements of a walker
+  aligned_vector<T_FP> LU_diag_;
+
+  /// inverses of A or of A^T if TRANSPOSE
+  template<bool TRANSPOSE, typename TMAT, typename ALLOC1, typename ALLOC2, typename LOGVEC>
+  void mw_invert_impl(const RefVector<const Matrix<TMAT, ALLOC1>>& a_mats,
+                      const RefVector<Matrix<TMAT, ALLOC2>>& inv_a_mats,
+                      LOGVEC& log_values)
+  {
+    static_assert(!IsComplex_t<T_FP>::value, "DiracMatrixInterleaved only supports real types.");
+    const int nw = a_mats.size();
+    const int n  = a_mats[0].get().rows();
+    const size_t row_stride = static_cast<size_t>(n) * group_size;
+    lu_.resize(n * row_stride);
+    inv_.resize(n * row_stride);
+    pivots_.resize(n * group_size);
+    LU_diag_.resize(n);
+
+    for (int first = 0; first < nw; first += group_size)
+    {
+      const int num_lanes = std::min(group_size, nw - first);
+      for (int iw = 0; iw < group_size; iw++)
+        if (iw < num_lanes)
+        {
+          const auto& a_mat = a_mats[first + iw].get();
+          for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+              lu_[(i * n + j) * group_size + iw] = a_mat(i, j);
+        }
+        else
+          for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+              lu_[(i * n + j) * group_size + iw] = i == j ? T_FP(1) : T_FP(0);
+
+      factorize(n);
+
+      for (int iw = 0; iw < num_lanes; iw++)
+      {
+        int status = 0;
+        for (int i = 0; i < n; i++)
+        {
+          LU_diag_[i] = lu_[i * row_stride + i * group_size + iw];
+          if (LU_diag_[i] == T_FP(0) && status == 0)
+            status = i + 1;
+        }
+        if (status != 0)
+        {
+          std::ostringstream msg;
+          msg << "DiracMatrixInterleaved LU factorization found a singular matrix with zero pivot " << status
+              << std::endl;
+          throw std::runtime_error(msg.str());
+        }
+        computeLogDet(LU_diag_.data(), n, pivots_.data() + iw * n, log_values[first + iw]);
+      }
+
+      invert(n);
+
+      // inv_ holds the inverse of A, transpose it to the inverse of A^T if requested
+      for (int iw = 0; iw < num_lanes; iw++)
+      {
+        auto& inv_a_mat = inv_a_mats[first + iw].get();
+        for (int i = 0; i < n; i++)
+          for (int j = 0; j < n; j++)
+            inv_a_mat(i, j) = TRANSPOSE ? inv_[(j * n + i) * group_size + iw] : inv_[(i * n + j) * group_size + iw];
+      }
+    }
+  }
+
+  /** dst_r[0:ncols] -= sum_p coef_r[p] * src_p[0:ncols] for RB rows r, register tiled by JB columns
+   * Each element is a group of W walkers.
+   * @param dst first destination row, dst_stride between rows
+   * @param coef coefficients of the first row, coef_stride between rows
+   * @param src first source row, src_stride between rows
+   */
+  template<int RB, int JB>
+  static void update_rows(T_FP* restrict dst,
+                          size_t dst_stride,
+                          const T_FP* restrict coef,
+                          size_t coef_stride,
+                          const T_FP* restrict src,
+                          size_t src_stride,
+                          int np,
+                          int ncols)
+  {
+    int j0 = 0;
+    for (; j0 + JB <= ncols; j0 += JB)
+    {
+      T_FP acc[RB][JB][W];
+      for (int r = 0; r < RB; r++)
+        for (int jj = 0; jj < JB; jj++)
+#pragma omp simd
+          for (int w = 0; w < W; w++)
+            acc[r][jj][w] = dst[r * dst_stride + (j0 + jj) * W + w];
+      for (int p = 0; p < np; p++)
+      {
+        const T_FP* restrict s = src + p * src_stride + j0 * W;
+        for (int r = 0; r < RB; r++)
+        {
+          const T_FP* restrict c = coef + r * coef_stride + p * W;
+          for (int jj = 0; jj < JB; jj++)
+#pragma omp simd
+            for (int w = 0; w < W; w++)
+              acc[r][jj][w] -= c[w] * s[jj * W + w];
+        }
+      }
+      for (int r = 0; r < RB; r++)
+        for (int jj = 0; jj < JB; jj++)
+#pragma omp simd
+          for (int w = 0; w < W; w++)
+            dst[r * dst_stride + (j0 + jj) * W + w] = acc[r][jj][w];
+    }
+    if constexpr (JB > 1)
+      if (j0 < ncols)
+        update_rows<RB, 1>(dst + j0 * W, dst_stride, coef, coef_stride, src + j0 * W, src_stride, np, ncols - j0);
+  }
+
+  /// update_rows of any number of rows with the widest register tile
+  static void update_rows(T_FP* restrict dst,
+                          size_t dst_stride,
+                          const T_FP* restrict coef,
+                          size_t coef_stride,
+                          const T_FP* restrict src,
+                          size_t src_stride,
+                          int nrows,
+                          int np,
+                          int ncols)
+  {
+    int r = 0;
+    for (; r + 4 <= nrows; r += 4)
+      update_rows<4, 4>(dst + r * dst_stride, dst_stride, coef + r * coef_stride, coef_stride, src, src_stride, np,
+                        ncols);
+    for (; r < nrows; r++)
+      update_rows<1, 8>(dst + r * dst_stride, dst_stride, coef + r * coef_stride, coef_stride, src, src_stride, np,
+                        ncols);
+  }
+
+  /// LU factorization of lu_ with partial pivoting, right looking and blocked by panel_size columns
+  void factorize(const int n)
+  {
+    const size_t rs = static_cast<size_t>(n) * W;
+    T_FP* restrict a = lu_.data();
+    T_FP max_abs[W], inv_pivot[W];
+    int pivot[W];
+    for (int kb = 0; kb < n; kb += panel_size)
+    {
+      const int kend = std::min(n, kb + panel_size);
+      for (int k = kb; k < kend; k++)
+      {
+        T_FP* restrict row_k = a + k * rs;
+        for (int w = 0; w < W; w++)
+        {
+          max_abs[w] = std::abs(row_k[k * W + w]);
+          pivot[w]   = k;
+        }
+        for (int i = k + 1; i < n; i++)
+        {
+          const T_FP* restrict a_ik = a + i * rs + k * W;
+#pragma omp simd
+          for (int w = 0; w < W; w++)
+          {
+            const T_FP v    = std::abs(a_ik[w]);
+            const bool larger = v > max_abs[w];
+            max_abs[w]      = larger ? v : max_abs[w];
+            pivot[w]        = larger ? i : pivot[w];
+          }
+        }
+        for (int w = 0; w < W; w++)
+        {
+          pivots_[w * n + k] = pivot[w] + 1;
+          if (pivot[w] != k)
+          {
+            T_FP* restrict row_p = a + pivot[w] * rs;
+            for (int j = 0; j < n; j++)
+              std::swap(row_k[j * W + w], row_p[j * W + w]);
+          }
+        }
+#pragma omp simd
+        for (int w = 0; w < W; w++)
+          inv_pivot[w] = T_FP(1) / row_k[k * W + w];
+        // column of L and the rank-1 update within the panel
+        for (int i = k + 1; i < n; i++)
+        {
+          T_FP* restrict row_i = a + i * rs;
+#pragma omp simd
+          for (int w = 0; w < W; w++)
+            row_i[k * W + w] *= inv_pivot[w];
+          for (int j = k + 1; j < kend; j++)
+#pragma omp simd
+            for (int w = 0; w < W; w++)
+              row_i[j * W + w] -= row_i[k * W + w] * row_k[j * W + w];
+        }
+      }
+      if (kend == n)
+        break;
+      // U12 = L11^{-1} A12
+      for (int i = kb + 1; i < kend; i++)
+        update_rows<1, 8>(a + i * rs + kend * W, rs, a + i * rs + kb * W, 0, a + kb * rs + kend * W, rs, i - kb,
+                          n - kend);
+      // A22 -= L21 U12
+      update_rows(a + kend * rs + kend * W, rs, a + kend * rs + kb * W, rs, a + kb * rs + kend * W, rs, n - kend,
+                  kend - kb, n - kend);
+    }
+  }
+
+  /// inv_ = U^{-1} L^{-1} P from the LU factors in lu_
+  void invert(const int n)
+  {
+    constexpr int RB = 4;
+    const size_t rs           = static_cast<size_t>(n) * W;
+    const T_FP* restrict a    = lu_.data();
+    T_FP* restrict b          = inv_.data();
+
+    // L^{-1}, lower triangular with a unit diagonal. Row i only needs the columns [0, i) of the rows above.
+    std::fill(inv_.begin(), inv_.end(), T_FP(0));
+    for (int i = 0; i < n; i++)
+      for (int w = 0; w < W; w++)
+        b[i * rs + i * W + w] = T_FP(1);
+    for (int i0 = 0; i0 < n; i0 += RB)
+    {
+      const int nr = std::min(RB, n - i0);
+      if (i0 > 0)
+      {
+        if (nr == RB)
+          update_rows<RB, 4>(b + i0 * rs, rs, a + i0 * rs, rs, b, rs, i0, i0);
+        else
+          update_rows(b + i0 * rs, rs, a + i0 * rs, rs, b, rs, nr, i0, i0);
+      }
+      for (int i = i0 + 1; i < i0 + nr; i++)
+        update_rows<1, 8>(b + i * rs, rs, a + i * rs + i0 * W, 0, b + i0 * rs, rs, i - i0, i);
+    }
+
+    // U^{-1} L^{-1} by back substitution, blocked by RB rows
+    T_FP inv_diag[W];
+    for (int iend = n; iend > 0;)
+    {
+      const int i0 = std::max(0, iend - RB);
+      const int nr = iend - i0;
+      if (iend < n)
+      {
+        if (nr == RB)
+          update_rows<RB, 4>(b + i0 * rs, rs, a + i0 * rs + iend * W, rs, b + iend * rs, rs, n - iend, n);
+        else
+          update_rows(b + i0 * rs, rs, a + i0 * rs + iend * W, rs, b + iend * rs, rs, nr, n - iend, n);
+      }
+      for (int i = iend - 1; i >= i0; i--)
+      {
+        if (i + 1 < iend)
+          update_rows<1, 8>(b + i * rs, rs, a + i * rs + (i + 1) * W, 0, b + (i + 1) * rs, rs, iend - i - 1, n);
+#pragma omp simd
+        for (int w = 0; w < W; w++)
+          inv_diag[w] = T_FP(1) / a[i * rs + i * W + w];
+        for (int j = 0; j < n; j++)
+#pragma omp simd
+          for (int w = 0; w < W; w++)
+            b[i * rs + j * W + w] *= inv_diag[w];
+      }
+      iend = i0;
+    }
+
+    // apply the row interchanges of the factorization to the columns in reverse order, row by row
+    for (int i = 0; i < n; i++)
+    {
+      T_FP* restrict row = b + i * rs;
+      for (int k = n - 1; k >= 0; k--)
+        for (int w = 0; w < W; w++)
+        {
+          const int kp = pivots_[w * n + k] - 1;
+          if (kp != k)
+            std::swap(row[k * W + w], row[kp * W + w]);
+        }
+    }
+  }
+};
+} // namespace qmcplusplus
+
+#endif // QMCPLUSPLUS_DIRAC_MATRIX_INTERLEAVED_H
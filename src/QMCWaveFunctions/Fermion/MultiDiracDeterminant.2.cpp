@@ -31,7 +31,7 @@ void MultiDiracDeterminant::buildTableMatrix_calculateRatios_impl(
     const OffloadMatrix<ValueType>& psiinv,
     const OffloadMatrix<ValueType>& psi,
     OffloadMatrix<ValueType>& table_matrix,
-    const OffloadVector<int>& data,
+    const OffloadVector<ExcitationIndex>& data,
     const VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>& pairs,
     const OffloadVector<RealType>& sign)
 {
@@ -52,19 +52,16 @@ void MultiDiracDeterminant::buildTableMatrix_calculateRatios_impl(
 
   {
     ScopedTimer local(table2ratios_timer);
-    const int* it2       = data.data();
-    const size_t nitems  = sign.size();
-    const size_t nb_cols = table_matrix.cols();
-    // explore Inclusive Scan for OpenMP
-    for (size_t count = 0; count < nitems; ++count)
-    {
-      const size_t n = *it2;
-      if (count != ref)
+    const ExcitationIndex* it2 = data.data();
+    const size_t nb_cols       = table_matrix.cols();
+    const int max_ext_level    = ndets_per_excitation_level_->size() - 1;
+    // the reference is the only determinant of excitation level 0
+    size_t count = 1;
+    for (int n = 1; n <= max_ext_level; n++)
+      for (size_t idet = 0; idet < (*ndets_per_excitation_level_)[n]; idet++, count++, it2 += 2 * n)
         ratios[count] = sign[count] * det0 *
-            (n > MaxSmallDet ? det_calculator_.evaluate(table_matrix, it2 + 1, n)
-                             : calcSmallDeterminant(n, table_matrix.data(), it2 + 1, nb_cols));
-      it2 += 3 * n + 1;
-    }
+            (n > MaxSmallDet ? det_calculator_.evaluate(table_matrix, it2, n)
+                             : calcSmallDeterminant(n, table_matrix.data(), it2, nb_cols));
 
     ratios[ref] = det0;
   }
@@ -76,7 +73,7 @@ void MultiDiracDeterminant::mw_buildTableMatrix_calculateRatios_impl(
     const OffloadVector<ValueType>& det0_list,
     const RefVector<OffloadMatrix<ValueType>>& psiinv_list,
     const RefVector<OffloadMatrix<ValueType>>& psi_list,
-    const OffloadVector<int>& data,
+    const OffloadVector<ExcitationIndex>& data,
     const VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>& pairs,
     const OffloadVector<RealType>& sign,
     const RefVector<OffloadMatrix<ValueType>>& table_matrix_list,
@@ -146,11 +143,11 @@ void MultiDiracDeterminant::mw_buildTableMatrix_calculateRatios_impl(
     // Compute workload changes drastically as the excitation level increases.
     // this may need different parallelization strategy.
     size_t det_offset  = 1;
-    size_t data_offset = 1;
+    size_t data_offset = 0;
 
     auto update_offsets = [&](size_t ext_level) {
       det_offset += (*ndets_per_excitation_level_)[ext_level];
-      data_offset += (*ndets_per_excitation_level_)[ext_level] * (3 * ext_level + 1);
+      data_offset += (*ndets_per_excitation_level_)[ext_level] * 2 * ext_level;
     };
 
     if (max_ext_level >= 1)
@@ -208,7 +205,7 @@ void MultiDiracDeterminant::buildTableMatrix_calculateRatios(
     int ref,
     const OffloadMatrix<ValueType>& psiinv,
     const OffloadMatrix<ValueType>& psi,
-    const OffloadVector<int>& data,
+    const OffloadVector<ExcitationIndex>& data,
     const VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>& pairs,
     const OffloadVector<RealType>& sign,
     OffloadMatrix<ValueType>& table_matrix,
@@ -224,7 +221,7 @@ void MultiDiracDeterminant::mw_buildTableMatrix_calculateRatios(
     const OffloadVector<ValueType>& det0_list,
     const RefVector<OffloadMatrix<ValueType>>& psiinv_list,
     const RefVector<OffloadMatrix<ValueType>>& psi_list,
-    const OffloadVector<int>& data,
+    const OffloadVector<ExcitationIndex>& data,
     const VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>& pairs,
     const OffloadVector<RealType>& sign,
     const RefVector<OffloadMatrix<ValueType>>& table_matrix_list,
@@ -245,7 +242,7 @@ void MultiDiracDeterminant::buildTableMatrix_calculateGradRatios(
     int ref,
     const OffloadMatrix<ValueType>& psiinv,
     const OffloadMatrix<ValueType>& psi,
-    const OffloadVector<int>& data,
+    const OffloadVector<ExcitationIndex>& data,
     const VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>& pairs,
     const OffloadVector<RealType>& sign,
     const ValueType& det0_grad,
@@ -269,7 +266,7 @@ void MultiDiracDeterminant::mw_buildTableMatrix_calculateGradRatios(
     const OffloadVector<ValueType>& det0_grad_list,
     const RefVector<OffloadMatrix<ValueType>>& psiinv_list,
     const RefVector<OffloadMatrix<ValueType>>& psi_list,
-    const OffloadVector<int>& data,
+    const OffloadVector<ExcitationIndex>& data,
     const VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>& pairs,
     const OffloadVector<RealType>& sign,
     const RefVector<OffloadVector<ValueType>>& WorkSpace_list,
@@ -300,7 +297,7 @@ void MultiDiracDeterminant::buildTableMatrix_calculateRatiosValueMatrixOnePartic
     int ref,
     const OffloadMatrix<ValueType>& psiinv,
     const OffloadMatrix<ValueType>& psi,
-    const OffloadVector<int>& data,
+    const OffloadVector<ExcitationIndex>& data,
     const VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>& pairs,
     const OffloadVector<RealType>& sign,
     OffloadMatrix<ValueType>& table_matrix,
@@ -404,7 +401,6 @@ void MultiDiracDeterminant::mw_evaluateDetsForPtclMove(const RefVectorWithLeader
   const auto TpsiM_rows   = TpsiM_list[0].get().rows();
   const auto NumPtcls     = det_leader.NumPtcls;
   const auto NumOrbitals  = det_leader.NumOrbitals;
-  const auto& confgList   = *det_leader.ciConfigList;
 
   auto* psiV_list_devptr   = det_leader.mw_res_->psiV_deviceptr_list.device_data();
   auto* psiV_temp_list_ptr = det_leader.mw_res_->psiV_temp_deviceptr_list.data();
@@ -496,9 +492,7 @@ void MultiDiracDeterminant::evaluateDetsForPtclMove(const ParticleSet& P, int ia
   }
   const int WorkingIndex = (refPtcl < 0 ? iat : refPtcl) - FirstIndex;
   assert(WorkingIndex >= 0 && WorkingIndex < LastIndex - FirstIndex);
-  const auto& confgList = *ciConfigList;
-  //std::vector<int>::iterator it(confgList[ReferenceDeterminant].occup.begin());
-  auto it(confgList[ReferenceDeterminant].occup.begin());
+  auto it(refdet_occup->begin());
   // mmorales: the only reason this is here is because
   // NonlocalECP do not necessarily call rejectMove after
   // calling ratio(), and even if the move is rejected
@@ -536,7 +530,6 @@ void MultiDiracDeterminant::evaluateDetsAndGradsForPtclMove(const ParticleSet& P
     Phi->evaluateVGL(P, iat, psiV_host_view, dpsiV_host_view, d2psiV_host_view);
   }
   const int WorkingIndex = iat - FirstIndex;
-  const auto& confgList  = *ciConfigList;
   assert(WorkingIndex >= 0 && WorkingIndex < LastIndex - FirstIndex);
 
   GradType ratioGradRef;
@@ -544,8 +537,7 @@ void MultiDiracDeterminant::evaluateDetsAndGradsForPtclMove(const ParticleSet& P
     ScopedTimer inverse(updateInverse_timer);
     //mmorales: check comment above
     psiMinv_temp = psiMinv;
-    //std::vector<int>::iterator it(confgList[ReferenceDeterminant].occup.begin());
-    auto it(confgList[ReferenceDeterminant].occup.begin());
+    auto it(refdet_occup->begin());
     for (size_t i = 0; i < NumPtcls; i++)
     {
       psiV_temp[i] = psiV[*it];
@@ -565,7 +557,7 @@ void MultiDiracDeterminant::evaluateDetsAndGradsForPtclMove(const ParticleSet& P
       ScopedTimer inverse(updateInverse_timer);
       //dpsiMinv = psiMinv_temp;
       dpsiMinv = psiMinv;
-      auto it(confgList[ReferenceDeterminant].occup.begin());
+      auto it(refdet_occup->begin());
       for (size_t i = 0; i < NumPtcls; i++)
         psiV_temp[i] = dpsiV[*(it++)][idim];
       InverseUpdateByColumn(dpsiMinv, psiV_temp, workV1, workV2, WorkingIndex, ratioGradRef[idim]);
@@ -595,15 +587,13 @@ void MultiDiracDeterminant::evaluateDetsAndGradsForPtclMoveWithSpin(const Partic
   }
   const int WorkingIndex = iat - FirstIndex;
   assert(WorkingIndex >= 0 && WorkingIndex < LastIndex - FirstIndex);
-  const auto& confgList = *ciConfigList;
   GradType ratioGradRef;
   ValueType ratioSpinGradRef = 0.0;
   {
     ScopedTimer inverse(updateInverse_timer);
     //mmorales: check comment above
     psiMinv_temp = psiMinv;
-    //std::vector<int>::iterator it(confgList[ReferenceDeterminant].occup.begin());
-    auto it(confgList[ReferenceDeterminant].occup.begin());
+    auto it(refdet_occup->begin());
     for (size_t i = 0; i < NumPtcls; i++)
     {
       psiV_temp[i] = psiV[*it];
@@ -625,7 +615,7 @@ void MultiDiracDeterminant::evaluateDetsAndGradsForPtclMoveWithSpin(const Partic
       ScopedTimer inverse(updateInverse_timer);
       //dpsiMinv = psiMinv_temp;
       dpsiMinv = psiMinv;
-      auto it(confgList[ReferenceDeterminant].occup.begin());
+      auto it(refdet_occup->begin());
       for (size_t i = 0; i < NumPtcls; i++)
         psiV_temp[i] = dpsiV[*(it++)][idim];
       InverseUpdateByColumn(dpsiMinv, psiV_temp, workV1, workV2, WorkingIndex, ratioGradRef[idim]);
@@ -640,7 +630,7 @@ void MultiDiracDeterminant::evaluateDetsAndGradsForPtclMoveWithSpin(const Partic
   {
     ScopedTimer inverse(updateInverse_timer);
     dpsiMinv = psiMinv;
-    auto it(confgList[ReferenceDeterminant].occup.begin());
+    auto it(refdet_occup->begin());
     for (size_t i = 0; i < NumPtcls; i++)
       psiV_temp[i] = dspin_psiV[*(it++)];
     InverseUpdateByColumn(dpsiMinv, psiV_temp, workV1, workV2, WorkingIndex, ratioSpinGradRef);
@@ -743,7 +733,6 @@ void MultiDiracDeterminant::mw_evaluateDetsAndGradsForPtclMove(
   const auto psiMinv_cols   = psiMinv_list[0].get().cols();
   const auto TpsiM_num_cols = TpsiM_list[0].get().cols();
   const auto psiM_num_cols  = psiM_list[0].get().cols();
-  const auto& confgList     = *det_leader.ciConfigList;
 
   auto* psiV_list_devptr         = det_leader.mw_res_->psiV_deviceptr_list.device_data();
   auto* psiV_temp_list_ptr       = det_leader.mw_res_->psiV_temp_deviceptr_list.data();
@@ -881,12 +870,11 @@ void MultiDiracDeterminant::evaluateGrads(ParticleSet& P, int iat)
   const int WorkingIndex = iat - FirstIndex;
   assert(WorkingIndex >= 0 && WorkingIndex < LastIndex - FirstIndex);
 
-  const auto& confgList = *ciConfigList;
   for (size_t idim = 0; idim < OHMMS_DIM; idim++)
   {
     //dpsiMinv = psiMinv_temp;
     dpsiMinv         = psiMinv;
-    auto it          = confgList[ReferenceDeterminant].occup.begin();
+    auto it          = refdet_occup->begin();
     ValueType ratioG = 0.0;
     for (size_t i = 0; i < NumPtcls; i++)
     {
@@ -911,12 +899,11 @@ void MultiDiracDeterminant::evaluateGradsWithSpin(ParticleSet& P, int iat)
   const int WorkingIndex = iat - FirstIndex;
   assert(WorkingIndex >= 0 && WorkingIndex < LastIndex - FirstIndex);
 
-  const auto& confgList = *ciConfigList;
   for (size_t idim = 0; idim < OHMMS_DIM; idim++)
   {
     //dpsiMinv = psiMinv_temp;
     dpsiMinv         = psiMinv;
-    auto it          = confgList[ReferenceDeterminant].occup.begin();
+    auto it          = refdet_occup->begin();
     ValueType ratioG = 0.0;
     for (size_t i = 0; i < NumPtcls; i++)
     {
@@ -933,7 +920,7 @@ void MultiDiracDeterminant::evaluateGradsWithSpin(ParticleSet& P, int iat)
 
   //Now compute the spin gradient, same procedure as normal gradient components above
   dpsiMinv          = psiMinv;
-  auto it           = confgList[ReferenceDeterminant].occup.begin();
+  auto it           = refdet_occup->begin();
   ValueType ratioSG = 0.0;
   for (size_t i = 0; i < NumPtcls; i++)
   {
@@ -1004,7 +991,6 @@ void MultiDiracDeterminant::mw_evaluateGrads(const RefVectorWithLeader<MultiDira
   const auto psiM_cols    = psiM_list[0].get().cols();
   const auto dpsiM_cols   = dpsiM_list[0].get().cols();
   const auto dpsiM_rows   = dpsiM_list[0].get().rows();
-  const auto& confgList   = *det_leader.ciConfigList;
 
   auto& ratioG_list = det_leader.mw_res_->curRatio_list;
   ratioG_list.resize(nw);
@@ -1087,27 +1073,27 @@ void MultiDiracDeterminant::mw_updateRatios_generic(int ext_level,
                                                     const size_t det_offset,
                                                     const size_t data_offset,
                                                     SmallMatrixDetCalculator<ValueType>& det_calculator,
-                                                    const OffloadVector<int>& data,
+                                                    const OffloadVector<ExcitationIndex>& data,
                                                     const OffloadVector<RealType>& sign,
                                                     const OffloadVector<ValueType>& det0_list,
                                                     const RefVector<OffloadMatrix<ValueType>>& table_matrix_list,
                                                     const RefVector<OffloadVector<ValueType>>& ratios_list) const
 {
-  const size_t nw = ratios_list.size();
-  const int* it2  = data.data() + data_offset;
+  const size_t nw            = ratios_list.size();
+  const ExcitationIndex* it2 = data.data() + data_offset;
   for (size_t iw = 0; iw < nw; iw++)
     for (size_t count = 0; count < (*ndets_per_excitation_level_)[ext_level]; ++count)
     {
       size_t det_id                 = det_offset + count;
       ratios_list[iw].get()[det_id] = sign[det_id] * det0_list[iw] *
-          det_calculator.evaluate(table_matrix_list[iw].get(), it2 + 1 + count * (3 * ext_level + 1), ext_level);
+          det_calculator.evaluate(table_matrix_list[iw].get(), it2 + count * 2 * ext_level, ext_level);
     }
 }
 
 template<unsigned EXT_LEVEL>
 void MultiDiracDeterminant::mw_updateRatios(const size_t det_offset,
                                             const size_t data_offset,
-                                            const OffloadVector<int>& data,
+                                            const OffloadVector<ExcitationIndex>& data,
                                             const OffloadVector<RealType>& sign,
                                             const OffloadVector<ValueType>& det0_list,
                                             const OffloadVector<ValueType*>& table_matrix_deviceptr_list,
@@ -1122,7 +1108,7 @@ void MultiDiracDeterminant::mw_updateRatios(const size_t det_offset,
 
   auto* ratios_list_ptr             = ratios_deviceptr_list.data();
   const auto* sign_ptr              = sign.data();
-  const int* data_ptr               = data.data();
+  const ExcitationIndex* data_ptr   = data.data();
   const auto* det0_list_ptr         = det0_list.data();
   const auto* table_matrix_list_ptr = table_matrix_deviceptr_list.data();
 
@@ -1136,7 +1122,7 @@ void MultiDiracDeterminant::mw_updateRatios(const size_t det_offset,
       ratios_list_ptr[iw][0] = det0_list_ptr[iw];
       ratios_local           = sign_ptr[det_id] * det0_list_ptr[iw] *
           CustomizedMatrixDet<EXT_LEVEL>::evaluate(table_matrix_list_ptr[iw],
-                                                   (data_ptr + data_offset) + 1 + count * (3 * EXT_LEVEL + 1),
+                                                   (data_ptr + data_offset) + count * 2 * EXT_LEVEL,
                                                    num_table_matrix_cols);
       ratios_list_ptr[iw][det_id] = ratios_local;
     }
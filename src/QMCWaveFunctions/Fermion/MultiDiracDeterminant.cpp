@@ -21,6 +21,9 @@
 #include "CPU/BLAS.hpp"
 #include "Numerics/MatrixOperators.h"
 #include <algorithm>
+#include <limits>
+#include <map>
+#include <stdexcept>
 #include <vector>
 
 // mmorales:
@@ -36,21 +39,26 @@ void MultiDiracDeterminant::createDetData(const int ref_det_id,
                                           std::vector<size_t>& C2nodes_sorted)
 {
   auto& ref                        = configlist_unsorted[ref_det_id];
-  auto& configlist_sorted          = *ciConfigList;
   auto& data                       = *detData;
   auto& pairs                      = *uniquePairs;
   auto& sign                       = *DetSigns;
   auto& ndets_per_excitation_level = *ndets_per_excitation_level_;
 
+  if (NumOrbitals > std::numeric_limits<ExcitationIndex>::max())
+    throw std::runtime_error("MultiDiracDeterminant::createDetData the number of orbitals exceeds the range of "
+                             "the excitation table indices.");
+
   const size_t nci = configlist_unsorted.size();
   std::vector<std::pair<int, int>> pairs_local;
+  // flag the (position, orbital) pairs already in pairs_local
+  std::vector<char> pair_found(NumPtcls * NumOrbitals, 0);
 
   size_t nex_max = 0;
   std::vector<size_t> pos(NumPtcls);
   std::vector<size_t> ocp(NumPtcls);
   std::vector<size_t> uno(NumPtcls);
   // map key is exc. lvl
-  std::map<int, std::vector<int>> dataMap;
+  std::map<int, std::vector<ExcitationIndex>> dataMap;
   std::map<int, std::vector<int>> sortMap;
   std::vector<RealType> tmp_sign(nci, 0);
   for (size_t i = 0; i < nci; i++)
@@ -58,25 +66,20 @@ void MultiDiracDeterminant::createDetData(const int ref_det_id,
     size_t nex;
     tmp_sign[i] = ref.calculateExcitations(configlist_unsorted[i], nex, pos, ocp, uno);
     nex_max     = std::max(nex, nex_max);
-    dataMap[nex].push_back(nex);
     sortMap[nex].push_back(i);
+    auto& level_data = dataMap[nex];
     for (int k = 0; k < nex; k++)
-      dataMap[nex].push_back(pos[k]);
-    for (int k = 0; k < nex; k++)
-      dataMap[nex].push_back(uno[k]);
+      level_data.push_back(pos[k]);
     for (int k = 0; k < nex; k++)
-      dataMap[nex].push_back(ocp[k]);
+      level_data.push_back(uno[k]);
     // determine unique pairs, to avoid redundant calculation of matrix elements
-    // if storing the entire MOxMO matrix is too much, then make an array and a mapping to it.
-    // is there an easier way??
     for (int k1 = 0; k1 < nex; k1++)
       for (int k2 = 0; k2 < nex; k2++)
-      {
-        //           std::pair<int,int> temp(ocp[k1],uno[k2]);
-        std::pair<int, int> temp(pos[k1], uno[k2]);
-        if (find(pairs_local.begin(), pairs_local.end(), temp) == pairs_local.end()) //pair is new
-          pairs_local.push_back(temp);
-      }
+        if (!pair_found[pos[k1] * NumOrbitals + uno[k2]])
+        {
+          pair_found[pos[k1] * NumOrbitals + uno[k2]] = 1;
+          pairs_local.emplace_back(pos[k1], uno[k2]);
+        }
   }
   pairs.resize(pairs_local.size());
   int* first  = pairs.data(0);
@@ -90,6 +93,7 @@ void MultiDiracDeterminant::createDetData(const int ref_det_id,
 
 
   app_log() << "Number of terms in pairs array: " << pairs.size() << std::endl;
+  ndets_per_excitation_level.clear();
   ndets_per_excitation_level.resize(nex_max + 1, 0);
   //reorder configs and det data
   std::vector<size_t> det_idx_order;           // old indices in new order
@@ -97,36 +101,33 @@ void MultiDiracDeterminant::createDetData(const int ref_det_id,
 
   // populate data, ordered by exc. lvl.
   // make mapping from new to old det idx
-  std::vector<int> data_local;
-  data_local.clear();
-  data.clear();
-
+  size_t data_size = 0;
+  for (const auto& [nex, level_data] : dataMap)
+    data_size += level_data.size();
+  data.resize(data_size);
+  det_idx_order.reserve(nci);
+  auto data_it = data.begin();
   for (const auto& [nex, det_idx_old] : sortMap)
   {
-    data_local.insert(data_local.end(), dataMap[nex].begin(), dataMap[nex].end());
+    data_it = std::copy(dataMap[nex].begin(), dataMap[nex].end(), data_it);
     det_idx_order.insert(det_idx_order.end(), det_idx_old.begin(), det_idx_old.end());
     ndets_per_excitation_level[nex] = det_idx_old.size();
   }
-  data.resize(data_local.size());
-  for (size_t i = 0; i < data_local.size(); i++)
-    data[i] = data_local[i];
 
   assert(det_idx_order.size() == nci);
 
-  // make reverse mapping (old to new) and reorder confgList by exc. lvl.
-  configlist_sorted.resize(nci);
+  // make reverse mapping (old to new) and reorder signs by exc. lvl.
   sign.resize(nci);
   for (size_t i = 0; i < nci; i++)
   {
     det_idx_reverse[det_idx_order[i]] = i;
-    configlist_sorted[i]              = configlist_unsorted[det_idx_order[i]];
     sign[i]                           = tmp_sign[det_idx_order[i]];
   }
 
   auto& refdet_occup_ref(*refdet_occup);
   refdet_occup_ref.resize(NumPtcls);
   for (size_t i = 0; i < NumPtcls; i++)
-    refdet_occup_ref[i] = configlist_unsorted[ReferenceDeterminant].occup[i];
+    refdet_occup_ref[i] = ref.occup[i];
 
   {
     ScopedTimer local_timer(transferH2D_timer);
@@ -140,16 +141,9 @@ void MultiDiracDeterminant::createDetData(const int ref_det_id,
   for (int i = 0; i < C2nodes_unsorted.size(); i++)
     C2nodes_sorted[i] = det_idx_reverse[C2nodes_unsorted[i]];
 
-  /*
-       std::cout <<"ref: " <<ref << std::endl;
-       std::cout <<"list: " << std::endl;
-       for(int i=0; i<confgList.size(); i++)
-         std::cout <<confgList[i] << std::endl;
-
-       std::cout <<"pairs: " << std::endl;
-       for(int i=0; i<pairs.size(); i++)
-         std::cout <<pairs[i].first <<"   " <<pairs[i].second << std::endl;
-  */
+  app_log() << "Excitation table of " << nci << " unique determinants: "
+            << (data.size() * sizeof(ExcitationIndex) + sign.size() * sizeof(RealType)) / nci
+            << " bytes per determinant" << std::endl;
 
   // make sure internal objects depending on the number of unique determinants are resized
   resize();
@@ -174,11 +168,10 @@ void MultiDiracDeterminant::evaluateForWalkerMove(const ParticleSet& P, bool fro
   }
 
 
-  const auto& confgList = *ciConfigList;
 
   {
     ScopedTimer local_timer(inverse_timer);
-    auto it(confgList[ReferenceDeterminant].occup.begin());
+    auto it(refdet_occup->begin());
     for (size_t i = 0; i < NumPtcls; i++)
     {
       for (size_t j = 0; j < NumPtcls; j++)
@@ -203,7 +196,7 @@ void MultiDiracDeterminant::evaluateForWalkerMove(const ParticleSet& P, bool fro
 
   for (size_t iat = 0; iat < NumPtcls; iat++)
   {
-    auto it(confgList[ReferenceDeterminant].occup.begin());
+    auto it(refdet_occup->begin());
     GradType gradRatio;
     ValueType ratioLapl = 0.0;
     for (size_t i = 0; i < NumPtcls; i++)
@@ -216,7 +209,7 @@ void MultiDiracDeterminant::evaluateForWalkerMove(const ParticleSet& P, bool fro
     for (size_t idim = 0; idim < OHMMS_DIM; idim++)
     {
       dpsiMinv = psiMinv;
-      it       = confgList[ReferenceDeterminant].occup.begin();
+      it       = refdet_occup->begin();
       for (size_t i = 0; i < NumPtcls; i++)
         psiV_temp[i] = dpsiM(iat, *(it++))[idim];
       InverseUpdateByColumn(dpsiMinv, psiV_temp, workV1, workV2, iat, gradRatio[idim]);
@@ -226,7 +219,7 @@ void MultiDiracDeterminant::evaluateForWalkerMove(const ParticleSet& P, bool fro
                                            gradRatio[idim], table_matrix, idim, iat, grads);
     }
     dpsiMinv = psiMinv;
-    it       = confgList[ReferenceDeterminant].occup.begin();
+    it       = refdet_occup->begin();
     for (size_t i = 0; i < NumPtcls; i++)
       psiV_temp[i] = d2psiM(iat, *(it++));
     InverseUpdateByColumn(dpsiMinv, psiV_temp, workV1, workV2, iat, ratioLapl);
@@ -268,12 +261,11 @@ void MultiDiracDeterminant::evaluateForWalkerMoveWithSpin(const ParticleSet& P,
   }
 
 
-  const auto& confgList = *ciConfigList;
   std::complex<RealType> logValueRef;
 
   {
     ScopedTimer local_timer(inverse_timer);
-    auto it(confgList[ReferenceDeterminant].occup.begin());
+    auto it(refdet_occup->begin());
     for (size_t i = 0; i < NumPtcls; i++)
     {
       for (size_t j = 0; j < NumPtcls; j++)
@@ -294,7 +286,7 @@ void MultiDiracDeterminant::evaluateForWalkerMoveWithSpin(const ParticleSet& P,
 
   for (size_t iat = 0; iat < NumPtcls; iat++)
   {
-    auto it(confgList[ReferenceDeterminant].occup.begin());
+    auto it(refdet_occup->begin());
     GradType gradRatio;
     ValueType ratioLapl     = 0.0;
     ValueType spingradRatio = 0.0;
@@ -310,7 +302,7 @@ void MultiDiracDeterminant::evaluateForWalkerMoveWithSpin(const ParticleSet& P,
     for (size_t idim = 0; idim < OHMMS_DIM; idim++)
     {
       dpsiMinv = psiMinv;
-      it       = confgList[ReferenceDeterminant].occup.begin();
+      it       = refdet_occup->begin();
       for (size_t i = 0; i < NumPtcls; i++)
         psiV_temp[i] = dpsiM(iat, *(it++))[idim];
       InverseUpdateByColumn(dpsiMinv, psiV_temp, workV1, workV2, iat, gradRatio[idim]);
@@ -320,7 +312,7 @@ void MultiDiracDeterminant::evaluateForWalkerMoveWithSpin(const ParticleSet& P,
                                            gradRatio[idim], table_matrix, idim, iat, grads);
     }
     dpsiMinv = psiMinv;
-    it       = confgList[ReferenceDeterminant].occup.begin();
+    it       = refdet_occup->begin();
     for (size_t i = 0; i < NumPtcls; i++)
       psiV_temp[i] = d2psiM(iat, *(it++));
     InverseUpdateByColumn(dpsiMinv, psiV_temp, workV1, workV2, iat, ratioLapl);
@@ -331,7 +323,7 @@ void MultiDiracDeterminant::evaluateForWalkerMoveWithSpin(const ParticleSet& P,
 
     //Adding the spin gradient
     dpsiMinv = psiMinv;
-    it       = confgList[ReferenceDeterminant].occup.begin();
+    it       = refdet_occup->begin();
     for (size_t i = 0; i < NumPtcls; i++)
       psiV_temp[i] = dspin_psiM(iat, *(it++));
     InverseUpdateByColumn(dpsiMinv, psiV_temp, workV1, workV2, iat, spingradRatio);
@@ -541,7 +533,6 @@ MultiDiracDeterminant::MultiDiracDeterminant(const MultiDiracDeterminant& s)
       FirstIndex(s.FirstIndex),
       NumPtcls(s.NumPtcls),
       LastIndex(s.LastIndex),
-      ciConfigList(s.ciConfigList),
       refdet_occup(s.refdet_occup),
       is_spinor_(s.is_spinor_),
       detData(s.detData),
@@ -594,9 +585,8 @@ MultiDiracDeterminant::MultiDiracDeterminant(std::unique_ptr<SPOSet>&& spos, boo
 {
   (Phi->isOptimizable() == true) ? Optimizable = true : Optimizable = false;
 
-  ciConfigList                = std::make_shared<std::vector<ci_configuration2>>();
   refdet_occup                = std::make_shared<OffloadVector<size_t>>();
-  detData                     = std::make_shared<OffloadVector<int>>();
+  detData                     = std::make_shared<OffloadVector<ExcitationIndex>>();
   uniquePairs                 = std::make_shared<VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>>();
   DetSigns                    = std::make_shared<OffloadVector<RealType>>();
   ndets_per_excitation_level_ = std::make_shared<std::vector<int>>();
@@ -800,36 +790,44 @@ void MultiDiracDeterminant::buildOptVariables(std::vector<size_t>& C2node)
   Phi->buildOptVariables(m_act_rot_inds);
 }
 
-int MultiDiracDeterminant::build_occ_vec(const OffloadVector<int>& data,
+int MultiDiracDeterminant::build_occ_vec(const OffloadVector<ExcitationIndex>& data,
                                          const size_t nel,
                                          const size_t nmo,
-                                         std::vector<int>& occ_vec)
+                                         std::vector<int>& occ_vec) const
 {
-  size_t it = 0;
-  int count = 0; //number of determinants
-  while (it < data.size())
-  {
-    int k = data[it]; // number of excitations with respect to the reference matrix
-    if (count == 0)
-    {
-      it += 3 * k + 1;
-      count++;
-    }
-    else
-    {
+  const ExcitationIndex* it = data.data();
+  int count                 = 0; //number of determinants
+  for (int k = 0; k < ndets_per_excitation_level_->size(); k++)
+    for (int idet = 0; idet < (*ndets_per_excitation_level_)[k]; idet++, count++, it += 2 * k)
       for (int i = 0; i < k; i++)
       {
         //for determining active orbitals
-        occ_vec[data[it + 1 + i]]++;
-        occ_vec[data[it + 1 + k + i]]++;
+        occ_vec[it[i]]++;
+        occ_vec[it[k + i]]++;
       }
-      it += 3 * k + 1;
-      count++;
-    }
-  }
   return count;
 }
 
+void MultiDiracDeterminant::expandDetData(std::vector<int>& data) const
+{
+  const auto& ndets_per_level = *ndets_per_excitation_level_;
+  size_t data_size            = 0;
+  for (int k = 0; k < ndets_per_level.size(); k++)
+    data_size += ndets_per_level[k] * (3 * k + 1);
+  data.resize(data_size);
+
+  const ExcitationIndex* it = detData->data();
+  auto data_it              = data.begin();
+  for (int k = 0; k < ndets_per_level.size(); k++)
+    for (int idet = 0; idet < ndets_per_level[k]; idet++, it += 2 * k)
+    {
+      *data_it++ = k;
+      data_it    = std::copy(it, it + 2 * k, data_it);
+      for (int i = 0; i < k; i++)
+        *data_it++ = (*refdet_occup)[it[i]];
+    }
+}
+
 
 void MultiDiracDeterminant::evaluateDerivatives(ParticleSet& P,
                                                 const opt_variables_type& optvars,
@@ -856,9 +854,8 @@ void MultiDiracDeterminant::evaluateDerivatives(ParticleSet& P,
   const OffloadMatrix<ValueType>& Minv_dn      = pseudo_dn.psiMinv;
   const OffloadMatrix<GradType>& B_grad        = dpsiM;
   const OffloadMatrix<ValueType>& B_lapl       = d2psiM;
-  std::vector<int> detData_local(detData->size());
-  for (size_t i = 0; i < detData->size(); i++)
-    detData_local[i] = (*detData)[i];
+  std::vector<int> detData_local;
+  expandDetData(detData_local);
 
 
   const size_t N1  = FirstIndex;
@@ -899,9 +896,8 @@ void MultiDiracDeterminant::evaluateDerivativesWF(ParticleSet& P,
   const OffloadMatrix<ValueType>& Minv_up      = psiMinv;
   const OffloadMatrix<ValueType>& Minv_dn      = pseudo_dn.psiMinv;
 
-  std::vector<int> detData_local(detData->size());
-  for (size_t i = 0; i < detData->size(); i++)
-    detData_local[i] = (*detData)[i];
+  std::vector<int> detData_local;
+  expandDetData(detData_local);
   Vector<ValueType> detValues_up_host_view(const_cast<ValueType*>(detValues_up.data()), detValues_up.size());
   Vector<ValueType> detValues_dn_host_view(const_cast<ValueType*>(detValues_dn.data()), detValues_dn.size());
   Matrix<ValueType> M_up_host_view(const_cast<ValueType*>(M_up.data()), M_up.rows(), M_up.cols());
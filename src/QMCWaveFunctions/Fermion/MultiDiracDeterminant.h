@@ -51,6 +51,8 @@ public:
   using OffloadMatrix = Matrix<DT, OffloadPinnedAllocator<DT>>;
   template<typename DT>
   using UnpinnedOffloadMatrix = Matrix<DT, OffloadAllocator<DT>>;
+  /// type of the orbital and electron indices stored in the excitation table
+  using ExcitationIndex = uint16_t;
 
   using IndexVector = SPOSet::IndexVector;
   using ValueVector = SPOSet::ValueVector;
@@ -155,7 +157,10 @@ public:
   /// create optimizable orbital rotation parameters
   void buildOptVariables(std::vector<size_t>& C2node);
   ///helper function to buildOptVariables
-  int build_occ_vec(const OffloadVector<int>& data, const size_t nel, const size_t nmo, std::vector<int>& occ_vec);
+  int build_occ_vec(const OffloadVector<ExcitationIndex>& data,
+                    const size_t nel,
+                    const size_t nmo,
+                    std::vector<int>& occ_vec) const;
 
   void resetParameters(const opt_variables_type& active) override { Phi->resetParameters(active); }
 
@@ -251,13 +256,14 @@ public:
    ***************************************************************************/
 
   /** create necessary structures related to unique determinants
-   * sort configlist_unsorted by excitation level abd store the results in ciConfigList (class member)
-   * ciConfigList shouldn't change during a simulation after it is sorted here
+   * sort configlist_unsorted by excitation level and store the excitations from the reference in detData (class member)
+   * only the occupation of the reference is kept, configlist_unsorted can be released afterwards.
+   * detData shouldn't change during a simulation after it is sorted here
    *
    * @param ref_det_id id of the reference determinant before sorting
    * @param configlist_unsorted config list to be loaded.
    * @param C2nodes_unsorted mapping from overall det index to unique det (configlist_unsorted) index
-   * @param C2nodes_sorted mapping from overall det index to unique det (ciConfigList) index
+   * @param C2nodes_sorted mapping from overall det index to sorted unique det index
    */
   void createDetData(const int ref_det_id,
                      const std::vector<ci_configuration2>& configlist_unsorted,
@@ -302,7 +308,7 @@ public:
   void evaluateForWalkerMoveWithSpin(const ParticleSet& P, bool fromScratch = true);
 
   // accessors
-  inline int getNumDets() const { return ciConfigList->size(); }
+  inline int getNumDets() const { return DetSigns->size(); }
   inline int getNumPtcls() const { return NumPtcls; }
   inline int getFirstIndex() const { return FirstIndex; }
 
@@ -318,6 +324,11 @@ public:
   PsiValueType getRefDetRatio() const { return static_cast<PsiValueType>(curRatio); }
   LogValueType getLogValueRefDet() const { return log_value_ref_det_; }
 
+  /** expand detData into the {n, i1..in, a1..an, o1..on} per determinant layout used by the orbital rotations
+   * where i are the replaced positions, a the substituted orbitals and o the replaced orbitals.
+   */
+  void expandDetData(std::vector<int>& data) const;
+
 private:
   void mw_InverseUpdateByColumn(MultiDiracDetMultiWalkerResource& mw_res,
                                 const int working_index,
@@ -329,7 +340,7 @@ private:
   /** update ratios with respect to the reference deteriminant for a given excitation level
    * @param ext_level excitation level
    * @param det_offset offset of the determinant id
-   * @param data_offset offset of the "data" structure
+   * @param data_offset offset of the excitation level in the "data" structure
    * @param sign of determinants
    * @param det0_list list of reference det value
    * @param table_matrix_list list of table_matrix
@@ -340,7 +351,7 @@ private:
                                const size_t det_offset,
                                const size_t data_offset,
                                SmallMatrixDetCalculator<ValueType>& det_calculator,
-                               const OffloadVector<int>& data,
+                               const OffloadVector<ExcitationIndex>& data,
                                const OffloadVector<RealType>& sign,
                                const OffloadVector<ValueType>& det0_list,
                                const RefVector<OffloadMatrix<ValueType>>& table_matrix_list,
@@ -348,7 +359,7 @@ private:
 
   /** update ratios with respect to the reference deteriminant for a given excitation level
    * @param det_offset offset of the determinant id
-   * @param data_offset offset of the "data" structure
+   * @param data_offset offset of the excitation level in the "data" structure
    * @param sign of determinants
    * @param det0_list list of reference det value
    * @param table_matrix_list list of table_matrix
@@ -358,7 +369,7 @@ private:
   template<unsigned EXT_LEVEL>
   void mw_updateRatios(const size_t det_offset,
                        const size_t data_offset,
-                       const OffloadVector<int>& data,
+                       const OffloadVector<ExcitationIndex>& data,
                        const OffloadVector<RealType>& sign,
                        const OffloadVector<ValueType>& det0_list,
                        const OffloadVector<ValueType*>& table_matrix_deviceptr_list,
@@ -382,7 +393,7 @@ private:
                                                 const OffloadVector<ValueType>& det0_list,
                                                 const RefVector<OffloadMatrix<ValueType>>& psiinv_list,
                                                 const RefVector<OffloadMatrix<ValueType>>& psi_list,
-                                                const OffloadVector<int>& data,
+                                                const OffloadVector<ExcitationIndex>& data,
                                                 const VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>& pairs,
                                                 const OffloadVector<RealType>& sign,
                                                 const RefVector<OffloadMatrix<ValueType>>& table_matrix_list,
@@ -405,7 +416,7 @@ private:
                                              const OffloadMatrix<ValueType>& psiinv,
                                              const OffloadMatrix<ValueType>& psi,
                                              OffloadMatrix<ValueType>& table_matrix,
-                                             const OffloadVector<int>& data,
+                                             const OffloadVector<ExcitationIndex>& data,
                                              const VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>& pairs,
                                              const OffloadVector<RealType>& sign);
 
@@ -415,7 +426,7 @@ private:
   void buildTableMatrix_calculateRatios(int ref,
                                         const OffloadMatrix<ValueType>& psiinv,
                                         const OffloadMatrix<ValueType>& psi,
-                                        const OffloadVector<int>& data,
+                                        const OffloadVector<ExcitationIndex>& data,
                                         const VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>& pairs,
                                         const OffloadVector<RealType>& sign,
                                         OffloadMatrix<ValueType>& table_matrix,
@@ -426,7 +437,7 @@ private:
                                            const OffloadVector<ValueType>& det0_list,
                                            const RefVector<OffloadMatrix<ValueType>>& psiinv_list,
                                            const RefVector<OffloadMatrix<ValueType>>& psi_list,
-                                           const OffloadVector<int>& data,
+                                           const OffloadVector<ExcitationIndex>& data,
                                            const VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>& pairs,
                                            const OffloadVector<RealType>& sign,
                                            const RefVector<OffloadMatrix<ValueType>>& table_matrix_list,
@@ -448,7 +459,7 @@ private:
   void buildTableMatrix_calculateGradRatios(int ref,
                                             const OffloadMatrix<ValueType>& psiinv,
                                             const OffloadMatrix<ValueType>& psi,
-                                            const OffloadVector<int>& data,
+                                            const OffloadVector<ExcitationIndex>& data,
                                             const VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>& pairs,
                                             const OffloadVector<RealType>& sign,
                                             const ValueType& det0_grad,
@@ -480,7 +491,7 @@ private:
                                                const OffloadVector<ValueType>& det0_grad_list,
                                                const RefVector<OffloadMatrix<ValueType>>& psiinv_list,
                                                const RefVector<OffloadMatrix<ValueType>>& psi_list,
-                                               const OffloadVector<int>& data,
+                                               const OffloadVector<ExcitationIndex>& data,
                                                const VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>& pairs,
                                                const OffloadVector<RealType>& sign,
                                                const RefVector<OffloadVector<ValueType>>& WorkSpace_list,
@@ -491,7 +502,7 @@ private:
       int ref,
       const OffloadMatrix<ValueType>& psiinv,
       const OffloadMatrix<ValueType>& psi,
-      const OffloadVector<int>& data,
+      const OffloadVector<ExcitationIndex>& data,
       const VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>& pairs,
       const OffloadVector<RealType>& sign,
       OffloadMatrix<ValueType>& table_matrix,
@@ -511,8 +522,6 @@ private:
   const int NumPtcls;
   ///index of the last particle with respect to the particle set
   const int LastIndex;
-  ///use shared_ptr
-  std::shared_ptr<std::vector<ci_configuration2>> ciConfigList;
   /// all the unique determinants are sorted, the id of the reference det id is always 0
   static constexpr int ReferenceDeterminant = 0;
   /// reference determinant occupation
@@ -571,15 +580,14 @@ private:
   Matrix<ValueType> spingrads, new_spingrads;
 
 
-  /* mmorales:
-   *  i decided to stored the excitation information of all determinants in the following
-   *  compact form: (all these integers are found consecutively in the array)
-   *    For each determinant:
-   *     -n : number of excitations
-   *     -i1,i2,...,in : occupied orbital to be replaced (these must be numbers from 0:Nptcl-1)
+  /** excitations of all the unique determinants with respect to the reference, sorted by excitation level.
+   *  A determinant with n excitations takes 2n consecutive entries
+   *     -i1,i2,...,in : positions of the occupied orbitals to be replaced (these must be numbers from 0:Nptcl-1)
    *     -a1,a2,...,an : excited states that replace the orbitals (these can be anything)
+   *  The level n is implied by the position in the table, see ndets_per_excitation_level_,
+   *  and the replaced orbitals are refdet_occup[i1..in].
    */
-  std::shared_ptr<OffloadVector<int>> detData;
+  std::shared_ptr<OffloadVector<ExcitationIndex>> detData;
   std::shared_ptr<VectorSoaContainer<int, 2, OffloadPinnedAllocator<int>>> uniquePairs;
   std::shared_ptr<OffloadVector<RealType>> DetSigns;
   /** number of unique determinants at each excitation level (relative to reference)
@@ -0,0 +1,136 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "PackedDetList.h"
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include "hdf/hdf_archive.h"
+
+namespace qmcplusplus
+{
+uint64_t PackedDetList::hash(const uint64_t* det, int n_int)
+{
+  // splitmix64 finalizer applied to each word
+  uint64_t h = 0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(n_int);
+  for (int k = 0; k < n_int; k++)
+  {
+    uint64_t z = det[k] + 0x9E3779B97F4A7C15ULL * (k + 1);
+    z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z          = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    h          = (h ^ z ^ (z >> 31)) * 0x100000001B3ULL;
+  }
+  return h ^ (h >> 29);
+}
+
+size_t PackedDetList::insert(const uint64_t* det, uint64_t det_hash)
+{
+  // keep the load factor below 1/2
+  if (2 * (size() + 1) > table_.size())
+    grow();
+  const size_t mask = table_.size() - 1;
+  for (size_t slot = det_hash & mask;; slot = (slot + 1) & mask)
+  {
+    const size_t entry = table_[slot];
+    if (entry == 0)
+    {
+      table_[slot] = size() + 1;
+      hashes_.push_back(det_hash);
+      words_.insert(words_.end(), det, det + n_int_);
+      return size() - 1;
+    }
+    if (hashes_[entry - 1] == det_hash && std::equal(det, det + n_int_, (*this)[entry - 1]))
+      return entry - 1;
+  }
+}
+
+void PackedDetList::grow()
+{
+  table_.assign(std::max(size_t(1024), table_.size() * 2), 0);
+  const size_t mask = table_.size() - 1;
+  for (size_t i = 0; i < size(); i++)
+  {
+    size_t slot = hashes_[i] & mask;
+    while (table_[slot] != 0)
+      slot = (slot + 1) & mask;
+    table_[slot] = i + 1;
+  }
+}
+
+void readPackedDetList(hdf_archive& hin,
+                       size_t ndets,
+                       int n_int,
+                       size_t nstates,
+                       const std::vector<size_t>& selected,
+                       size_t chunk_size,
+                       std::vector<PackedDetList>& unique_dets,
+                       std::vector<std::vector<size_t>>& C2nodes)
+{
+  const int nGroups = unique_dets.size();
+  std::vector<std::string> names(nGroups);
+  std::vector<int> dims;
+  for (int grp = 0; grp < nGroups; grp++)
+  {
+    names[grp] = "CI_" + std::to_string(grp);
+    //for backwards compatibility
+    if (grp < 2 && !hin.getShape<int64_t>(names[grp], dims))
+      names[grp] = grp == 0 ? "CI_Alpha" : "CI_Beta";
+    unique_dets[grp] = PackedDetList(n_int);
+    C2nodes[grp].clear();
+    C2nodes[grp].reserve(selected.size());
+  }
+
+  if (nstates > static_cast<size_t>(n_int) * 64)
+    throw std::runtime_error("readPackedDetList nstates exceeds the number of bits of a determinant");
+  // clear the bits beyond nstates in the last word
+  const int last_word      = (nstates + 63) / 64 - 1;
+  const uint64_t last_mask = nstates % 64 == 0 ? ~uint64_t(0) : (uint64_t(1) << (nstates % 64)) - 1;
+
+  // the files store signed integers, read as such to avoid any conversion and reinterpret the bits
+  std::vector<int64_t> chunk;
+  std::vector<uint64_t> hashes;
+  auto sel_first = selected.begin();
+  for (size_t first = 0; first < ndets && sel_first != selected.end(); first += chunk_size)
+  {
+    const size_t nrows   = std::min(chunk_size, ndets - first);
+    const auto sel_last  = std::lower_bound(sel_first, selected.end(), first + nrows);
+    const size_t num_sel = sel_last - sel_first;
+    if (num_sel == 0)
+      continue;
+    hashes.resize(num_sel);
+    for (int grp = 0; grp < nGroups; grp++)
+    {
+      const std::array<size_t, 2> file_shape{ndets, static_cast<size_t>(n_int)};
+      const std::array<size_t, 2> chunk_shape{nrows, static_cast<size_t>(n_int)};
+      const std::array<size_t, 2> offsets{first, 0};
+      chunk.resize(nrows * n_int);
+      hyperslab_proxy<std::vector<int64_t>, 2> pxy(chunk, file_shape, chunk_shape, offsets);
+      hin.read(pxy, names[grp]);
+      uint64_t* chunk_words = reinterpret_cast<uint64_t*>(chunk.data());
+
+#pragma omp parallel for
+      for (size_t i = 0; i < num_sel; i++)
+      {
+        uint64_t* det = chunk_words + (sel_first[i] - first) * n_int;
+        det[last_word] &= last_mask;
+        std::fill(det + last_word + 1, det + n_int, 0);
+        hashes[i] = PackedDetList::hash(det, n_int);
+      }
+
+      for (size_t i = 0; i < num_sel; i++)
+        C2nodes[grp].push_back(unique_dets[grp].insert(chunk_words + (sel_first[i] - first) * n_int, hashes[i]));
+    }
+    sel_first = sel_last;
+  }
+}
+
+} // namespace qmcplusplus
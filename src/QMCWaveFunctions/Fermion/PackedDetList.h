@@ -0,0 +1,122 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_PACKED_DET_LIST_H
+#define QMCPLUSPLUS_PACKED_DET_LIST_H
+
+#include <cstdint>
+#include <vector>
+#include <string>
+
+namespace qmcplusplus
+{
+class hdf_archive;
+
+/// index of the lowest set bit of a nonzero word
+inline int countTrailingZeros(uint64_t w)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(w);
+#else
+  int n = 0;
+  for (; (w & 1) == 0; w >>= 1)
+    n++;
+  return n;
+#endif
+}
+
+/** unique determinant occupations of one particle group, stored as packed bit strings
+ *
+ * Determinant i occupies the n_int 64-bit words starting at words_[i * n_int].
+ * Bit b of word k is set if orbital k * 64 + b is occupied, the layout of the CI_X datasets of the HDF5 files.
+ * Determinants are deduplicated by an open addressing hash table on the packed words.
+ */
+class PackedDetList
+{
+public:
+  PackedDetList(int n_int = 1) : n_int_(n_int) {}
+
+  /// number of 64-bit words per determinant
+  int numWords() const { return n_int_; }
+  /// number of unique determinants
+  size_t size() const { return hashes_.size(); }
+  /// words of the i-th determinant
+  const uint64_t* operator[](size_t i) const { return words_.data() + i * n_int_; }
+
+  /// hash of a packed determinant of n_int words
+  static uint64_t hash(const uint64_t* det, int n_int);
+
+  /** find a determinant and add it if it is new
+   * @param det packed determinant
+   * @param det_hash hash(det, numWords())
+   * @return the index of det
+   */
+  size_t insert(const uint64_t* det, uint64_t det_hash);
+
+  /** the occupied orbitals of a determinant in increasing order
+   * @param i determinant index
+   * @param occup the first number of occupied orbitals elements are set
+   * @return number of occupied orbitals
+   */
+  template<typename IT>
+  size_t getOccupied(size_t i, std::vector<IT>& occup) const
+  {
+    const uint64_t* det = (*this)[i];
+    size_t count        = 0;
+    for (int k = 0; k < n_int_; k++)
+      for (uint64_t w = det[k]; w != 0; w &= w - 1)
+      {
+        if (count < occup.size())
+          occup[count] = k * 64 + countTrailingZeros(w);
+        count++;
+      }
+    return count;
+  }
+
+private:
+  int n_int_;
+  /// packed determinants
+  std::vector<uint64_t> words_;
+  /// hash of each determinant, used when the table grows
+  std::vector<uint64_t> hashes_;
+  /// open addressing table of determinant index + 1, 0 for an empty slot. Power of 2 size.
+  std::vector<size_t> table_;
+
+  /// double the table size and rehash
+  void grow();
+};
+
+/** read the determinants of all the particle groups from the MultiDet group of a HDF5 file
+ * @param hin archive with the MultiDet group pushed
+ * @param ndets number of determinants in the file
+ * @param n_int number of 64-bit words per determinant
+ * @param nstates number of orbitals, the bits of higher orbitals are ignored
+ * @param selected increasing indices of the determinants to keep, e.g. after a cutoff on the coefficients
+ * @param chunk_size number of determinants read per hyperslab
+ * @param unique_dets [out] unique determinants of each group in the order of first appearance
+ * @param C2nodes [out] for each group, the index in unique_dets of every selected determinant
+ *
+ * CI_X datasets are read in chunks of rows to bound the memory. The packed words of the selected rows of a chunk
+ * are hashed in parallel and inserted in order, so the numbering matches a serial pass.
+ * Falls back on CI_Alpha and CI_Beta if CI_0 is absent.
+ */
+void readPackedDetList(hdf_archive& hin,
+                       size_t ndets,
+                       int n_int,
+                       size_t nstates,
+                       const std::vector<size_t>& selected,
+                       size_t chunk_size,
+                       std::vector<PackedDetList>& unique_dets,
+                       std::vector<std::vector<size_t>>& C2nodes);
+
+} // namespace qmcplusplus
+#endif
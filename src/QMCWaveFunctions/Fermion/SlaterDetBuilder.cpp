@@ -18,6 +18,8 @@
 
 #include "SlaterDetBuilder.h"
 #include <type_traits>
+#include <algorithm>
+#include <cctype>
 #include <bitset>
 #include <unordered_map>
 #include "QMCWaveFunctions/SPOSetBuilderFactory.h"
@@ -40,6 +42,7 @@
 //#include "QMCWaveFunctions/Fermion/ci_node.h"
 #include "QMCWaveFunctions/Fermion/ci_configuration.h"
 #include "QMCWaveFunctions/Fermion/ci_configuration2.h"
+#include "QMCWaveFunctions/Fermion/PackedDetList.h"
 
 namespace qmcplusplus
 {
@@ -289,10 +292,10 @@ std::unique_ptr<DiracDeterminantBase> SlaterDetBuilder::putDeterminant(
   std::string matrix_inverter;
   std::string use_batch;
   std::string useGPU;
-  int delay_rank(0);
+  std::string delay_rank_input("0");
 
   OhmmsAttributeSet sdAttrib;
-  sdAttrib.add(delay_rank, "delay_rank");
+  sdAttrib.add(delay_rank_input, "delay_rank");
   sdAttrib.add(optimize, "optimize", {"no", "yes"});
   sdAttrib.add(matrix_inverter, "matrix_inverter", {"gpu", "host"});
 #if defined(ENABLE_OFFLOAD)
@@ -349,13 +352,22 @@ std::unique_ptr<DiracDeterminantBase> SlaterDetBuilder::putDeterminant(
   const int firstIndex = targetPtcl.first(spin_group);
   const int lastIndex  = targetPtcl.last(spin_group);
 
+  // delay_rank="auto" measures and selects the delay rank at run time, only supported by the CPU delayed update
+  const bool tune_delay_rank = delay_rank_input == "auto";
+  int delay_rank(-1);
+  if (tune_delay_rank)
+    delay_rank = 0;
+  else if (!delay_rank_input.empty() &&
+           std::all_of(delay_rank_input.begin(), delay_rank_input.end(), [](char c) { return std::isdigit(c); }))
+    delay_rank = std::stoi(delay_rank_input);
+
   if (delay_rank < 0 || delay_rank > lastIndex - firstIndex)
   {
     std::ostringstream err_msg;
     err_msg << "SlaterDetBuilder::putDeterminant delay_rank must be positive "
             << "and no larger than the electron count within a determinant!\n"
             << "Acceptable value [1," << lastIndex - firstIndex << "], "
-            << "user input " + std::to_string(delay_rank);
+            << "or auto, user input " + delay_rank_input;
     APP_ABORT(err_msg.str());
   }
   else if (delay_rank == 0)
@@ -364,10 +376,14 @@ std::unique_ptr<DiracDeterminantBase> SlaterDetBuilder::putDeterminant(
       delay_rank = 32;
     else
       delay_rank = 1;
-    app_summary() << "      Setting delay_rank to default value " << delay_rank << std::endl;
+    if (!tune_delay_rank)
+      app_summary() << "      Setting delay_rank to default value " << delay_rank << std::endl;
   }
 
-  if (delay_rank > 1)
+  if (tune_delay_rank)
+    app_summary() << "      Using delayed update with auto-tuned delay rank on CPU, otherwise rank-" << delay_rank
+                  << std::endl;
+  else if (delay_rank > 1)
     app_summary() << "      Using rank-" << delay_rank << " delayed update" << std::endl;
   else
     app_summary() << "      Using rank-1 Sherman-Morrison Fahy update (SM1)" << std::endl;
@@ -452,8 +468,9 @@ std::unique_ptr<DiracDeterminantBase> SlaterDetBuilder::putDeterminant(
       else
       {
         app_summary() << "      Running on CPU." << std::endl;
-        adet = std::make_unique<DiracDeterminant<>>(std::move(psi_clone), firstIndex, lastIndex, delay_rank,
-                                                    matrix_inverter_kind);
+        // DelayedUpdate auto-tunes with delay rank 0
+        adet = std::make_unique<DiracDeterminant<>>(std::move(psi_clone), firstIndex, lastIndex,
+                                                    tune_delay_rank ? 0 : delay_rank, matrix_inverter_kind);
       }
     }
   }
@@ -496,7 +513,7 @@ std::unique_ptr<MultiSlaterDetTableMethod> SlaterDetBuilder::createMSDFast(
   for (int grp = 0; grp < nGroups; grp++)
     nptcls[grp] = targetPtcl.groupsize(grp);
 
-  std::vector<std::vector<ci_configuration>> uniqueConfgs(nGroups);
+  std::vector<std::vector<ci_configuration2>> uniqueConfgs(nGroups);
   std::vector<std::string> CItags;
 
   //Check id multideterminants are in HDF5
@@ -517,10 +534,47 @@ std::unique_ptr<MultiSlaterDetTableMethod> SlaterDetBuilder::createMSDFast(
   if (!HDF5Path.empty())
   {
     app_log() << "Found Multideterminants in H5 File" << std::endl;
-    readDetListH5(cur, uniqueConfgs, C2nodes, CItags, C, optimizeCI, nptcls);
+    std::vector<PackedDetList> packed_confgs(nGroups);
+    readDetListH5(cur, packed_confgs, C2nodes, CItags, C, optimizeCI, nptcls);
+    for (int grp = 0; grp < nGroups; grp++)
+    {
+      auto& list = uniqueConfgs[grp];
+      list.resize(packed_confgs[grp].size());
+      bool mismatch = false;
+#pragma omp parallel for reduction(|| : mismatch)
+      for (size_t i = 0; i < list.size(); i++)
+      {
+        list[i].occup.resize(nptcls[grp]);
+        mismatch = mismatch || packed_confgs[grp].getOccupied(i, list[i].occup) != nptcls[grp];
+      }
+      if (mismatch)
+        throw std::runtime_error("Error in SlaterDetBuilder::createMSDFast for ptcl group " + std::to_string(grp) +
+                                 ", problems with ci configuration list. \n");
+    }
   }
   else
-    readDetList(cur, uniqueConfgs, C2nodes, CItags, C, optimizeCI, nptcls, csf_data_ptr);
+  {
+    std::vector<std::vector<ci_configuration>> confgs(nGroups);
+    readDetList(cur, confgs, C2nodes, CItags, C, optimizeCI, nptcls, csf_data_ptr);
+    for (int grp = 0; grp < nGroups; grp++)
+    {
+      auto& list = uniqueConfgs[grp];
+      list.resize(confgs[grp].size());
+      for (int i = 0; i < list.size(); i++)
+      {
+        list[i].occup.resize(nptcls[grp]);
+        int cnt = 0;
+        for (int k = 0; k < confgs[grp][i].occup.size(); k++)
+          if (confgs[grp][i].occup[k])
+            list[i].occup[cnt++] = k;
+        if (cnt != nptcls[grp])
+        {
+          APP_ABORT("Error in SlaterDetBuilder::createMSDFast for ptcl group "
+                    << grp << ", problems with ci configuration list. \n");
+        }
+      }
+    }
+  }
 
   const auto maxloc   = std::max_element(C.begin(), C.end(), [](ValueType const& lhs, ValueType const& rhs) {
     return std::norm(lhs) < std::norm(rhs);
@@ -534,22 +588,8 @@ std::unique_ptr<MultiSlaterDetTableMethod> SlaterDetBuilder::createMSDFast(
   {
     dets.emplace_back(std::make_unique<MultiDiracDeterminant>(std::move(spo_clones[grp]), spinor, targetPtcl.first(grp),
                                                               nptcls[grp]));
-    std::vector<ci_configuration2> list(uniqueConfgs[grp].size());
-    for (int i = 0; i < list.size(); i++)
-    {
-      list[i].occup.resize(nptcls[grp]);
-      int cnt = 0;
-      for (int k = 0; k < uniqueConfgs[grp][i].occup.size(); k++)
-        if (uniqueConfgs[grp][i].occup[k])
-          list[i].occup[cnt++] = k;
-      if (cnt != nptcls[grp])
-      {
-        APP_ABORT("Error in SlaterDetBuilder::createMSDFast for ptcl group "
-                  << grp << ", problems with ci configuration list. \n");
-      }
-    }
     // reorder unique determinants for a given spin based on the selected reference determinant
-    dets[grp]->createDetData(C2nodes[grp][refdet_id], list, C2nodes[grp], C2nodes_sorted[grp]);
+    dets[grp]->createDetData(C2nodes[grp][refdet_id], uniqueConfgs[grp], C2nodes[grp], C2nodes_sorted[grp]);
   }
 
   if (csf_data_ptr && csf_data_ptr->coeffs.size() == 1)
@@ -993,7 +1033,7 @@ bool SlaterDetBuilder::readDetList(xmlNodePtr cur,
 }
 
 bool SlaterDetBuilder::readDetListH5(xmlNodePtr cur,
-                                     std::vector<std::vector<ci_configuration>>& uniqueConfgs,
+                                     std::vector<PackedDetList>& uniqueConfgs,
                                      std::vector<std::vector<size_t>>& C2nodes,
                                      std::vector<std::string>& CItags,
                                      std::vector<ValueType>& coeff,
@@ -1003,17 +1043,10 @@ bool SlaterDetBuilder::readDetListH5(xmlNodePtr cur,
   bool success = true;
   int extlevel(0);
   const int nGroups = uniqueConfgs.size();
-  for (int grp = 0; grp < nGroups; grp++)
-  {
-    uniqueConfgs[grp].clear();
-    C2nodes[grp].clear();
-  }
   CItags.clear();
   coeff.clear();
   std::string CICoeffH5path("");
-  std::vector<std::vector<ci_configuration>> confgLists(nGroups);
   std::vector<ValueType> CIcoeff;
-  std::vector<std::string> ConfigTag;
   std::string optCI = "no";
   RealType cutoff   = 0.0;
   OhmmsAttributeSet ciAttrib;
@@ -1099,7 +1132,6 @@ bool SlaterDetBuilder::readDetListH5(xmlNodePtr cur,
 
   hin.read(N_int, "Nbits");
   CIcoeff.resize(ndets);
-  ConfigTag.resize(ndets);
 
   readCoeffs(hin, CIcoeff, ndets, extlevel);
 
@@ -1138,95 +1170,27 @@ bool SlaterDetBuilder::readDetListH5(xmlNodePtr cur,
               << " Optimized coefficients were substituted to the original set of coefficients." << std::endl;
   }
 
-  std::vector<Matrix<int64_t>> temps;
-  for (int grp = 0; grp < nGroups; grp++)
-  {
-    Matrix<int64_t> tmp(ndets, N_int);
-    temps.push_back(tmp);
-    std::string ci_str;
-
-    if (!hin.readEntry(temps[grp], "CI_" + std::to_string(grp)))
-    {
-      //for backwards compatibility
-      if (grp == 0)
-        hin.read(temps[grp], "CI_Alpha");
-      else if (grp == 1)
-        hin.read(temps[grp], "CI_Beta");
-      else
-        APP_ABORT("Unknown HDF5 CI format");
-    }
-  }
-
-  std::vector<std::string> MyCIs(nGroups);
-  std::vector<ci_configuration> dummyCs(nGroups);
-  for (int grp = 0; grp < nGroups; grp++)
-  {
-    MyCIs[grp].resize(nstates);
-    dummyCs[grp].occup.resize(nstates, false);
-    for (size_t i = 0; i < nstates; i++)
-      dummyCs[grp].occup[i] = true;
-  }
-
-  hin.close();
-  app_log() << " Done reading " << ndets << " CIs from H5!" << std::endl;
-
-  std::vector<int> cnts(nGroups, 0);
-  std::vector<std::unordered_map<std::string, int>> MyMaps(nGroups);
-
-  app_log() << " Sorting unique CIs" << std::endl;
-  ///This loop will find all unique Determinants in and store them "unsorted" in a new container uniqueConfg_up
-  ///and uniqueConfg_dn. The sorting is not done here
-  for (int ni = 0; ni < ndets; ni++)
+  ///the cutoff filter is applied before the determinants are read, only the selected ones are hashed
+  std::vector<size_t> selected;
+  for (size_t ni = 0; ni < ndets; ni++)
   {
     if (std::abs(CIcoeff[ni]) < cutoff)
       continue;
-
-    int j = 0;
-    for (int k = 0; k < N_int; k++)
-    {
-      std::vector<std::bitset<bit_kind>> a2s(nGroups);
-      for (int grp = 0; grp < nGroups; grp++)
-      {
-        int64_t a = temps[grp][ni][k];
-        a2s[grp]  = a;
-      }
-
-      for (int i = 0; i < bit_kind; i++)
-      {
-        if (j < nstates)
-        {
-          for (int grp = 0; grp < nGroups; grp++)
-            MyCIs[grp][j] = a2s[grp][i] ? '1' : '0';
-          j++;
-        }
-      }
-    }
+    selected.push_back(ni);
     coeff.push_back(CIcoeff[ni]);
-    std::ostringstream h5tag;
-    h5tag << "CIcoeff_" << ni;
-    CItags.push_back(h5tag.str());
-
-    for (int grp = 0; grp < nGroups; grp++)
-    {
-      std::unordered_map<std::string, int>::const_iterator got = MyMaps[grp].find(MyCIs[grp]);
-
-      if (got == MyMaps[grp].end())
-      {
-        uniqueConfgs[grp].push_back(dummyCs[grp]);
-        uniqueConfgs[grp].back().add_occupation(MyCIs[grp]);
-        C2nodes[grp].push_back(cnts[grp]);
-        MyMaps[grp].insert(std::pair<std::string, int>(MyCIs[grp], cnts[grp]));
-        cnts[grp]++;
-      }
-      else
-      {
-        C2nodes[grp].push_back(got->second);
-      }
-    }
+    ///the tags are only needed by optimizable coefficients, skip them for large expansions otherwise
+    if (optimizeCI)
+      CItags.push_back("CIcoeff_" + std::to_string(ni));
     sumsq += CIcoeff[ni] * CIcoeff[ni];
   }
 
-  app_log() << " Done Sorting unique CIs" << std::endl;
+  app_log() << " Reading and sorting unique CIs" << std::endl;
+  /// number of determinants per hyperslab read, 1MB per group and 64-bit word
+  constexpr size_t det_chunk_size = 1 << 17;
+  readPackedDetList(hin, ndets, N_int, nstates, selected, det_chunk_size, uniqueConfgs, C2nodes);
+  hin.close();
+  app_log() << " Done reading " << ndets << " CIs from H5!" << std::endl;
+
   app_log() << "Found " << coeff.size() << " terms in the MSD expansion.\n";
   app_log() << "Norm of ci vector (sum of ci^2): " << sumsq << std::endl;
 
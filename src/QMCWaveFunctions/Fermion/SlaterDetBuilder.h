@@ -20,6 +20,7 @@
 #include "Configuration.h"
 #include "WaveFunctionComponentBuilder.h"
 #include <hdf/hdf_archive.h>
+#include "QMCWaveFunctions/Fermion/PackedDetList.h"
 
 namespace qmcplusplus
 {
@@ -94,7 +95,7 @@ private:
                    std::unique_ptr<CSFData>& csf_data_ptr) const;
 
   bool readDetListH5(xmlNodePtr cur,
-                     std::vector<std::vector<ci_configuration>>& uniqueConfgs,
+                     std::vector<PackedDetList>& uniqueConfgs,
                      std::vector<std::vector<size_t>>& C2nodes,
                      std::vector<std::string>& CItags,
                      std::vector<ValueType>& coeff,
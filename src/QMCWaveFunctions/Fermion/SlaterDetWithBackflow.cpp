@@ -45,6 +45,83 @@ void SlaterDetWithBackflow::evaluateRatiosAlltoOne(ParticleSet& P, std::vector<V
     Dets[i]->evaluateRatiosAlltoOne(P, ratios);
 }
 
+void SlaterDetWithBackflow::mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                         const RefVectorWithLeader<ParticleSet>& p_list,
+                                         int iat,
+                                         std::vector<PsiValueType>& ratios) const
+{
+  BFTrans->mw_evaluatePbyP(extract_BF_list(wfc_list), p_list, iat, false);
+  std::fill(ratios.begin(), ratios.end(), PsiValueType(1));
+  std::vector<PsiValueType> det_ratios(wfc_list.size());
+  for (int i = 0; i < Dets.size(); ++i)
+  {
+    Dets[i]->mw_calcRatio(extract_DetRef_list(wfc_list, i), p_list, iat, det_ratios);
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+      ratios[iw] *= det_ratios[iw];
+  }
+}
+
+void SlaterDetWithBackflow::mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                         const RefVectorWithLeader<ParticleSet>& p_list,
+                                         int iat,
+                                         std::vector<PsiValueType>& ratios,
+                                         std::vector<GradType>& grad_new) const
+{
+  BFTrans->mw_evaluatePbyP(extract_BF_list(wfc_list), p_list, iat, true);
+  std::fill(ratios.begin(), ratios.end(), PsiValueType(1));
+  std::vector<PsiValueType> det_ratios(wfc_list.size());
+  for (int i = 0; i < Dets.size(); ++i)
+  {
+    Dets[i]->mw_ratioGrad(extract_DetRef_list(wfc_list, i), p_list, iat, det_ratios, grad_new);
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+      ratios[iw] *= det_ratios[iw];
+  }
+}
+
+void SlaterDetWithBackflow::mw_accept_rejectMove(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                                 const RefVectorWithLeader<ParticleSet>& p_list,
+                                                 int iat,
+                                                 const std::vector<bool>& isAccepted,
+                                                 bool safe_to_delay) const
+{
+  BFTrans->mw_accept_rejectMove(extract_BF_list(wfc_list), p_list, iat, isAccepted);
+  for (int iw = 0; iw < wfc_list.size(); iw++)
+    if (isAccepted[iw])
+      wfc_list.getCastedElement<SlaterDetWithBackflow>(iw).log_value_ = 0.0;
+  // every determinant depends on all the quasi-particles
+  for (int i = 0; i < Dets.size(); ++i)
+  {
+    const auto Det_list(extract_DetRef_list(wfc_list, i));
+    Dets[i]->mw_accept_rejectMove(Det_list, p_list, iat, isAccepted, safe_to_delay);
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+      if (isAccepted[iw])
+        wfc_list.getCastedElement<SlaterDetWithBackflow>(iw).log_value_ += Det_list[iw].get_log_value();
+  }
+}
+
+void SlaterDetWithBackflow::createResource(ResourceCollection& collection) const
+{
+  BFTrans->createResource(collection);
+  for (int i = 0; i < Dets.size(); ++i)
+    Dets[i]->createResource(collection);
+}
+
+void SlaterDetWithBackflow::acquireResource(ResourceCollection& collection,
+                                            const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+{
+  BFTrans->acquireResource(collection, extract_BF_list(wfc_list));
+  for (int i = 0; i < Dets.size(); ++i)
+    Dets[i]->acquireResource(collection, extract_DetRef_list(wfc_list, i));
+}
+
+void SlaterDetWithBackflow::releaseResource(ResourceCollection& collection,
+                                            const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+{
+  BFTrans->releaseResource(collection, extract_BF_list(wfc_list));
+  for (int i = 0; i < Dets.size(); ++i)
+    Dets[i]->releaseResource(collection, extract_DetRef_list(wfc_list, i));
+}
+
 SlaterDetWithBackflow::LogValueType SlaterDetWithBackflow::evaluateLog(const ParticleSet& P,
                                                                        ParticleSet::ParticleGradient& G,
                                                                        ParticleSet::ParticleLaplacian& L)
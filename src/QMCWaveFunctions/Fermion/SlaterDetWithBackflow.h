@@ -90,6 +90,12 @@ public:
     return psi;
   }
 
+  void mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValueType>& ratios,
+                    std::vector<GradType>& grad_new) const override;
+
   GradType evalGrad(ParticleSet& P, int iat) override
   {
     QMCTraits::GradType g;
@@ -121,6 +127,12 @@ public:
       Dets[i]->acceptMove(P, iat);
   }
 
+  void mw_accept_rejectMove(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                            const RefVectorWithLeader<ParticleSet>& p_list,
+                            int iat,
+                            const std::vector<bool>& isAccepted,
+                            bool safe_to_delay = false) const override;
+
   inline void restore(int iat) override
   {
     BFTrans->restore(iat);
@@ -139,6 +151,17 @@ public:
     return ratio;
   }
 
+  void mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValueType>& ratios) const override;
+
+  void createResource(ResourceCollection& collection) const override;
+  void acquireResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override;
+  void releaseResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override;
+
   std::unique_ptr<WaveFunctionComponent> makeClone(ParticleSet& tqp) const override;
 
   SPOSetPtr getPhi(int i = 0) const { return Dets[i]->getPhi(); }
@@ -157,6 +180,28 @@ private:
   const std::vector<std::unique_ptr<Determinant_t>> Dets;
   /// backflow transformation
   const std::unique_ptr<BackflowTransformation> BFTrans;
+
+  RefVectorWithLeader<WaveFunctionComponent> extract_DetRef_list(
+      const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+      int det_id) const
+  {
+    RefVectorWithLeader<WaveFunctionComponent> Det_list(
+        *wfc_list.getCastedLeader<SlaterDetWithBackflow>().Dets[det_id]);
+    Det_list.reserve(wfc_list.size());
+    for (WaveFunctionComponent& wfc : wfc_list)
+      Det_list.push_back(*static_cast<SlaterDetWithBackflow&>(wfc).Dets[det_id]);
+    return Det_list;
+  }
+
+  RefVectorWithLeader<BackflowTransformation> extract_BF_list(
+      const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+  {
+    RefVectorWithLeader<BackflowTransformation> bf_list(*wfc_list.getCastedLeader<SlaterDetWithBackflow>().BFTrans);
+    bf_list.reserve(wfc_list.size());
+    for (WaveFunctionComponent& wfc : wfc_list)
+      bf_list.push_back(*static_cast<SlaterDetWithBackflow&>(wfc).BFTrans);
+    return bf_list;
+  }
 };
 } // namespace qmcplusplus
 #endif
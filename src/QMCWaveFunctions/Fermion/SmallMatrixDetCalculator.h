@@ -156,8 +156,8 @@ template<>
 class CustomizedMatrixDet<1>
 {
 public:
-  template<typename VALUE>
-  static VALUE evaluate(const VALUE* table_matrix, const int* it, const size_t nb_cols)
+  template<typename VALUE, typename INDEX>
+  static VALUE evaluate(const VALUE* table_matrix, const INDEX* it, const size_t nb_cols)
   {
     const int i = *it;
     const int a = *(it + 1);
@@ -170,8 +170,8 @@ template<>
 class CustomizedMatrixDet<2>
 {
 public:
-  template<typename VALUE>
-  static VALUE evaluate(const VALUE* table_matrix, const int* it, const size_t nb_cols)
+  template<typename VALUE, typename INDEX>
+  static VALUE evaluate(const VALUE* table_matrix, const INDEX* it, const size_t nb_cols)
   {
     const int i = *it;
     const int j = *(it + 1);
@@ -189,8 +189,8 @@ template<>
 class CustomizedMatrixDet<3>
 {
 public:
-  template<typename VALUE>
-  static VALUE evaluate(const VALUE* table_matrix, const int* it, const size_t nb_cols)
+  template<typename VALUE, typename INDEX>
+  static VALUE evaluate(const VALUE* table_matrix, const INDEX* it, const size_t nb_cols)
   {
     const int i1 = *it;
     const int i2 = *(it + 1);
@@ -214,8 +214,8 @@ template<>
 class CustomizedMatrixDet<4>
 {
 public:
-  template<typename VALUE>
-  static VALUE evaluate(const VALUE* table_matrix, const int* it, const size_t nb_cols)
+  template<typename VALUE, typename INDEX>
+  static VALUE evaluate(const VALUE* table_matrix, const INDEX* it, const size_t nb_cols)
   {
     const int i1 = *it;
     const int i2 = *(it + 1);
@@ -248,8 +248,8 @@ template<>
 class CustomizedMatrixDet<5>
 {
 public:
-  template<typename VALUE>
-  static VALUE evaluate(const VALUE* table_matrix, const int* it, const size_t nb_cols)
+  template<typename VALUE, typename INDEX>
+  static VALUE evaluate(const VALUE* table_matrix, const INDEX* it, const size_t nb_cols)
   {
     const int i1 = *it;
     const int i2 = *(it + 1);
@@ -278,8 +278,8 @@ public:
   }
 };
 
-template<typename VALUE>
-inline VALUE calcSmallDeterminant(size_t n, const VALUE* table_matrix, const int* it, const size_t nb_cols)
+template<typename VALUE, typename INDEX>
+inline VALUE calcSmallDeterminant(size_t n, const VALUE* table_matrix, const INDEX* it, const size_t nb_cols)
 {
   switch (n)
   {
@@ -318,15 +318,43 @@ public:
     std::fill(Lgrad_t.begin(), Lgrad_t.end(), 0);
     std::fill(Llap_t.begin(), Llap_t.end(), 0);
 
-    Lmax_t = Lmax[iat];
-    Nval_t = 0;
     // temporary variables
     for (int I = 0; I < num_regions; ++I)
-    {
       C[I]->evaluateLog(P.getActivePos(), Lval_t[I], Lgrad_t[I], Llap_t[I]);
+    normalizeTemp(iat);
+  }
+
+  /** evaluateTemp of a crowd
+   * @param region_list the regions of all the walkers, this is the one of the leader walker
+   * @param p_list the particle sets of all the walkers
+   * @param iat moved particle
+   *
+   * The counting functions are shared by the walkers, each one of the leader is evaluated
+   * at the proposed positions of all the walkers before moving to the next one.
+   */
+  void mw_evaluateTemp(const RefVector<CountingGaussianRegion>& region_list,
+                       const RefVectorWithLeader<ParticleSet>& p_list,
+                       int iat) const
+  {
+    const int nw = region_list.size();
+    for (int I = 0; I < num_regions; ++I)
+      for (int iw = 0; iw < nw; ++iw)
+      {
+        CountingGaussianRegion& region = region_list[iw];
+        C[I]->evaluateLog(p_list[iw].getActivePos(), region.Lval_t[I], region.Lgrad_t[I], region.Llap_t[I]);
+      }
+    for (int iw = 0; iw < nw; ++iw)
+      region_list[iw].get().normalizeTemp(iat);
+  }
+
+  // build the temporary value arrays from Lval_t, Lgrad_t and Llap_t of the proposed move of iat
+  void normalizeTemp(int iat)
+  {
+    Lmax_t = Lmax[iat];
+    Nval_t = 0;
+    for (int I = 0; I < num_regions; ++I)
       if (Lval_t[I] > Lmax_t)
         Lmax_t = Lval_t[I];
-    }
     // build counting function values; subtract off largest log value
     for (int I = 0; I < num_regions; ++I)
     {
@@ -302,6 +302,12 @@ public:
   {
     // evaluate temporary counting regions
     C->evaluateTemp(P, iat);
+    evaluateTempExponentsFromRegions(P, iat);
+  }
+
+  // temporary exponents of the proposed move of iat once the temporary counting regions are evaluated
+  void evaluateTempExponentsFromRegions(ParticleSet& P, int iat)
+  {
     Jval_t = 0;
     std::fill(Jgrad_t.begin(), Jgrad_t.end(), 0);
     std::fill(Jlap_t.begin(), Jlap_t.end(), 0);
@@ -383,6 +389,47 @@ public:
     return std::exp(static_cast<PsiValueType>(Jval_t - Jval));
   }
 
+  void mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValueType>& ratios) const override
+  {
+    mw_ratio_impl(wfc_list, p_list, iat, ratios, nullptr);
+  }
+
+  void mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValueType>& ratios,
+                    std::vector<GradType>& grad_new) const override
+  {
+    mw_ratio_impl(wfc_list, p_list, iat, ratios, &grad_new);
+  }
+
+  // mw_calcRatio and mw_ratioGrad, the counting regions of all the walkers are evaluated by the leader in one pass
+  void mw_ratio_impl(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                     const RefVectorWithLeader<ParticleSet>& p_list,
+                     int iat,
+                     std::vector<PsiValueType>& ratios,
+                     std::vector<GradType>* grad_new) const
+  {
+    assert(this == &wfc_list.getLeader());
+    const int nw = wfc_list.size();
+    RefVector<RegionType> region_list;
+    region_list.reserve(nw);
+    for (int iw = 0; iw < nw; ++iw)
+      region_list.push_back(*wfc_list.template getCastedElement<CountingJastrow>(iw).C);
+    C->mw_evaluateTemp(region_list, p_list, iat);
+    for (int iw = 0; iw < nw; ++iw)
+    {
+      auto& wfc = wfc_list.template getCastedElement<CountingJastrow>(iw);
+      wfc.evaluateTempExponentsFromRegions(p_list[iw], iat);
+      ratios[iw] = std::exp(static_cast<PsiValueType>(wfc.Jval_t - wfc.Jval));
+      if (grad_new)
+        (*grad_new)[iw] += wfc.Jgrad_t[iat];
+    }
+  }
+
   void acceptMove(ParticleSet& P, int iat, bool safe_to_delay = false) override
   {
     C->acceptMove(P, iat);
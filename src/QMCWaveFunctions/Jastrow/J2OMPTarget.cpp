@@ -275,7 +275,15 @@ typename J2OMPTarget<FT>::LogValueType J2OMPTarget<FT>::updateBuffer(ParticleSet
                                                                      bool fromscratch)
 {
   log_value_ = computeGL(P.G, P.L);
-  buf.forward(Bytes_in_WFBuffer);
+  // Uat, dUat and d2Uat no longer live in buf after the multi walker resource was acquired and released.
+  if (reinterpret_cast<char*>(Uat.data()) != buf.data() + buf.current())
+  {
+    buf.put(Uat.begin(), Uat.end());
+    buf.put(dUat.data(), dUat.end());
+    buf.put(d2Uat.begin(), d2Uat.end());
+  }
+  else
+    buf.forward(Bytes_in_WFBuffer);
   return log_value_;
 }
 
@@ -173,10 +173,37 @@ typename J2OrbitalSoA<FT>::posT J2OrbitalSoA<FT>::accumulateG(const valT* restri
   return grad;
 }
 
+template<typename FT>
+typename J2OrbitalSoA<FT>::valT J2OrbitalSoA<FT>::computeNeighborU3(const ParticleSet& P,
+                                                                   int iat,
+                                                                   const std::vector<int>& ids,
+                                                                   const DistRow& dist,
+                                                                   valT* restrict u,
+                                                                   valT* restrict du,
+                                                                   valT* restrict d2u)
+{
+  const int igt = P.GroupID[iat] * NumGroups;
+  valT sumU(0);
+  for (int k = 0; k < ids.size(); ++k)
+  {
+    const int jat = ids[k];
+    if (jat == iat)
+    {
+      u[k] = du[k] = d2u[k] = valT(0);
+      continue;
+    }
+    u[k] = F[igt + P.GroupID[jat]]->evaluate(dist[k], du[k], d2u[k]);
+    du[k] /= dist[k];
+    sumU += u[k];
+  }
+  return sumU;
+}
+
 template<typename FT>
 J2OrbitalSoA<FT>::J2OrbitalSoA(const std::string& obj_name, ParticleSet& p)
     : WaveFunctionComponent("J2OrbitalSoA", obj_name),
       my_table_ID_(p.addTable(p, DTModes::NEED_TEMP_DATA_ON_HOST | DTModes::NEED_VP_FULL_TABLE_ON_HOST)),
+      neighbor_cutoff_(p.getDistTableAA(my_table_ID_).getNeighborCutoff()),
       j2_ke_corr_helper(p, F)
 {
   if (myName.empty())
@@ -214,6 +241,10 @@ void J2OrbitalSoA<FT>::addFunc(int ia, int ib, std::unique_ptr<FT> j)
 {
   assert(ia < NumGroups);
   assert(ib < NumGroups);
+  if (neighbor_cutoff_ > 0 && (j->cutoff_radius <= 0 || j->cutoff_radius > neighbor_cutoff_))
+    throw std::runtime_error("J2OrbitalSoA the cutoff radius " + std::to_string(j->cutoff_radius) +
+                             " of a two-body function must be positive and not larger than the neighbor cutoff " +
+                             std::to_string(neighbor_cutoff_) + " of the e-e distance table.");
   if (ia == ib)
   {
     if (ia == 0) //first time, assign everything
@@ -312,8 +343,13 @@ template<typename FT>
 typename J2OrbitalSoA<FT>::PsiValueType J2OrbitalSoA<FT>::ratio(ParticleSet& P, int iat)
 {
   //only ratio, ready to compute it again
-  UpdateMode = ORB_PBYP_RATIO;
-  cur_Uat    = computeU(P, iat, P.getDistTableAA(my_table_ID_).getTempDists());
+  UpdateMode          = ORB_PBYP_RATIO;
+  const auto& d_table = P.getDistTableAA(my_table_ID_);
+  if (neighbor_cutoff_ > 0)
+    cur_Uat = computeNeighborU3(P, iat, d_table.getTempNeighbors(), d_table.getTempNeighborDists(), cur_u.data(),
+                                cur_du.data(), cur_d2u.data());
+  else
+    cur_Uat = computeU(P, iat, d_table.getTempDists());
   return std::exp(static_cast<PsiValueType>(Uat[iat] - cur_Uat));
 }
 
@@ -321,8 +357,31 @@ template<typename FT>
 void J2OrbitalSoA<FT>::evaluateRatiosAlltoOne(ParticleSet& P, std::vector<ValueType>& ratios)
 {
   const auto& d_table = P.getDistTableAA(my_table_ID_);
-  const auto& dist    = d_table.getTempDists();
+  if (neighbor_cutoff_ > 0)
+  {
+    // only the particles within the cutoff of the new position contribute
+    const auto& ids  = d_table.getTempNeighbors();
+    const auto& dist = d_table.getTempNeighborDists();
+    for (int ig = 0; ig < NumGroups; ++ig)
+    {
+      const int igt = ig * NumGroups;
+      valT sumU(0);
+      for (int k = 0; k < ids.size(); ++k)
+        sumU += F[igt + P.GroupID[ids[k]]]->evaluate(dist[k]);
+      for (int i = P.first(ig); i < P.last(ig); ++i)
+        ratios[i] = std::exp(Uat[i] - sumU);
+    }
+    // remove self-interaction
+    for (int k = 0; k < ids.size(); ++k)
+    {
+      const int i  = ids[k];
+      const int ig = P.GroupID[i];
+      ratios[i] *= std::exp(F[ig * NumGroups + ig]->evaluate(dist[k]));
+    }
+    return;
+  }
 
+  const auto& dist = d_table.getTempDists();
   for (int ig = 0; ig < NumGroups; ++ig)
   {
     const int igt = ig * NumGroups;
@@ -355,16 +414,35 @@ typename J2OrbitalSoA<FT>::PsiValueType J2OrbitalSoA<FT>::ratioGrad(ParticleSet&
 {
   UpdateMode = ORB_PBYP_PARTIAL;
 
-  computeU3(P, iat, P.getDistTableAA(my_table_ID_).getTempDists(), cur_u.data(), cur_du.data(), cur_d2u.data());
-  cur_Uat = simd::accumulate_n(cur_u.data(), N, valT());
+  const auto& d_table = P.getDistTableAA(my_table_ID_);
+  if (neighbor_cutoff_ > 0)
+  {
+    const auto& ids   = d_table.getTempNeighbors();
+    const auto& displ = d_table.getTempNeighborDispls();
+    cur_Uat           = computeNeighborU3(P, iat, ids, d_table.getTempNeighborDists(), cur_u.data(), cur_du.data(),
+                                          cur_d2u.data());
+    for (int k = 0; k < ids.size(); ++k)
+      grad_iat += cur_du[k] * displ[k];
+  }
+  else
+  {
+    computeU3(P, iat, d_table.getTempDists(), cur_u.data(), cur_du.data(), cur_d2u.data());
+    cur_Uat = simd::accumulate_n(cur_u.data(), N, valT());
+    grad_iat += accumulateG(cur_du.data(), d_table.getTempDispls());
+  }
   DiffVal = Uat[iat] - cur_Uat;
-  grad_iat += accumulateG(cur_du.data(), P.getDistTableAA(my_table_ID_).getTempDispls());
   return std::exp(static_cast<PsiValueType>(DiffVal));
 }
 
 template<typename FT>
 void J2OrbitalSoA<FT>::acceptMove(ParticleSet& P, int iat, bool safe_to_delay)
 {
+  if (neighbor_cutoff_ > 0)
+  {
+    acceptMoveNeighbors(P, iat);
+    return;
+  }
+
   // get the old u, du, d2u
   const auto& d_table = P.getDistTableAA(my_table_ID_);
   computeU3(P, iat, d_table.getOldDists(), old_u.data(), old_du.data(), old_d2u.data());
@@ -413,6 +491,51 @@ void J2OrbitalSoA<FT>::acceptMove(ParticleSet& P, int iat, bool safe_to_delay)
   d2Uat[iat] = cur_d2Uat;
 }
 
+template<typename FT>
+void J2OrbitalSoA<FT>::acceptMoveNeighbors(ParticleSet& P, int iat)
+{
+  // cur_u, cur_du, cur_d2u were computed over the new neighbors by ratio or ratioGrad
+  const auto& d_table = P.getDistTableAA(my_table_ID_);
+  const auto& old_ids = d_table.getOldNeighbors();
+  const auto& new_ids = d_table.getTempNeighbors();
+  const auto& old_dr  = d_table.getOldNeighborDispls();
+  const auto& new_dr  = d_table.getTempNeighborDispls();
+  computeNeighborU3(P, iat, old_ids, d_table.getOldNeighborDists(), old_u.data(), old_du.data(), old_d2u.data());
+
+  constexpr valT lapfac = OHMMS_DIM - RealType(1);
+  for (int k = 0; k < old_ids.size(); ++k)
+  {
+    const int jat = old_ids[k];
+    Uat[jat] -= old_u[k];
+    d2Uat[jat] += old_d2u[k] + lapfac * old_du[k];
+    for (int idim = 0; idim < OHMMS_DIM; ++idim)
+      dUat.data(idim)[jat] += old_du[k] * old_dr.data(idim)[k];
+  }
+
+  valT cur_d2Uat(0);
+  posT cur_dUat;
+  for (int k = 0; k < new_ids.size(); ++k)
+  {
+    const int jat = new_ids[k];
+    if (jat == iat)
+      continue;
+    const valT newl = cur_d2u[k] + lapfac * cur_du[k];
+    Uat[jat] += cur_u[k];
+    d2Uat[jat] -= newl;
+    cur_d2Uat -= newl;
+    for (int idim = 0; idim < OHMMS_DIM; ++idim)
+    {
+      const valT newg = cur_du[k] * new_dr.data(idim)[k];
+      dUat.data(idim)[jat] -= newg;
+      cur_dUat[idim] += newg;
+    }
+  }
+  log_value_ += Uat[iat] - cur_Uat;
+  Uat[iat]   = cur_Uat;
+  dUat(iat)  = cur_dUat;
+  d2Uat[iat] = cur_d2Uat;
+}
+
 template<typename FT>
 void J2OrbitalSoA<FT>::recompute(const ParticleSet& P)
 {
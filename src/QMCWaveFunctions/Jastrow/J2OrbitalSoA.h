@@ -93,6 +93,8 @@ protected:
   std::vector<FT*> F;
   /// e-e table ID
   const int my_table_ID_;
+  /// cutoff of the neighbor lists of the e-e table, 0 if the table is dense
+  RealType neighbor_cutoff_;
   // helper for compute J2 Chiesa KE correction
   J2KECorrection<RealType, FT> j2_ke_corr_helper;
 
@@ -127,6 +129,21 @@ protected:
   /** compute gradient
    */
   posT accumulateG(const valT* restrict du, const DisplRow& displ) const;
+
+  /** compute u, du/r and d2u of the pairs in a neighbor list of the e-e table
+   * @param ids particles of the neighbor list, the pair with iat itself is skipped
+   * @return \f$\sum_j u(r_j)\f$
+   */
+  valT computeNeighborU3(const ParticleSet& P,
+                         int iat,
+                         const std::vector<int>& ids,
+                         const DistRow& dist,
+                         valT* restrict u,
+                         valT* restrict du,
+                         valT* restrict d2u);
+
+  /// acceptMove using the neighbor lists of the e-e table
+  void acceptMoveNeighbors(ParticleSet& P, int iat);
   /**@} */
 
 public:
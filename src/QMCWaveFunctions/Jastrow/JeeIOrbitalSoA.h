@@ -19,12 +19,64 @@
 #include "Particle/DistanceTable.h"
 #include "CPU/SIMD/aligned_allocator.hpp"
 #include "CPU/SIMD/algorithm.hpp"
+#include "ResourceCollection.h"
+#include <ResourceHandle.h>
 #include <map>
 #include <numeric>
 #include <memory>
 
 namespace qmcplusplus
 {
+/** scratch space of the batched JeeIOrbitalSoA APIs, owned by the crowd leader
+ *
+ * The compressed e-e-I triplets of all the walkers are packed back to back
+ * so that a functor is evaluated only once per crowd over the triplets of all the walkers.
+ * The triplets of walker iw occupy [offsets[iw], offsets[iw+1]).
+ */
+template<typename T>
+struct JeeIOrbitalSoAMultiWalkerMem : public Resource
+{
+  using gContainer_type = VectorSoaContainer<T, OHMMS_DIM>;
+  /// compressed distances
+  aligned_vector<T> Distjk_Compressed, DistkI_Compressed, DistjI_Compressed;
+  /// compressed displacements
+  gContainer_type Disp_jk_Compressed, Disp_jI_Compressed, Disp_kI_Compressed;
+  /// the index of the k electron of each triplet
+  std::vector<int> DistIndice_k;
+  /// the contribution of each triplet to the gradient of the j electron along one direction
+  aligned_vector<T> dUj_comp;
+  /// work result buffer
+  VectorSoaContainer<T, 9> mVGL;
+  /// the range of the triplets of each walker
+  std::vector<int> offsets;
+  /// the walkers taking part in the current batched evaluation
+  std::vector<bool> active;
+  /// accumulated value, gradient and laplacian of the j electron of each walker
+  std::vector<T> Uj, d2Uj;
+  std::vector<TinyVector<T, OHMMS_DIM>> dUj;
+
+  void resize(size_t n)
+  {
+    if (mVGL.size() >= n)
+      return;
+    Distjk_Compressed.resize(n);
+    DistkI_Compressed.resize(n);
+    DistjI_Compressed.resize(n);
+    Disp_jk_Compressed.resize(n);
+    Disp_jI_Compressed.resize(n);
+    Disp_kI_Compressed.resize(n);
+    DistIndice_k.resize(n);
+    dUj_comp.resize(n);
+    mVGL.resize(n);
+  }
+
+  JeeIOrbitalSoAMultiWalkerMem() : Resource("JeeIOrbitalSoAMultiWalkerMem") {}
+
+  JeeIOrbitalSoAMultiWalkerMem(const JeeIOrbitalSoAMultiWalkerMem&) : JeeIOrbitalSoAMultiWalkerMem() {}
+
+  Resource* makeClone() const override { return new JeeIOrbitalSoAMultiWalkerMem(*this); }
+};
+
 /** @ingroup WaveFunctionComponent
  *  @brief Specialization for three-body Jastrow function using multiple functors
  *
@@ -99,6 +151,9 @@ class JeeIOrbitalSoA : public WaveFunctionComponent
   Array<PosType, 2> gradLogPsi;
   Array<RealType, 2> lapLogPsi;
 
+  /// scratch space of the batched APIs
+  ResourceHandle<JeeIOrbitalSoAMultiWalkerMem<valT>> mw_mem_;
+
   // Temporary store for parameter derivatives of functor
   // The first index is the functor index in J3Unique.  The second is the parameter index w.r.t. to that
   // functor
@@ -153,6 +208,8 @@ public:
   {
     if (myName.empty())
       throw std::runtime_error("JeeIOrbitalSoA object name cannot be empty!");
+    if (elecs.getDistTableAA(ee_Table_ID_).getNeighborCutoff() > 0)
+      throw std::runtime_error("JeeIOrbitalSoA doesn't support the neighbor lists of the e-e distance table!");
     init(elecs);
   }
 
@@ -490,6 +547,89 @@ public:
       computeU3(P, iat, eI_table.getTempDists(), eI_table.getTempDispls(), ee_table.getTempDists(),
                 ee_table.getTempDispls(), cur_Uat, cur_dUat, cur_d2Uat, newUk, newdUk, newd2Uk, ions_nearby_new);
     }
+    updateAccepted(P, iat);
+  }
+
+  /** batched ratioGrad.
+   * The proposed move of all the walkers are evaluated with the functors called once per crowd.
+   */
+  void mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValueType>& ratios,
+                    std::vector<GradType>& grad_new) const override
+  {
+    assert(this == &wfc_list.getLeader());
+    auto& mw_mem = wfc_list.getCastedLeader<JeeIOrbitalSoA<FT>>().getMWMem();
+    mw_mem.active.assign(wfc_list.size(), true);
+    mw_computeU3(wfc_list, p_list, iat, mw_mem.active, true);
+
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+    {
+      auto& eeI      = wfc_list.getCastedElement<JeeIOrbitalSoA<FT>>(iw);
+      eeI.UpdateMode = ORB_PBYP_PARTIAL;
+      eeI.DiffVal    = eeI.Uat[iat] - eeI.cur_Uat;
+      grad_new[iw] += eeI.cur_dUat;
+      ratios[iw] = std::exp(static_cast<PsiValueType>(eeI.DiffVal));
+    }
+  }
+
+  /** batched acceptMove and restore.
+   * The current values of the accepted walkers are evaluated with the functors called once per crowd.
+   */
+  void mw_accept_rejectMove(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                            const RefVectorWithLeader<ParticleSet>& p_list,
+                            int iat,
+                            const std::vector<bool>& isAccepted,
+                            bool safe_to_delay = false) const override
+  {
+    assert(this == &wfc_list.getLeader());
+    auto& mw_mem = wfc_list.getCastedLeader<JeeIOrbitalSoA<FT>>().getMWMem();
+    // ratio-only during the move; need to compute derivatives
+    mw_mem.active.assign(wfc_list.size(), false);
+    bool need_new = false;
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+      if (isAccepted[iw] && wfc_list[iw].UpdateMode == ORB_PBYP_RATIO)
+        mw_mem.active[iw] = need_new = true;
+    if (need_new)
+      mw_computeU3(wfc_list, p_list, iat, mw_mem.active, true);
+
+    // get the old value, grad, lapl
+    mw_computeU3(wfc_list, p_list, iat, isAccepted, false);
+
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+      if (isAccepted[iw])
+        wfc_list.getCastedElement<JeeIOrbitalSoA<FT>>(iw).updateAccepted(p_list[iw], iat);
+  }
+
+  void createResource(ResourceCollection& collection) const override
+  {
+    collection.addResource(std::make_unique<JeeIOrbitalSoAMultiWalkerMem<valT>>());
+  }
+
+  void acquireResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override
+  {
+    auto& wfc_leader = wfc_list.getCastedLeader<JeeIOrbitalSoA<FT>>();
+    auto res_ptr     = dynamic_cast<JeeIOrbitalSoAMultiWalkerMem<valT>*>(collection.lendResource().release());
+    if (!res_ptr)
+      throw std::runtime_error("JeeIOrbitalSoA::acquireResource dynamic_cast failed");
+    wfc_leader.mw_mem_.reset(res_ptr);
+  }
+
+  void releaseResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override
+  {
+    auto& wfc_leader = wfc_list.getCastedLeader<JeeIOrbitalSoA<FT>>();
+    collection.takebackResource(std::move(wfc_leader.mw_mem_));
+  }
+
+  /** update the internal data after the move of iat is accepted.
+   * Requires the current values in Uat[iat], d2Uat[iat], old* and the new values in cur_*, new*.
+   */
+  void updateAccepted(const ParticleSet& P, int iat)
+  {
+    const auto& eI_table = P.getDistTableAB(ei_Table_ID_);
 
 #pragma omp simd
     for (int jel = 0; jel < Nelec; jel++)
@@ -812,6 +952,257 @@ public:
     }
   }
 
+  ///return the batched scratch space, allocated on the fly if no resource has been acquired
+  JeeIOrbitalSoAMultiWalkerMem<valT>& getMWMem()
+  {
+    // make this class unit tests friendly without the need of setup resources.
+    if (!mw_mem_)
+      mw_mem_ = std::make_unique<JeeIOrbitalSoAMultiWalkerMem<valT>>();
+    return *mw_mem_;
+  }
+
+  /** batched computeU3 of the iat-th electron for the walkers selected by isActive.
+   * The triplets of all the walkers sharing a functor are packed and evaluated in a single call.
+   * @param use_temp if true, evaluate at the proposed position and store the results in cur_* and new*.
+   *                 Otherwise, evaluate at the current position and store them in Uat[iat], d2Uat[iat] and old*.
+   */
+  void mw_computeU3(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    const std::vector<bool>& isActive,
+                    bool use_temp) const
+  {
+    constexpr valT czero(0);
+
+    auto& mw_mem = wfc_list.getCastedLeader<JeeIOrbitalSoA<FT>>().getMWMem();
+    const int nw = wfc_list.size();
+    const int jg = p_list.getLeader().GroupID[iat];
+    mw_mem.offsets.resize(nw + 1);
+    mw_mem.Uj.assign(nw, czero);
+    mw_mem.dUj.assign(nw, posT());
+    mw_mem.d2Uj.assign(nw, czero);
+
+    for (int iw = 0; iw < nw; iw++)
+    {
+      if (!isActive[iw])
+        continue;
+      auto& eeI            = wfc_list.getCastedElement<JeeIOrbitalSoA<FT>>(iw);
+      const auto& eI_table = p_list[iw].getDistTableAB(ei_Table_ID_);
+      const auto& distjI   = use_temp ? eI_table.getTempDists() : eI_table.getDistRow(iat);
+      auto& ions_nearby    = use_temp ? eeI.ions_nearby_new : eeI.ions_nearby_old;
+      ions_nearby.clear();
+      for (int jat = 0; jat < Nion; ++jat)
+        if (distjI[jat] < Ion_cutoff[jat])
+          ions_nearby.push_back(jat);
+
+      auto& Uk   = use_temp ? eeI.newUk : eeI.oldUk;
+      auto& dUk  = use_temp ? eeI.newdUk : eeI.olddUk;
+      auto& d2Uk = use_temp ? eeI.newd2Uk : eeI.oldd2Uk;
+      std::fill_n(Uk.data(), Nelec, czero);
+      std::fill_n(d2Uk.data(), Nelec, czero);
+      for (int idim = 0; idim < OHMMS_DIM; ++idim)
+        std::fill_n(dUk.data(idim), Nelec, czero);
+    }
+
+    for (int kg = 0; kg < eGroups; ++kg)
+      for (int ig = 0; ig < iGroups; ++ig)
+      {
+        if (F(ig, jg, kg) == nullptr)
+          continue;
+
+        // upper bound of the number of triplets
+        size_t max_triplets = 0;
+        for (int iw = 0; iw < nw; iw++)
+          if (isActive[iw])
+          {
+            const auto& eeI = wfc_list.getCastedElement<JeeIOrbitalSoA<FT>>(iw);
+            for (const int jat : use_temp ? eeI.ions_nearby_new : eeI.ions_nearby_old)
+              if (Ions.GroupID[jat] == ig)
+                max_triplets += eeI.elecs_inside(kg, jat).size();
+          }
+        if (max_triplets == 0)
+          continue;
+        mw_mem.resize(max_triplets);
+
+        int kel_counter = 0;
+        for (int iw = 0; iw < nw; iw++)
+        {
+          mw_mem.offsets[iw] = kel_counter;
+          if (!isActive[iw])
+            continue;
+          const auto& eeI      = wfc_list.getCastedElement<JeeIOrbitalSoA<FT>>(iw);
+          const auto& eI_table = p_list[iw].getDistTableAB(ei_Table_ID_);
+          const auto& ee_table = p_list[iw].getDistTableAA(ee_Table_ID_);
+          const auto& distjI   = use_temp ? eI_table.getTempDists() : eI_table.getDistRow(iat);
+          const auto& displjI  = use_temp ? eI_table.getTempDispls() : eI_table.getDisplRow(iat);
+          const auto& distjk   = use_temp ? ee_table.getTempDists() : ee_table.getOldDists();
+          const auto& displjk  = use_temp ? ee_table.getTempDispls() : ee_table.getOldDispls();
+          for (const int jat : use_temp ? eeI.ions_nearby_new : eeI.ions_nearby_old)
+          {
+            if (Ions.GroupID[jat] != ig)
+              continue;
+            const valT r_jI    = distjI[jat];
+            const posT disp_Ij = displjI[jat];
+            for (int kind = 0; kind < eeI.elecs_inside(kg, jat).size(); kind++)
+            {
+              const int kel = eeI.elecs_inside(kg, jat)[kind];
+              if (kel != iat)
+              {
+                mw_mem.DistkI_Compressed[kel_counter]  = eeI.elecs_inside_dist(kg, jat)[kind];
+                mw_mem.DistjI_Compressed[kel_counter]  = r_jI;
+                mw_mem.Distjk_Compressed[kel_counter]  = distjk[kel];
+                mw_mem.Disp_kI_Compressed(kel_counter) = eeI.elecs_inside_displ(kg, jat)[kind];
+                mw_mem.Disp_jI_Compressed(kel_counter) = disp_Ij;
+                mw_mem.Disp_jk_Compressed(kel_counter) = displjk[kel];
+                mw_mem.DistIndice_k[kel_counter]       = kel;
+                kel_counter++;
+              }
+            }
+          }
+        }
+        mw_mem.offsets[nw] = kel_counter;
+
+        if (kel_counter > 0)
+          mw_computeU3_engine(wfc_list, *F(ig, jg, kg), kel_counter, use_temp);
+      }
+
+    for (int iw = 0; iw < nw; iw++)
+    {
+      if (!isActive[iw])
+        continue;
+      auto& eeI = wfc_list.getCastedElement<JeeIOrbitalSoA<FT>>(iw);
+      if (use_temp)
+      {
+        eeI.cur_Uat   = mw_mem.Uj[iw];
+        eeI.cur_dUat  = mw_mem.dUj[iw];
+        eeI.cur_d2Uat = mw_mem.d2Uj[iw];
+      }
+      else
+      {
+        eeI.Uat[iat]   = mw_mem.Uj[iw];
+        eeI.dUat_temp  = mw_mem.dUj[iw];
+        eeI.d2Uat[iat] = mw_mem.d2Uj[iw];
+      }
+    }
+  }
+
+  /** batched computeU3_engine over the packed triplets of all the walkers.
+   * The functor is evaluated in one call for all the walkers.
+   * The reductions over the j electron and the scatter to the k electrons are done per walker.
+   */
+  void mw_computeU3_engine(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                           const FT& feeI,
+                           int kel_counter,
+                           bool use_temp) const
+  {
+    constexpr valT czero(0);
+    constexpr valT cone(1);
+    constexpr valT ctwo(2);
+    constexpr valT lapfac = OHMMS_DIM - cone;
+
+    auto& mw_mem           = wfc_list.getCastedLeader<JeeIOrbitalSoA<FT>>().getMWMem();
+    const int nw           = wfc_list.size();
+    const int* offsets     = mw_mem.offsets.data();
+    const int* DistIndiceK = mw_mem.DistIndice_k.data();
+
+    valT* restrict val     = mw_mem.mVGL.data(0);
+    valT* restrict gradF0  = mw_mem.mVGL.data(1);
+    valT* restrict gradF1  = mw_mem.mVGL.data(2);
+    valT* restrict gradF2  = mw_mem.mVGL.data(3);
+    valT* restrict hessF00 = mw_mem.mVGL.data(4);
+    valT* restrict hessF11 = mw_mem.mVGL.data(5);
+    valT* restrict hessF22 = mw_mem.mVGL.data(6);
+    valT* restrict hessF01 = mw_mem.mVGL.data(7);
+    valT* restrict hessF02 = mw_mem.mVGL.data(8);
+    valT* restrict dUj_x   = mw_mem.dUj_comp.data();
+
+    feeI.evaluateVGL(kel_counter, mw_mem.Distjk_Compressed.data(), mw_mem.DistjI_Compressed.data(),
+                     mw_mem.DistkI_Compressed.data(), val, gradF0, gradF1, gradF2, hessF00, hessF11, hessF22, hessF01,
+                     hessF02);
+
+    // compute the contribution to jel
+    for (int iw = 0; iw < nw; iw++)
+    {
+      const int first = offsets[iw];
+      const int n     = offsets[iw + 1] - first;
+      if (n == 0)
+        continue;
+      mw_mem.Uj[iw]    = simd::accumulate_n(val + first, n, mw_mem.Uj[iw]);
+      valT gradF0_sum  = simd::accumulate_n(gradF0 + first, n, czero);
+      valT gradF1_sum  = simd::accumulate_n(gradF1 + first, n, czero);
+      valT hessF00_sum = simd::accumulate_n(hessF00 + first, n, czero);
+      valT hessF11_sum = simd::accumulate_n(hessF11 + first, n, czero);
+      mw_mem.d2Uj[iw] -= hessF00_sum + hessF11_sum + lapfac * (gradF0_sum + gradF1_sum);
+    }
+    std::fill_n(hessF11, kel_counter, czero);
+    for (int idim = 0; idim < OHMMS_DIM; ++idim)
+    {
+      valT* restrict jk = mw_mem.Disp_jk_Compressed.data(idim);
+      valT* restrict jI = mw_mem.Disp_jI_Compressed.data(idim);
+      valT* restrict kI = mw_mem.Disp_kI_Compressed.data(idim);
+#pragma omp simd aligned(gradF0, gradF1, gradF2, hessF11, jk, jI, kI, dUj_x : QMC_SIMD_ALIGNMENT)
+      for (int kel_index = 0; kel_index < kel_counter; kel_index++)
+      {
+        // recycle hessF11
+        hessF11[kel_index] += kI[kel_index] * jk[kel_index];
+        // destroy jk, kI
+        const valT temp  = jk[kel_index] * gradF0[kel_index];
+        dUj_x[kel_index] = gradF1[kel_index] * jI[kel_index] + temp;
+        jk[kel_index] *= jI[kel_index];
+        kI[kel_index] = kI[kel_index] * gradF2[kel_index] - temp;
+      }
+
+      valT* restrict jk0 = mw_mem.Disp_jk_Compressed.data(0);
+      if (idim > 0)
+      {
+#pragma omp simd aligned(jk, jk0 : QMC_SIMD_ALIGNMENT)
+        for (int kel_index = 0; kel_index < kel_counter; kel_index++)
+          jk0[kel_index] += jk[kel_index];
+      }
+
+      for (int iw = 0; iw < nw; iw++)
+      {
+        const int first = offsets[iw];
+        const int last  = offsets[iw + 1];
+        if (first == last)
+          continue;
+        auto& eeI = wfc_list.getCastedElement<JeeIOrbitalSoA<FT>>(iw);
+        mw_mem.dUj[iw][idim] += simd::accumulate_n(dUj_x + first, last - first, czero);
+        valT* restrict dUk_x = (use_temp ? eeI.newdUk : eeI.olddUk).data(idim);
+        for (int kel_index = first; kel_index < last; kel_index++)
+          dUk_x[DistIndiceK[kel_index]] += kI[kel_index];
+      }
+    }
+
+    const valT* restrict jk0 = mw_mem.Disp_jk_Compressed.data(0);
+#pragma omp simd aligned(hessF00, hessF22, gradF0, gradF2, hessF01, hessF02, hessF11, jk0 : QMC_SIMD_ALIGNMENT)
+    for (int kel_index = 0; kel_index < kel_counter; kel_index++)
+    {
+      // recycle hessF01
+      hessF01[kel_index] *= jk0[kel_index];
+      hessF00[kel_index] = hessF00[kel_index] + hessF22[kel_index] + lapfac * (gradF0[kel_index] + gradF2[kel_index]) -
+          ctwo * hessF02[kel_index] * hessF11[kel_index];
+    }
+
+    for (int iw = 0; iw < nw; iw++)
+    {
+      const int first = offsets[iw];
+      const int last  = offsets[iw + 1];
+      if (first == last)
+        continue;
+      auto& eeI = wfc_list.getCastedElement<JeeIOrbitalSoA<FT>>(iw);
+      mw_mem.d2Uj[iw] -= ctwo * simd::accumulate_n(hessF01 + first, last - first, czero);
+      auto& Uk   = use_temp ? eeI.newUk : eeI.oldUk;
+      auto& d2Uk = use_temp ? eeI.newd2Uk : eeI.oldd2Uk;
+      for (int kel_index = first; kel_index < last; kel_index++)
+      {
+        const int kel = DistIndiceK[kel_index];
+        Uk[kel] += val[kel_index];
+        d2Uk[kel] -= hessF00[kel_index];
+      }
+    }
+  }
+
   inline void registerData(ParticleSet& P, WFBufferType& buf) override
   {
     if (Bytes_in_WFBuffer == 0)
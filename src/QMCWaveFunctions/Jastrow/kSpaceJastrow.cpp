@@ -171,7 +171,7 @@ void kSpaceJastrow::sortGvecs(std::vector<PosType>& gvecs, std::vector<kSpaceCoe
   if (symm == CRYSTAL)
   {
     // First pass:  sort all the G-vectors into equivalent groups
-    std::sort(gvecs.begin(), gvecs.end(), *this);
+    std::sort(gvecs.begin(), gvecs.end(), [this](const PosType& G1, const PosType& G2) { return (*this)(G1, G2); });
     // Now, look through the sorted G-vectors and group them
     kSpaceCoef<T> coef;
     coef.cG         = T();
@@ -514,15 +514,12 @@ kSpaceJastrow::PsiValueType kSpaceJastrow::ratioGrad(ParticleSet& P, int iat, Gr
   }
   for (int i = 0; i < nTwo; i++)
   {
-    ComplexType rho_G = TwoBody_rhoG[i] + TwoBody_e2iGr_new[i] - TwoBody_e2iGr_old[i];
+    Delta_e2iGr(iat, i) = TwoBody_e2iGr_new[i] - TwoBody_e2iGr_old[i];
+    ComplexType rho_G   = TwoBody_rhoG[i] + Delta_e2iGr(iat, i);
     J2new += Prefactor * TwoBodyCoefs[i] * std::norm(rho_G);
-  }
-  for (int i = 0; i < nTwo; i++)
-  {
-    PosType Gvec(TwoBodyGvecs[i]);
-    ComplexType z = TwoBody_e2iGr_new[i];
+    // gradient at the proposed position, with rho_G of the proposed configuration
     grad_iat += -Prefactor * 2.0 * TwoBodyGvecs[i] * TwoBodyCoefs[i] *
-        imag(qmcplusplus::conj(TwoBody_rhoG[i]) * TwoBody_e2iGr_new[i]);
+        imag(qmcplusplus::conj(rho_G) * TwoBody_e2iGr_new[i]);
   }
   return std::exp(static_cast<PsiValueType>(J1new + J2new - (J1old + J2old)));
 }
@@ -561,12 +558,118 @@ kSpaceJastrow::PsiValueType kSpaceJastrow::ratio(ParticleSet& P, int iat)
   }
   for (int i = 0; i < nTwo; i++)
   {
-    ComplexType rho_G = TwoBody_rhoG[i] + TwoBody_e2iGr_new[i] - TwoBody_e2iGr_old[i];
+    Delta_e2iGr(iat, i) = TwoBody_e2iGr_new[i] - TwoBody_e2iGr_old[i];
+    ComplexType rho_G   = TwoBody_rhoG[i] + Delta_e2iGr(iat, i);
     J2new += Prefactor * TwoBodyCoefs[i] * std::norm(rho_G);
   }
   return std::exp(static_cast<PsiValueType>(J1new + J2new - (J1old + J2old)));
 }
 
+void kSpaceJastrow::mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                 const RefVectorWithLeader<ParticleSet>& p_list,
+                                 int iat,
+                                 std::vector<PsiValueType>& ratios) const
+{
+  mw_ratio_impl(wfc_list, p_list, iat, ratios, nullptr);
+}
+
+void kSpaceJastrow::mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                 const RefVectorWithLeader<ParticleSet>& p_list,
+                                 int iat,
+                                 std::vector<PsiValueType>& ratios,
+                                 std::vector<GradType>& grad_new) const
+{
+  mw_ratio_impl(wfc_list, p_list, iat, ratios, &grad_new);
+}
+
+void kSpaceJastrow::mw_ratio_impl(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                  const RefVectorWithLeader<ParticleSet>& p_list,
+                                  int iat,
+                                  std::vector<PsiValueType>& ratios,
+                                  std::vector<GradType>* grad_new) const
+{
+  assert(this == &wfc_list.getLeader());
+  auto& wfc_leader = wfc_list.getCastedLeader<kSpaceJastrow>();
+  wfc_leader.guardMultiWalkerRes();
+  auto& mw_res  = *wfc_leader.mw_res_;
+  const int nw  = wfc_list.size();
+  const ComplexType eye(0.0, 1.0);
+
+  // e^{iG.r} of the proposed (row iw) and current (row nw + iw) positions of every walker in one pass
+  auto crowd_e2iGr = [&](const std::vector<PosType>& gvecs, Matrix<RealType>& phase, Matrix<ComplexType>& e2iGr) {
+    const int nG = gvecs.size();
+    phase.resize(2 * nw, nG);
+    e2iGr.resize(2 * nw, nG);
+    for (int iw = 0; iw < nw; iw++)
+    {
+      const PosType &rnew(p_list[iw].getActivePos()), &rold(p_list[iw].R[iat]);
+      RealType* restrict phase_new = phase[iw];
+      RealType* restrict phase_old = phase[nw + iw];
+      for (int i = 0; i < nG; i++)
+      {
+        phase_new[i] = dot(gvecs[i], rnew);
+        phase_old[i] = dot(gvecs[i], rold);
+      }
+    }
+    eval_e2iphi(phase.size(), phase.data(), e2iGr.data());
+  };
+  crowd_e2iGr(OneBodyGvecs, mw_res.OneBodyPhase, mw_res.OneBody_e2iGr);
+  crowd_e2iGr(TwoBodyGvecs, mw_res.TwoBodyPhase, mw_res.TwoBody_e2iGr);
+
+  const int nOne = OneBodyGvecs.size();
+  const int nTwo = TwoBodyGvecs.size();
+  for (int iw = 0; iw < nw; iw++)
+  {
+    auto& wfc = wfc_list.getCastedElement<kSpaceJastrow>(iw);
+    RealType dJ(0.0);
+    GradType grad;
+    const ComplexType* restrict one_new = mw_res.OneBody_e2iGr[iw];
+    const ComplexType* restrict one_old = mw_res.OneBody_e2iGr[nw + iw];
+    for (int i = 0; i < nOne; i++)
+    {
+      ComplexType z = OneBodyCoefs[i] * qmcplusplus::conj(one_new[i]);
+      dJ += real(z) - real(OneBodyCoefs[i] * qmcplusplus::conj(one_old[i]));
+      if (grad_new)
+        grad += -real(z * eye) * OneBodyGvecs[i];
+    }
+    const ComplexType* restrict two_new = mw_res.TwoBody_e2iGr[iw];
+    const ComplexType* restrict two_old = mw_res.TwoBody_e2iGr[nw + iw];
+    for (int i = 0; i < nTwo; i++)
+    {
+      wfc.Delta_e2iGr(iat, i) = two_new[i] - two_old[i];
+      ComplexType rho_G       = wfc.TwoBody_rhoG[i] + wfc.Delta_e2iGr(iat, i);
+      dJ += TwoBodyCoefs[i] * (std::norm(rho_G) - std::norm(wfc.TwoBody_rhoG[i]));
+      if (grad_new)
+        grad += -2.0 * TwoBodyGvecs[i] * TwoBodyCoefs[i] * imag(qmcplusplus::conj(rho_G) * two_new[i]);
+    }
+    ratios[iw] = std::exp(static_cast<PsiValueType>(Prefactor * dJ));
+    if (grad_new)
+      (*grad_new)[iw] += Prefactor * grad;
+  }
+}
+
+void kSpaceJastrow::createResource(ResourceCollection& collection) const
+{
+  collection.addResource(std::make_unique<kSpaceJastrowMultiWalkerResource>());
+}
+
+void kSpaceJastrow::acquireResource(ResourceCollection& collection,
+                                    const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+{
+  auto& wfc_leader = wfc_list.getCastedLeader<kSpaceJastrow>();
+  auto res_ptr     = dynamic_cast<kSpaceJastrowMultiWalkerResource*>(collection.lendResource().release());
+  if (!res_ptr)
+    throw std::runtime_error("kSpaceJastrow::acquireResource dynamic_cast failed");
+  wfc_leader.mw_res_.reset(res_ptr);
+}
+
+void kSpaceJastrow::releaseResource(ResourceCollection& collection,
+                                    const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+{
+  auto& wfc_leader = wfc_list.getCastedLeader<kSpaceJastrow>();
+  collection.takebackResource(std::move(wfc_leader.mw_res_));
+}
+
 /** evaluate the ratio
 */
 void kSpaceJastrow::evaluateRatiosAlltoOne(ParticleSet& P, std::vector<kSpaceJastrow::ValueType>& ratios)
@@ -29,6 +29,7 @@
 #include "OhmmsPETE/OhmmsVector.h"
 #include "OhmmsPETE/OhmmsMatrix.h"
 #include "LongRange/LRHandlerBase.h"
+#include "ResourceCollection.h"
 
 namespace qmcplusplus
 {
@@ -113,8 +114,24 @@ private:
   std::vector<RealType> OneBodyPhase, TwoBodyPhase;
   //
   std::vector<ComplexType> OneBody_e2iGr, TwoBody_e2iGr_new, TwoBody_e2iGr_old;
+  // change of e^{iG.r} of each electron at its last proposed move, added to TwoBody_rhoG on acceptance
   Matrix<ComplexType> Delta_e2iGr;
 
+  /// scratch of the multi walker ratios, the phases and e^{iG.r} of the proposed and current positions of a crowd
+  struct kSpaceJastrowMultiWalkerResource : public Resource
+  {
+    kSpaceJastrowMultiWalkerResource() : Resource("kSpaceJastrow") {}
+    kSpaceJastrowMultiWalkerResource(const kSpaceJastrowMultiWalkerResource&) : kSpaceJastrowMultiWalkerResource() {}
+
+    Resource* makeClone() const override { return new kSpaceJastrowMultiWalkerResource(*this); }
+
+    /// rows [0, nw) for the proposed positions, rows [nw, 2nw) for the current positions
+    Matrix<RealType> OneBodyPhase, TwoBodyPhase;
+    Matrix<ComplexType> OneBody_e2iGr, TwoBody_e2iGr;
+  };
+
+  std::unique_ptr<kSpaceJastrowMultiWalkerResource> mw_res_;
+
   // Map of the optimizable variables:
   //std::map<std::string,RealType*> VarMap;
 
@@ -170,6 +187,23 @@ public:
   GradType evalGrad(ParticleSet& P, int iat) override;
   PsiValueType ratioGrad(ParticleSet& P, int iat, GradType& grad_iat) override;
 
+  void mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValueType>& ratios) const override;
+
+  void mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValueType>& ratios,
+                    std::vector<GradType>& grad_new) const override;
+
+  void createResource(ResourceCollection& collection) const override;
+  void acquireResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override;
+  void releaseResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override;
+
   void restore(int iat) override;
   void acceptMove(ParticleSet& P, int iat, bool safe_to_delay = false) override;
 
@@ -204,6 +238,31 @@ public:
 
 private:
   void copyFrom(const kSpaceJastrow& old);
+
+  /** ratios, and gradients if grad_new is not null, of a crowd
+   *
+   * The G-vectors and coefficients are shared by the clones and taken from the leader.
+   * e^{iG.r} of the proposed and current positions of all the walkers are computed by a single eval_e2iphi call,
+   * the k-sums are then done per walker with its own TwoBody_rhoG.
+   */
+  void mw_ratio_impl(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                     const RefVectorWithLeader<ParticleSet>& p_list,
+                     int iat,
+                     std::vector<PsiValueType>& ratios,
+                     std::vector<GradType>* grad_new) const;
+
+  /// make this class unit tests friendly without the need of setup resources.
+  void guardMultiWalkerRes()
+  {
+    if (!mw_res_)
+    {
+      std::cerr << "WARNING kSpaceJastrow : This message should not be seen in production (performance "
+                   "bug) runs but only unit tests (expected)."
+                << std::endl;
+      mw_res_ = std::make_unique<kSpaceJastrowMultiWalkerResource>();
+    }
+  }
+
   std::vector<int> TwoBodyVarMap;
   std::vector<int> OneBodyVarMap;
 };
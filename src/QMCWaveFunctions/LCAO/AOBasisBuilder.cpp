@@ -286,9 +286,12 @@ std::unique_ptr<COT> AOBasisBuilder<COT>::createAOSet(xmlNodePtr cur)
   //aos->Rmax can be set small
   //aos->setRmax(0);
   aos->setBasisSetSize(-1);
+  //only used by the screened evaluation of LCAO orbitals
+  aos->setScreeningRadii(ao_screening_eps_);
   app_log() << "   Maximum Angular Momentum  = " << aos->Ylm.lmax() << std::endl
             << "   Number of Radial functors = " << aos->RnlID.size() << std::endl
-            << "   Basis size                = " << aos->getBasisSetSize() << "\n\n";
+            << "   Basis size                = " << aos->getBasisSetSize() << std::endl
+            << "   Screening radius          = " << aos->ScreeningRadius << "\n\n";
   return aos;
 }
 
@@ -413,9 +416,12 @@ std::unique_ptr<COT> AOBasisBuilder<COT>::createAOSetH5(hdf_archive& hin)
   //aos->Rmax can be set small
   //aos->setRmax(0);
   aos->setBasisSetSize(-1);
+  //only used by the screened evaluation of LCAO orbitals
+  aos->setScreeningRadii(ao_screening_eps_);
   app_log() << "   Maximum Angular Momentum  = " << aos->Ylm.lmax() << std::endl
             << "   Number of Radial functors = " << aos->RnlID.size() << std::endl
-            << "   Basis size                = " << aos->getBasisSetSize() << "\n\n";
+            << "   Basis size                = " << aos->getBasisSetSize() << std::endl
+            << "   Screening radius          = " << aos->ScreeningRadius << "\n\n";
   return aos;
 }
 
@@ -58,6 +58,9 @@ private:
   ///map for (n,l,m,s) to its quantum number index
   std::map<std::string, int> nlms_id;
 
+  ///magnitude below which a basis function is screened out
+  static constexpr double ao_screening_eps_ = 1e-8;
+
 public:
   AOBasisBuilder(const std::string& eName, Communicate* comm);
 
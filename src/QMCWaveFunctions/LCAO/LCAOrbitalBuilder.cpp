@@ -452,7 +452,7 @@ LCAOrbitalBuilder::BasisSet_t* LCAOrbitalBuilder::createBasisSetH5()
 std::unique_ptr<SPOSet> LCAOrbitalBuilder::createSPOSetFromXML(xmlNodePtr cur)
 {
   ReportEngine PRE(ClassName, "createSPO(xmlNodePtr)");
-  std::string spo_name(""), id, cusp_file(""), optimize("no");
+  std::string spo_name(""), id, cusp_file(""), optimize("no"), screening("no");
   std::string basisset_name("LCAOBSet");
   OhmmsAttributeSet spoAttrib;
   spoAttrib.add(spo_name, "name");
@@ -460,6 +460,7 @@ std::unique_ptr<SPOSet> LCAOrbitalBuilder::createSPOSetFromXML(xmlNodePtr cur)
   spoAttrib.add(cusp_file, "cuspInfo");
   spoAttrib.add(optimize, "optimize");
   spoAttrib.add(basisset_name, "basisset");
+  spoAttrib.add(screening, "screening", {"no", "yes"});
   spoAttrib.put(cur);
 
   std::unique_ptr<BasisSet_t> myBasisSet;
@@ -487,6 +488,12 @@ std::unique_ptr<SPOSet> LCAOrbitalBuilder::createSPOSetFromXML(xmlNodePtr cur)
     lcos = std::make_unique<LCAOrbitalSet>(std::move(myBasisSet), optimize == "yes");
   loadMO(*lcos, cur);
 
+  if (screening == "yes")
+  {
+    app_summary() << "        Using spatially screened basis function evaluation." << std::endl;
+    lcos->setScreening(true);
+  }
+
 #if !defined(QMC_COMPLEX)
   if (doCuspCorrection)
   {
@@ -13,11 +13,33 @@
 #include "LCAOrbitalSet.h"
 #include "Numerics/MatrixOperators.h"
 #include "CPU/BLAS.hpp"
+#include "ResourceCollection.h"
 
 namespace qmcplusplus
 {
+struct LCAOrbitalSet::LCAOMultiWalkerMem : public Resource
+{
+  ///[5][nw][BasisSetSize] VGL of the basis functions of all the walkers
+  ValueMatrix basis_vgl;
+  ///[5][nw][num_orbs] VGL of the orbitals of all the walkers
+  ValueMatrix phi_vgl;
+  ///[nw][num_orbs] rows of the inverse Slater matrices
+  ValueMatrix inv_rows;
+  ///[nw][BasisSetSize] inverse rows in the basis set representation, inv_rows * C
+  ValueMatrix inv_basis;
+
+  LCAOMultiWalkerMem() : Resource("LCAOrbitalSet") {}
+
+  LCAOMultiWalkerMem(const LCAOMultiWalkerMem&) : LCAOMultiWalkerMem() {}
+
+  Resource* makeClone() const override { return new LCAOMultiWalkerMem(*this); }
+};
+
 LCAOrbitalSet::LCAOrbitalSet(std::unique_ptr<basis_type>&& bs, bool optimize)
-    : SPOSet(false, true, optimize), BasisSetSize(bs ? bs->getBasisSetSize() : 0), Identity(true)
+    : SPOSet(false, true, optimize),
+      BasisSetSize(bs ? bs->getBasisSetSize() : 0),
+      Identity(true),
+      Screening(false)
 {
   if (!bs)
     throw std::runtime_error("LCAOrbitalSet cannot take nullptr as its  basis set!");
@@ -30,7 +52,12 @@ LCAOrbitalSet::LCAOrbitalSet(std::unique_ptr<basis_type>&& bs, bool optimize)
 }
 
 LCAOrbitalSet::LCAOrbitalSet(const LCAOrbitalSet& in)
-    : SPOSet(in), myBasisSet(in.myBasisSet->makeClone()), C(in.C), BasisSetSize(in.BasisSetSize), Identity(in.Identity)
+    : SPOSet(in),
+      myBasisSet(in.myBasisSet->makeClone()),
+      C(in.C),
+      BasisSetSize(in.BasisSetSize),
+      Identity(in.Identity),
+      Screening(in.Screening)
 {
   Temp.resize(BasisSetSize);
   Temph.resize(BasisSetSize);
@@ -44,6 +71,8 @@ LCAOrbitalSet::LCAOrbitalSet(const LCAOrbitalSet& in)
   LCAOrbitalSet::checkObject();
 }
 
+LCAOrbitalSet::~LCAOrbitalSet() = default;
+
 void LCAOrbitalSet::setOrbitalSetSize(int norbs)
 {
   if (C)
@@ -87,6 +116,12 @@ void LCAOrbitalSet::evaluateValue(const ParticleSet& P, int iat, ValueVector& ps
   { //PAY ATTENTION TO COMPLEX
     myBasisSet->evaluateV(P, iat, psi.data());
   }
+  else if (Screening)
+  {
+    assert(psi.size() <= OrbitalSetSize);
+    myBasisSet->evaluateVScreened(P, iat, Temp.data(0), LiveAOs);
+    contract_live_v(Temp.data(0), psi);
+  }
   else
   {
     Vector<ValueType> vTemp(Temp.data(0), BasisSetSize);
@@ -97,6 +132,60 @@ void LCAOrbitalSet::evaluateValue(const ParticleSet& P, int iat, ValueVector& ps
   }
 }
 
+inline void LCAOrbitalSet::contract_live_v(const ValueType* restrict vals, ValueVector& psi) const
+{
+  const size_t num_live    = LiveAOs.size();
+  const int* restrict live = LiveAOs.data();
+  for (size_t j = 0; j < psi.size(); j++)
+  {
+    const ValueType* restrict cj = (*C)[j];
+    ValueType v(0);
+    for (size_t k = 0; k < num_live; k++)
+      v += cj[live[k]] * vals[live[k]];
+    psi[j] = v;
+  }
+}
+
+inline void LCAOrbitalSet::contract_live_vgl(const vgl_type& temp, size_t num_orbs, vgl_type& tempv)
+{
+  const size_t num_live    = LiveAOs.size();
+  const int* restrict live = LiveAOs.data();
+  // pack the live basis functions to stream them contiguously for every orbital
+  TempLive.resize(num_live);
+  for (int idim = 0; idim < OHMMS_DIM + 2; idim++)
+  {
+    const ValueType* restrict src = temp.data(idim);
+    ValueType* restrict dst       = TempLive.data(idim);
+    for (size_t k = 0; k < num_live; k++)
+      dst[k] = src[live[k]];
+  }
+
+  const ValueType* restrict v  = TempLive.data(0);
+  const ValueType* restrict gx = TempLive.data(1);
+  const ValueType* restrict gy = TempLive.data(2);
+  const ValueType* restrict gz = TempLive.data(3);
+  const ValueType* restrict l  = TempLive.data(4);
+  for (size_t j = 0; j < num_orbs; j++)
+  {
+    const ValueType* restrict cj = (*C)[j];
+    ValueType psi(0), dpsi_x(0), dpsi_y(0), dpsi_z(0), d2psi(0);
+    for (size_t k = 0; k < num_live; k++)
+    {
+      const ValueType c = cj[live[k]];
+      psi += c * v[k];
+      dpsi_x += c * gx[k];
+      dpsi_y += c * gy[k];
+      dpsi_z += c * gz[k];
+      d2psi += c * l[k];
+    }
+    tempv.data(0)[j] = psi;
+    tempv.data(1)[j] = dpsi_x;
+    tempv.data(2)[j] = dpsi_y;
+    tempv.data(3)[j] = dpsi_z;
+    tempv.data(4)[j] = d2psi;
+  }
+}
+
 /** Find a better place for other user classes, Matrix should be padded as well */
 template<typename T, unsigned D>
 inline void Product_ABt(const VectorSoaContainer<T, D>& A, const Matrix<T>& B, VectorSoaContainer<T, D>& C)
@@ -329,6 +418,15 @@ inline void LCAOrbitalSet::evaluate_ionderiv_v_row_impl(const vgl_type& temp, Gr
 void LCAOrbitalSet::evaluateVGL(const ParticleSet& P, int iat, ValueVector& psi, GradVector& dpsi, ValueVector& d2psi)
 {
   //TAKE CARE OF IDENTITY
+  if (Screening && !Identity)
+  {
+    assert(psi.size() <= OrbitalSetSize);
+    myBasisSet->evaluateVGLScreened(P, iat, Temp, LiveAOs);
+    contract_live_vgl(Temp, psi.size(), Tempv);
+    evaluate_vgl_impl(Tempv, psi, dpsi, d2psi);
+    return;
+  }
+
   myBasisSet->evaluateVGL(P, iat, Temp);
   if (Identity)
     evaluate_vgl_impl(Temp, psi, dpsi, d2psi);
@@ -351,10 +449,199 @@ void LCAOrbitalSet::evaluateDetRatios(const VirtualParticleSet& VP,
 
   MatrixOperators::product_Atx(*C, psiinv, invTemp.data());
 
-  for (size_t j = 0; j < VP.getTotalNum(); j++)
+  if (Screening)
+    for (size_t j = 0; j < VP.getTotalNum(); j++)
+    {
+      myBasisSet->evaluateVScreened(VP, j, vTemp.data(), LiveAOs);
+      ValueType ratio(0);
+      for (const int ib : LiveAOs)
+        ratio += vTemp[ib] * invTemp[ib];
+      ratios[j] = ratio;
+    }
+  else
+    for (size_t j = 0; j < VP.getTotalNum(); j++)
+    {
+      myBasisSet->evaluateV(VP, j, vTemp.data());
+      ratios[j] = simd::dot(vTemp.data(), invTemp.data(), BasisSetSize);
+    }
+}
+
+void LCAOrbitalSet::createResource(ResourceCollection& collection) const
+{
+  collection.addResource(std::make_unique<LCAOMultiWalkerMem>());
+}
+
+void LCAOrbitalSet::acquireResource(ResourceCollection& collection, const RefVectorWithLeader<SPOSet>& spo_list) const
+{
+  assert(this == &spo_list.getLeader());
+  auto& spo_leader = spo_list.getCastedLeader<LCAOrbitalSet>();
+  auto res_ptr     = dynamic_cast<LCAOMultiWalkerMem*>(collection.lendResource().release());
+  if (!res_ptr)
+    throw std::runtime_error("LCAOrbitalSet::acquireResource dynamic_cast failed");
+  spo_leader.mw_mem_.reset(res_ptr);
+}
+
+void LCAOrbitalSet::releaseResource(ResourceCollection& collection, const RefVectorWithLeader<SPOSet>& spo_list) const
+{
+  assert(this == &spo_list.getLeader());
+  auto& spo_leader = spo_list.getCastedLeader<LCAOrbitalSet>();
+  collection.takebackResource(std::move(spo_leader.mw_mem_));
+}
+
+LCAOrbitalSet::LCAOMultiWalkerMem& LCAOrbitalSet::getMWMem()
+{
+  // make this class unit tests friendly without the need of setup resources.
+  if (!mw_mem_)
+    mw_mem_ = std::make_unique<LCAOMultiWalkerMem>();
+  return *mw_mem_;
+}
+
+const LCAOrbitalSet::ValueMatrix& LCAOrbitalSet::mw_evaluate_vgl_gemm(const RefVectorWithLeader<SPOSet>& spo_list,
+                                                                      const RefVectorWithLeader<ParticleSet>& P_list,
+                                                                      int iat,
+                                                                      size_t num_orbs) const
+{
+  assert(this == &spo_list.getLeader());
+  assert(num_orbs <= OrbitalSetSize);
+  auto& mw_mem    = spo_list.getCastedLeader<LCAOrbitalSet>().getMWMem();
+  auto& basis_vgl = mw_mem.basis_vgl;
+  auto& phi_vgl   = mw_mem.phi_vgl;
+  const size_t nw = spo_list.size();
+  basis_vgl.resize(5 * nw, BasisSetSize);
+  phi_vgl.resize(5 * nw, num_orbs);
+
+  // the basis sets hold per walker scratch space, each walker evaluates with its own copy
+#pragma omp parallel for
+  for (int iw = 0; iw < nw; iw++)
+  {
+    auto& spo = spo_list.getCastedElement<LCAOrbitalSet>(iw);
+    spo.myBasisSet->evaluateVGL(P_list[iw], iat, spo.Temp);
+    for (size_t idim = 0; idim < 5; idim++)
+      std::copy_n(spo.Temp.data(idim), BasisSetSize, basis_vgl[idim * nw + iw]);
+  }
+
+  const ValueMatrix C_partial_view(C->data(), num_orbs, BasisSetSize);
+  MatrixOperators::product_ABt(basis_vgl, C_partial_view, phi_vgl);
+  return phi_vgl;
+}
+
+void LCAOrbitalSet::mw_evaluateVGL(const RefVectorWithLeader<SPOSet>& spo_list,
+                                   const RefVectorWithLeader<ParticleSet>& P_list,
+                                   int iat,
+                                   const RefVector<ValueVector>& psi_v_list,
+                                   const RefVector<GradVector>& dpsi_v_list,
+                                   const RefVector<ValueVector>& d2psi_v_list) const
+{
+  assert(this == &spo_list.getLeader());
+  // Identity has nothing to contract and screening is sparse per walker, use the single walker code path.
+  if (Identity || Screening)
+  {
+    SPOSet::mw_evaluateVGL(spo_list, P_list, iat, psi_v_list, dpsi_v_list, d2psi_v_list);
+    return;
+  }
+
+  const size_t nw          = spo_list.size();
+  const size_t output_size = psi_v_list[0].get().size();
+  const auto& phi_vgl      = mw_evaluate_vgl_gemm(spo_list, P_list, iat, output_size);
+
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    ValueVector& psi             = psi_v_list[iw];
+    GradVector& dpsi             = dpsi_v_list[iw];
+    ValueVector& d2psi           = d2psi_v_list[iw];
+    const ValueType* restrict gx = phi_vgl[nw + iw];
+    const ValueType* restrict gy = phi_vgl[2 * nw + iw];
+    const ValueType* restrict gz = phi_vgl[3 * nw + iw];
+    std::copy_n(phi_vgl[iw], output_size, psi.data());
+    for (size_t j = 0; j < output_size; j++)
+    {
+      dpsi[j][0] = gx[j];
+      dpsi[j][1] = gy[j];
+      dpsi[j][2] = gz[j];
+    }
+    std::copy_n(phi_vgl[4 * nw + iw], output_size, d2psi.data());
+  }
+}
+
+void LCAOrbitalSet::mw_evaluateVGLandDetRatioGrads(const RefVectorWithLeader<SPOSet>& spo_list,
+                                                   const RefVectorWithLeader<ParticleSet>& P_list,
+                                                   int iat,
+                                                   const std::vector<const ValueType*>& invRow_ptr_list,
+                                                   VGLVector& phi_vgl_v,
+                                                   std::vector<ValueType>& ratios,
+                                                   std::vector<GradType>& grads) const
+{
+  assert(this == &spo_list.getLeader());
+  if (Identity || Screening)
   {
-    myBasisSet->evaluateV(VP, j, vTemp.data());
-    ratios[j] = simd::dot(vTemp.data(), invTemp.data(), BasisSetSize);
+    SPOSet::mw_evaluateVGLandDetRatioGrads(spo_list, P_list, iat, invRow_ptr_list, phi_vgl_v, ratios, grads);
+    return;
+  }
+
+  const size_t nw             = spo_list.size();
+  const size_t norb_requested = phi_vgl_v.size() / nw;
+  const auto& phi_vgl         = mw_evaluate_vgl_gemm(spo_list, P_list, iat, norb_requested);
+
+  // phi_vgl_v holds values and laplacians in SoA, gradients as GradType arrays starting at data(1)
+  std::copy_n(phi_vgl[0], nw * norb_requested, phi_vgl_v.data(0));
+  std::copy_n(phi_vgl[4 * nw], nw * norb_requested, phi_vgl_v.data(4));
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    GradType* restrict dphi      = reinterpret_cast<GradType*>(phi_vgl_v.data(1)) + norb_requested * iw;
+    const ValueType* restrict gx = phi_vgl[nw + iw];
+    const ValueType* restrict gy = phi_vgl[2 * nw + iw];
+    const ValueType* restrict gz = phi_vgl[3 * nw + iw];
+    for (size_t j = 0; j < norb_requested; j++)
+    {
+      dphi[j][0] = gx[j];
+      dphi[j][1] = gy[j];
+      dphi[j][2] = gz[j];
+    }
+
+    ratios[iw] = simd::dot(invRow_ptr_list[iw], phi_vgl_v.data(0) + norb_requested * iw, norb_requested);
+    grads[iw]  = simd::dot(invRow_ptr_list[iw], dphi, norb_requested) / ratios[iw];
+  }
+}
+
+void LCAOrbitalSet::mw_evaluateDetRatios(const RefVectorWithLeader<SPOSet>& spo_list,
+                                         const RefVectorWithLeader<const VirtualParticleSet>& vp_list,
+                                         const RefVector<ValueVector>& psi_list,
+                                         const std::vector<const ValueType*>& invRow_ptr_list,
+                                         std::vector<std::vector<ValueType>>& ratios_list) const
+{
+  assert(this == &spo_list.getLeader());
+  if (Identity || Screening)
+  {
+    SPOSet::mw_evaluateDetRatios(spo_list, vp_list, psi_list, invRow_ptr_list, ratios_list);
+    return;
+  }
+
+  auto& mw_mem          = spo_list.getCastedLeader<LCAOrbitalSet>().getMWMem();
+  auto& inv_rows        = mw_mem.inv_rows;
+  auto& inv_basis       = mw_mem.inv_basis;
+  const size_t nw       = spo_list.size();
+  const size_t num_orbs = psi_list[0].get().size();
+  assert(num_orbs <= OrbitalSetSize);
+  inv_rows.resize(nw, num_orbs);
+  inv_basis.resize(nw, BasisSetSize);
+
+  for (size_t iw = 0; iw < nw; iw++)
+    std::copy_n(invRow_ptr_list[iw], num_orbs, inv_rows[iw]);
+  const ValueMatrix C_partial_view(C->data(), num_orbs, BasisSetSize);
+  MatrixOperators::product(inv_rows, C_partial_view, inv_basis);
+
+#pragma omp parallel for
+  for (int iw = 0; iw < nw; iw++)
+  {
+    auto& spo                         = spo_list.getCastedElement<LCAOrbitalSet>(iw);
+    const VirtualParticleSet& vp      = vp_list[iw];
+    ValueType* restrict vTemp         = spo.Temp.data(0);
+    const ValueType* restrict invTemp = inv_basis[iw];
+    for (size_t j = 0; j < vp.getTotalNum(); j++)
+    {
+      spo.myBasisSet->evaluateV(vp, j, vTemp);
+      ratios_list[iw][j] = simd::dot(vTemp, invTemp, BasisSetSize);
+    }
   }
 }
 
@@ -537,8 +824,16 @@ void LCAOrbitalSet::evaluate_notranspose(const ParticleSet& P,
     ValueMatrix C_partial_view(C->data(), logdet.cols(), BasisSetSize);
     for (size_t i = 0, iat = first; iat < last; i++, iat++)
     {
-      myBasisSet->evaluateVGL(P, iat, Temp);
-      Product_ABt(Temp, C_partial_view, Tempv);
+      if (Screening)
+      {
+        myBasisSet->evaluateVGLScreened(P, iat, Temp, LiveAOs);
+        contract_live_vgl(Temp, logdet.cols(), Tempv);
+      }
+      else
+      {
+        myBasisSet->evaluateVGL(P, iat, Temp);
+        Product_ABt(Temp, C_partial_view, Tempv);
+      }
       evaluate_vgl_impl(Tempv, i, logdet, dlogdet, d2logdet);
     }
   }
@@ -16,6 +16,7 @@
 #include <memory>
 #include "QMCWaveFunctions/SPOSet.h"
 #include "QMCWaveFunctions/BasisSetBase.h"
+#include <ResourceHandle.h>
 
 #include "Numerics/MatrixOperators.h"
 #include "Numerics/DeterminantOperators.h"
@@ -47,6 +48,8 @@ public:
 
   LCAOrbitalSet(const LCAOrbitalSet& in);
 
+  ~LCAOrbitalSet() override;
+
   std::unique_ptr<SPOSet> makeClone() const override;
 
   void storeParamsBeforeRotation() override { C_copy = *C; }
@@ -79,6 +82,15 @@ public:
 
   bool isIdentity() const { return Identity; };
 
+  /** enable/disable the spatially screened evaluation
+   *
+   * When enabled, only the basis functions within their screening radius of the electron are evaluated
+   * and contracted with C. Ignored if C is an identity matrix.
+   */
+  void setScreening(bool screening) { Screening = screening; }
+
+  bool isScreened() const { return Screening; }
+
   /** check consistency between Identity and C
     *
     */
@@ -93,6 +105,38 @@ public:
                          const ValueVector& psiinv,
                          std::vector<ValueType>& ratios) override;
 
+  /** batched evaluateVGL.
+   * The basis functions of all the walkers are packed and contracted with C in a single GEMM.
+   */
+  void mw_evaluateVGL(const RefVectorWithLeader<SPOSet>& spo_list,
+                      const RefVectorWithLeader<ParticleSet>& P_list,
+                      int iat,
+                      const RefVector<ValueVector>& psi_v_list,
+                      const RefVector<GradVector>& dpsi_v_list,
+                      const RefVector<ValueVector>& d2psi_v_list) const override;
+
+  void mw_evaluateVGLandDetRatioGrads(const RefVectorWithLeader<SPOSet>& spo_list,
+                                      const RefVectorWithLeader<ParticleSet>& P_list,
+                                      int iat,
+                                      const std::vector<const ValueType*>& invRow_ptr_list,
+                                      VGLVector& phi_vgl_v,
+                                      std::vector<ValueType>& ratios,
+                                      std::vector<GradType>& grads) const override;
+
+  /** batched evaluateDetRatios.
+   * The inverse rows of all the walkers are transformed to the basis set representation in a single GEMM
+   * and each virtual particle only needs a dot product with the basis function values.
+   */
+  void mw_evaluateDetRatios(const RefVectorWithLeader<SPOSet>& spo_list,
+                            const RefVectorWithLeader<const VirtualParticleSet>& vp_list,
+                            const RefVector<ValueVector>& psi_list,
+                            const std::vector<const ValueType*>& invRow_ptr_list,
+                            std::vector<std::vector<ValueType>>& ratios_list) const override;
+
+  void createResource(ResourceCollection& collection) const override;
+  void acquireResource(ResourceCollection& collection, const RefVectorWithLeader<SPOSet>& spo_list) const override;
+  void releaseResource(ResourceCollection& collection, const RefVectorWithLeader<SPOSet>& spo_list) const override;
+
   void evaluateVGH(const ParticleSet& P,
                    int iat,
                    ValueVector& psi,
@@ -209,6 +253,12 @@ protected:
 
   ///true if C is an identity matrix
   bool Identity;
+  ///true if only the basis functions within their screening radius are used
+  bool Screening;
+  ///indices of the basis functions within their screening radius of the last evaluated electron
+  std::vector<int> LiveAOs;
+  ///TempLive(LiveAOs.size()) : packed Temp of the basis functions in LiveAOs
+  vgl_type TempLive;
   ///Temp(BasisSetSize) : Row index=V,Gx,Gy,Gz,L
   vgl_type Temp;
   ///Tempv(OrbitalSetSize) Tempv=C*Temp
@@ -229,6 +279,26 @@ protected:
   vghgh_type Tempghv;
 
 private:
+  struct LCAOMultiWalkerMem;
+  ///scratch space of the batched APIs, only used by the crowd leader
+  ResourceHandle<LCAOMultiWalkerMem> mw_mem_;
+
+  ///return the batched scratch space, allocated on the fly if no resource has been acquired
+  LCAOMultiWalkerMem& getMWMem();
+
+  /** evaluate the VGL of the first num_orbs orbitals of all the walkers with a single GEMM.
+   * The result is stored in the scratch space of the leader as a [5][nw][num_orbs] matrix.
+   */
+  const ValueMatrix& mw_evaluate_vgl_gemm(const RefVectorWithLeader<SPOSet>& spo_list,
+                                          const RefVectorWithLeader<ParticleSet>& P_list,
+                                          int iat,
+                                          size_t num_orbs) const;
+
+  ///contract the values of the basis functions in LiveAOs with the first psi.size() rows of C
+  void contract_live_v(const ValueType* restrict vals, ValueVector& psi) const;
+  ///contract the VGL of the basis functions in LiveAOs with the first num_orbs rows of C into tempv
+  void contract_live_vgl(const vgl_type& temp, size_t num_orbs, vgl_type& tempv);
+
   ///helper functions to handl Identity
   void evaluate_vgl_impl(const vgl_type& temp, ValueVector& psi, GradVector& dpsi, ValueVector& d2psi) const;
 
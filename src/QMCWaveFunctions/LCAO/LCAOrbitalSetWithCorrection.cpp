@@ -49,6 +49,59 @@ void LCAOrbitalSetWithCorrection::evaluateVGL(const ParticleSet& P,
   cusp.add_vector_vgl(P, iat, psi, dpsi, d2psi);
 }
 
+void LCAOrbitalSetWithCorrection::mw_evaluateVGL(const RefVectorWithLeader<SPOSet>& spo_list,
+                                                 const RefVectorWithLeader<ParticleSet>& P_list,
+                                                 int iat,
+                                                 const RefVector<ValueVector>& psi_v_list,
+                                                 const RefVector<GradVector>& dpsi_v_list,
+                                                 const RefVector<ValueVector>& d2psi_v_list) const
+{
+  // the per walker fallback calls evaluateVGL of this class, which already adds the cusp correction.
+  if (isIdentity() || isScreened())
+  {
+    SPOSet::mw_evaluateVGL(spo_list, P_list, iat, psi_v_list, dpsi_v_list, d2psi_v_list);
+    return;
+  }
+
+  LCAOrbitalSet::mw_evaluateVGL(spo_list, P_list, iat, psi_v_list, dpsi_v_list, d2psi_v_list);
+  for (int iw = 0; iw < spo_list.size(); iw++)
+    spo_list.getCastedElement<LCAOrbitalSetWithCorrection>(iw).cusp.add_vector_vgl(P_list[iw], iat, psi_v_list[iw],
+                                                                                     dpsi_v_list[iw],
+                                                                                     d2psi_v_list[iw]);
+}
+
+void LCAOrbitalSetWithCorrection::mw_evaluateVGLandDetRatioGrads(const RefVectorWithLeader<SPOSet>& spo_list,
+                                                                 const RefVectorWithLeader<ParticleSet>& P_list,
+                                                                 int iat,
+                                                                 const std::vector<const ValueType*>& invRow_ptr_list,
+                                                                 VGLVector& phi_vgl_v,
+                                                                 std::vector<ValueType>& ratios,
+                                                                 std::vector<GradType>& grads) const
+{
+  const size_t nw             = spo_list.size();
+  const size_t norb_requested = phi_vgl_v.size() / nw;
+  std::vector<ValueVector> phi_v, d2phi_v;
+  std::vector<GradVector> dphi_v;
+  phi_v.reserve(nw);
+  dphi_v.reserve(nw);
+  d2phi_v.reserve(nw);
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    phi_v.emplace_back(phi_vgl_v.data() + norb_requested * iw, norb_requested);
+    dphi_v.emplace_back(reinterpret_cast<GradType*>(phi_vgl_v.data(1)) + norb_requested * iw, norb_requested);
+    d2phi_v.emplace_back(phi_vgl_v.data(4) + norb_requested * iw, norb_requested);
+  }
+  // the cusp correction is added per walker on top of the batched evaluation
+  mw_evaluateVGL(spo_list, P_list, iat, makeRefVector<ValueVector>(phi_v), makeRefVector<GradVector>(dphi_v),
+                 makeRefVector<ValueVector>(d2phi_v));
+
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    ratios[iw] = simd::dot(invRow_ptr_list[iw], phi_v[iw].data(), norb_requested);
+    grads[iw]  = simd::dot(invRow_ptr_list[iw], dphi_v[iw].data(), norb_requested) / ratios[iw];
+  }
+}
+
 void LCAOrbitalSetWithCorrection::evaluateVGH(const ParticleSet& P,
                                               int iat,
                                               ValueVector& psi,
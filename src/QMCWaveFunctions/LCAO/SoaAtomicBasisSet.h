@@ -55,6 +55,10 @@ struct SoaAtomicBasisSet
   std::vector<QuantumNumberType> RnlID;
   ///temporary storage
   VectorSoaContainer<RealType, 4> tempS;
+  ///screening radius of each basis function, beyond which its magnitude is negligible
+  aligned_vector<RealType> AORcut;
+  ///the largest screening radius of this center
+  RealType ScreeningRadius;
 
   ///the constructor
   explicit SoaAtomicBasisSet(int lmax, bool addsignforM = false) : Ylm(lmax, addsignforM) {}
@@ -107,6 +111,8 @@ struct SoaAtomicBasisSet
   {
     BasisSetSize = LM.size();
     tempS.resize(std::max(Ylm.size(), RnlID.size()));
+    AORcut.assign(BasisSetSize, Rmax);
+    ScreeningRadius = Rmax;
   }
 
   /** Set Rmax */
@@ -116,6 +122,43 @@ struct SoaAtomicBasisSet
     Rmax = (rmax > 0) ? rmax : MultiRnl.rmax();
   }
 
+  /** compute the screening radius of each basis function
+   *
+   * Each radial orbital is scanned inward from Rmax on a logarithmic grid and the outermost radius
+   * where \f$ |R_{nl}(r)| r^l \f$ reaches eps becomes the screening radius of all the (l,m) channels
+   * sharing it. Must be called after setRmax and setBasisSetSize.
+   * @param eps magnitude below which a basis function is considered negligible
+   */
+  void setScreeningRadii(RealType eps)
+  {
+    constexpr int num_grid = 1000;
+    constexpr RealType rmin(1e-3);
+    const size_t num_rnl = RnlID.size();
+    std::vector<RealType> rnl_rcut(num_rnl, 0);
+    RealType* restrict phi = tempS.data(0);
+
+    const RealType ratio = std::pow(rmin / Rmax, RealType(1) / num_grid);
+    RealType r_prev      = Rmax;
+    RealType r           = Rmax * ratio;
+    for (int i = 0; i < num_grid; ++i)
+    {
+      MultiRnl.evaluate(r, phi);
+      for (size_t nl = 0; nl < num_rnl; ++nl)
+        if (rnl_rcut[nl] == 0 && std::abs(phi[nl]) * std::pow(r, RnlID[nl][q_l]) >= eps)
+          rnl_rcut[nl] = r_prev;
+      r_prev = r;
+      r *= ratio;
+    }
+
+    ScreeningRadius = 0;
+    for (size_t ib = 0; ib < BasisSetSize; ++ib)
+    {
+      // never exceeding eps is treated as negligible everywhere except the origin
+      AORcut[ib]      = (rnl_rcut[NL[ib]] > 0) ? rnl_rcut[NL[ib]] : rmin;
+      ScreeningRadius = std::max(ScreeningRadius, AORcut[ib]);
+    }
+  }
+
   ///set the current offset
   inline void setCenter(int c, int offset) {}
 
@@ -185,6 +185,64 @@ void SoaLocalizedBasisSet<COT, ORBT>::evaluateV(const ParticleSet& P, int iat, O
   }
 }
 
+template<class COT, typename ORBT>
+void SoaLocalizedBasisSet<COT, ORBT>::evaluateVGLScreened(const ParticleSet& P,
+                                                          int iat,
+                                                          vgl_type& vgl,
+                                                          std::vector<int>& live_aos)
+{
+  const auto& IonID(ions_.GroupID);
+  const auto& coordR  = P.activeR(iat);
+  const auto& d_table = P.getDistTableAB(myTableIndex);
+  const auto& dist    = (P.getActivePtcl() == iat) ? d_table.getTempDists() : d_table.getDistRow(iat);
+  const auto& displ   = (P.getActivePtcl() == iat) ? d_table.getTempDispls() : d_table.getDisplRow(iat);
+
+  live_aos.clear();
+  PosType Tv;
+  for (int c = 0; c < NumCenters; c++)
+  {
+    const auto& aos = *LOBasisSet[IonID[c]];
+    if (dist[c] >= aos.ScreeningRadius)
+      continue;
+    Tv[0] = (ions_.R[c][0] - coordR[0]) - displ[c][0];
+    Tv[1] = (ions_.R[c][1] - coordR[1]) - displ[c][1];
+    Tv[2] = (ions_.R[c][2] - coordR[2]) - displ[c][2];
+    LOBasisSet[IonID[c]]->evaluateVGL(P.getLattice(), dist[c], displ[c], BasisOffset[c], vgl, Tv);
+    for (int ib = 0; ib < aos.BasisSetSize; ib++)
+      if (dist[c] < aos.AORcut[ib])
+        live_aos.push_back(BasisOffset[c] + ib);
+  }
+}
+
+template<class COT, typename ORBT>
+void SoaLocalizedBasisSet<COT, ORBT>::evaluateVScreened(const ParticleSet& P,
+                                                        int iat,
+                                                        ORBT* restrict vals,
+                                                        std::vector<int>& live_aos)
+{
+  const auto& IonID(ions_.GroupID);
+  const auto& coordR  = P.activeR(iat);
+  const auto& d_table = P.getDistTableAB(myTableIndex);
+  const auto& dist    = (P.getActivePtcl() == iat) ? d_table.getTempDists() : d_table.getDistRow(iat);
+  const auto& displ   = (P.getActivePtcl() == iat) ? d_table.getTempDispls() : d_table.getDisplRow(iat);
+
+  live_aos.clear();
+  PosType Tv;
+  for (int c = 0; c < NumCenters; c++)
+  {
+    const auto& aos = *LOBasisSet[IonID[c]];
+    if (dist[c] >= aos.ScreeningRadius)
+      continue;
+    Tv[0] = (ions_.R[c][0] - coordR[0]) - displ[c][0];
+    Tv[1] = (ions_.R[c][1] - coordR[1]) - displ[c][1];
+    Tv[2] = (ions_.R[c][2] - coordR[2]) - displ[c][2];
+    LOBasisSet[IonID[c]]->evaluateV(P.getLattice(), dist[c], displ[c], vals + BasisOffset[c], Tv);
+    for (int ib = 0; ib < aos.BasisSetSize; ib++)
+      if (dist[c] < aos.AORcut[ib])
+        live_aos.push_back(BasisOffset[c] + ib);
+  }
+}
+
 template<class COT, typename ORBT>
 void SoaLocalizedBasisSet<COT, ORBT>::evaluateGradSourceV(const ParticleSet& P,
                                                           int iat,
@@ -133,6 +133,18 @@ public:
    */
   void evaluateV(const ParticleSet& P, int iat, ORBT* restrict vals) override;
 
+  /** compute VGL of the basis functions within their screening radius of the iat-particle
+   *
+   * Centers farther than their ScreeningRadius are skipped based on the electron-ion distance table.
+   * @param live_aos indices of the basis functions within their screening radius
+   */
+  void evaluateVGLScreened(const ParticleSet& P, int iat, vgl_type& vgl, std::vector<int>& live_aos) override;
+
+  /** compute values of the basis functions within their screening radius of the iat-particle
+   * @param live_aos indices of the basis functions within their screening radius
+   */
+  void evaluateVScreened(const ParticleSet& P, int iat, ORBT* restrict vals, std::vector<int>& live_aos) override;
+
   void evaluateGradSourceV(const ParticleSet& P, int iat, const ParticleSet& ions, int jion, vgl_type& vgl) override;
 
   void evaluateGradSourceVGL(const ParticleSet& P,
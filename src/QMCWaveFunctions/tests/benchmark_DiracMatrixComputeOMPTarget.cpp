@@ -0,0 +1,101 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** \file
+ *  This implements micro benchmarking on DiracMatrixComputeOMPTarget.hpp on CPU
+ *  against the same size matrices and batch sizes using the Legacy DiracMatrix serially.
+ */
+
+#include "catch.hpp"
+
+#include <sstream>
+#include "OhmmsPETE/OhmmsMatrix.h"
+#include "OhmmsPETE/OhmmsVector.h"
+#include "QMCWaveFunctions/Fermion/DiracMatrixComputeOMPTarget.hpp"
+#include "makeRngSpdMatrix.hpp"
+#include "Utilities/Resource.h"
+
+// Legacy CPU inversion for comparison
+#include "QMCWaveFunctions/Fermion/DiracMatrix.h"
+
+namespace qmcplusplus
+{
+template<typename T>
+using OffloadPinnedAllocator = OMPallocator<T, PinnedAlignedAllocator<T>>;
+template<typename T>
+using OffloadPinnedMatrix = Matrix<T, OffloadPinnedAllocator<T>>;
+template<typename T>
+using OffloadPinnedVector = Vector<T, OffloadPinnedAllocator<T>>;
+
+/** benchmark mw_invertTranspose and the serial legacy inversion
+ * @param n matrix size
+ * @param batch_size number of walkers
+ */
+void benchmarkDiracMatrixComputeOMPTarget(int n, int batch_size)
+{
+  std::vector<Matrix<double>> spd_mats(batch_size, {n, n});
+  std::vector<OffloadPinnedMatrix<double>> pinned_spd_mats(batch_size, {n, n});
+
+  testing::MakeRngSpdMatrix<double> makeRngSpdMatrix;
+  for (int im = 0; im < batch_size; ++im)
+  {
+    makeRngSpdMatrix(spd_mats[im]);
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j < n; ++j)
+        pinned_spd_mats[im](i, j) = spd_mats[im](i, j);
+  }
+
+  OffloadPinnedVector<std::complex<double>> log_values(batch_size);
+  std::vector<OffloadPinnedMatrix<double>> pinned_inv_mats(batch_size, {n, n});
+
+  auto a_mats = makeRefVector<const decltype(pinned_spd_mats)::value_type>(pinned_spd_mats);
+  RefVector<OffloadPinnedMatrix<double>> inv_a_mats =
+      makeRefVector<decltype(pinned_inv_mats)::value_type>(pinned_inv_mats);
+
+  std::ostringstream name;
+  name << " n=" << n << " batch=" << batch_size;
+
+  DiracMatrixComputeOMPTarget<double> dmc_omp;
+  DummyResource dummy_res;
+  BENCHMARK_ADVANCED("Batched CPU" + name.str())(Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&] { dmc_omp.mw_invertTranspose(dummy_res, a_mats, inv_a_mats, log_values); });
+  };
+
+  DiracMatrix<double> dmat;
+  std::vector<Matrix<double>> inv_mats_test(batch_size, {n, n});
+  std::vector<std::complex<double>> log_values_test(batch_size);
+  BENCHMARK_ADVANCED("legacy CPU" + name.str())(Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&] {
+      for (int im = 0; im < batch_size; ++im)
+        dmat.invert_transpose(spd_mats[im], inv_mats_test[im], log_values_test[im]);
+    });
+  };
+}
+
+/** This test will run by default.
+ */
+TEST_CASE("benchmark_DiracMatrixComputeOMPTarget_vs_legacy_64_8", "[wavefunction][fermion][benchmark]")
+{
+  benchmarkDiracMatrixComputeOMPTarget(64, 8);
+}
+
+/** This and other [.benchmark] benchmarks only run if "[benchmark]" is explicitly passed as tag to test.
+ */
+TEST_CASE("benchmark_DiracMatrixComputeOMPTarget_vs_legacy_large", "[wavefunction][fermion][.benchmark]")
+{
+  for (const int n : {128, 256, 384})
+    benchmarkDiracMatrixComputeOMPTarget(n, 16);
+}
+
+} // namespace qmcplusplus
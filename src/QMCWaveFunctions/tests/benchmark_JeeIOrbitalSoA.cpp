@@ -0,0 +1,166 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** \file
+ *  This implements micro benchmarking of the batched eeI Jastrow particle-by-particle move
+ *  against the per walker loop of the single walker API.
+ */
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <sstream>
+#include "OhmmsData/Libxml2Doc.h"
+#include "Particle/ParticleSet.h"
+#include "QMCWaveFunctions/Jastrow/PolynomialFunctor3D.h"
+#include "QMCWaveFunctions/Jastrow/JeeIOrbitalSoA.h"
+#include "QMCWaveFunctions/Jastrow/eeI_JastrowBuilder.h"
+#include <ResourceCollection.h>
+
+namespace qmcplusplus
+{
+using RealType     = WaveFunctionComponent::RealType;
+using PsiValueType = WaveFunctionComponent::PsiValueType;
+using GradType     = WaveFunctionComponent::GradType;
+using PosType      = ParticleSet::SingleParticlePos;
+
+/** a cluster of oxygen ions on a cubic grid with 8 electrons per ion
+ * @param num_ions_per_dim number of ions along each direction
+ * @param num_walkers number of walkers in the crowd
+ */
+void benchmarkJeeI(int num_ions_per_dim, int num_walkers)
+{
+  Communicate* c = OHMMS::Controller;
+
+  const double spacing = 3.0;
+  const int num_ions   = num_ions_per_dim * num_ions_per_dim * num_ions_per_dim;
+  const int num_up     = 4 * num_ions;
+
+  const SimulationCell simulation_cell;
+  ParticleSet ions(simulation_cell);
+  ParticleSet elec(simulation_cell);
+
+  ions.setName("ion");
+  ions.create({num_ions});
+  ions.getSpeciesSet().addSpecies("O");
+  int count = 0;
+  for (int i = 0; i < num_ions_per_dim; i++)
+    for (int j = 0; j < num_ions_per_dim; j++)
+      for (int k = 0; k < num_ions_per_dim; k++)
+        ions.R[count++] = PosType(i * spacing, j * spacing, k * spacing);
+  ions.update();
+
+  elec.setName("elec");
+  elec.create({num_up, num_up});
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  for (int iel = 0; iel < elec.getTotalNum(); iel++)
+    elec.R[iel] = ions.R[iel % num_ions] + PosType(0.7 * std::sin(1.3 * iel), 0.7 * std::cos(0.7 * iel), 0.3);
+
+  const char* jastrow_xml = "<jastrow name=\"J3\" type=\"eeI\" function=\"polynomial\" source=\"ion\"> \
+      <correlation ispecies=\"O\" especies=\"u\" isize=\"3\" esize=\"3\" rcut=\"4\"> \
+        <coefficients id=\"uuO\" type=\"Array\"> 8.227710241e-06 2.480817653e-06 -5.354068112e-06 -1.112644787e-05 -2.208006078e-06 5.213121933e-06 -1.537865869e-05 8.899030233e-06 6.257255156e-06 3.214580988e-06 -7.716743107e-06 -5.275682077e-06 -1.778457637e-06 7.926231121e-06 1.767406868e-06 5.451359059e-08 2.801423724e-06 4.577282736e-06 7.634608083e-06 -9.510673173e-07 -2.344131575e-06 -1.878777219e-06 3.937363358e-07 5.065353773e-07 5.086724869e-07 -1.358768154e-07</coefficients> \
+      </correlation> \
+      <correlation ispecies=\"O\" especies1=\"u\" especies2=\"d\" isize=\"3\" esize=\"3\" rcut=\"4\"> \
+        <coefficients id=\"udO\" type=\"Array\"> -6.939530224e-06 2.634169299e-05 4.046077477e-05 -8.002682388e-06 -5.396795988e-06 6.697370507e-06 5.433953051e-05 -6.336849668e-06 3.680471431e-05 -2.996059772e-05 1.99365828e-06 -3.222705626e-05 -8.091669063e-06 4.15738535e-06 4.843939112e-06 3.563650208e-07 3.786332474e-05 -1.418336941e-05 2.282691374e-05 1.29239286e-06 -4.93580873e-06 -3.052539228e-06 9.870288001e-08 1.844286407e-06 2.970561871e-07 -4.364303677e-08</coefficients> \
+      </correlation> \
+    </jastrow>";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(jastrow_xml));
+
+  eeI_JastrowBuilder jastrow(c, elec, ions);
+  auto j3 = jastrow.buildComponent(doc.getRoot());
+  REQUIRE(dynamic_cast<JeeIOrbitalSoA<PolynomialFunctor3D>*>(j3.get()) != nullptr);
+
+  std::vector<std::unique_ptr<ParticleSet>> elec_clones;
+  std::vector<std::unique_ptr<WaveFunctionComponent>> j3_clones;
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec});
+  RefVectorWithLeader<WaveFunctionComponent> j3_list(*j3, {*j3});
+  for (int iw = 1; iw < num_walkers; iw++)
+  {
+    elec_clones.push_back(std::make_unique<ParticleSet>(elec));
+    for (int iel = 0; iel < elec.getTotalNum(); iel++)
+      elec_clones.back()->R[iel] += PosType(0.05 * iw, -0.03 * iw, 0.02 * iw);
+    j3_clones.push_back(j3->makeClone(*elec_clones.back()));
+    p_list.push_back(*elec_clones.back());
+    j3_list.push_back(*j3_clones.back());
+  }
+
+  ResourceCollection pset_res("test_pset_res");
+  ResourceCollection wfc_res("test_wfc_res");
+  elec.createResource(pset_res);
+  j3->createResource(wfc_res);
+  ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(pset_res, p_list);
+  ResourceCollectionTeamLock<WaveFunctionComponent> mw_wfc_lock(wfc_res, j3_list);
+
+  std::vector<bool> isAccepted(num_walkers);
+  for (int iw = 0; iw < num_walkers; iw++)
+    isAccepted[iw] = iw % 3 != 0;
+  ParticleSet::mw_update(p_list);
+  j3->mw_recompute(j3_list, p_list, std::vector<bool>(num_walkers, true));
+
+  std::vector<PosType> displs(num_walkers);
+  std::vector<PsiValueType> ratios(num_walkers);
+  std::vector<GradType> grads(num_walkers);
+  double sign = 1.0;
+
+  auto sweep = [&](bool batched) {
+    sign = -sign;
+    for (int iw = 0; iw < num_walkers; iw++)
+      displs[iw] = PosType(0.1 * sign, -0.05 * sign, 0.07 * sign);
+    for (int iel = 0; iel < elec.getTotalNum(); iel++)
+    {
+      ParticleSet::mw_makeMove(p_list, iel, displs);
+      if (batched)
+      {
+        j3->mw_ratioGrad(j3_list, p_list, iel, ratios, grads);
+        j3->mw_accept_rejectMove(j3_list, p_list, iel, isAccepted);
+      }
+      else
+      {
+        j3->WaveFunctionComponent::mw_ratioGrad(j3_list, p_list, iel, ratios, grads);
+        j3->WaveFunctionComponent::mw_accept_rejectMove(j3_list, p_list, iel, isAccepted);
+      }
+      ParticleSet::mw_accept_rejectMove(p_list, iel, isAccepted);
+    }
+    ParticleSet::mw_donePbyP(p_list);
+  };
+
+  std::ostringstream name;
+  name << "eeI sweep ions=" << num_ions << " walkers=" << num_walkers;
+  BENCHMARK_ADVANCED(name.str() + " single walker")(Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&] { sweep(false); });
+  };
+  BENCHMARK_ADVANCED(name.str() + " batched")(Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&] { sweep(true); });
+  };
+}
+
+/** This test will run by default.
+ */
+TEST_CASE("JeeIOrbitalSoA batched benchmark small", "[wavefunction][J3][benchmark]") { benchmarkJeeI(2, 4); }
+
+/** This and other [.benchmark] benchmarks only run if "[benchmark]" is explicitly passed as tag to test.
+ */
+TEST_CASE("JeeIOrbitalSoA batched benchmark large", "[wavefunction][J3][.benchmark]")
+{
+  for (const int num_walkers : {8, 16, 32})
+    benchmarkJeeI(3, num_walkers);
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,157 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** \file
+ *  This implements micro benchmarking of the screened LCAO orbital evaluation
+ *  against the dense one on hydrogen chains of increasing length.
+ *  The screened cost per electron move should stay nearly flat while the dense cost grows with the chain.
+ */
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <sstream>
+#include "Configuration.h"
+#include "OhmmsData/Libxml2Doc.h"
+#include "Particle/ParticleSet.h"
+#include "QMCWaveFunctions/SPOSetBuilderFactory.h"
+#include "QMCWaveFunctions/LCAO/LCAOrbitalSet.h"
+
+namespace qmcplusplus
+{
+/** sposet_collection of a hydrogen chain with a 2s1p basis on each atom
+ * @param num_atoms number of atoms
+ * @param num_orbs number of orbitals
+ * @param screening value of the sposet "screening" attribute
+ */
+std::string makeHChainSPOXML(int num_atoms, int num_orbs, const std::string& screening)
+{
+  const int basis_per_atom = 5;
+  std::ostringstream xml;
+  xml << "<sposet_collection type=\"MolecularOrbital\" name=\"LCAOBSet\" source=\"ion0\" cuspCorrection=\"no\">";
+  xml << "<basisset name=\"LCAOBSet\" key=\"GTO\" transform=\"yes\">";
+  xml << "<atomicBasisSet name=\"Gaussian\" angular=\"cartesian\" type=\"Gaussian\" elementType=\"H\" "
+         "normalized=\"no\">";
+  xml << "<grid type=\"log\" ri=\"1.e-6\" rf=\"1.e2\" npts=\"1001\"/>";
+  xml << "<basisGroup rid=\"H00\" n=\"0\" l=\"0\" type=\"Gaussian\">";
+  xml << "<radfunc exponent=\"3.425250914\" contraction=\"0.1543289673\"/>";
+  xml << "<radfunc exponent=\"0.6239137298\" contraction=\"0.5353281423\"/>";
+  xml << "<radfunc exponent=\"0.1688554040\" contraction=\"0.4446345422\"/>";
+  xml << "</basisGroup>";
+  xml << "<basisGroup rid=\"H10\" n=\"1\" l=\"0\" type=\"Gaussian\">";
+  xml << "<radfunc exponent=\"0.3\" contraction=\"1.0\"/>";
+  xml << "</basisGroup>";
+  xml << "<basisGroup rid=\"H21\" n=\"2\" l=\"1\" type=\"Gaussian\">";
+  xml << "<radfunc exponent=\"0.8\" contraction=\"1.0\"/>";
+  xml << "</basisGroup>";
+  xml << "</atomicBasisSet>";
+  xml << "</basisset>";
+  xml << "<sposet name=\"spo\" size=\"" << num_orbs << "\" screening=\"" << screening << "\">";
+  xml << "<occupation mode=\"ground\"/>";
+  xml << "<coefficient size=\"" << num_orbs << "\" id=\"spoC\">";
+  // smooth delocalized orbitals, every orbital has weight on every atom
+  for (int j = 0; j < num_orbs; j++)
+    for (int ib = 0; ib < num_atoms * basis_per_atom; ib++)
+      xml << " " << std::cos(0.37 * (j + 1) * (ib / basis_per_atom)) * (1.0 - 0.1 * (ib % basis_per_atom));
+  xml << "</coefficient>";
+  xml << "</sposet>";
+  xml << "</sposet_collection>";
+  return xml.str();
+}
+
+void benchmarkLCAOScreening(int num_atoms)
+{
+  using PosType     = ParticleSet::SingleParticlePos;
+  using ValueVector = SPOSet::ValueVector;
+  using GradVector  = SPOSet::GradVector;
+
+  Communicate* c       = OHMMS::Controller;
+  const double spacing = 1.4;
+  const int num_orbs   = num_atoms / 2;
+  const int num_elec   = 2 * num_orbs;
+
+  const SimulationCell simulation_cell;
+  auto ions_ptr = std::make_unique<ParticleSet>(simulation_cell);
+  auto elec_ptr = std::make_unique<ParticleSet>(simulation_cell);
+  auto& ions(*ions_ptr);
+  auto& elec(*elec_ptr);
+
+  ions.setName("ion0");
+  ions.create({num_atoms});
+  ions.getSpeciesSet().addSpecies("H");
+  for (int i = 0; i < num_atoms; i++)
+    ions.R[i] = PosType(i * spacing, 0.0, 0.0);
+  ions.update();
+
+  elec.setName("e");
+  elec.create({num_orbs, num_orbs});
+  SpeciesSet& tspecies       = elec.getSpeciesSet();
+  int upIdx                  = tspecies.addSpecies("u");
+  int downIdx                = tspecies.addSpecies("d");
+  int massIdx                = tspecies.addAttribute("mass");
+  tspecies(massIdx, upIdx)   = 1.0;
+  tspecies(massIdx, downIdx) = 1.0;
+  for (int iel = 0; iel < num_elec; iel++)
+    elec.R[iel] = PosType((iel % num_atoms) * spacing + 0.3, 0.2 * std::sin(iel), 0.1);
+  elec.addTable(ions);
+  elec.update();
+
+  WaveFunctionComponentBuilder::PSetMap particle_set_map;
+  particle_set_map.emplace(elec_ptr->getName(), std::move(elec_ptr));
+  particle_set_map.emplace(ions_ptr->getName(), std::move(ions_ptr));
+  SPOSetBuilderFactory bf(c, elec, particle_set_map);
+
+  ValueVector psi(num_orbs), d2psi(num_orbs);
+  GradVector dpsi(num_orbs);
+  const PosType delta(0.05, -0.02, 0.03);
+
+  for (const std::string screening : {"no", "yes"})
+  {
+    Libxml2Document doc;
+    REQUIRE(doc.parseFromString(makeHChainSPOXML(num_atoms, num_orbs, screening)));
+    xmlNodePtr collection = doc.getRoot();
+    auto builder          = bf.createSPOSetBuilder(collection);
+    xmlNodePtr spo_node   = collection->children;
+    while (spo_node != nullptr && std::string((const char*)spo_node->name) != "sposet")
+      spo_node = spo_node->next;
+    REQUIRE(spo_node != nullptr);
+    auto spo = builder->createSPOSet(spo_node);
+
+    std::ostringstream name;
+    name << "VGL sweep atoms=" << num_atoms << " screening=" << screening;
+    BENCHMARK_ADVANCED(name.str())(Catch::Benchmark::Chronometer meter)
+    {
+      meter.measure([&] {
+        for (int iel = 0; iel < num_elec; iel++)
+        {
+          elec.makeMove(iel, delta);
+          spo->evaluateVGL(elec, iel, psi, dpsi, d2psi);
+          elec.rejectMove(iel);
+        }
+      });
+    };
+  }
+}
+
+/** This test will run by default.
+ */
+TEST_CASE("LCAOrbitalSet screening benchmark small", "[wavefunction][LCAO][benchmark]") { benchmarkLCAOScreening(16); }
+
+/** This and other [.benchmark] benchmarks only run if "[benchmark]" is explicitly passed as tag to test.
+ */
+TEST_CASE("LCAOrbitalSet screening benchmark scaling", "[wavefunction][LCAO][.benchmark]")
+{
+  for (const int num_atoms : {32, 64, 128, 256, 512})
+    benchmarkLCAOScreening(num_atoms);
+}
+
+} // namespace qmcplusplus
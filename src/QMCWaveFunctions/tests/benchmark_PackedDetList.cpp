@@ -0,0 +1,129 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** \file
+ *  This implements micro benchmarking of the loading of determinant lists from HDF5
+ *  with readPackedDetList and with the former string based deduplication.
+ */
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cmath>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include "OhmmsPETE/OhmmsMatrix.h"
+#include "hdf/hdf_archive.h"
+#include "QMCWaveFunctions/Fermion/PackedDetList.h"
+
+namespace qmcplusplus
+{
+/** write a MultiDet file of selected CI like expansion
+ * Determinant i of each group is drawn among about sqrt(ndets) single and double excitations of 20 electrons in 128 orbitals.
+ */
+void writeDetListForBenchmark(const std::string& filename, size_t ndets)
+{
+  const int n_int = 2;
+  const int nel   = 20;
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> occ_dist(0, nel - 1), vir_dist(nel, 127);
+  const size_t num_distinct = std::sqrt(ndets) * 4;
+  std::vector<std::array<int64_t, n_int>> distinct(num_distinct, {(int64_t(1) << nel) - 1, 0});
+  for (size_t i = 1; i < num_distinct; i++)
+    for (int ex = 0; ex < 1 + i % 2; ex++)
+    {
+      const int from = occ_dist(rng), to = vir_dist(rng);
+      distinct[i][0] &= ~(int64_t(1) << from);
+      distinct[i][to / 64] |= int64_t(1) << (to % 64);
+    }
+
+  hdf_archive hout;
+  hout.create(filename);
+  hout.push("MultiDet");
+  std::uniform_int_distribution<size_t> pick(0, num_distinct - 1);
+  for (int grp = 0; grp < 2; grp++)
+  {
+    Matrix<int64_t> ci(ndets, n_int);
+    for (size_t i = 0; i < ndets; i++)
+      std::copy_n(distinct[pick(rng)].data(), n_int, ci[i]);
+    hout.write(ci, "CI_" + std::to_string(grp));
+  }
+}
+
+void benchmarkReadDetList(size_t ndets)
+{
+  const std::string filename("benchmark_det_list.h5");
+  writeDetListForBenchmark(filename, ndets);
+  const int n_int      = 2;
+  const size_t nstates = 128;
+  std::vector<size_t> selected(ndets);
+  for (size_t i = 0; i < ndets; i++)
+    selected[i] = i;
+
+  const std::string name = " ndets=" + std::to_string(ndets);
+  BENCHMARK_ADVANCED("packed" + name)(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<PackedDetList> unique_dets(2);
+    std::vector<std::vector<size_t>> C2nodes(2);
+    meter.measure([&] {
+      hdf_archive hin;
+      hin.open(filename, H5F_ACC_RDONLY);
+      hin.push("MultiDet", false);
+      readPackedDetList(hin, ndets, n_int, nstates, selected, 1 << 17, unique_dets, C2nodes);
+    });
+  };
+
+  BENCHMARK_ADVANCED("strings" + name)(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<std::vector<size_t>> C2nodes(2);
+    meter.measure([&] {
+      hdf_archive hin;
+      hin.open(filename, H5F_ACC_RDONLY);
+      hin.push("MultiDet", false);
+      for (int grp = 0; grp < 2; grp++)
+      {
+        Matrix<int64_t> ci(ndets, n_int);
+        hin.read(ci, "CI_" + std::to_string(grp));
+        std::unordered_map<std::string, int> unique;
+        std::string occ(nstates, '0');
+        C2nodes[grp].clear();
+        for (size_t i = 0; i < ndets; i++)
+        {
+          for (int k = 0, j = 0; k < n_int; k++)
+          {
+            std::bitset<64> bits(ci[i][k]);
+            for (int b = 0; b < 64 && j < nstates; b++, j++)
+              occ[j] = bits[b] ? '1' : '0';
+          }
+          C2nodes[grp].push_back(unique.emplace(occ, unique.size()).first->second);
+        }
+      }
+    });
+  };
+}
+
+/** This test will run by default.
+ */
+TEST_CASE("readPackedDetList benchmark small", "[wavefunction][fermion][benchmark]") { benchmarkReadDetList(10000); }
+
+/** This and other [.benchmark] benchmarks only run if "[benchmark]" is explicitly passed as tag to test.
+ */
+TEST_CASE("readPackedDetList benchmark large", "[wavefunction][fermion][.benchmark]")
+{
+  for (const size_t ndets : {100000, 1000000, 4000000})
+    benchmarkReadDetList(ndets);
+}
+
+} // namespace qmcplusplus
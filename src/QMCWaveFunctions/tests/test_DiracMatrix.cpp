@@ -22,6 +22,7 @@
 #include "createTestMatrix.h"
 
 #include <stdio.h>
+#include <random>
 #include <string>
 
 using std::string;
@@ -367,4 +368,83 @@ TEST_CASE("DiracMatrix_update_row", "[wavefunction][fermion]")
   CHECKED_ELSE(check_matrix_result.result) { FAIL(check_matrix_result.result_message); }
 }
 
+TEST_CASE("DiracMatrix_update_row_auto_delay", "[wavefunction][fermion]")
+{
+  const int n = 16;
+  DiracMatrix<ValueType> dm;
+  DelayedUpdate<ValueType, QMCTraits::QTFull::ValueType> updateEng;
+  // auto-tuned delay rank, tries 1, 2, 4, 8 and 16
+  updateEng.resize(n, 0);
+
+  Matrix<ValueType> a(n, n), a_inv(n, n), a_inv_ref(n, n);
+  LogValueType log_value;
+  std::mt19937 rng(17);
+  std::uniform_real_distribution<RealType> dist(-0.5, 0.5);
+  // diagonally dominant to keep the ratios away from zero
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++)
+      a(i, j) = dist(rng) + (i == j ? n : 0);
+
+  dm.invert_transpose(a, a_inv, log_value);
+
+  Vector<ValueType> v(n), invRow(n);
+  // enough sweeps to go through all the candidates
+  for (int sweep = 0; sweep < 20; sweep++)
+  {
+    for (int iel = 0; iel < n; iel++)
+    {
+      for (int j = 0; j < n; j++)
+        v[j] = dist(rng) + (iel == j ? n : 0);
+      updateEng.getInvRow(a_inv, iel, invRow);
+      const ValueType det_ratio = simd::dot(v.data(), invRow.data(), invRow.size());
+      // accept every other move
+      if ((sweep + iel) % 2 == 0)
+      {
+        updateEng.acceptRow(a_inv, iel, v, det_ratio);
+        std::copy_n(v.data(), n, a[iel]);
+      }
+    }
+    updateEng.updateInvMat(a_inv);
+  }
+
+  dm.invert_transpose(a, a_inv_ref, log_value);
+  auto check_matrix_result = checkMatrix(a_inv, a_inv_ref);
+  CHECKED_ELSE(check_matrix_result.result) { FAIL(check_matrix_result.result_message); }
+}
+
+TEST_CASE("DelayRankTuner", "[wavefunction][fermion]")
+{
+  const int norb = 8;
+  DelayRankTuner tuner;
+  tuner.reset(norb, norb);
+  CHECK(tuner.isTuning());
+  CHECK(tuner.getDelay() == 1);
+
+  int num_updates = 0;
+  while (tuner.isTuning() && num_updates < 100)
+  {
+    for (int i = 0; i < DelayRankTuner::sweeps_per_candidate * norb; i++)
+    {
+      DelayRankTuner::ScopedMeasure measure(tuner);
+      tuner.countProposal();
+    }
+    tuner.update();
+    num_updates++;
+  }
+  CHECK(!tuner.isTuning());
+  const int delay = tuner.getDelay();
+  CHECK((delay == 1 || delay == 2 || delay == 4 || delay == 8));
+  // no population change, nothing to do
+  CHECK(!tuner.update());
+
+  // the first report sets the reference population, a 10% change is ignored, a 50% change triggers re-tuning
+  DelayRankTuner::notifyPopulation(100);
+  DelayRankTuner::notifyPopulation(110);
+  CHECK(!tuner.update());
+  DelayRankTuner::notifyPopulation(165);
+  CHECK(tuner.update());
+  CHECK(tuner.isTuning());
+  CHECK(tuner.getDelay() == 1);
+}
+
 } // namespace qmcplusplus
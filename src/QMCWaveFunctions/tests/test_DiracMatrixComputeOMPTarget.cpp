@@ -168,4 +168,43 @@ TEST_CASE("DiracMatrixComputeOMPTarget_large_determinants_against_legacy", "[wav
 }
 
 
+TEST_CASE("DiracMatrixComputeOMPTarget_batched_general_matrices_against_legacy", "[wavefunction][fermion]")
+{
+  // odd sizes to leave a partially filled group and partial panels, general matrices to exercise pivoting
+  const int n  = 37;
+  const int nw = 9;
+
+  DiracMatrixComputeOMPTarget<double> dmc_omp;
+  testing::RandomForTest<double> rng;
+
+  std::vector<OffloadPinnedMatrix<double>> mats_a(nw, {n, n});
+  std::vector<OffloadPinnedMatrix<double>> inv_mats_a(nw, {n, n});
+  RefVector<const OffloadPinnedMatrix<double>> a_mats;
+  RefVector<OffloadPinnedMatrix<double>> inv_a_mats;
+  for (int iw = 0; iw < nw; iw++)
+  {
+    rng.fillBufferRng(mats_a[iw].data(), n * n);
+    a_mats.push_back(mats_a[iw]);
+    inv_a_mats.push_back(inv_mats_a[iw]);
+  }
+
+  OffloadPinnedVector<std::complex<double>> log_values(nw);
+  DummyResource dummy_res;
+  dmc_omp.mw_invertTranspose(dummy_res, a_mats, inv_a_mats, log_values);
+
+  DiracMatrix<double> dmat;
+  Matrix<double> mat_test(n, n);
+  Matrix<double> inv_mat_test(n, n);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    std::copy_n(mats_a[iw].data(), n * n, mat_test.data());
+    std::complex<double> det_log_value;
+    dmat.invert_transpose(mat_test, inv_mat_test, det_log_value);
+    CHECK(log_values[iw] == LogComplexApprox(det_log_value));
+    auto check_matrix_result = checkMatrix(inv_mats_a[iw], inv_mat_test);
+    CHECKED_ELSE(check_matrix_result.result) { FAIL(check_matrix_result.result_message); }
+  }
+}
+
+
 } // namespace qmcplusplus
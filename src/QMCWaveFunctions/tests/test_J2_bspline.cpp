@@ -20,8 +20,10 @@
 #include "QMCWaveFunctions/Jastrow/RadialJastrowBuilder.h"
 #include "ParticleBase/ParticleAttribOps.h"
 #include "QMCWaveFunctions/Jastrow/J2OrbitalSoA.h"
+#include "ParticleIO/LatticeIO.h"
 
 #include <cstdio>
+#include <random>
 #include <string>
 
 
@@ -249,4 +251,155 @@ TEST_CASE("BSpline builder Jastrow J2", "[wavefunction]")
   REQUIRE(std::real(ratio_1) == Approx(0.9871985577));
   REQUIRE(std::real(j2->get_log_value()) == Approx(0.0883791773));
 }
+
+TEST_CASE("BSpline Jastrow J2 neighbor lists", "[wavefunction]")
+{
+  using ValueType = QMCTraits::ValueType;
+  using GradType  = QMCTraits::GradType;
+  using PosType   = QMCTraits::PosType;
+
+  Communicate* c = OHMMS::Controller;
+
+  const char* lattice_xml = "<simulationcell> \
+     <parameter name=\"lattice\" units=\"bohr\"> \
+              8.00000000        0.00000000        0.00000000 \
+              0.00000000        8.00000000        0.00000000 \
+              0.00000000        0.00000000        8.00000000 \
+     </parameter> \
+     <parameter name=\"bconds\"> p p p </parameter> \
+  </simulationcell>";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(lattice_xml));
+  ParticleSet::ParticleLayout lattice;
+  LatticeParser lp(lattice);
+  lp.put(doc.getRoot());
+  const SimulationCell simulation_cell(lattice);
+
+  ParticleSet elec(simulation_cell);
+  elec.setName("e");
+  elec.create({30, 30});
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  int massIdx                  = tspecies.addAttribute("mass");
+  tspecies(massIdx, upIdx)     = 1.0;
+  tspecies(massIdx, downIdx)   = 1.0;
+  std::mt19937 rng(5);
+  std::uniform_real_distribution<RealType> in_cell(0.0, 8.0), step(-1.0, 1.0);
+  for (int iat = 0; iat < elec.getTotalNum(); iat++)
+    elec.R[iat] = PosType(in_cell(rng), in_cell(rng), in_cell(rng));
+
+  // the dense reference and the cell-list table with the same configuration
+  ParticleSet elec_ref(elec);
+  elec.setNeighborCutoff(3.0);
+
+  const char* jastrow_xml = "<tmp> \
+<jastrow name=\"J2\" type=\"Two-Body\" function=\"Bspline\" gpu=\"no\"> \
+   <correlation rcut=\"2.5\" size=\"6\" speciesA=\"u\" speciesB=\"u\"> \
+      <coefficients id=\"uu\" type=\"Array\"> 0.31 0.22 0.15 0.09 0.04 0.01</coefficients> \
+    </correlation> \
+   <correlation rcut=\"3.0\" size=\"6\" speciesA=\"u\" speciesB=\"d\"> \
+      <coefficients id=\"ud\" type=\"Array\"> 0.52 0.37 0.24 0.13 0.05 0.02</coefficients> \
+    </correlation> \
+</jastrow> \
+<jastrow name=\"J2\" type=\"Two-Body\" function=\"Bspline\" gpu=\"no\"> \
+   <correlation rcut=\"3.5\" size=\"6\" speciesA=\"u\" speciesB=\"u\"> \
+      <coefficients id=\"uu\" type=\"Array\"> 0.31 0.22 0.15 0.09 0.04 0.01</coefficients> \
+    </correlation> \
+</jastrow> \
+</tmp>";
+  REQUIRE(doc.parseFromString(jastrow_xml));
+  xmlNodePtr jas_node = xmlFirstElementChild(doc.getRoot());
+
+  RadialJastrowBuilder jastrow(c, elec), jastrow_ref(c, elec_ref);
+  auto j2     = jastrow.buildComponent(jas_node);
+  auto j2_ref = jastrow_ref.buildComponent(jas_node);
+  REQUIRE(elec.getDistTableAA(0).getNeighborCutoff() == Approx(3.0));
+  REQUIRE(elec_ref.getDistTableAA(0).getNeighborCutoff() == 0);
+
+  // a two-body function longer than the neighbor cutoff is rejected
+  CHECK_THROWS_AS(jastrow.buildComponent(xmlNextElementSibling(jas_node)), std::runtime_error);
+
+  elec.update();
+  elec_ref.update();
+  j2->evaluateLog(elec, elec.G, elec.L);
+  j2_ref->evaluateLog(elec_ref, elec_ref.G, elec_ref.L);
+  CHECK(std::real(j2->get_log_value()) == Approx(std::real(j2_ref->get_log_value())));
+
+  const int num_ptcls = elec.getTotalNum();
+  std::vector<ValueType> ratios(num_ptcls), ratios_ref(num_ptcls);
+  for (int imove = 0; imove < 3 * num_ptcls; imove++)
+  {
+    const int iat = (imove * 7) % num_ptcls;
+    const PosType displ(step(rng), step(rng), step(rng));
+    elec.makeMove(iat, displ);
+    elec_ref.makeMove(iat, displ);
+
+    GradType grad_iat, grad_iat_ref;
+    PsiValueType ratio, ratio_ref;
+    if (imove % 2 == 0)
+    {
+      ratio     = j2->ratioGrad(elec, iat, grad_iat);
+      ratio_ref = j2_ref->ratioGrad(elec_ref, iat, grad_iat_ref);
+      for (int idim = 0; idim < OHMMS_DIM; idim++)
+        CHECK(std::real(grad_iat[idim]) == Approx(std::real(grad_iat_ref[idim])));
+    }
+    else
+    {
+      ratio     = j2->ratio(elec, iat);
+      ratio_ref = j2_ref->ratio(elec_ref, iat);
+    }
+    CHECK(std::real(ratio) == Approx(std::real(ratio_ref)));
+
+    if (imove % 10 == 0)
+    {
+      j2->evaluateRatiosAlltoOne(elec, ratios);
+      j2_ref->evaluateRatiosAlltoOne(elec_ref, ratios_ref);
+      for (int jat = 0; jat < num_ptcls; jat++)
+        CHECK(std::real(ratios[jat]) == Approx(std::real(ratios_ref[jat])));
+    }
+
+    const bool accept = imove % 3 != 0;
+    if (accept)
+    {
+      j2->acceptMove(elec, iat);
+      j2_ref->acceptMove(elec_ref, iat);
+    }
+    elec.accept_rejectMove(iat, accept, false);
+    elec_ref.accept_rejectMove(iat, accept, false);
+  }
+  elec.donePbyP();
+  elec_ref.donePbyP();
+
+  CHECK(std::real(j2->get_log_value()) == Approx(std::real(j2_ref->get_log_value())));
+  for (int iat = 0; iat < num_ptcls; iat++)
+  {
+    const GradType grad     = j2->evalGrad(elec, iat);
+    const GradType grad_ref = j2_ref->evalGrad(elec_ref, iat);
+    for (int idim = 0; idim < OHMMS_DIM; idim++)
+      CHECK(std::real(grad[idim]) == Approx(std::real(grad_ref[idim])));
+  }
+
+  // the internal data updated through the neighbor lists agree with a recompute from scratch
+  ParticleSet::ParticleGradient G(num_ptcls), G_ref(num_ptcls);
+  ParticleSet::ParticleLaplacian L(num_ptcls), L_ref(num_ptcls);
+  G = 0;
+  L = 0;
+  j2->evaluateGL(elec, G, L, false);
+  const RealType log_updated = std::real(j2->get_log_value());
+  j2->evaluateLog(elec, G_ref, L_ref);
+  CHECK(log_updated == Approx(std::real(j2->get_log_value())));
+  G_ref = 0;
+  L_ref = 0;
+  j2->evaluateGL(elec, G_ref, L_ref, false);
+  for (int iat = 0; iat < num_ptcls; iat++)
+  {
+    CHECK(std::real(L[iat]) == Approx(std::real(L_ref[iat])));
+    for (int idim = 0; idim < OHMMS_DIM; idim++)
+      CHECK(std::real(G[iat][idim]) == Approx(std::real(G_ref[iat][idim])));
+  }
+}
 } // namespace qmcplusplus
@@ -19,6 +19,8 @@
 #include "Numerics/GaussianBasisSet.h"
 #include "QMCWaveFunctions/LCAO/LCAOrbitalBuilder.h"
 #include "QMCWaveFunctions/SPOSetBuilderFactory.h"
+#include "Particle/VirtualParticleSet.h"
+#include <ResourceCollection.h>
 
 namespace qmcplusplus
 {
@@ -706,4 +708,268 @@ TEST_CASE("ReadMolecularOrbital GTO HCN", "[wavefunction]") { test_HCN(false); }
 
 TEST_CASE("ReadMolecularOrbital Numerical HCN", "[wavefunction]") { test_HCN(true); }
 
+void test_HCN_screened(bool transform)
+{
+  std::ostringstream section_name;
+  section_name << "HCN screened, transform orbitals to grid: " << (transform ? "T" : "F");
+
+  SECTION(section_name.str())
+  {
+    Communicate* c = OHMMS::Controller;
+
+    Libxml2Document doc;
+    bool okay = doc.parse("hcn.structure.xml");
+    REQUIRE(okay);
+
+    const SimulationCell simulation_cell;
+    auto ions_ptr = std::make_unique<ParticleSet>(simulation_cell);
+    auto& ions(*ions_ptr);
+    XMLParticleParser parse_ions(ions);
+    OhmmsXPathObject particleset_ion("//particleset[@name='ion0']", doc.getXPathContext());
+    REQUIRE(particleset_ion.size() == 1);
+    parse_ions.readXML(particleset_ion[0]);
+    ions.update();
+
+    auto elec_ptr = std::make_unique<ParticleSet>(simulation_cell);
+    auto& elec(*elec_ptr);
+    XMLParticleParser parse_elec(elec);
+    OhmmsXPathObject particleset_elec("//particleset[@name='e']", doc.getXPathContext());
+    REQUIRE(particleset_elec.size() == 1);
+    parse_elec.readXML(particleset_elec[0]);
+    REQUIRE(elec.R.size() == 14);
+
+    elec.R = 0.0;
+    for (int iat = 0; iat < elec.getTotalNum(); iat++)
+      elec.R[iat][0] = 1.5 * iat - 4.0;
+    elec.addTable(ions);
+    elec.update();
+
+    Libxml2Document doc2;
+    okay = doc2.parse("hcn.wfnoj.xml");
+    REQUIRE(okay);
+
+    WaveFunctionComponentBuilder::PSetMap particle_set_map;
+    particle_set_map.emplace(elec_ptr->getName(), std::move(elec_ptr));
+    particle_set_map.emplace(ions_ptr->getName(), std::move(ions_ptr));
+
+    SPOSetBuilderFactory bf(c, elec, particle_set_map);
+
+    OhmmsXPathObject MO_base("//determinantset", doc2.getXPathContext());
+    REQUIRE(MO_base.size() == 1);
+    if (!transform)
+    {
+      xmlSetProp(MO_base[0], (const xmlChar*)"transform", (const xmlChar*)"no");
+      xmlSetProp(MO_base[0], (const xmlChar*)"key", (const xmlChar*)"GTO");
+    }
+
+    const auto bb_ptr = bf.createSPOSetBuilder(MO_base[0]);
+    auto& bb(*bb_ptr);
+
+    OhmmsXPathObject slater_base("//determinant", doc2.getXPathContext());
+    auto sposet_dense = bb.createSPOSet(slater_base[0]);
+    xmlSetProp(slater_base[0], (const xmlChar*)"screening", (const xmlChar*)"yes");
+    auto sposet_screened = bb.createSPOSet(slater_base[0]);
+    REQUIRE(dynamic_cast<LCAOrbitalSet&>(*sposet_screened).isScreened());
+
+    const int norb = 7;
+    SPOSet::ValueVector values(norb), values_ref(norb);
+    SPOSet::GradVector dpsi(norb), dpsi_ref(norb);
+    SPOSet::ValueVector d2psi(norb), d2psi_ref(norb);
+
+    // points next to the molecule and far enough to screen out N and C centers
+    const std::vector<ParticleSet::SingleParticlePos> positions{{0.1, 0.2, -0.3}, {4.5, 0.5, 0.0}, {9.0, 0.0, 1.0}};
+    for (const auto& pos : positions)
+    {
+      elec.makeMove(0, pos - elec.R[0]);
+
+      sposet_dense->evaluateValue(elec, 0, values_ref);
+      sposet_screened->evaluateValue(elec, 0, values);
+      for (int j = 0; j < norb; j++)
+        CHECK(values[j] == Approx(values_ref[j]).margin(1e-6));
+
+      sposet_dense->evaluateVGL(elec, 0, values_ref, dpsi_ref, d2psi_ref);
+      sposet_screened->evaluateVGL(elec, 0, values, dpsi, d2psi);
+      for (int j = 0; j < norb; j++)
+      {
+        CHECK(values[j] == Approx(values_ref[j]).margin(1e-6));
+        CHECK(dpsi[j][0] == Approx(dpsi_ref[j][0]).margin(1e-6));
+        CHECK(dpsi[j][1] == Approx(dpsi_ref[j][1]).margin(1e-6));
+        CHECK(dpsi[j][2] == Approx(dpsi_ref[j][2]).margin(1e-6));
+        CHECK(d2psi[j] == Approx(d2psi_ref[j]).margin(1e-6));
+      }
+      elec.rejectMove(0);
+    }
+
+    SPOSet::ValueMatrix psiM(elec.R.size(), norb), psiM_ref(elec.R.size(), norb);
+    SPOSet::GradMatrix dpsiM(elec.R.size(), norb), dpsiM_ref(elec.R.size(), norb);
+    SPOSet::ValueMatrix d2psiM(elec.R.size(), norb), d2psiM_ref(elec.R.size(), norb);
+    sposet_dense->evaluate_notranspose(elec, 0, elec.R.size(), psiM_ref, dpsiM_ref, d2psiM_ref);
+    sposet_screened->evaluate_notranspose(elec, 0, elec.R.size(), psiM, dpsiM, d2psiM);
+    for (int iat = 0; iat < elec.R.size(); iat++)
+      for (int j = 0; j < norb; j++)
+      {
+        CHECK(psiM[iat][j] == Approx(psiM_ref[iat][j]).margin(1e-6));
+        CHECK(dpsiM[iat][j][0] == Approx(dpsiM_ref[iat][j][0]).margin(1e-6));
+        CHECK(d2psiM[iat][j] == Approx(d2psiM_ref[iat][j]).margin(1e-6));
+      }
+  }
+}
+
+TEST_CASE("ReadMolecularOrbital screened GTO HCN", "[wavefunction]") { test_HCN_screened(false); }
+
+TEST_CASE("ReadMolecularOrbital screened Numerical HCN", "[wavefunction]") { test_HCN_screened(true); }
+
+void test_HCN_mw(bool transform)
+{
+  std::ostringstream section_name;
+  section_name << "HCN batched, transform orbitals to grid: " << (transform ? "T" : "F");
+
+  SECTION(section_name.str())
+  {
+    using PosType   = ParticleSet::SingleParticlePos;
+    using ValueType = SPOSet::ValueType;
+    using GradType  = SPOSet::GradType;
+
+    Communicate* c = OHMMS::Controller;
+
+    Libxml2Document doc;
+    bool okay = doc.parse("hcn.structure.xml");
+    REQUIRE(okay);
+
+    const SimulationCell simulation_cell;
+    auto ions_ptr = std::make_unique<ParticleSet>(simulation_cell);
+    auto& ions(*ions_ptr);
+    XMLParticleParser parse_ions(ions);
+    OhmmsXPathObject particleset_ion("//particleset[@name='ion0']", doc.getXPathContext());
+    REQUIRE(particleset_ion.size() == 1);
+    parse_ions.readXML(particleset_ion[0]);
+    ions.update();
+
+    auto elec_ptr = std::make_unique<ParticleSet>(simulation_cell);
+    auto& elec(*elec_ptr);
+    XMLParticleParser parse_elec(elec);
+    OhmmsXPathObject particleset_elec("//particleset[@name='e']", doc.getXPathContext());
+    REQUIRE(particleset_elec.size() == 1);
+    parse_elec.readXML(particleset_elec[0]);
+    REQUIRE(elec.R.size() == 14);
+
+    elec.R = 0.0;
+    for (int iat = 0; iat < elec.getTotalNum(); iat++)
+      elec.R[iat][0] = 0.5 * iat - 2.0;
+    elec.addTable(ions);
+    elec.update();
+
+    Libxml2Document doc2;
+    okay = doc2.parse("hcn.wfnoj.xml");
+    REQUIRE(okay);
+
+    WaveFunctionComponentBuilder::PSetMap particle_set_map;
+    particle_set_map.emplace(elec_ptr->getName(), std::move(elec_ptr));
+    particle_set_map.emplace(ions_ptr->getName(), std::move(ions_ptr));
+
+    SPOSetBuilderFactory bf(c, elec, particle_set_map);
+
+    OhmmsXPathObject MO_base("//determinantset", doc2.getXPathContext());
+    REQUIRE(MO_base.size() == 1);
+    if (!transform)
+    {
+      xmlSetProp(MO_base[0], (const xmlChar*)"transform", (const xmlChar*)"no");
+      xmlSetProp(MO_base[0], (const xmlChar*)"key", (const xmlChar*)"GTO");
+    }
+
+    const auto bb_ptr = bf.createSPOSetBuilder(MO_base[0]);
+    auto& bb(*bb_ptr);
+
+    OhmmsXPathObject slater_base("//determinant", doc2.getXPathContext());
+    auto sposet       = bb.createSPOSet(slater_base[0]);
+    auto sposet_clone = sposet->makeClone();
+
+    ParticleSet elec_clone(elec);
+    for (int iat = 0; iat < elec_clone.getTotalNum(); iat++)
+      elec_clone.R[iat] = PosType(0.3 * iat - 1.0, 0.2, -0.1 * iat);
+    elec_clone.update();
+
+    RefVectorWithLeader<SPOSet> spo_list(*sposet, {*sposet, *sposet_clone});
+    RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec_clone});
+    ResourceCollection spo_res("test_spo_res");
+    sposet->createResource(spo_res);
+    ResourceCollectionTeamLock<SPOSet> mw_spo_lock(spo_res, spo_list);
+
+    // use fewer orbitals than available to exercise the partial contraction
+    const int norb = 5;
+    const int iat  = 3;
+    SPOSet::ValueVector psi_0(norb), psi_1(norb), psi_ref(norb);
+    SPOSet::GradVector dpsi_0(norb), dpsi_1(norb), dpsi_ref(norb);
+    SPOSet::ValueVector d2psi_0(norb), d2psi_1(norb), d2psi_ref(norb);
+    RefVector<SPOSet::ValueVector> psi_v_list{psi_0, psi_1};
+    RefVector<SPOSet::GradVector> dpsi_v_list{dpsi_0, dpsi_1};
+    RefVector<SPOSet::ValueVector> d2psi_v_list{d2psi_0, d2psi_1};
+
+    sposet->mw_evaluateVGL(spo_list, p_list, iat, psi_v_list, dpsi_v_list, d2psi_v_list);
+    for (int iw = 0; iw < spo_list.size(); iw++)
+    {
+      spo_list[iw].evaluateVGL(p_list[iw], iat, psi_ref, dpsi_ref, d2psi_ref);
+      for (int j = 0; j < norb; j++)
+      {
+        CHECK(psi_v_list[iw].get()[j] == Approx(psi_ref[j]));
+        CHECK(dpsi_v_list[iw].get()[j][0] == Approx(dpsi_ref[j][0]));
+        CHECK(dpsi_v_list[iw].get()[j][1] == Approx(dpsi_ref[j][1]));
+        CHECK(dpsi_v_list[iw].get()[j][2] == Approx(dpsi_ref[j][2]));
+        CHECK(d2psi_v_list[iw].get()[j] == Approx(d2psi_ref[j]));
+      }
+    }
+
+    // arbitrary rows of inverse matrices
+    SPOSet::ValueVector inv_row_0(norb), inv_row_1(norb);
+    for (int j = 0; j < norb; j++)
+    {
+      inv_row_0[j] = 0.1 * (j + 1);
+      inv_row_1[j] = 0.3 - 0.05 * j;
+    }
+    std::vector<const ValueType*> inv_row_ptr_list{inv_row_0.data(), inv_row_1.data()};
+
+    SPOSet::VGLVector phi_vgl_v(norb * spo_list.size());
+    std::vector<ValueType> ratios(spo_list.size());
+    std::vector<GradType> grads(spo_list.size());
+    sposet->mw_evaluateVGLandDetRatioGrads(spo_list, p_list, iat, inv_row_ptr_list, phi_vgl_v, ratios, grads);
+    for (int iw = 0; iw < spo_list.size(); iw++)
+    {
+      spo_list[iw].evaluateVGL(p_list[iw], iat, psi_ref, dpsi_ref, d2psi_ref);
+      const ValueType ratio_ref = simd::dot(inv_row_ptr_list[iw], psi_ref.data(), norb);
+      const GradType grad_ref   = simd::dot(inv_row_ptr_list[iw], dpsi_ref.data(), norb) / ratio_ref;
+      CHECK(ratios[iw] == Approx(ratio_ref));
+      CHECK(grads[iw][0] == Approx(grad_ref[0]));
+      CHECK(grads[iw][1] == Approx(grad_ref[1]));
+      CHECK(grads[iw][2] == Approx(grad_ref[2]));
+      for (int j = 0; j < norb; j++)
+      {
+        CHECK(phi_vgl_v.data(0)[norb * iw + j] == Approx(psi_ref[j]));
+        CHECK(phi_vgl_v.data(4)[norb * iw + j] == Approx(d2psi_ref[j]));
+      }
+    }
+
+    const int nknot = 3;
+    VirtualParticleSet vp(elec, nknot), vp_clone(elec_clone, nknot);
+    std::vector<PosType> deltaV{{0.1, 0.2, 0.3}, {-0.3, 0.1, 0.2}, {0.2, -0.1, -0.3}};
+    vp.makeMoves(iat, elec.R[iat], deltaV);
+    vp_clone.makeMoves(iat, elec_clone.R[iat], deltaV);
+    RefVectorWithLeader<const VirtualParticleSet> vp_list(vp, {vp, vp_clone});
+
+    std::vector<std::vector<ValueType>> ratios_list(spo_list.size(), std::vector<ValueType>(nknot));
+    sposet->mw_evaluateDetRatios(spo_list, vp_list, psi_v_list, inv_row_ptr_list, ratios_list);
+    for (int iw = 0; iw < spo_list.size(); iw++)
+      for (int k = 0; k < nknot; k++)
+      {
+        p_list[iw].makeMove(iat, deltaV[k]);
+        spo_list[iw].evaluateValue(p_list[iw], iat, psi_ref);
+        p_list[iw].rejectMove(iat);
+        CHECK(ratios_list[iw][k] == Approx(simd::dot(inv_row_ptr_list[iw], psi_ref.data(), norb)));
+      }
+  }
+}
+
+TEST_CASE("ReadMolecularOrbital batched GTO HCN", "[wavefunction]") { test_HCN_mw(false); }
+
+TEST_CASE("ReadMolecularOrbital batched Numerical HCN", "[wavefunction]") { test_HCN_mw(true); }
+
 } // namespace qmcplusplus
@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include "OhmmsPETE/OhmmsMatrix.h"
+#include "hdf/hdf_archive.h"
+#include "QMCWaveFunctions/Fermion/PackedDetList.h"
+
+namespace qmcplusplus
+{
+TEST_CASE("PackedDetList insert", "[wavefunction][fermion]")
+{
+  PackedDetList dets(2);
+  const uint64_t a[2]{0b1011, 1}, b[2]{0b1011, 2}, c[2]{0b1011, 1};
+  CHECK(dets.insert(a, PackedDetList::hash(a, 2)) == 0);
+  CHECK(dets.insert(b, PackedDetList::hash(b, 2)) == 1);
+  CHECK(dets.insert(c, PackedDetList::hash(c, 2)) == 0);
+  CHECK(dets.size() == 2);
+
+  std::vector<int> occup(4);
+  CHECK(dets.getOccupied(1, occup) == 4);
+  CHECK(occup == std::vector<int>{0, 1, 3, 65});
+
+  // many determinants to go through the growth of the table
+  PackedDetList many(1);
+  size_t num_wrong = 0;
+  for (int pass = 0; pass < 2; pass++)
+    for (uint64_t i = 0; i < 5000; i++)
+      if (many.insert(&i, PackedDetList::hash(&i, 1)) != i)
+        num_wrong++;
+  CHECK(num_wrong == 0);
+  CHECK(many.size() == 5000);
+}
+
+TEST_CASE("readPackedDetList", "[wavefunction][fermion]")
+{
+  // 70 orbitals in 2 words, 7 determinants
+  const size_t ndets = 7;
+  const int n_int    = 2;
+  Matrix<int64_t> ci_0(ndets, n_int), ci_1(ndets, n_int);
+  const int64_t up[ndets][n_int]{{0b0111, 0}, {0b1011, 0}, {0b0111, 0}, {0b0111, 1},
+                                 {0b1011, 0}, {0b0110, 1}, {0b0111, int64_t(1) << 40}};
+  const int64_t dn[ndets][n_int]{{0b0111, 0},  {0b0111, 0}, {0b1011, 0}, {0b0111, 0},
+                                 {-1, -1}, {0b0111, 0}, {0b0111, 0}};
+  for (int i = 0; i < ndets; i++)
+    for (int k = 0; k < n_int; k++)
+    {
+      ci_0(i, k) = up[i][k];
+      ci_1(i, k) = dn[i][k];
+    }
+
+  {
+    hdf_archive hout;
+    hout.create("test_packed_det_list.h5");
+    hout.push("MultiDet");
+    hout.write(ci_0, "CI_0");
+    hout.write(ci_1, "CI_1");
+  }
+
+  hdf_archive hin;
+  REQUIRE(hin.open("test_packed_det_list.h5", H5F_ACC_RDONLY));
+  REQUIRE(hin.push("MultiDet", false) >= 0);
+
+  // determinant 4 is left out, chunks of 3 determinants
+  const std::vector<size_t> selected{0, 1, 2, 3, 5, 6};
+  std::vector<PackedDetList> unique_dets(2);
+  std::vector<std::vector<size_t>> C2nodes(2);
+  readPackedDetList(hin, ndets, n_int, 70, selected, 3, unique_dets, C2nodes);
+
+  // the orbital 104 of determinant 6 is beyond the 70 orbitals and ignored
+  CHECK(C2nodes[0] == std::vector<size_t>{0, 1, 0, 2, 3, 0});
+  CHECK(C2nodes[1] == std::vector<size_t>{0, 0, 1, 0, 0, 0});
+  REQUIRE(unique_dets[0].size() == 4);
+  REQUIRE(unique_dets[1].size() == 2);
+
+  std::vector<size_t> occup(4);
+  CHECK(unique_dets[0].getOccupied(2, occup) == 4);
+  CHECK(occup == std::vector<size_t>{0, 1, 2, 64});
+  CHECK(unique_dets[0].getOccupied(3, occup) == 3);
+  CHECK(occup[0] == 1);
+  CHECK(occup[1] == 2);
+  CHECK(occup[2] == 64);
+  CHECK(unique_dets[1].getOccupied(1, occup) == 3);
+  CHECK(occup[0] == 0);
+  CHECK(occup[1] == 1);
+  CHECK(occup[2] == 3);
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,199 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include <random>
+#include "OhmmsData/Libxml2Doc.h"
+#include "Particle/ParticleSet.h"
+#include "ParticleIO/LatticeIO.h"
+#include "QMCWaveFunctions/ElectronGas/ElectronGasOrbitalBuilder.h"
+#include "QMCWaveFunctions/Fermion/SlaterDetWithBackflow.h"
+#include "ResourceCollection.h"
+
+namespace qmcplusplus
+{
+using PsiValueType = WaveFunctionComponent::PsiValueType;
+using GradType     = WaveFunctionComponent::GradType;
+using PosType      = QMCTraits::PosType;
+
+TEST_CASE("SlaterDetWithBackflow batched", "[wavefunction][fermion]")
+{
+  Communicate* c = OHMMS::Controller;
+
+  const char* lattice_xml = "<simulationcell> \
+     <parameter name=\"lattice\" units=\"bohr\"> \
+              6.00000000        0.00000000        0.00000000 \
+              0.00000000        6.00000000        0.00000000 \
+              0.00000000        0.00000000        6.00000000 \
+     </parameter> \
+     <parameter name=\"bconds\"> p p p </parameter> \
+  </simulationcell>";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(lattice_xml));
+  ParticleSet::ParticleLayout lattice;
+  LatticeParser lp(lattice);
+  lp.put(doc.getRoot());
+  const SimulationCell simulation_cell(lattice);
+
+  ParticleSet elec(simulation_cell);
+  elec.setName("e");
+  elec.create({7, 7});
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+
+  std::mt19937 rng(17);
+  std::uniform_real_distribution<double> in_cell(0.0, 6.0);
+  for (int i = 0; i < elec.getTotalNum(); i++)
+    for (int idim = 0; idim < 3; idim++)
+      elec.R[i][idim] = in_cell(rng);
+
+  const char* wfs_xml = "<determinantset type=\"electron-gas\" shell=\"1\" shell2=\"1\"> \
+  <backflow> \
+    <transformation name=\"eeB\" type=\"e-e\" function=\"Bspline\"> \
+      <correlation cusp=\"0.0\" speciesA=\"u\" speciesB=\"u\" size=\"5\" type=\"shortrange\" init=\"no\"> \
+        <coefficients id=\"eeuu\" type=\"Array\"> 0.0106 0.0617 0.0825 0.0199 0.0284 </coefficients> \
+      </correlation> \
+      <correlation cusp=\"0.0\" speciesA=\"u\" speciesB=\"d\" size=\"5\" type=\"shortrange\" init=\"no\"> \
+        <coefficients id=\"eeud\" type=\"Array\"> 0.5825 0.2722 0.1645 0.0751 0.0389 </coefficients> \
+      </correlation> \
+    </transformation> \
+  </backflow> \
+</determinantset>";
+  REQUIRE(doc.parseFromString(wfs_xml));
+  ElectronGasOrbitalBuilder eg_builder(c, elec);
+  auto sdet = eg_builder.buildComponent(doc.getRoot());
+  REQUIRE(dynamic_cast<SlaterDetWithBackflow*>(sdet.get()) != nullptr);
+
+  // two walkers driven by the batched API and their copies driven by the single walker API
+  const int nw = 2;
+  std::vector<std::unique_ptr<ParticleSet>> psets, psets_ref;
+  std::vector<std::unique_ptr<WaveFunctionComponent>> wfcs, wfcs_ref;
+  std::vector<WaveFunctionComponent::WFBufferType> buffers(nw);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    psets.push_back(std::make_unique<ParticleSet>(elec));
+    psets_ref.push_back(std::make_unique<ParticleSet>(elec));
+    // move the second walker away from the first one
+    for (int i = 0; i < elec.getTotalNum(); i++)
+    {
+      psets[iw]->R[i] += PosType(0.1 * iw, 0.05 * iw * i, -0.1 * iw);
+      psets_ref[iw]->R[i] = psets[iw]->R[i];
+    }
+    psets[iw]->update();
+    psets_ref[iw]->update();
+    wfcs.push_back(sdet->makeClone(*psets[iw]));
+    wfcs_ref.push_back(sdet->makeClone(*psets_ref[iw]));
+    // the single walker particle-by-particle moves need the buffer
+    wfcs_ref[iw]->registerData(*psets_ref[iw], buffers[iw]);
+    psets_ref[iw]->G = 0;
+    psets_ref[iw]->L = 0;
+    wfcs_ref[iw]->evaluateLog(*psets_ref[iw], psets_ref[iw]->G, psets_ref[iw]->L);
+    psets[iw]->G = 0;
+    psets[iw]->L = 0;
+    wfcs[iw]->evaluateLog(*psets[iw], psets[iw]->G, psets[iw]->L);
+    CHECK(std::real(wfcs[iw]->get_log_value()) == Approx(std::real(wfcs_ref[iw]->get_log_value())));
+  }
+
+  RefVectorWithLeader<ParticleSet> p_list(*psets[0], {*psets[0], *psets[1]});
+  RefVectorWithLeader<WaveFunctionComponent> wfc_list(*wfcs[0], {*wfcs[0], *wfcs[1]});
+  ResourceCollection wfc_res("test_wfc_res");
+  wfcs[0]->createResource(wfc_res);
+  ResourceCollectionTeamLock<WaveFunctionComponent> mw_wfc_lock(wfc_res, wfc_list);
+
+  const std::vector<PosType> displs{{0.3, -0.2, 0.1}, {-0.1, 0.25, 0.2}};
+  const std::vector<bool> isAccepted{true, false};
+  std::vector<PsiValueType> ratios(nw);
+  std::vector<GradType> grads(nw);
+
+  // an up electron with gradients, accepted on the first walker only
+  const int iat = 2;
+  for (int iw = 0; iw < nw; iw++)
+  {
+    psets[iw]->makeMove(iat, displs[iw]);
+    psets_ref[iw]->makeMove(iat, displs[iw]);
+    grads[iw] = 0;
+  }
+  wfcs[0]->mw_ratioGrad(wfc_list, p_list, iat, ratios, grads);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    GradType grad_ref(0);
+    const PsiValueType ratio_ref = wfcs_ref[iw]->ratioGrad(*psets_ref[iw], iat, grad_ref);
+    CHECK(ratios[iw] == ValueApprox(ratio_ref));
+    for (int idim = 0; idim < 3; idim++)
+      CHECK(grads[iw][idim] == ValueApprox(grad_ref[idim]));
+  }
+  wfcs[0]->mw_accept_rejectMove(wfc_list, p_list, iat, isAccepted);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    psets[iw]->accept_rejectMove(iat, isAccepted[iw]);
+    if (isAccepted[iw])
+      wfcs_ref[iw]->acceptMove(*psets_ref[iw], iat);
+    else
+      wfcs_ref[iw]->restore(iat);
+    psets_ref[iw]->accept_rejectMove(iat, isAccepted[iw]);
+  }
+
+  // a down electron without gradients sees the accepted quasi-particle coordinates
+  const int jat = 9;
+  for (int iw = 0; iw < nw; iw++)
+  {
+    psets[iw]->makeMove(jat, displs[1 - iw]);
+    psets_ref[iw]->makeMove(jat, displs[1 - iw]);
+  }
+  wfcs[0]->mw_calcRatio(wfc_list, p_list, jat, ratios);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    CHECK(ratios[iw] == ValueApprox(wfcs_ref[iw]->ratio(*psets_ref[iw], jat)));
+    const GradType grad     = wfcs[iw]->evalGrad(*psets[iw], iat);
+    const GradType grad_ref = wfcs_ref[iw]->evalGrad(*psets_ref[iw], iat);
+    for (int idim = 0; idim < 3; idim++)
+      CHECK(grad[idim] == ValueApprox(grad_ref[idim]));
+  }
+}
+
+TEST_CASE("BackflowTransformation neighbor lists", "[wavefunction][fermion]")
+{
+  const char* lattice_xml = "<simulationcell> \
+     <parameter name=\"lattice\" units=\"bohr\"> \
+              6.00000000        0.00000000        0.00000000 \
+              0.00000000        6.00000000        0.00000000 \
+              0.00000000        0.00000000        6.00000000 \
+     </parameter> \
+     <parameter name=\"bconds\"> p p p </parameter> \
+  </simulationcell>";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(lattice_xml));
+  ParticleSet::ParticleLayout lattice;
+  LatticeParser lp(lattice);
+  lp.put(doc.getRoot());
+  const SimulationCell simulation_cell(lattice);
+
+  ParticleSet elec(simulation_cell);
+  elec.setName("e");
+  elec.create({4, 4});
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  elec.setNeighborCutoff(2.5);
+
+  // the cell-list e-e table doesn't fill the temp displacements of the moved particle
+  CHECK_THROWS_AS(BackflowTransformation(elec), std::runtime_error);
+}
+} // namespace qmcplusplus
@@ -400,4 +400,114 @@ TEST_CASE("CountingJastrow","[wavefunction]")
 
 }
 
+TEST_CASE("CountingJastrow batched", "[wavefunction]")
+{
+  using PosType      = QMCTraits::PosType;
+  using GradType     = WaveFunctionComponent::GradType;
+  using PsiValueType = WaveFunctionComponent::PsiValueType;
+
+  Communicate* c = OHMMS::Controller;
+
+  const SimulationCell simulation_cell;
+  ParticleSet elec(simulation_cell);
+  elec.setName("e");
+  elec.create({4});
+  elec.R[0] = {2.4601162537, 6.7476360528, -1.9073129953};
+  elec.R[1] = {2.2585811248, 2.1282254384, 0.051545776028};
+  elec.R[2] = {0.84796873937, 5.1735597110, 0.84642416761};
+  elec.R[3] = {3.1597337850, 5.1079432473, 1.0545953717};
+
+  const char* cj_xml = "<jastrow name=\"ncjf_normgauss\" type=\"Counting\">\
+      <var name=\"F\" opt=\"true\">\
+        4.4903e-01 5.3502e-01 5.2550e-01\
+                   5.1408e-01 4.8658e-01\
+                              0.0000e+00\
+      </var>\
+      <region type=\"normalized_gaussian\" reference_id=\"g0\" opt=\"true\" >\
+        <function id=\"g0\">\
+          <var name=\"A\" opt=\"False\">-1.0 -0.0 -0.0 -1.0 -0.0 -1.0</var>\
+          <var name=\"B\" opt=\"False\">-2.6136335251 -5.01928226905 0.0</var>\
+          <var name=\"C\" opt=\"False\">-32.0242747</var>\
+        </function>\
+        <function id=\"g1\">\
+          <var name=\"A\" opt=\"true\">-1.0 -0.0 -0.0 -1.0 -0.0 -1.0</var>\
+          <var name=\"B\" opt=\"true\">-3.74709851168 -3.70007145722 0.0</var>\
+          <var name=\"C\" opt=\"true\">-27.7312760448</var>\
+        </function>\
+        <function id=\"g2\">\
+          <var name=\"A\" opt=\"true\">-1.0 -0.0 -0.0 -1.0 -0.0 -1.0</var>\
+          <var name=\"B\" opt=\"true\">-6.11011670935 -1.66504047682 0.0</var>\
+          <var name=\"C\" opt=\"true\">-40.1058859913</var>\
+        </function>\
+      </region>\
+    </jastrow>";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(cj_xml));
+  CountingJastrowBuilder cjb(c, elec);
+  auto cj = cjb.buildComponent(doc.getRoot());
+
+  // two walkers driven by the batched API and their copies driven by the single walker API
+  const int nw = 2;
+  std::vector<std::unique_ptr<ParticleSet>> psets, psets_ref;
+  std::vector<std::unique_ptr<WaveFunctionComponent>> wfcs, wfcs_ref;
+  for (int iw = 0; iw < nw; iw++)
+  {
+    psets.push_back(std::make_unique<ParticleSet>(elec));
+    for (int i = 0; i < elec.getTotalNum(); i++)
+      psets[iw]->R[i] += PosType(0.3 * iw, -0.2 * iw, 0.1 * iw * i);
+    psets_ref.push_back(std::make_unique<ParticleSet>(*psets[iw]));
+    wfcs.push_back(cj->makeClone(*psets[iw]));
+    wfcs_ref.push_back(cj->makeClone(*psets_ref[iw]));
+    wfcs[iw]->evaluateLog(*psets[iw], psets[iw]->G, psets[iw]->L);
+    wfcs_ref[iw]->evaluateLog(*psets_ref[iw], psets_ref[iw]->G, psets_ref[iw]->L);
+  }
+
+  RefVectorWithLeader<ParticleSet> p_list(*psets[0], {*psets[0], *psets[1]});
+  RefVectorWithLeader<WaveFunctionComponent> wfc_list(*wfcs[0], {*wfcs[0], *wfcs[1]});
+
+  const std::vector<PosType> displs{{0.0984629815, 0.0144420719, 0.1334309321},
+                                    {-0.1026409581, 0.2289767772, 0.490138058592}};
+  const std::vector<bool> isAccepted{true, false};
+  std::vector<PsiValueType> ratios(nw);
+  std::vector<GradType> grads(nw);
+
+  const int iat = 1;
+  for (int iw = 0; iw < nw; iw++)
+  {
+    psets[iw]->makeMove(iat, displs[iw]);
+    psets_ref[iw]->makeMove(iat, displs[iw]);
+    grads[iw] = 0;
+  }
+  wfcs[0]->mw_ratioGrad(wfc_list, p_list, iat, ratios, grads);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    GradType grad_ref(0);
+    const PsiValueType ratio_ref = wfcs_ref[iw]->ratioGrad(*psets_ref[iw], iat, grad_ref);
+    CHECK(ratios[iw] == ValueApprox(ratio_ref));
+    for (int idim = 0; idim < 3; idim++)
+      CHECK(grads[iw][idim] == ValueApprox(grad_ref[idim]));
+  }
+  wfcs[0]->mw_accept_rejectMove(wfc_list, p_list, iat, isAccepted);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    psets[iw]->accept_rejectMove(iat, isAccepted[iw]);
+    if (isAccepted[iw])
+      wfcs_ref[iw]->acceptMove(*psets_ref[iw], iat);
+    else
+      wfcs_ref[iw]->restore(iat);
+    psets_ref[iw]->accept_rejectMove(iat, isAccepted[iw]);
+    CHECK(std::real(wfcs[iw]->get_log_value()) == Approx(std::real(wfcs_ref[iw]->get_log_value())));
+  }
+
+  const int jat = 2;
+  for (int iw = 0; iw < nw; iw++)
+  {
+    psets[iw]->makeMove(jat, displs[1 - iw]);
+    psets_ref[iw]->makeMove(jat, displs[1 - iw]);
+  }
+  wfcs[0]->mw_calcRatio(wfc_list, p_list, jat, ratios);
+  for (int iw = 0; iw < nw; iw++)
+    CHECK(ratios[iw] == ValueApprox(wfcs_ref[iw]->ratio(*psets_ref[iw], jat)));
+}
+
 } //namespace qmcplusplus
@@ -19,10 +19,12 @@
 #include "QMCWaveFunctions/WaveFunctionComponent.h"
 #include "QMCWaveFunctions/EinsplineSetBuilder.h"
 #include "QMCWaveFunctions/EinsplineSpinorSetBuilder.h"
+#include "QMCWaveFunctions/BsplineFactory/SplineCoefsCache.h"
 
 #include <stdio.h>
 #include <string>
 #include <limits>
+#include <fstream>
 
 using std::string;
 
@@ -621,4 +623,150 @@ TEST_CASE("EinsplineSetBuilder CheckLattice", "[wavefunction]")
   REQUIRE_FALSE(esb.CheckLattice());
 }
 
+TEST_CASE("SplineCoefsCache write and map", "[wavefunction]")
+{
+  SplineCoefsCache::Key key;
+  key.hash        = 12345;
+  key.coefs_size  = 3 * 1000 * 1000 + 7;
+  key.data_size   = sizeof(float);
+  key.grid[0]     = 10;
+  key.grid[1]     = 11;
+  key.grid[2]     = 12;
+  key.num_splines = 16;
+  key.first_band  = 0;
+  key.last_band   = 13;
+
+  std::vector<float> coefs(key.coefs_size);
+  for (size_t i = 0; i < coefs.size(); i++)
+    coefs[i] = 0.25f * (i % 1001);
+
+  const std::string filename = SplineCoefsCache::getFileName("spline_cache_test", key);
+  REQUIRE(SplineCoefsCache::write(filename, key, coefs.data()));
+
+  {
+    auto mapped = SplineCoefsCache::map(filename, key);
+    REQUIRE(mapped);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(mapped->coefs()) % 4096 == 0);
+    const float* mapped_coefs = static_cast<const float*>(mapped->coefs());
+    for (size_t i = 0; i < coefs.size(); i += 997)
+      CHECK(mapped_coefs[i] == coefs[i]);
+    CHECK(mapped_coefs[coefs.size() - 1] == coefs.back());
+  }
+
+  // a different table
+  SplineCoefsCache::Key other_key = key;
+  other_key.hash                  = 54321;
+  CHECK(!SplineCoefsCache::map(filename, other_key));
+  other_key           = key;
+  other_key.last_band = 12;
+  CHECK(!SplineCoefsCache::map(filename, other_key));
+
+  // a corrupted table
+  {
+    std::fstream fio(filename, std::ios::binary | std::ios::in | std::ios::out);
+    fio.seekp(SplineCoefsCache::header_bytes + 4 * 123456);
+    const float bad_value = -1.0f;
+    fio.write(reinterpret_cast<const char*>(&bad_value), sizeof(float));
+  }
+  CHECK(!SplineCoefsCache::map(filename, key));
+
+  // a missing file
+  std::remove(filename.c_str());
+  CHECK(!SplineCoefsCache::map(filename, key));
+}
+
+TEST_CASE("Einspline SPO from HDF diamond_1x1x1 int16 coefficients", "[wavefunction]")
+{
+  Communicate* c = OHMMS::Controller;
+
+  ParticleSet::ParticleLayout lattice;
+  // diamondC_1x1x1
+  lattice.R(0, 0) = 3.37316115;
+  lattice.R(0, 1) = 3.37316115;
+  lattice.R(0, 2) = 0.0;
+  lattice.R(1, 0) = 0.0;
+  lattice.R(1, 1) = 3.37316115;
+  lattice.R(1, 2) = 3.37316115;
+  lattice.R(2, 0) = 3.37316115;
+  lattice.R(2, 1) = 0.0;
+  lattice.R(2, 2) = 3.37316115;
+
+  ParticleSetPool ptcl = ParticleSetPool(c);
+  ptcl.setSimulationCell(lattice);
+  auto ions_uptr = std::make_unique<ParticleSet>(ptcl.getSimulationCell());
+  auto elec_uptr = std::make_unique<ParticleSet>(ptcl.getSimulationCell());
+  ParticleSet& ions_(*ions_uptr);
+  ParticleSet& elec_(*elec_uptr);
+
+  ions_.setName("ion");
+  ptcl.addParticleSet(std::move(ions_uptr));
+  ions_.create({2});
+  ions_.R[0] = {0.0, 0.0, 0.0};
+  ions_.R[1] = {1.68658058, 1.68658058, 1.68658058};
+
+  elec_.setName("elec");
+  ptcl.addParticleSet(std::move(elec_uptr));
+  elec_.create({2});
+  elec_.R[0] = {0.1, 0.2, 0.3};
+  elec_.R[1] = {0.0, 1.0, 0.0};
+
+  SpeciesSet& tspecies       = elec_.getSpeciesSet();
+  int upIdx                  = tspecies.addSpecies("u");
+  int chargeIdx              = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx) = -1;
+
+  // the reference in double precision and the compressed table evaluated in single precision
+  const char* particles = "<tmp> \
+<determinantset type=\"einspline\" href=\"diamondC_1x1x1.pwscf.h5\" tilematrix=\"1 0 0 0 1 0 0 0 1\" twistnum=\"0\" source=\"ion\" meshfactor=\"1.0\" precision=\"double\" size=\"8\"/> \
+<determinantset type=\"einspline\" href=\"diamondC_1x1x1.pwscf.h5\" tilematrix=\"1 0 0 0 1 0 0 0 1\" twistnum=\"0\" source=\"ion\" meshfactor=\"1.0\" precision=\"float\" size=\"8\" int16_coefs=\"yes\"/> \
+</tmp> \
+";
+
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(particles);
+  REQUIRE(okay);
+
+  xmlNodePtr root = doc.getRoot();
+
+  xmlNodePtr ein_ref   = xmlFirstElementChild(root);
+  xmlNodePtr ein_int16 = xmlNextElementSibling(ein_ref);
+
+  EinsplineSetBuilder einSet_ref(elec_, ptcl.getPool(), c, ein_ref);
+  auto spo_ref = einSet_ref.createSPOSetFromXML(ein_ref);
+  REQUIRE(spo_ref);
+  EinsplineSetBuilder einSet_int16(elec_, ptcl.getPool(), c, ein_int16);
+  auto spo_int16 = einSet_int16.createSPOSetFromXML(ein_int16);
+  REQUIRE(spo_int16);
+
+  const int norb = spo_ref->getOrbitalSetSize();
+  REQUIRE(spo_int16->getOrbitalSetSize() == norb);
+
+  SPOSet::ValueMatrix psiM_ref(elec_.R.size(), norb), psiM(elec_.R.size(), norb);
+  SPOSet::GradMatrix dpsiM_ref(elec_.R.size(), norb), dpsiM(elec_.R.size(), norb);
+  SPOSet::ValueMatrix d2psiM_ref(elec_.R.size(), norb), d2psiM(elec_.R.size(), norb);
+  spo_ref->evaluate_notranspose(elec_, 0, elec_.R.size(), psiM_ref, dpsiM_ref, d2psiM_ref);
+  spo_int16->evaluate_notranspose(elec_, 0, elec_.R.size(), psiM, dpsiM, d2psiM);
+
+  // 16-bit coefficients are accurate to about 3e-5 relative to the largest coefficient of each orbital.
+  // The derivatives amplify the error by the inverse grid spacing.
+  for (int iel = 0; iel < elec_.R.size(); iel++)
+    for (int iorb = 0; iorb < norb; iorb++)
+    {
+      CHECK(std::real(psiM[iel][iorb]) == Approx(std::real(psiM_ref[iel][iorb])).margin(2e-4));
+      for (int idim = 0; idim < 3; idim++)
+        CHECK(std::real(dpsiM[iel][iorb][idim]) == Approx(std::real(dpsiM_ref[iel][iorb][idim])).margin(2e-3));
+      CHECK(std::real(d2psiM[iel][iorb]) == Approx(std::real(d2psiM_ref[iel][iorb])).margin(2e-2));
+    }
+
+  SPOSet::ValueVector psiV_ref(norb), psiV(norb);
+  SPOSet::GradVector dpsiV_ref(norb), dpsiV(norb);
+  SPOSet::HessVector ddpsiV_ref(norb), ddpsiV(norb);
+  spo_ref->evaluateVGH(elec_, 1, psiV_ref, dpsiV_ref, ddpsiV_ref);
+  spo_int16->evaluateVGH(elec_, 1, psiV, dpsiV, ddpsiV);
+  for (int iorb = 0; iorb < norb; iorb++)
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++)
+        CHECK(std::real(ddpsiV[iorb](i, j)) == Approx(std::real(ddpsiV_ref[iorb](i, j))).margin(2e-2));
+}
+
 } // namespace qmcplusplus
@@ -20,6 +20,7 @@
 #include "QMCWaveFunctions/Jastrow/kSpaceJastrow.h"
 #include "QMCWaveFunctions/Jastrow/kSpaceJastrowBuilder.h"
 #include "ParticleIO/LatticeIO.h"
+#include "ResourceCollection.h"
 
 #include <stdio.h>
 #include <string>
@@ -112,4 +113,144 @@ TEST_CASE("kspace jastrow", "[wavefunction]")
   double logpsi_real = std::real(jas->evaluateLog(elec_, elec_.G, elec_.L));
   REQUIRE(logpsi_real == Approx(-4.4088303951)); // !!!! value not checked
 }
+
+TEST_CASE("kspace jastrow batched", "[wavefunction]")
+{
+  using PsiValueType = WaveFunctionComponent::PsiValueType;
+  using GradType     = WaveFunctionComponent::GradType;
+  using PosType      = QMCTraits::PosType;
+
+  Communicate* c = OHMMS::Controller;
+
+  const char* lattice_xml = "<simulationcell> \
+     <parameter name=\"lattice\" units=\"bohr\"> \
+              6.00000000        0.00000000        0.00000000 \
+              0.00000000        6.00000000        0.00000000 \
+              0.00000000        0.00000000        6.00000000 \
+     </parameter> \
+     <parameter name=\"bconds\"> p p p </parameter> \
+  </simulationcell>";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(lattice_xml));
+  ParticleSet::ParticleLayout lattice;
+  LatticeParser lp(lattice);
+  lp.put(doc.getRoot());
+  const SimulationCell simulation_cell(lattice);
+
+  ParticleSet ions(simulation_cell);
+  ions.setName("ion");
+  ions.create({2});
+  ions.R[0] = {0.0, 0.0, 0.0};
+  ions.R[1] = {1.5, 0.5, 2.0};
+
+  ParticleSet elec(simulation_cell);
+  elec.setName("elec");
+  elec.create({2, 2});
+  elec.R[0] = {-0.28, 0.0225, -2.709};
+  elec.R[1] = {-1.08389, 1.9679, -0.0128914};
+  elec.R[2] = {1.2, -0.3, 0.8};
+  elec.R[3] = {2.5, 2.1, -1.4};
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+
+  const char* jas_xml = "<jastrow name=\"Jk\" type=\"kSpace\" source=\"ion\"> \
+  <correlation kc=\"1.5\" type=\"One-Body\" symmetry=\"isotropic\"> \
+    <coefficients id=\"cG1\" type=\"Array\"> 20. 5. -10. 3. </coefficients> \
+  </correlation> \
+  <correlation kc=\"1.5\" type=\"Two-Body\" symmetry=\"isotropic\"> \
+    <coefficients id=\"cG2\" type=\"Array\"> -100. -50. </coefficients> \
+  </correlation> \
+</jastrow>";
+  REQUIRE(doc.parseFromString(jas_xml));
+  kSpaceJastrowBuilder jastrow(c, elec, ions);
+  std::unique_ptr<WaveFunctionComponent> jas(jastrow.buildComponent(doc.getRoot()));
+
+  // two walkers driven by the batched API and their copies driven by the single walker API
+  const int nw = 2;
+  std::vector<std::unique_ptr<ParticleSet>> psets, psets_ref;
+  std::vector<std::unique_ptr<WaveFunctionComponent>> wfcs, wfcs_ref;
+  for (int iw = 0; iw < nw; iw++)
+  {
+    psets.push_back(std::make_unique<ParticleSet>(elec));
+    for (int i = 0; i < elec.getTotalNum(); i++)
+      psets[iw]->R[i] += PosType(0.1 * iw, -0.2 * iw, 0.05 * iw * i);
+    psets_ref.push_back(std::make_unique<ParticleSet>(*psets[iw]));
+    psets[iw]->update();
+    psets_ref[iw]->update();
+    wfcs.push_back(jas->makeClone(*psets[iw]));
+    wfcs_ref.push_back(jas->makeClone(*psets_ref[iw]));
+    wfcs[iw]->evaluateLog(*psets[iw], psets[iw]->G, psets[iw]->L);
+    wfcs_ref[iw]->evaluateLog(*psets_ref[iw], psets_ref[iw]->G, psets_ref[iw]->L);
+  }
+
+  RefVectorWithLeader<ParticleSet> p_list(*psets[0], {*psets[0], *psets[1]});
+  RefVectorWithLeader<WaveFunctionComponent> wfc_list(*wfcs[0], {*wfcs[0], *wfcs[1]});
+  ResourceCollection wfc_res("test_wfc_res");
+  wfcs[0]->createResource(wfc_res);
+  ResourceCollectionTeamLock<WaveFunctionComponent> mw_wfc_lock(wfc_res, wfc_list);
+
+  const std::vector<PosType> displs{{0.3, -0.2, 0.1}, {-0.1, 0.25, 0.2}};
+  const std::vector<bool> isAccepted{true, false};
+  std::vector<PsiValueType> ratios(nw);
+  std::vector<GradType> grads(nw);
+
+  const int iat = 1;
+  for (int iw = 0; iw < nw; iw++)
+  {
+    psets[iw]->makeMove(iat, displs[iw]);
+    psets_ref[iw]->makeMove(iat, displs[iw]);
+    grads[iw] = 0;
+  }
+  wfcs[0]->mw_ratioGrad(wfc_list, p_list, iat, ratios, grads);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    GradType grad_ref(0);
+    const PsiValueType ratio_ref = wfcs_ref[iw]->ratioGrad(*psets_ref[iw], iat, grad_ref);
+    CHECK(ratios[iw] == ValueApprox(ratio_ref));
+    for (int idim = 0; idim < 3; idim++)
+      CHECK(grads[iw][idim] == ValueApprox(grad_ref[idim]));
+  }
+  wfcs[0]->mw_accept_rejectMove(wfc_list, p_list, iat, isAccepted);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    psets[iw]->accept_rejectMove(iat, isAccepted[iw]);
+    if (isAccepted[iw])
+      wfcs_ref[iw]->acceptMove(*psets_ref[iw], iat);
+    else
+      wfcs_ref[iw]->restore(iat);
+    psets_ref[iw]->accept_rejectMove(iat, isAccepted[iw]);
+  }
+
+  // the gradient of ratioGrad is the one of the accepted configuration
+  const GradType grad_accepted = wfcs[0]->evalGrad(*psets[0], iat);
+  for (int idim = 0; idim < 3; idim++)
+    CHECK(grads[0][idim] == ValueApprox(grad_accepted[idim]));
+
+  // the ratios of the next move see the accepted move, check against log values from scratch
+  ParticleSet scratch(elec);
+  auto logpsi_from_scratch = [&](const ParticleSet& P, int jat, const PosType& rjat) {
+    scratch.R = P.R;
+    scratch.R[jat] = rjat;
+    scratch.update();
+    return std::real(jas->evaluateLog(scratch, scratch.G, scratch.L));
+  };
+  const int jat = 3;
+  for (int iw = 0; iw < nw; iw++)
+  {
+    psets[iw]->makeMove(jat, displs[1 - iw]);
+    psets_ref[iw]->makeMove(jat, displs[1 - iw]);
+  }
+  wfcs[0]->mw_calcRatio(wfc_list, p_list, jat, ratios);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    CHECK(ratios[iw] == ValueApprox(wfcs_ref[iw]->ratio(*psets_ref[iw], jat)));
+    const double dlogpsi = logpsi_from_scratch(*psets[iw], jat, psets[iw]->getActivePos()) -
+        logpsi_from_scratch(*psets[iw], jat, psets[iw]->R[jat]);
+    CHECK(std::real(ratios[iw]) == Approx(std::exp(dlogpsi)));
+  }
+}
 } // namespace qmcplusplus
@@ -14,8 +14,10 @@
 
 #include "OhmmsPETE/OhmmsMatrix.h"
 #include "QMCWaveFunctions/Fermion/MultiDiracDeterminant.h"
+#include "FakeSPO.h"
 
 //#include <stdio.h>
+#include <map>
 #include <string>
 
 using std::string;
@@ -95,4 +97,61 @@ TEST_CASE("SmallMatrixDetCalculator::evaluate-Small", "[wavefunction][fermion][m
   CHECK(double_test.generic_evaluate(1<<12) == Approx(-1.3586431786));
 }
 
+/** the compact excitation table expanded by expandDetData must match the layout the orbital rotations expect,
+ *  {n, pos, uno, ocp} per determinant sorted by excitation level, as createDetData used to store it.
+ */
+TEST_CASE("MultiDiracDeterminant expandDetData", "[wavefunction][fermion][multidet]")
+{
+  const int nel = 4;
+  auto spo      = std::make_unique<FakeSPO>();
+  spo->setOrbitalSetSize(12);
+  MultiDiracDeterminant msd(std::move(spo), false, 0, nel);
+
+  // unique determinants of 1 to 4 excitations in mixed order, the reference is not the first one
+  // and its orbitals differ from the positions
+  const std::vector<std::vector<size_t>> occupations{{2, 3, 5, 8}, {2, 3, 5, 6}, {2, 0, 5, 9}, {10, 11, 4, 6},
+                                                     {3, 2, 5, 7}, {0, 1, 4, 7}, {2, 3, 11, 10}};
+  const int ref_det_id = 1;
+  std::vector<ci_configuration2> configs;
+  for (auto occup : occupations)
+    configs.emplace_back(occup);
+  std::vector<size_t> C2nodes_unsorted(configs.size());
+  for (size_t i = 0; i < C2nodes_unsorted.size(); i++)
+    C2nodes_unsorted[i] = i;
+  std::vector<size_t> C2nodes_sorted(configs.size());
+  msd.createDetData(ref_det_id, configs, C2nodes_unsorted, C2nodes_sorted);
+  REQUIRE(msd.getNumDets() == configs.size());
+
+  // the legacy layout, each excitation level in input order
+  std::map<size_t, std::vector<int>> legacy_levels;
+  std::map<size_t, std::vector<size_t>> dets_per_level;
+  std::vector<size_t> pos(nel), ocp(nel), uno(nel);
+  for (size_t i = 0; i < configs.size(); i++)
+  {
+    size_t nex;
+    configs[ref_det_id].calculateExcitations(configs[i], nex, pos, ocp, uno);
+    auto& level = legacy_levels[nex];
+    level.push_back(nex);
+    level.insert(level.end(), pos.begin(), pos.begin() + nex);
+    level.insert(level.end(), uno.begin(), uno.begin() + nex);
+    level.insert(level.end(), ocp.begin(), ocp.begin() + nex);
+    dets_per_level[nex].push_back(i);
+  }
+  REQUIRE(legacy_levels.size() == nel + 1);
+  std::vector<int> legacy;
+  size_t sorted_id = 0;
+  for (const auto& [nex, level] : legacy_levels)
+  {
+    legacy.insert(legacy.end(), level.begin(), level.end());
+    for (size_t i : dets_per_level[nex])
+      CHECK(C2nodes_sorted[i] == sorted_id++);
+  }
+
+  std::vector<int> expanded;
+  msd.expandDetData(expanded);
+  REQUIRE(expanded.size() == legacy.size());
+  for (size_t i = 0; i < legacy.size(); i++)
+    CHECK(expanded[i] == legacy[i]);
+}
+
 } // namespace qmcplusplus
@@ -243,6 +243,52 @@ void test_J3_polynomial3D(const DynamicCoordinateKind kind_selected)
   CHECK(ValueApprox(nlpp_ratios[1][0]) == ValueType(1.0013145208));
   CHECK(ValueApprox(nlpp_ratios[1][1]) == ValueType(1.0011137724));
   CHECK(ValueApprox(nlpp_ratios[1][2]) == ValueType(1.0017225742));
+
+  // batched particle-by-particle move against the single walker path
+  using GradType = WaveFunctionComponent::GradType;
+  const int iel  = 2;
+  std::vector<PosType> displs{{0.1, -0.2, 0.3}, {-0.4, 0.1, 0.2}};
+  ParticleSet::mw_makeMove(p_ref_list, iel, displs);
+
+  std::vector<PsiValueType> ratios_ref(2);
+  std::vector<GradType> grads_ref(2);
+  for (int iw = 0; iw < 2; iw++)
+    ratios_ref[iw] = j3_ref_list[iw].ratioGrad(p_ref_list[iw], iel, grads_ref[iw]);
+
+  std::vector<PsiValueType> mw_ratios(2);
+  std::vector<GradType> mw_grads(2);
+  j3->mw_ratioGrad(j3_ref_list, p_ref_list, iel, mw_ratios, mw_grads);
+  for (int iw = 0; iw < 2; iw++)
+  {
+    CHECK(ValueApprox(mw_ratios[iw]) == ratios_ref[iw]);
+    CHECK(ValueApprox(mw_grads[iw][0]) == grads_ref[iw][0]);
+    CHECK(ValueApprox(mw_grads[iw][1]) == grads_ref[iw][1]);
+    CHECK(ValueApprox(mw_grads[iw][2]) == grads_ref[iw][2]);
+  }
+
+  std::vector<bool> isAccepted_mixed{true, false};
+  j3->mw_accept_rejectMove(j3_ref_list, p_ref_list, iel, isAccepted_mixed);
+  ParticleSet::mw_accept_rejectMove(p_ref_list, iel, isAccepted_mixed);
+
+  // the incrementally updated gradients must match a recompute from scratch
+  for (int iw = 0; iw < 2; iw++)
+  {
+    ParticleSet& elec = p_ref_list[iw];
+    auto j3_fresh     = j3_ref_list[iw].makeClone(elec);
+    elec.update();
+    ParticleSet::ParticleGradient G(elec.G);
+    ParticleSet::ParticleLaplacian L(elec.L);
+    G = 0.0;
+    L = 0.0;
+    j3_fresh->evaluateLog(elec, G, L);
+    for (int jel = 0; jel < elec.getTotalNum(); jel++)
+    {
+      const GradType grad = j3_ref_list[iw].evalGrad(elec, jel);
+      CHECK(ValueApprox(grad[0]) == G[jel][0]);
+      CHECK(ValueApprox(grad[1]) == G[jel][1]);
+      CHECK(ValueApprox(grad[2]) == G[jel][2]);
+    }
+  }
 }
 
 TEST_CASE("PolynomialFunctor3D Jastrow", "[wavefunction]")
@@ -24,6 +24,7 @@
 #include "QMCWaveFunctions/LCAO/CuspCorrection.h"
 
 #include "QMCWaveFunctions/SPOSetBuilderFactory.h"
+#include <ResourceCollection.h>
 
 namespace qmcplusplus
 {
@@ -547,6 +548,110 @@ TEST_CASE("Ethanol MO with cusp", "[wavefunction]")
   REQUIRE(all_lap[0][11] == Approx(-33.5202249813));
 }
 
+void test_HCN_cusp_mw(bool screening)
+{
+  std::ostringstream section_name;
+  section_name << "HCN MO with cusp batched, screening: " << (screening ? "T" : "F");
+
+  SECTION(section_name.str())
+  {
+    using PosType = ParticleSet::SingleParticlePos;
+
+    Communicate* c = OHMMS::Controller;
+
+    Libxml2Document doc;
+    bool okay = doc.parse("hcn.structure.xml");
+    REQUIRE(okay);
+
+    const SimulationCell simulation_cell;
+    auto ions_ptr = std::make_unique<ParticleSet>(simulation_cell);
+    auto& ions(*ions_ptr);
+    XMLParticleParser parse_ions(ions);
+    OhmmsXPathObject particleset_ion("//particleset[@name='ion0']", doc.getXPathContext());
+    REQUIRE(particleset_ion.size() == 1);
+    parse_ions.readXML(particleset_ion[0]);
+    ions.update();
+
+    auto elec_ptr = std::make_unique<ParticleSet>(simulation_cell);
+    auto& elec(*elec_ptr);
+    XMLParticleParser parse_elec(elec);
+    OhmmsXPathObject particleset_elec("//particleset[@name='e']", doc.getXPathContext());
+    REQUIRE(particleset_elec.size() == 1);
+    parse_elec.readXML(particleset_elec[0]);
+    REQUIRE(elec.R.size() == 14);
+
+    elec.R = 0.0;
+    elec.addTable(ions);
+    elec.update();
+
+    Libxml2Document doc2;
+    okay = doc2.parse("hcn.wfnoj.xml");
+    REQUIRE(okay);
+
+    WaveFunctionComponentBuilder::PSetMap particle_set_map;
+    particle_set_map.emplace(elec_ptr->getName(), std::move(elec_ptr));
+    particle_set_map.emplace(ions_ptr->getName(), std::move(ions_ptr));
+
+    SPOSetBuilderFactory bf(c, elec, particle_set_map);
+
+    OhmmsXPathObject MO_base("//determinantset", doc2.getXPathContext());
+    REQUIRE(MO_base.size() == 1);
+    xmlSetProp(MO_base[0], (const xmlChar*)"cuspCorrection", (const xmlChar*)"yes");
+
+    const auto bb_ptr = bf.createSPOSetBuilder(MO_base[0]);
+    auto& bb(*bb_ptr);
+
+    OhmmsXPathObject slater_base("//determinant", doc2.getXPathContext());
+    if (screening)
+      xmlSetProp(slater_base[0], (const xmlChar*)"screening", (const xmlChar*)"yes");
+    auto sposet = bb.createSPOSet(slater_base[0]);
+    REQUIRE(dynamic_cast<LCAOrbitalSet&>(*sposet).isScreened() == screening);
+    auto sposet_clone = sposet->makeClone();
+
+    // the moved electron is inside the cusp region of N in the first walker
+    const int iat = 0;
+    elec.R[iat][0] = -1.09;
+    elec.update();
+    ParticleSet elec_clone(elec);
+    for (int jat = 0; jat < elec_clone.getTotalNum(); jat++)
+      elec_clone.R[jat] = PosType(0.3 * jat - 1.0, 0.2, -0.1 * jat);
+    elec_clone.update();
+
+    RefVectorWithLeader<SPOSet> spo_list(*sposet, {*sposet, *sposet_clone});
+    RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec_clone});
+    ResourceCollection spo_res("test_spo_res");
+    sposet->createResource(spo_res);
+    ResourceCollectionTeamLock<SPOSet> mw_spo_lock(spo_res, spo_list);
+
+    const int norb = 7;
+    SPOSet::ValueVector psi_0(norb), psi_1(norb), psi_ref(norb);
+    SPOSet::GradVector dpsi_0(norb), dpsi_1(norb), dpsi_ref(norb);
+    SPOSet::ValueVector d2psi_0(norb), d2psi_1(norb), d2psi_ref(norb);
+    RefVector<SPOSet::ValueVector> psi_v_list{psi_0, psi_1};
+    RefVector<SPOSet::GradVector> dpsi_v_list{dpsi_0, dpsi_1};
+    RefVector<SPOSet::ValueVector> d2psi_v_list{d2psi_0, d2psi_1};
+
+    // the cusp correction must enter the batched values exactly once
+    sposet->mw_evaluateVGL(spo_list, p_list, iat, psi_v_list, dpsi_v_list, d2psi_v_list);
+    for (int iw = 0; iw < spo_list.size(); iw++)
+    {
+      spo_list[iw].evaluateVGL(p_list[iw], iat, psi_ref, dpsi_ref, d2psi_ref);
+      for (int j = 0; j < norb; j++)
+      {
+        CHECK(psi_v_list[iw].get()[j] == Approx(psi_ref[j]));
+        CHECK(dpsi_v_list[iw].get()[j][0] == Approx(dpsi_ref[j][0]));
+        CHECK(dpsi_v_list[iw].get()[j][1] == Approx(dpsi_ref[j][1]));
+        CHECK(dpsi_v_list[iw].get()[j][2] == Approx(dpsi_ref[j][2]));
+        CHECK(d2psi_v_list[iw].get()[j] == Approx(d2psi_ref[j]));
+      }
+    }
+  }
+}
+
+TEST_CASE("HCN MO with cusp batched", "[wavefunction]") { test_HCN_cusp_mw(false); }
+
+TEST_CASE("HCN MO with cusp batched screened", "[wavefunction]") { test_HCN_cusp_mw(true); }
+
 
 TEST_CASE("broadcastCuspInfo", "[wavefunction]")
 {
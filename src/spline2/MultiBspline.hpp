@@ -20,6 +20,7 @@
 #define QMCPLUSPLUS_MULTIEINSPLINE_COMMON_HPP
 #include <iostream>
 #include <cstdlib>
+#include <memory>
 #include <type_traits>
 #include "config.h"
 #include "spline2/BsplineAllocator.hpp"
@@ -47,6 +48,8 @@ private:
   SplineType* spline_m;
   ///use allocator
   BsplineAllocator<T, COEFS_ALLOC, MULTI_SPLINE_ALLOC, SINGLE_SPLINE_ALLOC> myAllocator;
+  ///keep alive the owner of the coefficients attached by attachExternalCoefs
+  std::shared_ptr<void> external_coefs_owner_;
 
 public:
   MultiBspline() : spline_m(nullptr) {}
@@ -56,7 +59,12 @@ public:
   ~MultiBspline()
   {
     if (spline_m != nullptr)
+    {
+      // the external coefficients are released by their owner
+      if (external_coefs_owner_)
+        spline_m->coefs = nullptr;
       myAllocator.destroy(spline_m);
+    }
   }
 
   SplineType* getSplinePtr() { return spline_m; }
@@ -95,6 +103,22 @@ public:
       throw std::runtime_error("MultiBspline::spline_m cannot be created twice!\n");
   }
 
+  /** replace the coefficient storage by memory owned by another object, e.g. a node shared buffer
+   * @param coefs the new storage of at least coefs_size elements with the alignment of COEFS_ALLOC
+   * @param owner object owning coefs, kept alive as long as this MultiBspline
+   *
+   * The current coefficients are discarded. Only valid for host memory allocators.
+   */
+  void attachExternalCoefs(T* coefs, std::shared_ptr<void> owner)
+  {
+    if (spline_m == nullptr)
+      throw std::runtime_error("The internal storage of MultiBspline must be created first!\n");
+    if (!external_coefs_owner_)
+      COEFS_ALLOC().deallocate(spline_m->coefs, spline_m->coefs_size);
+    spline_m->coefs       = coefs;
+    external_coefs_owner_ = std::move(owner);
+  }
+
   void flush_zero() const
   {
     if (spline_m != nullptr)
@@ -36,6 +36,9 @@
 ///include evaluate_vghgh_impl
 #include "spline2/MultiBsplineVGHGH.hpp"
 
+///include evaluate_v_impl, evaluate_vgl_impl and evaluate_vgh_impl of 16-bit tables
+#include "spline2/MultiBsplineInt16Eval.hpp"
+
 namespace spline2
 {
 /// evaluate values optionally in the range [first,last)
@@ -72,9 +72,10 @@ inline void getSplineBound(T x, TRESIDUAL& dx, int& ind, int nmax)
 /** define computeLocationAndFractional: common to any implementation
  * compute the location of the spline grid point and residual coordinates
  * also it precomputes auxiliary array a, b and c
+ * @tparam SPLINET any multi spline type with x/y/z_grid
  */
-template<typename T>
-inline void computeLocationAndFractional(const typename qmcplusplus::bspline_traits<T, 3>::SplineType* restrict spline_m,
+template<typename SPLINET, typename T>
+inline void computeLocationAndFractional(const SPLINET* restrict spline_m,
                             T x, T y, T z,
                             int& ix, int& iy, int& iz,
                             T a[4], T b[4], T c[4])
@@ -98,8 +99,8 @@ inline void computeLocationAndFractional(const typename qmcplusplus::bspline_tra
  * compute the location of the spline grid point and residual coordinates
  * also it precomputes auxiliary array (a,b,c) (da,db,dc) (d2a,d2b,d2c)
  */
-template<typename T>
-inline void computeLocationAndFractional(const typename qmcplusplus::bspline_traits<T, 3>::SplineType* restrict spline_m,
+template<typename SPLINET, typename T>
+inline void computeLocationAndFractional(const SPLINET* restrict spline_m,
                             T x, T y, T z,
                             int& ix, int& iy, int& iz,
                             T a[4], T b[4], T c[4],
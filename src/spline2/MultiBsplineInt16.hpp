@@ -0,0 +1,135 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/**@file MultiBsplineInt16.hpp
+ *
+ * define classes MultiBsplineInt16, a multi spline table stored in 16-bit integers
+ * The evaluation functions are defined in MultiBsplineInt16Eval.hpp
+ */
+#ifndef QMCPLUSPLUS_MULTIEINSPLINE_INT16_HPP
+#define QMCPLUSPLUS_MULTIEINSPLINE_INT16_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "spline2/bspline_traits.hpp"
+#include "CPU/SIMD/aligned_allocator.hpp"
+
+namespace qmcplusplus
+{
+/** multi_UBspline_3d_X counterpart holding scaled 16-bit integer coefficients
+ * @tparam T the precision of evaluation
+ *
+ * The coefficient of spline n is coefs[...+n] * scales[n].
+ * The layout of coefs is the same as in multi_UBspline_3d_X.
+ */
+template<typename T>
+struct multi_UBspline_3d_int16
+{
+  const int16_t* coefs;
+  const T* scales;
+  intptr_t x_stride, y_stride, z_stride;
+  Ugrid x_grid, y_grid, z_grid;
+  int num_splines;
+  size_t coefs_size;
+};
+
+/** container class holding a multi spline table compressed to 16-bit integers
+ * @tparam T the precision of evaluation
+ *
+ * Each spline is scaled by its largest coefficient in magnitude and rounded to int16,
+ * giving a relative accuracy of about 2^-15 with respect to that largest coefficient.
+ * The evaluation is linear in the coefficients. The kernels accumulate the integers widened to T
+ * and apply the scale once to each result. It halves the memory footprint and bandwidth of a float table.
+ */
+template<typename T>
+class MultiBsplineInt16
+{
+public:
+  using SplineType = multi_UBspline_3d_int16<T>;
+
+  /** compress a multi spline table
+   * @param source table of any precision
+   */
+  template<typename ST>
+  explicit MultiBsplineInt16(const ST& source)
+  {
+    spline_m.x_stride    = source.x_stride;
+    spline_m.y_stride    = source.y_stride;
+    spline_m.z_stride    = source.z_stride;
+    spline_m.x_grid      = source.x_grid;
+    spline_m.y_grid      = source.y_grid;
+    spline_m.z_grid      = source.z_grid;
+    spline_m.num_splines = source.num_splines;
+    spline_m.coefs_size  = source.coefs_size;
+
+    const int nsplines   = source.num_splines;
+    const size_t npoints = source.coefs_size / nsplines;
+
+    std::vector<T> max_abs(nsplines, T(0));
+#pragma omp parallel
+    {
+      std::vector<T> my_max_abs(nsplines, T(0));
+#pragma omp for
+      for (size_t ip = 0; ip < npoints; ip++)
+      {
+        const auto* restrict src = source.coefs + ip * nsplines;
+        for (int n = 0; n < nsplines; n++)
+          my_max_abs[n] = std::max(my_max_abs[n], static_cast<T>(std::abs(src[n])));
+      }
+#pragma omp critical
+      for (int n = 0; n < nsplines; n++)
+        max_abs[n] = std::max(max_abs[n], my_max_abs[n]);
+    }
+
+    scales_.resize(nsplines);
+    std::vector<T> inv_scales(nsplines);
+    for (int n = 0; n < nsplines; n++)
+    {
+      scales_[n]    = max_abs[n] / max_int;
+      inv_scales[n] = max_abs[n] > T(0) ? max_int / max_abs[n] : T(0);
+    }
+
+    coefs_.resize(source.coefs_size);
+#pragma omp parallel for
+    for (size_t ip = 0; ip < npoints; ip++)
+    {
+      const auto* restrict src = source.coefs + ip * nsplines;
+      int16_t* restrict dest   = coefs_.data() + ip * nsplines;
+      for (int n = 0; n < nsplines; n++)
+        dest[n] = static_cast<int16_t>(std::lround(src[n] * inv_scales[n]));
+    }
+
+    spline_m.coefs  = coefs_.data();
+    spline_m.scales = scales_.data();
+  }
+
+  MultiBsplineInt16(const MultiBsplineInt16& in) = delete;
+  MultiBsplineInt16& operator=(const MultiBsplineInt16& in) = delete;
+
+  const SplineType* getSplinePtr() const { return &spline_m; }
+
+  int num_splines() const { return spline_m.num_splines; }
+
+  size_t sizeInByte() const { return coefs_.size() * sizeof(int16_t) + scales_.size() * sizeof(T); }
+
+private:
+  static constexpr T max_int = 32767;
+  ///the table referring to coefs_ and scales_
+  SplineType spline_m;
+  aligned_vector<int16_t> coefs_;
+  aligned_vector<T> scales_;
+};
+
+} // namespace qmcplusplus
+
+#endif
@@ -0,0 +1,278 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+// -*- C++ -*-
+/**@file MultiBsplineInt16Eval.hpp
+ *
+ * evaluate_v_impl, evaluate_vgl_impl and evaluate_vgh_impl of multi_UBspline_3d_int16.
+ * Literal copies of the float/double kernels except that the 16-bit coefficients are widened to T
+ * in the inner loop and the per-spline scales are applied with the grid factors at the end.
+ * The 16-bit coefficient rows are not necessarily aligned to QMC_SIMD_ALIGNMENT, hence not in the aligned clauses.
+ */
+#ifndef SPLINE2_MULTIEINSPLINE_INT16_EVAL_HPP
+#define SPLINE2_MULTIEINSPLINE_INT16_EVAL_HPP
+
+#include "spline2/MultiBsplineInt16.hpp"
+#include "spline2/MultiBsplineEval_helper.hpp"
+
+namespace spline2
+{
+template<typename T>
+inline void evaluate_v_impl(const qmcplusplus::multi_UBspline_3d_int16<T>* restrict spline_m,
+                            T x,
+                            T y,
+                            T z,
+                            T* restrict vals,
+                            int first,
+                            int last)
+{
+  int ix, iy, iz;
+  T a[4], b[4], c[4];
+
+  computeLocationAndFractional(spline_m, x, y, z, ix, iy, iz, a, b, c);
+
+  const intptr_t xs = spline_m->x_stride;
+  const intptr_t ys = spline_m->y_stride;
+  const intptr_t zs = spline_m->z_stride;
+
+  constexpr T zero(0);
+  const int num_splines = last - first;
+  std::fill(vals, vals + num_splines, zero);
+
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+    {
+      const T pre00                    = a[i] * b[j];
+      const int16_t* restrict coefs    = spline_m->coefs + ((ix + i) * xs + (iy + j) * ys + iz * zs) + first;
+      const int16_t* restrict coefszs  = coefs + zs;
+      const int16_t* restrict coefs2zs = coefs + 2 * zs;
+      const int16_t* restrict coefs3zs = coefs + 3 * zs;
+#pragma omp simd aligned(vals: QMC_SIMD_ALIGNMENT)
+      for (int n = 0; n < num_splines; n++)
+        vals[n] += pre00 *
+            (c[0] * static_cast<T>(coefs[n]) + c[1] * static_cast<T>(coefszs[n]) +
+             c[2] * static_cast<T>(coefs2zs[n]) + c[3] * static_cast<T>(coefs3zs[n]));
+    }
+
+  const T* restrict scales = spline_m->scales + first;
+#pragma omp simd aligned(vals: QMC_SIMD_ALIGNMENT)
+  for (int n = 0; n < num_splines; n++)
+    vals[n] *= scales[n];
+}
+
+template<typename T>
+inline void evaluate_vgl_impl(const qmcplusplus::multi_UBspline_3d_int16<T>* restrict spline_m,
+                              T x,
+                              T y,
+                              T z,
+                              T* restrict vals,
+                              T* restrict grads,
+                              T* restrict lapl,
+                              size_t out_offset,
+                              int first,
+                              int last)
+{
+  int ix, iy, iz;
+  T a[4], b[4], c[4], da[4], db[4], dc[4], d2a[4], d2b[4], d2c[4];
+
+  computeLocationAndFractional(spline_m, x, y, z, ix, iy, iz, a, b, c, da, db, dc, d2a, d2b, d2c);
+
+  const intptr_t xs = spline_m->x_stride;
+  const intptr_t ys = spline_m->y_stride;
+  const intptr_t zs = spline_m->z_stride;
+
+  const int num_splines = last - first;
+
+  T* restrict gx = grads;
+  T* restrict gy = grads + out_offset;
+  T* restrict gz = grads + 2 * out_offset;
+  T* restrict lx = lapl;
+  T* restrict ly = lapl + out_offset;
+  T* restrict lz = lapl + 2 * out_offset;
+
+  std::fill(vals, vals + num_splines, T());
+  std::fill(gx, gx + num_splines, T());
+  std::fill(gy, gy + num_splines, T());
+  std::fill(gz, gz + num_splines, T());
+  std::fill(lx, lx + num_splines, T());
+  std::fill(ly, ly + num_splines, T());
+  std::fill(lz, lz + num_splines, T());
+
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+    {
+      const T pre20 = d2a[i] * b[j];
+      const T pre10 = da[i] * b[j];
+      const T pre00 = a[i] * b[j];
+      const T pre01 = a[i] * db[j];
+      const T pre02 = a[i] * d2b[j];
+
+      const int16_t* restrict coefs    = spline_m->coefs + ((ix + i) * xs + (iy + j) * ys + iz * zs) + first;
+      const int16_t* restrict coefszs  = coefs + zs;
+      const int16_t* restrict coefs2zs = coefs + 2 * zs;
+      const int16_t* restrict coefs3zs = coefs + 3 * zs;
+
+#pragma omp simd aligned(gx, gy, gz, lx, ly, lz, vals: QMC_SIMD_ALIGNMENT)
+      for (int n = 0; n < num_splines; n++)
+      {
+        const T coefsv    = coefs[n];
+        const T coefsvzs  = coefszs[n];
+        const T coefsv2zs = coefs2zs[n];
+        const T coefsv3zs = coefs3zs[n];
+
+        T sum0 = c[0] * coefsv + c[1] * coefsvzs + c[2] * coefsv2zs + c[3] * coefsv3zs;
+        T sum1 = dc[0] * coefsv + dc[1] * coefsvzs + dc[2] * coefsv2zs + dc[3] * coefsv3zs;
+        T sum2 = d2c[0] * coefsv + d2c[1] * coefsvzs + d2c[2] * coefsv2zs + d2c[3] * coefsv3zs;
+        gx[n] += pre10 * sum0;
+        gy[n] += pre01 * sum0;
+        gz[n] += pre00 * sum1;
+        lx[n] += pre20 * sum0;
+        ly[n] += pre02 * sum0;
+        lz[n] += pre00 * sum2;
+        vals[n] += pre00 * sum0;
+      }
+    }
+
+  const T dxInv = spline_m->x_grid.delta_inv;
+  const T dyInv = spline_m->y_grid.delta_inv;
+  const T dzInv = spline_m->z_grid.delta_inv;
+
+  const T dxInv2 = dxInv * dxInv;
+  const T dyInv2 = dyInv * dyInv;
+  const T dzInv2 = dzInv * dzInv;
+
+  const T* restrict scales = spline_m->scales + first;
+#pragma omp simd aligned(gx, gy, gz, lx, vals: QMC_SIMD_ALIGNMENT)
+  for (int n = 0; n < num_splines; n++)
+  {
+    const T scale = scales[n];
+    vals[n] *= scale;
+    gx[n] *= dxInv * scale;
+    gy[n] *= dyInv * scale;
+    gz[n] *= dzInv * scale;
+    lx[n] = (lx[n] * dxInv2 + ly[n] * dyInv2 + lz[n] * dzInv2) * scale;
+  }
+}
+
+template<typename T>
+inline void evaluate_vgh_impl(const qmcplusplus::multi_UBspline_3d_int16<T>* restrict spline_m,
+                              T x,
+                              T y,
+                              T z,
+                              T* restrict vals,
+                              T* restrict grads,
+                              T* restrict hess,
+                              size_t out_offset,
+                              int first,
+                              int last)
+{
+  int ix, iy, iz;
+  T a[4], b[4], c[4], da[4], db[4], dc[4], d2a[4], d2b[4], d2c[4];
+
+  computeLocationAndFractional(spline_m, x, y, z, ix, iy, iz, a, b, c, da, db, dc, d2a, d2b, d2c);
+
+  const intptr_t xs = spline_m->x_stride;
+  const intptr_t ys = spline_m->y_stride;
+  const intptr_t zs = spline_m->z_stride;
+
+  const int num_splines = last - first;
+
+  T* restrict gx = grads;
+  T* restrict gy = grads + out_offset;
+  T* restrict gz = grads + 2 * out_offset;
+
+  T* restrict hxx = hess;
+  T* restrict hxy = hess + out_offset;
+  T* restrict hxz = hess + 2 * out_offset;
+  T* restrict hyy = hess + 3 * out_offset;
+  T* restrict hyz = hess + 4 * out_offset;
+  T* restrict hzz = hess + 5 * out_offset;
+
+  std::fill(vals, vals + num_splines, T());
+  std::fill(gx, gx + num_splines, T());
+  std::fill(gy, gy + num_splines, T());
+  std::fill(gz, gz + num_splines, T());
+  std::fill(hxx, hxx + num_splines, T());
+  std::fill(hxy, hxy + num_splines, T());
+  std::fill(hxz, hxz + num_splines, T());
+  std::fill(hyy, hyy + num_splines, T());
+  std::fill(hyz, hyz + num_splines, T());
+  std::fill(hzz, hzz + num_splines, T());
+
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++)
+    {
+      const int16_t* restrict coefs    = spline_m->coefs + ((ix + i) * xs + (iy + j) * ys + iz * zs) + first;
+      const int16_t* restrict coefszs  = coefs + zs;
+      const int16_t* restrict coefs2zs = coefs + 2 * zs;
+      const int16_t* restrict coefs3zs = coefs + 3 * zs;
+
+      const T pre20 = d2a[i] * b[j];
+      const T pre10 = da[i] * b[j];
+      const T pre00 = a[i] * b[j];
+      const T pre11 = da[i] * db[j];
+      const T pre01 = a[i] * db[j];
+      const T pre02 = a[i] * d2b[j];
+
+#pragma omp simd aligned(gx, gy, gz, hxx, hxy, hxz, hyy, hyz, hzz, vals: QMC_SIMD_ALIGNMENT)
+      for (int n = 0; n < num_splines; n++)
+      {
+        T coefsv    = coefs[n];
+        T coefsvzs  = coefszs[n];
+        T coefsv2zs = coefs2zs[n];
+        T coefsv3zs = coefs3zs[n];
+
+        T sum0 = c[0] * coefsv + c[1] * coefsvzs + c[2] * coefsv2zs + c[3] * coefsv3zs;
+        T sum1 = dc[0] * coefsv + dc[1] * coefsvzs + dc[2] * coefsv2zs + dc[3] * coefsv3zs;
+        T sum2 = d2c[0] * coefsv + d2c[1] * coefsvzs + d2c[2] * coefsv2zs + d2c[3] * coefsv3zs;
+
+        hxx[n] += pre20 * sum0;
+        hxy[n] += pre11 * sum0;
+        hxz[n] += pre10 * sum1;
+        hyy[n] += pre02 * sum0;
+        hyz[n] += pre01 * sum1;
+        hzz[n] += pre00 * sum2;
+        gx[n] += pre10 * sum0;
+        gy[n] += pre01 * sum0;
+        gz[n] += pre00 * sum1;
+        vals[n] += pre00 * sum0;
+      }
+    }
+
+  const T dxInv = spline_m->x_grid.delta_inv;
+  const T dyInv = spline_m->y_grid.delta_inv;
+  const T dzInv = spline_m->z_grid.delta_inv;
+  const T dxx   = dxInv * dxInv;
+  const T dyy   = dyInv * dyInv;
+  const T dzz   = dzInv * dzInv;
+  const T dxy   = dxInv * dyInv;
+  const T dxz   = dxInv * dzInv;
+  const T dyz   = dyInv * dzInv;
+
+  const T* restrict scales = spline_m->scales + first;
+#pragma omp simd aligned(gx, gy, gz, hxx, hxy, hxz, hyy, hyz, hzz, vals: QMC_SIMD_ALIGNMENT)
+  for (int n = 0; n < num_splines; n++)
+  {
+    const T scale = scales[n];
+    vals[n] *= scale;
+    gx[n] *= dxInv * scale;
+    gy[n] *= dyInv * scale;
+    gz[n] *= dzInv * scale;
+    hxx[n] *= dxx * scale;
+    hyy[n] *= dyy * scale;
+    hzz[n] *= dzz * scale;
+    hxy[n] *= dxy * scale;
+    hxz[n] *= dxz * scale;
+    hyz[n] *= dyz * scale;
+  }
+}
+
+} // namespace spline2
+#endif
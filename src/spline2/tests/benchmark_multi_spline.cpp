@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2022 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** \file
+ *  This implements micro benchmarking of the multi spline evaluation with single precision
+ *  and 16-bit integer coefficient tables.
+ */
+
+#include "catch.hpp"
+
+#include <random>
+#include <sstream>
+#include "OhmmsSoA/VectorSoaContainer.h"
+#include "spline2/MultiBspline.hpp"
+#include "spline2/MultiBsplineEval.hpp"
+#include "spline2/MultiBsplineInt16.hpp"
+
+namespace qmcplusplus
+{
+/** evaluate VGH at random positions
+ * @param grid_size number of grid points in each direction
+ * @param num_splines number of splines
+ *
+ * Each evaluation reads 64 grid points times num_splines coefficients, reported as bytes/eval.
+ */
+void benchmarkMultiSpline(int grid_size, int num_splines)
+{
+  Ugrid grid[3];
+  BCtype_s bc[3];
+  for (int i = 0; i < 3; i++)
+  {
+    grid[i].start = 0.0;
+    grid[i].end   = 1.0;
+    grid[i].num   = grid_size;
+    bc[i].lCode = bc[i].rCode = PERIODIC;
+  }
+
+  MultiBspline<float> bs;
+  bs.create(grid, bc, num_splines);
+  auto* spline_ptr = bs.getSplinePtr();
+  std::mt19937 rng(11);
+  std::uniform_real_distribution<float> coef_dist(-1.0f, 1.0f);
+  for (size_t i = 0; i < spline_ptr->coefs_size; i++)
+    spline_ptr->coefs[i] = coef_dist(rng);
+  MultiBsplineInt16<float> bs16(*spline_ptr);
+
+  std::uniform_real_distribution<float> pos_dist(0.0f, 1.0f);
+  std::vector<TinyVector<float, 3>> positions(64);
+  for (auto& pos : positions)
+    pos = {pos_dist(rng), pos_dist(rng), pos_dist(rng)};
+
+  aligned_vector<float> v(num_splines);
+  VectorSoaContainer<float, 3> dv(num_splines);
+  VectorSoaContainer<float, 6> hess(num_splines);
+
+  std::ostringstream name;
+  name << "grid=" << grid_size << " splines=" << num_splines;
+  BENCHMARK_ADVANCED("VGH float " + name.str() + " bytes/eval=" + std::to_string(64 * num_splines * sizeof(float)))
+  (Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&] {
+      for (const auto& pos : positions)
+        spline2::evaluate3d_vgh(bs.getSplinePtr(), pos, v, dv, hess);
+    });
+  };
+  BENCHMARK_ADVANCED("VGH int16 " + name.str() + " bytes/eval=" + std::to_string(64 * num_splines * sizeof(int16_t)))
+  (Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&] {
+      for (const auto& pos : positions)
+        spline2::evaluate3d_vgh(bs16.getSplinePtr(), pos, v, dv, hess);
+    });
+  };
+}
+
+/** This test will run by default.
+ */
+TEST_CASE("MultiBspline float vs int16 benchmark small", "[spline2][benchmark]") { benchmarkMultiSpline(16, 64); }
+
+/** This and other [.benchmark] benchmarks only run if "[benchmark]" is explicitly passed as tag to test.
+ *  The tables exceed the last level cache, where the bandwidth saving of int16 shows.
+ */
+TEST_CASE("MultiBspline float vs int16 benchmark large", "[spline2][.benchmark]")
+{
+  for (const int num_splines : {128, 512})
+    benchmarkMultiSpline(64, num_splines);
+}
+
+} // namespace qmcplusplus
@@ -15,6 +15,7 @@
 #include "OhmmsSoA/VectorSoaContainer.h"
 #include "spline2/MultiBspline.hpp"
 #include "spline2/MultiBsplineEval.hpp"
+#include "spline2/MultiBsplineInt16.hpp"
 #include "QMCWaveFunctions/BsplineFactory/contraction_helper.hpp"
 #include "config/stdlib/Constants.h"
 
@@ -372,4 +373,57 @@ TEST_CASE("MultiBspline periodic double large", "[.spline2]")
 
 TEST_CASE("MultiBspline periodic float", "[spline2]") { test_splines<float>().test(); }
 
+TEST_CASE("MultiBsplineInt16 periodic float", "[spline2]")
+{
+  // several splines of different magnitudes, evaluated on a sub-range
+  test_splines_base<float, 8, 20> base;
+  MultiBspline<float> bs;
+  bs.create(base.grid, base.bc, base.npad);
+
+  BsplineAllocator<double> mAllocator;
+  UBspline_3d_d* aspline =
+      mAllocator.allocateUBspline(base.grid[0], base.grid[1], base.grid[2], base.bc[0], base.bc[1], base.bc[2],
+                                  base.data.data());
+  for (int i = 0; i < base.num_splines; i++)
+    bs.copy_spline(aspline, i);
+  mAllocator.destroy(aspline);
+
+  auto* spline_ptr = bs.getSplinePtr();
+  for (size_t ip = 0; ip < spline_ptr->coefs_size / base.npad; ip++)
+    for (int i = 0; i < base.num_splines; i++)
+      spline_ptr->coefs[ip * base.npad + i] *= std::pow(10.0f, i % 5 - 2);
+
+  MultiBsplineInt16<float> bs16(*bs.getSplinePtr());
+  REQUIRE(bs16.num_splines() == base.npad);
+  REQUIRE(bs16.sizeInByte() == spline_ptr->coefs_size * sizeof(int16_t) + base.npad * sizeof(float));
+
+  const int first = getAlignedSize<float>(1);
+  const int last  = base.npad;
+  TinyVector<float, 3> pos = {0.1, 0.27, 0.73};
+
+  aligned_vector<float> v(base.npad), v16(base.npad);
+  VectorSoaContainer<float, 3> dv(base.npad), dv16(base.npad);
+  VectorSoaContainer<float, 6> hess(base.npad), hess16(base.npad);
+  VectorSoaContainer<float, 3> lap(base.npad), lap16(base.npad);
+
+  spline2::evaluate3d(bs.getSplinePtr(), pos, v, first, last);
+  spline2::evaluate3d(bs16.getSplinePtr(), pos, v16, first, last);
+  spline2::evaluate3d_vgh(bs.getSplinePtr(), pos, v, dv, hess, first, last);
+  spline2::evaluate3d_vgh(bs16.getSplinePtr(), pos, v16, dv16, hess16, first, last);
+  spline2::evaluate3d_vgl(bs.getSplinePtr(), pos, v, dv, lap, first, last);
+  spline2::evaluate3d_vgl(bs16.getSplinePtr(), pos, v16, dv16, lap16, first, last);
+
+  // the error is relative to the largest coefficient of each spline
+  for (int i = first; i < base.num_splines; i++)
+  {
+    const float mag = std::pow(10.0f, i % 5 - 2);
+    CHECK(v16[i] == Approx(v[i]).margin(1e-3 * mag));
+    for (int idim = 0; idim < 3; idim++)
+      CHECK(dv16.data(idim)[i] == Approx(dv.data(idim)[i]).margin(1e-2 * mag));
+    for (int ih = 0; ih < 6; ih++)
+      CHECK(hess16.data(ih)[i] == Approx(hess.data(ih)[i]).margin(1e-1 * mag));
+    CHECK(lap16.data(0)[i] == Approx(lap.data(0)[i]).margin(1e-1 * mag));
+  }
+}
+
 } // namespace qmcplusplus
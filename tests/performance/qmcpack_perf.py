@@ -0,0 +1,386 @@
+#! /usr/bin/env python3
+
+# Self-contained throughput benchmark of the batched drivers.
+#
+# Synthetic systems of several sizes are generated from inputs shipped with the source tree,
+#   heg      homogeneous electron gas with plane wave orbitals (ElectronGasOrbitalBuilder)
+#   diamond  diamond supercells with spline orbitals from the tests/solids wavefunctions
+#   molecule all-electron molecules with Gaussian orbitals from the src/QMCWaveFunctions/tests data
+# and run with fixed seeds for VMCBatched and DMCBatched over a range of crowd and walker counts.
+# The diamond runs can be repeated with 16-bit spline coefficients (int16_coefs) to compare the storage options.
+# Per-timer walker steps per second are read from the .info.xml timing output and written as JSON
+# so that the results can be tracked from commit to commit on a CPU-only machine.
+
+import argparse
+import json
+import os
+import shutil
+import subprocess
+import sys
+import time
+import xml.etree.ElementTree as ET
+
+source_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+
+heg_header = '''
+  <qmcsystem>
+    <simulationcell>
+      <parameter name="bconds"> p p p </parameter>
+      <parameter name="LR_dim_cutoff"> 6 </parameter>
+      <parameter name="rs"> 5.0 </parameter>
+      <parameter name="nparticles"> {nelec} </parameter>
+    </simulationcell>
+    <particleset name="e" random="yes">
+      <group name="u" size="{nup}" mass="1.0">
+        <parameter name="charge"> -1 </parameter>
+        <parameter name="mass"> 1.0 </parameter>
+      </group>
+      <group name="d" size="{nup}" mass="1.0">
+        <parameter name="charge"> -1 </parameter>
+        <parameter name="mass"> 1.0 </parameter>
+      </group>
+    </particleset>
+    <wavefunction name="psi0" target="e">
+      <sposet_builder type="heg">
+        <sposet type="heg" name="spo_ud" size="{nup}"/>
+      </sposet_builder>
+      <determinantset>
+        <slaterdeterminant>
+          <determinant id="updet" group="u" sposet="spo_ud" size="{nup}"/>
+          <determinant id="downdet" group="d" sposet="spo_ud" size="{nup}"/>
+        </slaterdeterminant>
+      </determinantset>
+      <jastrow name="J2" type="Two-Body" function="Bspline" optimize="no">
+        <correlation speciesA="u" speciesB="u" size="5">
+          <coefficients id="uu" type="Array"> 1.082858193 0.6653279375 0.4358910287 0.2243616172 0.1102948764 </coefficients>
+        </correlation>
+        <correlation speciesA="u" speciesB="d" size="5">
+          <coefficients id="ud" type="Array"> 1.696171854 1.047722154 0.6275148566 0.3175982878 0.1446706214 </coefficients>
+        </correlation>
+      </jastrow>
+    </wavefunction>
+    <hamiltonian name="h0" type="generic" target="e">
+      <pairpot type="coulomb" name="ElecElec" source="e" target="e"/>
+    </hamiltonian>
+  </qmcsystem>
+'''
+
+diamond_header = '''
+  <qmcsystem>
+    <simulationcell>
+      <parameter name="lattice" units="bohr">
+{lattice}
+      </parameter>
+      <parameter name="bconds"> p p p </parameter>
+      <parameter name="LR_dim_cutoff"> 15 </parameter>
+    </simulationcell>
+    <particleset name="e" random="yes">
+      <group name="u" size="{nup}" mass="1.0">
+        <parameter name="charge"> -1 </parameter>
+        <parameter name="mass"> 1.0 </parameter>
+      </group>
+      <group name="d" size="{nup}" mass="1.0">
+        <parameter name="charge"> -1 </parameter>
+        <parameter name="mass"> 1.0 </parameter>
+      </group>
+    </particleset>
+    <particleset name="ion0">
+      <group name="C" size="{nion}" mass="21894.7135906">
+        <parameter name="charge"> 4 </parameter>
+        <parameter name="valence"> 4 </parameter>
+        <parameter name="atomicnumber"> 6 </parameter>
+        <parameter name="mass"> 21894.7135906 </parameter>
+        <attrib name="position" datatype="posArray" condition="0">
+{positions}
+        </attrib>
+      </group>
+    </particleset>
+    <wavefunction name="psi0" target="e">
+      <determinantset type="einspline" href="pwscf.pwscf.h5" tilematrix="{tilematrix}" twistnum="0" source="ion0" meshfactor="1.0" precision="float"{spline_options}>
+        <slaterdeterminant>
+          <determinant id="updet" size="{nup}">
+            <occupation mode="ground" spindataset="0"/>
+          </determinant>
+          <determinant id="downdet" size="{nup}">
+            <occupation mode="ground" spindataset="0"/>
+          </determinant>
+        </slaterdeterminant>
+      </determinantset>
+      <jastrow type="One-Body" name="J1" function="bspline" source="ion0">
+        <correlation elementType="C" size="8" cusp="0.0">
+          <coefficients id="eC" type="Array"> -0.2032153051 -0.1625595974 -0.143124599 -0.1216434956 -0.09919771951 -0.07111729038 -0.04445345869 -0.02135082917 </coefficients>
+        </correlation>
+      </jastrow>
+      <jastrow type="Two-Body" name="J2" function="bspline">
+        <correlation speciesA="u" speciesB="u" size="8">
+          <coefficients id="uu" type="Array"> 0.2797730287 0.2172604155 0.1656172964 0.1216984261 0.083995349 0.05302065936 0.02915953995 0.0122402581 </coefficients>
+        </correlation>
+        <correlation speciesA="u" speciesB="d" size="8">
+          <coefficients id="ud" type="Array"> 0.4631099906 0.356399124 0.2587895287 0.1829298509 0.1233653291 0.07714708174 0.04145899033 0.01690645936 </coefficients>
+        </correlation>
+      </jastrow>
+    </wavefunction>
+    <hamiltonian name="h0" type="generic" target="e">
+      <pairpot type="coulomb" name="ElecElec" source="e" target="e"/>
+      <pairpot type="coulomb" name="IonIon" source="ion0" target="ion0"/>
+      <pairpot type="pseudo" name="PseudoPot" source="ion0" wavefunction="psi0" format="xml">
+        <pseudo elementType="C" href="C.BFD.xml"/>
+      </pairpot>
+    </hamiltonian>
+  </qmcsystem>
+'''
+
+molecule_header = '''
+  <include href="{name}.structure.xml"/>
+  <include href="{name}.wfnoj.xml"/>
+  <hamiltonian name="h0" type="generic" target="e">
+    <pairpot type="coulomb" name="ElecElec" source="e" target="e"/>
+    <pairpot type="coulomb" name="ElecIon" source="ion0" target="e"/>
+    <pairpot type="coulomb" name="IonIon" source="ion0" target="ion0"/>
+  </hamiltonian>
+'''
+
+# closed shells of the HEG at the gamma point
+heg_sizes = {'small': 14, 'medium': 38, 'large': 54}
+
+diamond_sizes = {
+    'small': {
+        'dir': 'diamondC_1x1x1_pp',
+        'tilematrix': '1 0 0 0 1 0 0 0 1',
+        'lattice': ['3.37316115 3.37316115 0.00000000',
+                    '0.00000000 3.37316115 3.37316115',
+                    '3.37316115 0.00000000 3.37316115'],
+        'positions': ['0.00000000 0.00000000 0.00000000',
+                      '1.68658058 1.68658058 1.68658058'],
+    },
+    'medium': {
+        'dir': 'diamondC_2x1x1_pp',
+        'tilematrix': '2 0 0 0 1 0 0 0 1',
+        'lattice': ['6.74632230 6.74632230 0.00000000',
+                    '0.00000000 3.37316115 3.37316115',
+                    '3.37316115 0.00000000 3.37316115'],
+        'positions': ['0.00000000 0.00000000 0.00000000',
+                      '1.68658058 1.68658058 1.68658058',
+                      '3.37316115 3.37316115 0.00000000',
+                      '5.05974172 5.05974172 1.68658058'],
+    },
+}
+
+molecule_sizes = {'small': 'hcn', 'medium': 'ethanol'}
+
+
+def qmc_sections(method, crowds, walkers_per_crowd, blocks, steps):
+  walkers = crowds * walkers_per_crowd
+  common = '''
+    <parameter name="crowds"> {crowds} </parameter>
+    <parameter name="walkers_per_rank"> {walkers} </parameter>
+    <parameter name="warmupSteps"> {warmup} </parameter>
+    <parameter name="blocks"> {blocks} </parameter>
+    <parameter name="steps"> {steps} </parameter>'''
+  vmc = '''
+  <qmc method="vmc" move="pbyp">
+    <estimator name="LocalEnergy" hdf5="no"/>''' + common + '''
+    <parameter name="timestep"> 0.3 </parameter>
+  </qmc>'''
+  dmc = '''
+  <qmc method="dmc" move="pbyp" checkpoint="-1">
+    <estimator name="LocalEnergy" hdf5="no"/>''' + common + '''
+    <parameter name="timestep"> 0.01 </parameter>
+  </qmc>'''
+  if method == 'vmc':
+    return vmc.format(crowds=crowds, walkers=walkers, warmup=steps, blocks=blocks, steps=steps)
+  # the short VMC section only provides the initial DMC population
+  return (vmc.format(crowds=crowds, walkers=walkers, warmup=steps, blocks=1, steps=1) +
+          dmc.format(crowds=crowds, walkers=walkers, warmup=steps, blocks=blocks, steps=steps))
+
+
+def driver_steps(method, blocks, steps):
+  """steps run by each driver of qmc_sections, VMC warm-up included. The batched DMC driver has no warm-up."""
+  if method == 'vmc':
+    return {'VMCBatched': steps + blocks * steps}
+  return {'VMCBatched': steps + 1, 'DMCBatched': blocks * steps}
+
+
+def system_header(system, size, spline_coefs, run_dir):
+  if system == 'heg':
+    nelec = heg_sizes[size]
+    return heg_header.format(nelec=nelec, nup=nelec // 2), nelec
+  if system == 'diamond':
+    d = diamond_sizes[size]
+    data_dir = os.path.join(source_dir, 'tests', 'solids', d['dir'])
+    for fname in ['pwscf.pwscf.h5', 'C.BFD.xml']:
+      shutil.copy(os.path.join(data_dir, fname), run_dir)
+    nion = len(d['positions'])
+    indent = '        '
+    return diamond_header.format(lattice='\n'.join(indent + l for l in d['lattice']),
+                                 positions='\n'.join(indent + p for p in d['positions']),
+                                 tilematrix=d['tilematrix'], nion=nion, nup=2 * nion,
+                                 spline_options=' int16_coefs="yes"' if spline_coefs == 'int16' else ''), 8 * nion
+  if system == 'molecule':
+    name = molecule_sizes[size]
+    data_dir = os.path.join(source_dir, 'src', 'QMCWaveFunctions', 'tests')
+    shutil.copy(os.path.join(data_dir, name + '.structure.xml'), run_dir)
+    # cusp correction only adds to the initialization time, leave it out
+    with open(os.path.join(data_dir, name + '.wfnoj.xml')) as fin:
+      wfn = fin.read().replace('cuspCorrection="yes"', 'cuspCorrection="no"')
+    with open(os.path.join(run_dir, name + '.wfnoj.xml'), 'w') as fout:
+      fout.write(wfn)
+    structure = ET.parse(os.path.join(data_dir, name + '.structure.xml'))
+    nelec = sum(int(g.get('size')) for g in structure.findall(".//particleset[@name='e']/group"))
+    return molecule_header.format(name=name), nelec
+  raise ValueError('Unknown system ' + system)
+
+
+def write_input(fname, project_id, header, sections, seed):
+  with open(fname, 'w') as fout:
+    fout.write('<?xml version="1.0"?>\n<simulation>\n')
+    fout.write('  <project id="%s" series="0">\n' % project_id)
+    fout.write('    <parameter name="driver_version">batched</parameter>\n')
+    fout.write('  </project>\n')
+    fout.write('  <random seed="%d"/>\n' % seed)
+    fout.write(header)
+    fout.write(sections)
+    fout.write('\n</simulation>\n')
+
+
+def flatten_timers(info_fname):
+  """sum the inclusive time and the calls of each timer over all the call stacks"""
+  timers = {}
+  tree = ET.parse(info_fname)
+  timing = tree.find('timing')
+  if timing is None:
+    return timers
+  for timer in timing.iter('timer'):
+    name = timer.find('name').text
+    t = timers.setdefault(name, {'time_incl': 0.0, 'calls': 0})
+    t['time_incl'] += float(timer.find('time_incl').text)
+    t['calls'] += int(timer.find('calls').text)
+  return timers
+
+
+def run_case(args, system, size, spline_coefs, method, crowds, walkers_per_crowd):
+  case_name = '%s_%s_%s_c%d_w%d' % (system, size, method, crowds, walkers_per_crowd)
+  if system == 'diamond':
+    case_name = '%s_%s_%s_%s_c%d_w%d' % (system, size, spline_coefs, method, crowds, walkers_per_crowd)
+  run_dir = os.path.join(args.work_dir, case_name)
+  os.makedirs(run_dir, exist_ok=True)
+  header, nelec = system_header(system, size, spline_coefs, run_dir)
+  input_fname = case_name + '.xml'
+  write_input(os.path.join(run_dir, input_fname), case_name, header,
+              qmc_sections(method, crowds, walkers_per_crowd, args.blocks, args.steps), args.seed)
+
+  result = {
+      'system': system,
+      'size': size,
+      'electrons': nelec,
+      'spline_coefs': spline_coefs if system == 'diamond' else None,
+      'driver': method,
+      'crowds': crowds,
+      'walkers_per_crowd': walkers_per_crowd,
+      'blocks': args.blocks,
+      'steps': args.steps,
+  }
+  if args.dry_run:
+    return result
+
+  cmd = args.launcher.split() + [args.qmcpack, '--enable-timers=' + args.timer_level, input_fname]
+  env = dict(os.environ)
+  env['OMP_NUM_THREADS'] = str(args.threads if args.threads else crowds)
+  start = time.time()
+  with open(os.path.join(run_dir, case_name + '.out'), 'w') as fout:
+    status = subprocess.call(cmd, cwd=run_dir, stdout=fout, stderr=subprocess.STDOUT, env=env)
+  result['wall_time'] = time.time() - start
+  result['status'] = 'success' if status == 0 else 'failure'
+
+  info_fname = os.path.join(run_dir, case_name + '.info.xml')
+  if status != 0 or not os.path.exists(info_fname):
+    result['status'] = 'failure'
+    return result
+
+  # walkers per rank times the number of steps. The DMC population only fluctuates around it.
+  # The timers of a driver only cover its own steps, the other timers cover the steps of every section.
+  walkers = crowds * walkers_per_crowd
+  driver_walker_steps = {driver: walkers * n for driver, n in driver_steps(method, args.blocks, args.steps).items()}
+  walker_steps = sum(driver_walker_steps.values())
+  result['walker_steps'] = walker_steps
+  result['driver_walker_steps'] = driver_walker_steps
+  result['timers'] = {}
+  for name, t in flatten_timers(info_fname).items():
+    timer_walker_steps = walker_steps
+    for driver, n in driver_walker_steps.items():
+      if name == driver or name.startswith(driver + '::'):
+        timer_walker_steps = n
+    t['walker_steps_per_second'] = timer_walker_steps / t['time_incl'] if t['time_incl'] > 0 else 0.0
+    result['timers'][name] = t
+  return result
+
+
+def int_list(s):
+  return [int(x) for x in s.split(',')]
+
+
+def str_list(s):
+  return s.split(',')
+
+
+if __name__ == '__main__':
+  parser = argparse.ArgumentParser(description='Batched driver throughput benchmark')
+  parser.add_argument('--qmcpack', default='qmcpack', help='qmcpack executable')
+  parser.add_argument('--launcher', default='', help='command prefix such as "mpirun -np 1"')
+  parser.add_argument('--output', default='qmcpack_perf.json', help='JSON result file')
+  parser.add_argument('--work-dir', default='qmcpack_perf_runs', help='directory holding the runs')
+  parser.add_argument('--systems', type=str_list, default=['heg', 'diamond', 'molecule'])
+  parser.add_argument('--sizes', type=str_list, default=['small', 'medium'])
+  parser.add_argument('--drivers', type=str_list, default=['vmc', 'dmc'])
+  parser.add_argument('--spline-coefs', type=str_list, default=['float'],
+                      help='spline coefficient storage of the diamond runs, float and/or int16')
+  parser.add_argument('--crowds', type=int_list, default=[1])
+  parser.add_argument('--walkers-per-crowd', type=int_list, default=[1, 8])
+  parser.add_argument('--threads', type=int, default=0, help='OMP_NUM_THREADS, default to the number of crowds')
+  parser.add_argument('--blocks', type=int, default=4)
+  parser.add_argument('--steps', type=int, default=5)
+  parser.add_argument('--seed', type=int, default=17)
+  parser.add_argument('--timer-level', default='fine', choices=['coarse', 'medium', 'fine'])
+  parser.add_argument('--dry-run', action='store_true', help='only write the inputs')
+  args = parser.parse_args()
+
+  args.work_dir = os.path.abspath(args.work_dir)
+  os.makedirs(args.work_dir, exist_ok=True)
+  if not args.dry_run and shutil.which(args.qmcpack) is None:
+    print('qmcpack executable %s not found' % args.qmcpack)
+    sys.exit(1)
+
+  for spline_coefs in args.spline_coefs:
+    if spline_coefs not in ['float', 'int16']:
+      parser.error('Unknown spline coefficient storage ' + spline_coefs)
+
+  size_tables = {'heg': heg_sizes, 'diamond': diamond_sizes, 'molecule': molecule_sizes}
+  results = []
+  for system in args.systems:
+    for size in args.sizes:
+      if size not in size_tables[system]:
+        continue
+      for spline_coefs in (args.spline_coefs if system == 'diamond' else ['float']):
+        for method in args.drivers:
+          for crowds in args.crowds:
+            for walkers_per_crowd in args.walkers_per_crowd:
+              result = run_case(args, system, size, spline_coefs, method, crowds, walkers_per_crowd)
+              results.append(result)
+              storage = spline_coefs if system == 'diamond' else ''
+              label = '%-10s %-7s %-5s %s crowds=%d walkers/crowd=%d' % (system, size, storage, method, crowds,
+                                                                          walkers_per_crowd)
+              if 'walker_steps' in result:
+                # RunSteps only times the steps, the driver scope timer also includes the startup
+                driver = 'VMCBatched' if method == 'vmc' else 'DMCBatched'
+                steps_timer = driver + '::RunSteps'
+                if steps_timer not in result['timers']:
+                  steps_timer = driver
+                rate = result['timers'].get(steps_timer, {}).get('walker_steps_per_second', 0.0)
+                print('%s  %.1f walker steps/s (%s)' % (label, rate, steps_timer))
+              elif not args.dry_run:
+                print('%s  FAILED' % label)
+
+  with open(args.output, 'w') as fout:
+    json.dump({'qmcpack': args.qmcpack, 'runs': results}, fout, indent=2)
+  print('Results written to %s' % args.output)
+  sys.exit(0 if all(r.get('status', 'success') == 'success' for r in results) else 1)